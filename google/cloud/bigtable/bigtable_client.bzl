@@ -29,6 +29,7 @@ bigtable_client_HDRS = [
     "internal/table_admin.h",
     "internal/unary_client_utils.h",
     "idempotent_mutation_policy.h",
+    "mutation_flow_controller.h",
     "mutations.h",
     "polling_policy.h",
     "read_modify_write_rule.h",
@@ -36,9 +37,11 @@ bigtable_client_HDRS = [
     "row_range.h",
     "row_reader.h",
     "row_set.h",
+    "scan_checkpoint.h",
     "rpc_backoff_policy.h",
     "rpc_retry_policy.h",
     "metadata_update_policy.h",
+    "metrics_data_client.h",
     "table.h",
     "table_admin.h",
     "table_config.h",
@@ -68,14 +71,17 @@ bigtable_client_SRCS = [
     "internal/table.cc",
     "internal/table_admin.cc",
     "idempotent_mutation_policy.cc",
+    "mutation_flow_controller.cc",
     "mutations.cc",
     "polling_policy.cc",
     "row_range.cc",
     "row_reader.cc",
     "row_set.cc",
+    "scan_checkpoint.cc",
     "rpc_backoff_policy.cc",
     "rpc_retry_policy.cc",
     "metadata_update_policy.cc",
+    "metrics_data_client.cc",
     "table.cc",
     "table_admin.cc",
     "table_config.cc",
@@ -21,6 +21,7 @@ bigtable_client_unit_tests = [
     "internal/prefix_range_end_test.cc",
     "internal/table_admin_test.cc",
     "internal/table_test.cc",
+    "mutation_flow_controller_test.cc",
     "mutations_test.cc",
     "table_admin_test.cc",
     "table_apply_test.cc",
@@ -37,8 +38,10 @@ bigtable_client_unit_tests = [
     "row_test.cc",
     "row_range_test.cc",
     "row_set_test.cc",
+    "scan_checkpoint_test.cc",
     "rpc_backoff_policy_test.cc",
     "metadata_update_policy_test.cc",
+    "metrics_data_client_test.cc",
     "rpc_retry_policy_test.cc",
     "polling_policy_test.cc",
 ]
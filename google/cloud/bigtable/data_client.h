@@ -23,6 +23,7 @@ namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 // Forward declare some classes so we can be friends.
+class MetricsDataClient;
 class Table;
 namespace noex {
 class Table;
@@ -74,6 +75,7 @@ class DataClient {
   friend class noex::Table;
   friend class internal::BulkMutator;
   friend class RowReader;
+  friend class MetricsDataClient;
   //@{
   /// @name the `google.bigtable.v2.Bigtable` wrappers.
   virtual grpc::Status MutateRow(
@@ -47,6 +47,9 @@ inline namespace BIGTABLE_CLIENT_NS {
  */
 class Filter {
  public:
+  explicit Filter(::google::bigtable::v2::RowFilter rhs)
+      : filter_(std::move(rhs)) {}
+
   Filter(Filter&& rhs) noexcept = default;
   Filter& operator=(Filter&& rhs) noexcept = default;
   Filter(Filter const& rhs) = default;
@@ -16,6 +16,7 @@
 #include "google/cloud/bigtable/internal/table.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
 #include "google/cloud/bigtable/table_strong_types.h"
+#include <google/protobuf/arena.h>
 #include <numeric>
 
 namespace google {
@@ -29,7 +30,8 @@ namespace btproto = google::bigtable::v2;
 BulkMutator::BulkMutator(bigtable::AppProfileId const& app_profile_id,
                          bigtable::TableId const& table_name,
                          IdempotentMutationPolicy& idempotent_policy,
-                         BulkMutation&& mut) {
+                         BulkMutation&& mut)
+    : mutation_count_(0), mutation_bytes_(0) {
   // Every time the client library calls MakeOneRequest(), the data in the
   // "pending_*" variables initializes the next request.  So in the constructor
   // we start by putting the data on the "pending_*" variables.
@@ -53,6 +55,8 @@ BulkMutator::BulkMutator(bigtable::AppProfileId const& app_profile_id,
                          });
     pending_annotations_.push_back(Annotations{index++, r, false});
   }
+  mutation_count_ = pending_annotations_.size();
+  mutation_bytes_ = pending_mutations_.ByteSizeLong();
 }
 
 grpc::Status BulkMutator::MakeOneRequest(bigtable::DataClient& client,
@@ -60,9 +64,15 @@ grpc::Status BulkMutator::MakeOneRequest(bigtable::DataClient& client,
   PrepareForRequest();
   // Send the request to the server and read the resulting result stream.
   auto stream = client.MutateRows(&client_context, mutations_);
-  btproto::MutateRowsResponse response;
-  while (stream->Read(&response)) {
-    ProcessResponse(response);
+  // The responses are small and short-lived, allocate them in an arena scoped
+  // to this request, the same message (and its entries) is reused for every
+  // Read() on the stream.
+  google::protobuf::Arena arena;
+  auto* response =
+      google::protobuf::Arena::CreateMessage<btproto::MutateRowsResponse>(
+          &arena);
+  while (stream->Read(response)) {
+    ProcessResponse(*response);
   }
   FinishRequest();
   return stream->Finish();
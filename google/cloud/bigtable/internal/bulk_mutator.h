@@ -37,6 +37,12 @@ class BulkMutator {
     return pending_mutations_.entries_size() != 0;
   }
 
+  /// Return the number of mutations (rows) in the initial request.
+  std::size_t mutation_count() const { return mutation_count_; }
+
+  /// Return the size, in bytes, of the mutations in the initial request.
+  std::size_t mutation_bytes() const { return mutation_bytes_; }
+
   /// Send one batch request to the given stub.
   grpc::Status MakeOneRequest(bigtable::DataClient& client,
                               grpc::ClientContext& client_context);
@@ -89,6 +95,10 @@ class BulkMutator {
 
   /// Accumulate annotations for the next request.
   std::vector<Annotations> pending_annotations_;
+
+  /// The size of the initial request, used for flow control.
+  std::size_t mutation_count_;
+  std::size_t mutation_bytes_;
 };
 }  // namespace internal
 }  // namespace BIGTABLE_CLIENT_NS
@@ -22,7 +22,7 @@ inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
 using google::bigtable::v2::ReadRowsResponse_CellChunk;
 
-void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
+void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk&& chunk,
                                  grpc::Status& status) {
   if (end_of_stream_) {
     status = grpc::Status(grpc::StatusCode::INTERNAL,
@@ -160,6 +160,23 @@ Row ReadRowsParser::Next(grpc::Status& status) {
   return row;
 }
 
+void ReadRowsParser::Reset() {
+  // Use clear() instead of assigning new objects, this preserves the capacity
+  // of the strings and vectors for the next stream.
+  row_key_.clear();
+  cells_.clear();
+  cell_first_chunk_ = true;
+  cell_.row.clear();
+  cell_.family.clear();
+  cell_.column.clear();
+  cell_.timestamp = 0;
+  cell_.value.clear();
+  cell_.labels.clear();
+  last_seen_row_key_.clear();
+  row_ready_ = false;
+  end_of_stream_ = false;
+}
+
 Cell ReadRowsParser::MovePartialToCell() {
   // The row, family, and column are explicitly copied because the
   // ReadRows v2 may reuse them in future chunks. See the CellChunk
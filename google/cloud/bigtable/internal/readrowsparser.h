@@ -43,10 +43,11 @@ namespace internal {
  * parser.HandleEndOfStream();
  * @endcode
  *
- * NO RECYCLING of the parser object: This is a stateful class, and a
- * single and unique parser should be used for each stream of ReadRows
- * responses. If errors occur, an exception is thrown as documented by
- * each method and the parser object is left in an undefined state.
+ * This is a stateful class, a parser should be used for a single stream of
+ * ReadRows responses at a time. Call Reset() before using the parser with a
+ * new stream, this keeps any memory already allocated by the parser. If errors
+ * occur, an exception is thrown as documented by each method and the parser
+ * object is left in an undefined state until Reset() is called.
  */
 class ReadRowsParser {
  public:
@@ -64,15 +65,27 @@ class ReadRowsParser {
   /**
    * Pass an input chunk proto to the parser.
    *
+   * The parser takes ownership of the data in @p chunk, the strings are
+   * swapped into the parser and no copies are made, even if the chunk was
+   * allocated in a `google::protobuf::Arena`.
+   *
    * @throws std::runtime_error if called while a row is available
    * (HasNext() is true).
    *
    * @throws std::runtime_error if validation failed.
    */
   virtual void HandleChunk(
-      google::bigtable::v2::ReadRowsResponse_CellChunk chunk,
+      google::bigtable::v2::ReadRowsResponse_CellChunk&& chunk,
       grpc::Status& status);
 
+  /// Pass a copy of @p chunk to the parser.
+  void HandleChunk(
+      google::bigtable::v2::ReadRowsResponse_CellChunk const& chunk,
+      grpc::Status& status) {
+    HandleChunk(google::bigtable::v2::ReadRowsResponse_CellChunk(chunk),
+                status);
+  }
+
   /**
    * Signal that the input stream reached the end.
    *
@@ -97,6 +110,13 @@ class ReadRowsParser {
    */
   virtual Row Next(grpc::Status& status);
 
+  /**
+   * Return the parser to its initial state, ready for a new stream.
+   *
+   * Any partially parsed data is discarded.
+   */
+  void Reset();
+
  private:
   /// Holds partially formed data until a full Row is ready.
   struct ParseCell {
@@ -15,6 +15,7 @@
 #include "google/cloud/bigtable/internal/readrowsparser.h"
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/internal/throw_delegate.h"
+#include <google/protobuf/arena.h>
 #include <google/protobuf/text_format.h>
 #include <gtest/gtest.h>
 #include <numeric>
@@ -119,6 +120,40 @@ TEST(ReadRowsParserTest, NextAfterEndOfStreamSucceeds) {
   EXPECT_FALSE(parser.HasNext());
 }
 
+TEST(ReadRowsParserTest, ResetAllowsNewStream) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  ReadRowsResponse_CellChunk chunk;
+  std::string chunk1 = R"(
+    row_key: "RK"
+    family_name: < value: "F">
+    qualifier: < value: "C">
+    timestamp_micros: 42
+    value: "V"
+    commit_row: true
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk1, &chunk));
+  grpc::Status status;
+  parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_EQ(1U, parser.Next(status).cells().size());
+
+  // Without a Reset() the same row key would be out of order, and the stream
+  // is already closed.
+  parser.Reset();
+  EXPECT_FALSE(parser.HasNext());
+  parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  EXPECT_TRUE(parser.HasNext());
+  auto row = parser.Next(status);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ("RK", row.row_key());
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+}
+
 TEST(ReadRowsParserTest, NextWithNoDataThrows) {
   ReadRowsParser parser;
   grpc::Status status;
@@ -161,6 +196,37 @@ TEST(ReadRowsParserTest, SingleChunkValueIsMoved) {
   EXPECT_EQ(data_ptr, r.cells().begin()->value().data());
 }
 
+TEST(ReadRowsParserTest, ArenaChunkValueIsMoved) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  google::protobuf::Arena arena;
+  auto* chunk =
+      google::protobuf::Arena::CreateMessage<ReadRowsResponse_CellChunk>(
+          &arena);
+  std::string chunk1 = R"(
+    row_key: "RK"
+    family_name: < value: "F">
+    qualifier: < value: "C">
+    timestamp_micros: 42
+    commit_row: true
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk1, chunk));
+
+  // Same check as above, but the chunk is owned by an arena, moving from it
+  // must not make a copy of the value.
+  std::string value(1024, 'a');
+  auto* data_ptr = value.data();
+  chunk->mutable_value()->swap(value);
+  grpc::Status status;
+  parser.HandleChunk(std::move(*chunk), status);
+  EXPECT_TRUE(status.ok());
+  ASSERT_TRUE(parser.HasNext());
+  google::cloud::bigtable::Row r = parser.Next(status);
+  ASSERT_EQ(1U, r.cells().size());
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(data_ptr, r.cells().begin()->value().data());
+}
+
 // **** Acceptance tests helpers ****
 
 namespace google {
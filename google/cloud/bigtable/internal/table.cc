@@ -31,14 +31,109 @@ using ClientUtils = bigtable::internal::noex::UnaryClientUtils<DataClient>;
 static_assert(std::is_copy_assignable<bigtable::noex::Table>::value,
               "bigtable::noex::Table must be CopyAssignable");
 
+namespace {
+/**
+ * Make one attempt to read the row requested in @p request.
+ *
+ * @return the status of the stream, or any error detected by the parser.
+ *     The row (if any) is returned in @p row, and @p rows_received counts the
+ *     rows returned by the server, which should never be more than one.
+ */
+grpc::Status ReadRowAttempt(DataClient& client,
+                            grpc::ClientContext& client_context,
+                            btproto::ReadRowsRequest const& request,
+                            btproto::ReadRowsResponse& response,
+                            bigtable::internal::ReadRowsParser& parser,
+                            Row& row, int& rows_received) {
+  grpc::Status status;
+  auto stream = client.ReadRows(&client_context, request);
+  while (status.ok() and stream->Read(&response)) {
+    for (auto& chunk : *response.mutable_chunks()) {
+      parser.HandleChunk(std::move(chunk), status);
+      if (not status.ok()) {
+        break;
+      }
+      if (parser.HasNext()) {
+        ++rows_received;
+        row = parser.Next(status);
+        if (not status.ok()) {
+          break;
+        }
+      }
+    }
+  }
+  if (not status.ok()) {
+    // The parser rejected the data, discard anything left in the stream.
+    client_context.TryCancel();
+    while (stream->Read(&response)) {
+    }
+    (void)stream->Finish();  // ignore errors
+    return status;
+  }
+  status = stream->Finish();
+  if (not status.ok()) {
+    return status;
+  }
+  parser.HandleEndOfStream(status);
+  return status;
+}
+
+/**
+ * Hold the capacity reserved in a MutationFlowController for one operation.
+ *
+ * All the member functions are no-ops if the controller is null, i.e., when
+ * the application did not configure flow control for the table.
+ */
+class FlowControlReservation {
+ public:
+  FlowControlReservation(MutationFlowController* controller,
+                         std::size_t mutations, std::size_t bytes)
+      : controller_(controller), mutations_(mutations), bytes_(bytes) {
+    if (controller_ != nullptr) {
+      controller_->Acquire(mutations_, bytes_);
+    }
+  }
+  ~FlowControlReservation() {
+    if (controller_ != nullptr) {
+      controller_->Release(mutations_, bytes_);
+    }
+  }
+  FlowControlReservation(FlowControlReservation const&) = delete;
+  FlowControlReservation& operator=(FlowControlReservation const&) = delete;
+
+  void WaitForRequestSlot() {
+    if (controller_ != nullptr) {
+      controller_->WaitForRequestSlot();
+    }
+  }
+
+  void OnCompletion(grpc::Status const& status, bool has_retryable_entries) {
+    if (controller_ == nullptr) {
+      return;
+    }
+    if (has_retryable_entries or MutationFlowController::IsPushback(status)) {
+      controller_->OnPushback();
+    } else if (status.ok()) {
+      controller_->OnSuccess();
+    }
+  }
+
+ private:
+  MutationFlowController* controller_;
+  std::size_t mutations_;
+  std::size_t bytes_;
+};
+}  // anonymous namespace
+
 // Call the `google.bigtable.v2.Bigtable.MutateRow` RPC repeatedly until
 // successful, or until the policies in effect tell us to stop.
 std::vector<FailedMutation> Table::Apply(SingleRowMutation&& mut) {
   // Copy the policies in effect for this operation.  Many policy classes change
   // their state as the operation makes progress (or fails to make progress), so
-  // we need fresh instances.
+  // we need fresh instances.  The backoff policy is only needed after a
+  // failure, most operations succeed on the first attempt and never copy it.
   auto rpc_policy = rpc_retry_policy_->clone();
-  auto backoff_policy = rpc_backoff_policy_->clone();
+  std::unique_ptr<RPCBackoffPolicy> backoff_policy;
   auto idempotent_policy = idempotent_mutation_policy_->clone();
 
   // Build the RPC request, try to minimize copying.
@@ -53,15 +148,24 @@ std::vector<FailedMutation> Table::Apply(SingleRowMutation&& mut) {
                     return idempotent_policy->is_idempotent(m);
                   });
 
+  FlowControlReservation reservation(flow_controller_.get(), 1,
+                                     request.ByteSizeLong());
+
   btproto::MutateRowResponse response;
   std::vector<FailedMutation> failures;
   grpc::Status status;
   while (true) {
     grpc::ClientContext client_context;
     rpc_policy->Setup(client_context);
-    backoff_policy->Setup(client_context);
+    if (backoff_policy) {
+      backoff_policy->Setup(client_context);
+    } else {
+      rpc_backoff_policy_->Setup(client_context);
+    }
     metadata_update_policy_.Setup(client_context);
+    reservation.WaitForRequestSlot();
     status = client_->MutateRow(&client_context, request, &response);
+    reservation.OnCompletion(status, false);
     if (status.ok()) {
       return failures;
     }
@@ -78,6 +182,9 @@ std::vector<FailedMutation> Table::Apply(SingleRowMutation&& mut) {
           "Permanent (or too many transient) errors in Table::Apply()");
       return failures;
     }
+    if (not backoff_policy) {
+      backoff_policy = rpc_backoff_policy_->clone();
+    }
     auto delay = backoff_policy->OnCompletion(status);
     std::this_thread::sleep_for(delay);
   }
@@ -91,23 +198,42 @@ std::vector<FailedMutation> Table::BulkApply(BulkMutation&& mut,
                                              grpc::Status& status) {
   // Copy the policies in effect for this operation.  Many policy classes change
   // their state as the operation makes progress (or fails to make progress), so
-  // we need fresh instances.
-  auto backoff_policy = rpc_backoff_policy_->clone();
+  // we need fresh instances.  The backoff policy is only needed if some
+  // mutations must be retried.
+  std::unique_ptr<RPCBackoffPolicy> backoff_policy;
   auto retry_policy = rpc_retry_policy_->clone();
   auto idemponent_policy = idempotent_mutation_policy_->clone();
 
   bigtable::internal::BulkMutator mutator(app_profile_id_, table_name_,
                                           *idemponent_policy,
                                           std::forward<BulkMutation>(mut));
+  FlowControlReservation reservation(flow_controller_.get(),
+                                     mutator.mutation_count(),
+                                     mutator.mutation_bytes());
   while (mutator.HasPendingMutations()) {
     grpc::ClientContext client_context;
-    backoff_policy->Setup(client_context);
+    if (backoff_policy) {
+      backoff_policy->Setup(client_context);
+    } else {
+      rpc_backoff_policy_->Setup(client_context);
+    }
     retry_policy->Setup(client_context);
     metadata_update_policy_.Setup(client_context);
+    reservation.WaitForRequestSlot();
     status = mutator.MakeOneRequest(*client_, client_context);
+    // Entries that must be retried are a sign that the server is shedding
+    // load, even if the stream itself completed successfully.
+    reservation.OnCompletion(status,
+                             status.ok() and mutator.HasPendingMutations());
     if (not status.ok() and not retry_policy->OnFailure(status)) {
       break;
     }
+    if (not mutator.HasPendingMutations()) {
+      break;
+    }
+    if (not backoff_policy) {
+      backoff_policy = rpc_backoff_policy_->clone();
+    }
     auto delay = backoff_policy->OnCompletion(status);
     std::this_thread::sleep_for(delay);
   }
@@ -143,25 +269,68 @@ RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
                    raise_on_error);
 }
 
+RowReader Table::ReadRows(ScanCheckpoint checkpoint, bool raise_on_error) {
+  return RowReader(client_, app_profile_id_, table_name_, checkpoint,
+                   rpc_retry_policy_->clone(), rpc_backoff_policy_->clone(),
+                   metadata_update_policy_,
+                   google::cloud::internal::make_unique<
+                       bigtable::internal::ReadRowsParserFactory>(),
+                   raise_on_error);
+}
+
+// Point reads are very common and latency sensitive, so Table::ReadRow() does
+// not create a full RowReader. The parser is created by the same factory used
+// by RowReader, the request, response and parser are reused across retries of
+// the same call, and the backoff policy is only cloned after a failure.
 std::pair<bool, Row> Table::ReadRow(std::string row_key, Filter filter,
                                     grpc::Status& status) {
-  RowSet row_set(std::move(row_key));
-  std::int64_t const rows_limit = 1;
-  RowReader reader =
-      ReadRows(std::move(row_set), rows_limit, std::move(filter));
-  auto it = reader.begin();
-  if (it == reader.end()) {
-    status = reader.Finish();
-    return std::make_pair(false, Row("", {}));
-  }
-  auto result = std::make_pair(true, std::move(*it));
-  if (++it != reader.end()) {
-    status =
-        grpc::Status(grpc::StatusCode::INTERNAL,
-                     "internal error - RowReader returned 2 rows in ReadRow()");
-    return std::make_pair(false, Row("", {}));
+  btproto::ReadRowsRequest request;
+  bigtable::internal::SetCommonTableOperationRequest<btproto::ReadRowsRequest>(
+      request, app_profile_id_.get(), table_name_.get());
+  request.mutable_rows()->add_row_keys(std::move(row_key));
+  *request.mutable_filter() = filter.as_proto_move();
+  request.set_rows_limit(1);
+
+  btproto::ReadRowsResponse response;
+  auto parser = bigtable::internal::ReadRowsParserFactory().Create();
+  auto retry_policy = rpc_retry_policy_->clone();
+  std::unique_ptr<RPCBackoffPolicy> backoff_policy;
+  while (true) {
+    grpc::ClientContext client_context;
+    retry_policy->Setup(client_context);
+    if (backoff_policy) {
+      backoff_policy->Setup(client_context);
+    } else {
+      rpc_backoff_policy_->Setup(client_context);
+    }
+    metadata_update_policy_.Setup(client_context);
+
+    Row row("", {});
+    int rows_received = 0;
+    parser->Reset();
+    status = ReadRowAttempt(*client_, client_context, request, response,
+                            *parser, row, rows_received);
+    if (rows_received > 1) {
+      status = grpc::Status(
+          grpc::StatusCode::INTERNAL,
+          "internal error - ReadRow() received more than one row");
+      return std::make_pair(false, Row("", {}));
+    }
+    if (rows_received == 1) {
+      // Any errors after the row is received are irrelevant, we have the data
+      // requested by the application.
+      status = grpc::Status::OK;
+      return std::make_pair(true, std::move(row));
+    }
+    if (status.ok() or not retry_policy->OnFailure(status)) {
+      return std::make_pair(false, Row("", {}));
+    }
+    if (not backoff_policy) {
+      backoff_policy = rpc_backoff_policy_->clone();
+    }
+    auto delay = backoff_policy->OnCompletion(status);
+    std::this_thread::sleep_for(delay);
   }
-  return result;
 }
 
 bool Table::CheckAndMutateRow(std::string row_key, Filter filter,
@@ -20,12 +20,14 @@
 #include "google/cloud/bigtable/filters.h"
 #include "google/cloud/bigtable/idempotent_mutation_policy.h"
 #include "google/cloud/bigtable/metadata_update_policy.h"
+#include "google/cloud/bigtable/mutation_flow_controller.h"
 #include "google/cloud/bigtable/mutations.h"
 #include "google/cloud/bigtable/read_modify_write_rule.h"
 #include "google/cloud/bigtable/row_reader.h"
 #include "google/cloud/bigtable/row_set.h"
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
+#include "google/cloud/bigtable/scan_checkpoint.h"
 #include "google/cloud/bigtable/table_strong_types.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
 
@@ -124,6 +126,8 @@ class Table {
   RowReader ReadRows(RowSet row_set, std::int64_t rows_limit, Filter filter,
                      bool raise_on_error = false);
 
+  RowReader ReadRows(ScanCheckpoint checkpoint, bool raise_on_error = false);
+
   std::pair<bool, Row> ReadRow(std::string row_key, Filter filter,
                                grpc::Status& status);
 
@@ -190,6 +194,12 @@ class Table {
     idempotent_mutation_policy_ = policy.clone();
   }
 
+  // The flow controller is shared, not cloned, all the operations (and all the
+  // tables) configured with the same object share the same limits.
+  void ChangePolicy(std::shared_ptr<MutationFlowController> const& policy) {
+    flow_controller_ = policy;
+  }
+
   template <typename Policy, typename... Policies>
   void ChangePolicies(Policy&& policy, Policies&&... policies) {
     ChangePolicy(policy);
@@ -225,6 +235,7 @@ class Table {
   std::shared_ptr<RPCBackoffPolicy> rpc_backoff_policy_;
   MetadataUpdatePolicy metadata_update_policy_;
   std::shared_ptr<IdempotentMutationPolicy> idempotent_mutation_policy_;
+  std::shared_ptr<MutationFlowController> flow_controller_;
 };
 
 }  // namespace noex
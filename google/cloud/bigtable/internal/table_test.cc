@@ -282,6 +282,105 @@ TEST_F(NoexTableTest, ReadRowError) {
   EXPECT_FALSE(std::get<0>(result));
 }
 
+TEST_F(NoexTableTest, ReadRowRetry) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+  grpc::Status status;
+  auto response =
+      bigtable::testing::internal::ReadRowsResponseFromString(R"(
+chunks {
+row_key: "r1"
+    family_name { value: "fam" }
+    qualifier { value: "col" }
+timestamp_micros: 42000
+value: "value"
+commit_row: true
+}
+)",
+                                                              status);
+  EXPECT_TRUE(status.ok());
+
+  auto s1 = google::cloud::internal::make_unique<MockReadRowsReader>();
+  EXPECT_CALL(*s1, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*s1, Finish())
+      .WillOnce(Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "retry")));
+
+  auto s2 = google::cloud::internal::make_unique<MockReadRowsReader>();
+  EXPECT_CALL(*s2, Read(_))
+      .WillOnce(Invoke([&response](btproto::ReadRowsResponse* r) {
+        *r = response;
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*s2, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke([&s1](grpc::ClientContext*,
+                             btproto::ReadRowsRequest const& req) {
+        EXPECT_EQ("r1", req.rows().row_keys(0));
+        return s1.release()->AsUniqueMocked();
+      }))
+      .WillOnce(Invoke([&s2](grpc::ClientContext*,
+                             btproto::ReadRowsRequest const& req) {
+        // The retry must send the same request.
+        EXPECT_EQ(1, req.rows().row_keys_size());
+        EXPECT_EQ("r1", req.rows().row_keys(0));
+        EXPECT_EQ(1, req.rows_limit());
+        return s2.release()->AsUniqueMocked();
+      }));
+
+  auto result = table_.ReadRow("r1", bigtable::Filter::PassAllFilter(), status);
+  EXPECT_TRUE(status.ok());
+  EXPECT_TRUE(std::get<0>(result));
+  EXPECT_EQ("r1", std::get<1>(result).row_key());
+}
+
+TEST_F(NoexTableTest, ReadRowTwoRows) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+  grpc::Status status;
+  auto response =
+      bigtable::testing::internal::ReadRowsResponseFromString(R"(
+chunks {
+row_key: "r1"
+    family_name { value: "fam" }
+    qualifier { value: "col" }
+timestamp_micros: 42000
+value: "value"
+commit_row: true
+}
+chunks {
+row_key: "r2"
+    family_name { value: "fam" }
+    qualifier { value: "col" }
+timestamp_micros: 42000
+value: "value"
+commit_row: true
+}
+)",
+                                                              status);
+  EXPECT_TRUE(status.ok());
+
+  auto stream = google::cloud::internal::make_unique<MockReadRowsReader>();
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(Invoke([&response](btproto::ReadRowsResponse* r) {
+        *r = response;
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(
+          [&stream](grpc::ClientContext*, btproto::ReadRowsRequest const&) {
+            return stream.release()->AsUniqueMocked();
+          }));
+
+  auto result = table_.ReadRow("r1", bigtable::Filter::PassAllFilter(), status);
+  EXPECT_EQ(grpc::StatusCode::INTERNAL, status.error_code());
+  EXPECT_FALSE(std::get<0>(result));
+}
+
 TEST_F(NoexTableTest, ReadRowsCanReadOneRow) {
   grpc::Status status;
   auto response =
@@ -0,0 +1,192 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/metrics_data_client.h"
+#include "google/cloud/internal/make_unique.h"
+#include <chrono>
+
+namespace btproto = google::bigtable::v2;
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+void Report(google::cloud::RpcMetrics& metrics, char const* rpc,
+            Clock::time_point start, grpc::Status const& status,
+            std::int64_t bytes_sent, std::int64_t bytes_received,
+            std::int64_t messages_received) {
+  google::cloud::RpcMetricsRecord record{
+      rpc,
+      std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                            start),
+      static_cast<int>(status.error_code()),
+      status.ok(),
+      bytes_sent,
+      bytes_received,
+      messages_received};
+  metrics.OnAttemptComplete(record);
+}
+
+/**
+ * Wrap a unary RPC, measuring its latency and the size of the messages.
+ */
+template <typename Request, typename Response, typename Function>
+grpc::Status MakeUnaryCall(google::cloud::RpcMetrics& metrics, char const* rpc,
+                           Request const& request, Response* response,
+                           Function&& call) {
+  auto const start = Clock::now();
+  auto status = call();
+  Report(metrics, rpc, start, status,
+         static_cast<std::int64_t>(request.ByteSizeLong()),
+         static_cast<std::int64_t>(response->ByteSizeLong()), 1);
+  return status;
+}
+
+/**
+ * Wrap a streaming RPC reader, the measurements are reported by `Finish()`.
+ */
+template <typename Response>
+class MetricsStreamReader : public grpc::ClientReaderInterface<Response> {
+ public:
+  MetricsStreamReader(
+      std::unique_ptr<grpc::ClientReaderInterface<Response>> reader,
+      google::cloud::RpcMetrics& metrics, char const* rpc,
+      Clock::time_point start, std::int64_t bytes_sent)
+      : reader_(std::move(reader)),
+        metrics_(metrics),
+        rpc_(rpc),
+        start_(start),
+        bytes_sent_(bytes_sent),
+        bytes_received_(0),
+        messages_received_(0) {}
+
+  void WaitForInitialMetadata() override { reader_->WaitForInitialMetadata(); }
+
+  bool NextMessageSize(std::uint32_t* sz) override {
+    return reader_->NextMessageSize(sz);
+  }
+
+  bool Read(Response* msg) override {
+    if (not reader_->Read(msg)) {
+      return false;
+    }
+    ++messages_received_;
+    bytes_received_ += static_cast<std::int64_t>(msg->ByteSizeLong());
+    return true;
+  }
+
+  grpc::Status Finish() override {
+    auto status = reader_->Finish();
+    Report(metrics_, rpc_, start_, status, bytes_sent_, bytes_received_,
+           messages_received_);
+    return status;
+  }
+
+ private:
+  std::unique_ptr<grpc::ClientReaderInterface<Response>> reader_;
+  google::cloud::RpcMetrics& metrics_;
+  char const* rpc_;
+  Clock::time_point start_;
+  std::int64_t bytes_sent_;
+  std::int64_t bytes_received_;
+  std::int64_t messages_received_;
+};
+
+template <typename Request, typename Response>
+std::unique_ptr<grpc::ClientReaderInterface<Response>> MakeStream(
+    google::cloud::RpcMetrics& metrics, char const* rpc,
+    Clock::time_point start, Request const& request,
+    std::unique_ptr<grpc::ClientReaderInterface<Response>> reader) {
+  return google::cloud::internal::make_unique<MetricsStreamReader<Response>>(
+      std::move(reader), metrics, rpc, start,
+      static_cast<std::int64_t>(request.ByteSizeLong()));
+}
+}  // namespace
+
+MetricsDataClient::MetricsDataClient(
+    std::shared_ptr<DataClient> client,
+    std::shared_ptr<google::cloud::RpcMetrics> metrics)
+    : client_(std::move(client)), metrics_(std::move(metrics)) {}
+
+std::string const& MetricsDataClient::project_id() const {
+  return client_->project_id();
+}
+
+std::string const& MetricsDataClient::instance_id() const {
+  return client_->instance_id();
+}
+
+std::shared_ptr<grpc::Channel> MetricsDataClient::Channel() {
+  return client_->Channel();
+}
+
+void MetricsDataClient::reset() { client_->reset(); }
+
+grpc::Status MetricsDataClient::MutateRow(
+    grpc::ClientContext* context, btproto::MutateRowRequest const& request,
+    btproto::MutateRowResponse* response) {
+  return MakeUnaryCall(*metrics_, __func__, request, response, [&] {
+    return client_->MutateRow(context, request, response);
+  });
+}
+
+grpc::Status MetricsDataClient::CheckAndMutateRow(
+    grpc::ClientContext* context,
+    btproto::CheckAndMutateRowRequest const& request,
+    btproto::CheckAndMutateRowResponse* response) {
+  return MakeUnaryCall(*metrics_, __func__, request, response, [&] {
+    return client_->CheckAndMutateRow(context, request, response);
+  });
+}
+
+grpc::Status MetricsDataClient::ReadModifyWriteRow(
+    grpc::ClientContext* context,
+    btproto::ReadModifyWriteRowRequest const& request,
+    btproto::ReadModifyWriteRowResponse* response) {
+  return MakeUnaryCall(*metrics_, __func__, request, response, [&] {
+    return client_->ReadModifyWriteRow(context, request, response);
+  });
+}
+
+std::unique_ptr<grpc::ClientReaderInterface<btproto::ReadRowsResponse>>
+MetricsDataClient::ReadRows(grpc::ClientContext* context,
+                            btproto::ReadRowsRequest const& request) {
+  auto const start = Clock::now();
+  return MakeStream(*metrics_, __func__, start, request,
+                    client_->ReadRows(context, request));
+}
+
+std::unique_ptr<grpc::ClientReaderInterface<btproto::SampleRowKeysResponse>>
+MetricsDataClient::SampleRowKeys(grpc::ClientContext* context,
+                                 btproto::SampleRowKeysRequest const& request) {
+  auto const start = Clock::now();
+  return MakeStream(*metrics_, __func__, start, request,
+                    client_->SampleRowKeys(context, request));
+}
+
+std::unique_ptr<grpc::ClientReaderInterface<btproto::MutateRowsResponse>>
+MetricsDataClient::MutateRows(grpc::ClientContext* context,
+                              btproto::MutateRowsRequest const& request) {
+  auto const start = Clock::now();
+  return MakeStream(*metrics_, __func__, start, request,
+                    client_->MutateRows(context, request));
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
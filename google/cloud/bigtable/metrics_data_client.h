@@ -0,0 +1,95 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_METRICS_DATA_CLIENT_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_METRICS_DATA_CLIENT_H_
+
+#include "google/cloud/bigtable/data_client.h"
+#include "google/cloud/rpc_metrics.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * A `DataClient` decorator that reports the latency and outcome of each RPC.
+ *
+ * The `bigtable::Table` class implements its retry loops on top of the
+ * `DataClient`, so each attempt is reported separately, including the status
+ * code of failed (and retried) attempts.  For streaming RPCs (`ReadRows`,
+ * `MutateRows`, and `SampleRowKeys`) the latency is measured until the stream
+ * is finished, and the number and size of the responses is reported.
+ *
+ * @par Example
+ * @code
+ * auto metrics = std::make_shared<google::cloud::HistogramRpcMetrics>();
+ * auto client = std::make_shared<bigtable::MetricsDataClient>(
+ *     bigtable::CreateDefaultDataClient(project_id, instance_id, options),
+ *     metrics);
+ * bigtable::Table table(client, "my-table");
+ * @endcode
+ */
+class MetricsDataClient : public DataClient {
+ public:
+  MetricsDataClient(std::shared_ptr<DataClient> client,
+                    std::shared_ptr<google::cloud::RpcMetrics> metrics);
+
+  std::string const& project_id() const override;
+  std::string const& instance_id() const override;
+  std::shared_ptr<grpc::Channel> Channel() override;
+  void reset() override;
+
+  std::shared_ptr<DataClient> client() const { return client_; }
+
+ protected:
+  //@{
+  /// @name the `google.bigtable.v2.Bigtable` wrappers.
+  grpc::Status MutateRow(
+      grpc::ClientContext* context,
+      google::bigtable::v2::MutateRowRequest const& request,
+      google::bigtable::v2::MutateRowResponse* response) override;
+  grpc::Status CheckAndMutateRow(
+      grpc::ClientContext* context,
+      google::bigtable::v2::CheckAndMutateRowRequest const& request,
+      google::bigtable::v2::CheckAndMutateRowResponse* response) override;
+  grpc::Status ReadModifyWriteRow(
+      grpc::ClientContext* context,
+      google::bigtable::v2::ReadModifyWriteRowRequest const& request,
+      google::bigtable::v2::ReadModifyWriteRowResponse* response) override;
+  std::unique_ptr<
+      grpc::ClientReaderInterface<google::bigtable::v2::ReadRowsResponse>>
+  ReadRows(grpc::ClientContext* context,
+           google::bigtable::v2::ReadRowsRequest const& request) override;
+  std::unique_ptr<
+      grpc::ClientReaderInterface<google::bigtable::v2::SampleRowKeysResponse>>
+  SampleRowKeys(
+      grpc::ClientContext* context,
+      google::bigtable::v2::SampleRowKeysRequest const& request) override;
+  std::unique_ptr<
+      grpc::ClientReaderInterface<google::bigtable::v2::MutateRowsResponse>>
+  MutateRows(grpc::ClientContext* context,
+             google::bigtable::v2::MutateRowsRequest const& request) override;
+  //@}
+
+ private:
+  std::shared_ptr<DataClient> client_;
+  std::shared_ptr<google::cloud::RpcMetrics> metrics_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_METRICS_DATA_CLIENT_H_
@@ -0,0 +1,89 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/metrics_data_client.h"
+#include "google/cloud/bigtable/testing/mock_sample_row_keys_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+
+namespace bigtable = google::cloud::bigtable;
+using namespace google::cloud::testing_util::chrono_literals;
+
+/// Define helper types and functions for this test.
+namespace {
+class MetricsDataClientTest : public bigtable::testing::TableTestFixture {
+ protected:
+  std::shared_ptr<google::cloud::HistogramRpcMetrics> metrics_ =
+      std::make_shared<google::cloud::HistogramRpcMetrics>();
+  bigtable::Table metrics_table_ = bigtable::Table(
+      std::make_shared<bigtable::MetricsDataClient>(client_, metrics_),
+      kTableId);
+};
+using bigtable::testing::MockSampleRowKeysReader;
+}  // anonymous namespace
+
+/// @test Verify that each attempt of a unary RPC is reported.
+TEST_F(MetricsDataClientTest, UnaryRetries) {
+  using namespace ::testing;
+
+  EXPECT_CALL(*client_, MutateRow(_, _, _))
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again")))
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again")))
+      .WillOnce(Return(grpc::Status::OK));
+
+  metrics_table_.Apply(bigtable::SingleRowMutation(
+      "bar", {bigtable::SetCell("fam", "col", 0_ms, "val")}));
+
+  auto snapshot = metrics_->Snapshot();
+  ASSERT_EQ(1U, snapshot.size());
+  auto const& summary = snapshot["MutateRow"];
+  EXPECT_EQ(3, summary.attempts);
+  EXPECT_LT(0, summary.bytes_sent);
+  EXPECT_THAT(summary.failures,
+              ElementsAre(Pair(int(grpc::StatusCode::UNAVAILABLE), 2)));
+}
+
+/// @test Verify that streaming RPCs report the number of responses.
+TEST_F(MetricsDataClientTest, StreamingRpc) {
+  using namespace ::testing;
+  namespace btproto = ::google::bigtable::v2;
+
+  auto reader = new MockSampleRowKeysReader;
+  EXPECT_CALL(*client_, SampleRowKeys(_, _))
+      .WillOnce(Invoke(reader->MakeMockReturner()));
+  EXPECT_CALL(*reader, Read(_))
+      .WillOnce(Invoke([](btproto::SampleRowKeysResponse* r) {
+        r->set_row_key("test1");
+        r->set_offset_bytes(11);
+        return true;
+      }))
+      .WillOnce(Invoke([](btproto::SampleRowKeysResponse* r) {
+        r->set_row_key("test2");
+        r->set_offset_bytes(22);
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*reader, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  auto samples = metrics_table_.SampleRows<>();
+  EXPECT_EQ(2U, samples.size());
+
+  auto summary = metrics_->Snapshot()["SampleRowKeys"];
+  EXPECT_EQ(1, summary.attempts);
+  EXPECT_EQ(2, summary.messages_received);
+  EXPECT_LT(0, summary.bytes_received);
+  EXPECT_TRUE(summary.failures.empty());
+}
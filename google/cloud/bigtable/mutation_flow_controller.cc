@@ -0,0 +1,210 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/mutation_flow_controller.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <algorithm>
+
+namespace {
+// Define the defaults using a pre-processor macro, this allows the application
+// developers to change the defaults for their application by compiling with
+// different values.
+#ifndef BIGTABLE_CLIENT_DEFAULT_MAX_OUTSTANDING_MUTATIONS
+// The service rejects MutateRows requests with more than 100,000 entries.
+#define BIGTABLE_CLIENT_DEFAULT_MAX_OUTSTANDING_MUTATIONS 100000
+#endif  // BIGTABLE_CLIENT_DEFAULT_MAX_OUTSTANDING_MUTATIONS
+
+#ifndef BIGTABLE_CLIENT_DEFAULT_MAX_OUTSTANDING_BYTES
+#define BIGTABLE_CLIENT_DEFAULT_MAX_OUTSTANDING_BYTES (256 * 1024 * 1024)
+#endif  // BIGTABLE_CLIENT_DEFAULT_MAX_OUTSTANDING_BYTES
+
+std::size_t const DEFAULT_MAX_OUTSTANDING_MUTATIONS =
+    BIGTABLE_CLIENT_DEFAULT_MAX_OUTSTANDING_MUTATIONS;
+std::size_t const DEFAULT_MAX_OUTSTANDING_BYTES =
+    BIGTABLE_CLIENT_DEFAULT_MAX_OUTSTANDING_BYTES;
+
+/// Each successful RPC raises the limits by this fraction of the maximum.
+std::size_t const INCREASE_DIVISOR = 10;
+}  // anonymous namespace
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+MutationFlowControlOptions::MutationFlowControlOptions()
+    : max_outstanding_mutations_(DEFAULT_MAX_OUTSTANDING_MUTATIONS),
+      max_outstanding_bytes_(DEFAULT_MAX_OUTSTANDING_BYTES),
+      max_requests_per_second_(0.0) {}
+
+MutationFlowControlOptions&
+MutationFlowControlOptions::set_max_outstanding_mutations(std::size_t v) {
+  if (v == 0) {
+    google::cloud::internal::RaiseRangeError(
+        "MutationFlowControlOptions::set_max_outstanding_mutations requires "
+        "v > 0");
+  }
+  max_outstanding_mutations_ = v;
+  return *this;
+}
+
+MutationFlowControlOptions&
+MutationFlowControlOptions::set_max_outstanding_bytes(std::size_t v) {
+  if (v == 0) {
+    google::cloud::internal::RaiseRangeError(
+        "MutationFlowControlOptions::set_max_outstanding_bytes requires v > 0");
+  }
+  max_outstanding_bytes_ = v;
+  return *this;
+}
+
+MutationFlowControlOptions&
+MutationFlowControlOptions::set_max_requests_per_second(double v) {
+  if (v < 0.0) {
+    google::cloud::internal::RaiseRangeError(
+        "MutationFlowControlOptions::set_max_requests_per_second requires "
+        "v >= 0");
+  }
+  max_requests_per_second_ = v;
+  return *this;
+}
+
+MutationFlowController::MutationFlowController(
+    MutationFlowControlOptions options)
+    : options_(std::move(options)),
+      mutations_limit_(options_.max_outstanding_mutations()),
+      bytes_limit_(options_.max_outstanding_bytes()),
+      outstanding_mutations_(0),
+      outstanding_bytes_(0),
+      tokens_(std::max(1.0, options_.max_requests_per_second())),
+      last_refill_(std::chrono::steady_clock::now()) {}
+
+void MutationFlowController::Acquire(std::size_t mutations,
+                                     std::size_t bytes) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this, mutations, bytes] {
+    return HasCapacity(mutations, bytes);
+  });
+  outstanding_mutations_ += mutations;
+  outstanding_bytes_ += bytes;
+}
+
+bool MutationFlowController::TryAcquire(std::size_t mutations,
+                                        std::size_t bytes) {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (not HasCapacity(mutations, bytes)) {
+    return false;
+  }
+  outstanding_mutations_ += mutations;
+  outstanding_bytes_ += bytes;
+  return true;
+}
+
+void MutationFlowController::Release(std::size_t mutations,
+                                     std::size_t bytes) {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    outstanding_mutations_ -= std::min(mutations, outstanding_mutations_);
+    outstanding_bytes_ -= std::min(bytes, outstanding_bytes_);
+  }
+  cv_.notify_all();
+}
+
+void MutationFlowController::WaitForRequestSlot() {
+  double const rate = options_.max_requests_per_second();
+  if (rate == 0.0) {
+    return;
+  }
+  double const capacity = std::max(1.0, rate);
+  std::unique_lock<std::mutex> lk(mu_);
+  while (true) {
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = now - last_refill_;
+    last_refill_ = now;
+    tokens_ = std::min(capacity, tokens_ + elapsed.count() * rate);
+    if (tokens_ >= 1.0) {
+      tokens_ -= 1.0;
+      return;
+    }
+    // Release the lock while waiting, other threads can make progress and
+    // will refill the bucket as needed.
+    std::chrono::duration<double> delay((1.0 - tokens_) / rate);
+    cv_.wait_for(lk, delay);
+  }
+}
+
+void MutationFlowController::OnSuccess() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto const max_mutations = options_.max_outstanding_mutations();
+    auto const max_bytes = options_.max_outstanding_bytes();
+    if (mutations_limit_ == max_mutations and bytes_limit_ == max_bytes) {
+      return;
+    }
+    mutations_limit_ = std::min(
+        max_mutations,
+        mutations_limit_ + std::max<std::size_t>(
+                               1, max_mutations / INCREASE_DIVISOR));
+    bytes_limit_ = std::min(
+        max_bytes,
+        bytes_limit_ + std::max<std::size_t>(1, max_bytes / INCREASE_DIVISOR));
+  }
+  cv_.notify_all();
+}
+
+void MutationFlowController::OnPushback() {
+  std::lock_guard<std::mutex> lk(mu_);
+  mutations_limit_ = std::max<std::size_t>(1, mutations_limit_ / 2);
+  bytes_limit_ = std::max<std::size_t>(1, bytes_limit_ / 2);
+}
+
+bool MutationFlowController::IsPushback(grpc::Status const& status) {
+  return status.error_code() == grpc::StatusCode::UNAVAILABLE or
+         status.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED;
+}
+
+std::size_t MutationFlowController::mutations_limit() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return mutations_limit_;
+}
+
+std::size_t MutationFlowController::bytes_limit() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return bytes_limit_;
+}
+
+std::size_t MutationFlowController::outstanding_mutations() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return outstanding_mutations_;
+}
+
+std::size_t MutationFlowController::outstanding_bytes() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return outstanding_bytes_;
+}
+
+bool MutationFlowController::HasCapacity(std::size_t mutations,
+                                         std::size_t bytes) const {
+  // Always admit a request if nothing is outstanding, otherwise a single
+  // request larger than the limits would block forever.
+  if (outstanding_mutations_ == 0 and outstanding_bytes_ == 0) {
+    return true;
+  }
+  return outstanding_mutations_ + mutations <= mutations_limit_ and
+         outstanding_bytes_ + bytes <= bytes_limit_;
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,155 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_MUTATION_FLOW_CONTROLLER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_MUTATION_FLOW_CONTROLLER_H_
+
+#include "google/cloud/bigtable/version.h"
+#include <grpcpp/grpcpp.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Configuration options for `MutationFlowController`.
+ *
+ * Applications typically configure the flow controller using:
+ * @code
+ * auto flow_control = std::make_shared<bigtable::MutationFlowController>(
+ *     bigtable::MutationFlowControlOptions()
+ *         .set_max_outstanding_mutations(10000)
+ *         .set_max_outstanding_bytes(64 * 1024 * 1024)
+ *         .set_max_requests_per_second(100.0));
+ * @endcode
+ */
+class MutationFlowControlOptions {
+ public:
+  MutationFlowControlOptions();
+
+  /// The maximum number of mutations (rows) sent but not yet completed.
+  std::size_t max_outstanding_mutations() const {
+    return max_outstanding_mutations_;
+  }
+  MutationFlowControlOptions& set_max_outstanding_mutations(std::size_t v);
+
+  /// The maximum number of mutation bytes sent but not yet completed.
+  std::size_t max_outstanding_bytes() const { return max_outstanding_bytes_; }
+  MutationFlowControlOptions& set_max_outstanding_bytes(std::size_t v);
+
+  /**
+   * The maximum rate for mutation RPCs, including retries.
+   *
+   * A value of `0` (the default) disables rate limiting.  The rate is
+   * enforced with a token bucket that can accumulate up to one second worth of
+   * tokens, so short bursts are allowed.
+   */
+  double max_requests_per_second() const { return max_requests_per_second_; }
+  MutationFlowControlOptions& set_max_requests_per_second(double v);
+
+ private:
+  std::size_t max_outstanding_mutations_;
+  std::size_t max_outstanding_bytes_;
+  double max_requests_per_second_;
+};
+
+/**
+ * Limit the number of mutations, bytes, and RPCs in flight for a Table.
+ *
+ * When many threads call `Table::BulkApply()` or `Table::Apply()` nothing
+ * limits how much data is sent to the server.  Applications can share an
+ * instance of this class across all the `Table` objects that write to the same
+ * cluster to bound the outstanding mutations and bytes, and optionally the
+ * rate of mutation RPCs.
+ *
+ * The limits are adjusted dynamically: when the server pushes back (the RPC
+ * or some of its entries fail with `UNAVAILABLE` or `RESOURCE_EXHAUSTED`) the
+ * limits are halved, each successful RPC raises them back towards the
+ * configured maximums.
+ *
+ * A reservation is always admitted if nothing else is outstanding, so a single
+ * `BulkMutation` larger than the limits does not deadlock.
+ *
+ * @par Thread-safety
+ * Instances of this class are meant to be shared across threads, all the
+ * member functions are thread-safe.
+ */
+class MutationFlowController {
+ public:
+  explicit MutationFlowController(
+      MutationFlowControlOptions options = MutationFlowControlOptions());
+
+  MutationFlowController(MutationFlowController const&) = delete;
+  MutationFlowController& operator=(MutationFlowController const&) = delete;
+
+  /**
+   * Reserve capacity for @p mutations totalling @p bytes, blocking until the
+   * capacity is available.
+   */
+  void Acquire(std::size_t mutations, std::size_t bytes);
+
+  /// Reserve capacity only if it is immediately available.
+  bool TryAcquire(std::size_t mutations, std::size_t bytes);
+
+  /// Return capacity reserved by a previous `Acquire()` call.
+  void Release(std::size_t mutations, std::size_t bytes);
+
+  /**
+   * Block until the rate limiter allows one more RPC.
+   *
+   * This is a no-op if `max_requests_per_second()` is `0`.
+   */
+  void WaitForRequestSlot();
+
+  /// Report a successful RPC, the limits grow back towards their maximums.
+  void OnSuccess();
+
+  /// Report that the server pushed back, the limits are reduced.
+  void OnPushback();
+
+  /// Return true if @p status indicates the server is shedding load.
+  static bool IsPushback(grpc::Status const& status);
+
+  //@{
+  /// @name Accessors, mostly intended for testing and monitoring.
+  std::size_t mutations_limit() const;
+  std::size_t bytes_limit() const;
+  std::size_t outstanding_mutations() const;
+  std::size_t outstanding_bytes() const;
+  //@}
+
+ private:
+  bool HasCapacity(std::size_t mutations, std::size_t bytes) const;
+
+  MutationFlowControlOptions const options_;
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::size_t mutations_limit_;
+  std::size_t bytes_limit_;
+  std::size_t outstanding_mutations_;
+  std::size_t outstanding_bytes_;
+  double tokens_;
+  std::chrono::steady_clock::time_point last_refill_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_MUTATION_FLOW_CONTROLLER_H_
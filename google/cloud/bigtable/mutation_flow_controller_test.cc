@@ -0,0 +1,151 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/mutation_flow_controller.h"
+#include "google/cloud/testing_util/chrono_literals.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace bigtable = google::cloud::bigtable;
+using namespace google::cloud::testing_util::chrono_literals;
+
+namespace {
+bigtable::MutationFlowControlOptions TestOptions() {
+  return bigtable::MutationFlowControlOptions()
+      .set_max_outstanding_mutations(100)
+      .set_max_outstanding_bytes(1000);
+}
+}  // anonymous namespace
+
+/// @test Verify the default options disable rate limiting.
+TEST(MutationFlowControlOptionsTest, Defaults) {
+  bigtable::MutationFlowControlOptions options;
+  EXPECT_LT(0U, options.max_outstanding_mutations());
+  EXPECT_LT(0U, options.max_outstanding_bytes());
+  EXPECT_EQ(0.0, options.max_requests_per_second());
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify the options reject invalid values.
+TEST(MutationFlowControlOptionsTest, InvalidValues) {
+  bigtable::MutationFlowControlOptions options;
+  EXPECT_THROW(options.set_max_outstanding_mutations(0), std::range_error);
+  EXPECT_THROW(options.set_max_outstanding_bytes(0), std::range_error);
+  EXPECT_THROW(options.set_max_requests_per_second(-1.0), std::range_error);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+/// @test Verify that reservations are limited by the mutation count.
+TEST(MutationFlowControllerTest, LimitMutations) {
+  bigtable::MutationFlowController tested(TestOptions());
+  EXPECT_TRUE(tested.TryAcquire(60, 10));
+  EXPECT_FALSE(tested.TryAcquire(60, 10));
+  EXPECT_TRUE(tested.TryAcquire(40, 10));
+  EXPECT_EQ(100U, tested.outstanding_mutations());
+  EXPECT_EQ(20U, tested.outstanding_bytes());
+
+  tested.Release(60, 10);
+  EXPECT_TRUE(tested.TryAcquire(60, 10));
+}
+
+/// @test Verify that reservations are limited by the number of bytes.
+TEST(MutationFlowControllerTest, LimitBytes) {
+  bigtable::MutationFlowController tested(TestOptions());
+  EXPECT_TRUE(tested.TryAcquire(1, 600));
+  EXPECT_FALSE(tested.TryAcquire(1, 600));
+  tested.Release(1, 600);
+  EXPECT_TRUE(tested.TryAcquire(1, 600));
+}
+
+/// @test Verify that a large reservation is admitted if nothing is pending.
+TEST(MutationFlowControllerTest, AdmitLargeRequestWhenIdle) {
+  bigtable::MutationFlowController tested(TestOptions());
+  EXPECT_TRUE(tested.TryAcquire(1000, 100000));
+  EXPECT_FALSE(tested.TryAcquire(1, 1));
+  tested.Release(1000, 100000);
+  EXPECT_EQ(0U, tested.outstanding_mutations());
+  EXPECT_EQ(0U, tested.outstanding_bytes());
+}
+
+/// @test Verify that Acquire() blocks until capacity is released.
+TEST(MutationFlowControllerTest, AcquireBlocks) {
+  bigtable::MutationFlowController tested(TestOptions());
+  tested.Acquire(100, 10);
+
+  std::thread waiter([&tested] { tested.Acquire(50, 10); });
+  std::this_thread::sleep_for(10_ms);
+  EXPECT_EQ(100U, tested.outstanding_mutations());
+  tested.Release(100, 10);
+  waiter.join();
+  EXPECT_EQ(50U, tested.outstanding_mutations());
+}
+
+/// @test Verify that pushback reduces the limits and success restores them.
+TEST(MutationFlowControllerTest, Pushback) {
+  bigtable::MutationFlowController tested(TestOptions());
+  tested.OnPushback();
+  EXPECT_EQ(50U, tested.mutations_limit());
+  EXPECT_EQ(500U, tested.bytes_limit());
+  tested.OnPushback();
+  EXPECT_EQ(25U, tested.mutations_limit());
+  EXPECT_EQ(250U, tested.bytes_limit());
+
+  tested.OnSuccess();
+  EXPECT_EQ(35U, tested.mutations_limit());
+  EXPECT_EQ(350U, tested.bytes_limit());
+  for (int i = 0; i != 20; ++i) {
+    tested.OnSuccess();
+  }
+  EXPECT_EQ(100U, tested.mutations_limit());
+  EXPECT_EQ(1000U, tested.bytes_limit());
+}
+
+/// @test Verify that the limits never drop to zero.
+TEST(MutationFlowControllerTest, PushbackFloor) {
+  bigtable::MutationFlowController tested(TestOptions());
+  for (int i = 0; i != 64; ++i) {
+    tested.OnPushback();
+  }
+  EXPECT_EQ(1U, tested.mutations_limit());
+  EXPECT_EQ(1U, tested.bytes_limit());
+}
+
+/// @test Verify which status codes are treated as pushback.
+TEST(MutationFlowControllerTest, IsPushback) {
+  using bigtable::MutationFlowController;
+  EXPECT_TRUE(MutationFlowController::IsPushback(
+      grpc::Status(grpc::StatusCode::UNAVAILABLE, "try again")));
+  EXPECT_TRUE(MutationFlowController::IsPushback(
+      grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "slow down")));
+  EXPECT_FALSE(MutationFlowController::IsPushback(grpc::Status::OK));
+  EXPECT_FALSE(MutationFlowController::IsPushback(
+      grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh oh")));
+}
+
+/// @test Verify that the token bucket limits the request rate.
+TEST(MutationFlowControllerTest, RateLimit) {
+  bigtable::MutationFlowController tested(
+      TestOptions().set_max_requests_per_second(100.0));
+  // The bucket starts full, with one second worth of tokens.
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i != 100; ++i) {
+    tested.WaitForRequestSlot();
+  }
+  // Once the bucket is empty each request must wait ~10ms.
+  for (int i = 0; i != 5; ++i) {
+    tested.WaitForRequestSlot();
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_LE(40_ms, elapsed);
+}
@@ -106,12 +106,31 @@ RowReader::RowReader(
       parser_factory_(std::move(parser_factory)),
       stream_is_open_(false),
       operation_cancelled_(false),
+      arena_(google::cloud::internal::make_unique<google::protobuf::Arena>()),
+      response_(nullptr),
       processed_chunks_count_(0),
       rows_count_(0),
       status_(grpc::Status::OK),
       raise_on_error_(raise_on_error),
       error_retrieved_(raise_on_error) {}
 
+RowReader::RowReader(
+    std::shared_ptr<DataClient> client, bigtable::AppProfileId app_profile_id,
+    bigtable::TableId table_name, ScanCheckpoint const& checkpoint,
+    std::unique_ptr<RPCRetryPolicy> retry_policy,
+    std::unique_ptr<RPCBackoffPolicy> backoff_policy,
+    MetadataUpdatePolicy metadata_update_policy,
+    std::unique_ptr<internal::ReadRowsParserFactory> parser_factory,
+    bool raise_on_error)
+    : RowReader(std::move(client), std::move(app_profile_id),
+                std::move(table_name), checkpoint.row_set(),
+                checkpoint.rows_limit(), checkpoint.filter(),
+                std::move(retry_policy), std::move(backoff_policy),
+                std::move(metadata_update_policy), std::move(parser_factory),
+                raise_on_error) {
+  rows_count_ = checkpoint.rows_count();
+}
+
 // The name must be all lowercase to work with range-for loops.
 // NOLINTNEXTLINE(readability-identifier-naming)
 RowReader::iterator RowReader::begin() {
@@ -138,7 +157,7 @@ RowReader::iterator RowReader::end() {
 }
 
 void RowReader::MakeRequest() {
-  response_ = {};
+  ResetResponse();
   processed_chunks_count_ = 0;
 
   google::bigtable::v2::ReadRowsRequest request;
@@ -168,17 +187,26 @@ void RowReader::MakeRequest() {
 
 bool RowReader::NextChunk() {
   ++processed_chunks_count_;
-  while (processed_chunks_count_ >= response_.chunks_size()) {
+  while (processed_chunks_count_ >= response_->chunks_size()) {
     processed_chunks_count_ = 0;
-    bool response_is_valid = stream_->Read(&response_);
+    // All the chunks in the previous response have been moved into the
+    // parser, release its memory before reading the next one.
+    ResetResponse();
+    bool response_is_valid = stream_->Read(response_);
     if (not response_is_valid) {
-      response_ = {};
+      ResetResponse();
       return false;
     }
   }
   return true;
 }
 
+void RowReader::ResetResponse() {
+  arena_->Reset();
+  response_ = google::protobuf::Arena::CreateMessage<
+      google::bigtable::v2::ReadRowsResponse>(arena_.get());
+}
+
 void RowReader::Advance(internal::OptionalRow& row) {
   while (true) {
     grpc::Status status;
@@ -229,7 +257,7 @@ grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
   while (not parser_->HasNext()) {
     if (NextChunk()) {
       parser_->HandleChunk(
-          std::move(*(response_.mutable_chunks(processed_chunks_count_))),
+          std::move(*(response_->mutable_chunks(processed_chunks_count_))),
           status);
       if (not status.ok()) {
         return status;
@@ -261,6 +289,24 @@ grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
   return status;
 }
 
+ScanCheckpoint RowReader::Checkpoint() const {
+  bool limit_reached =
+      rows_limit_ != NO_ROWS_LIMIT and rows_limit_ <= rows_count_;
+  // The stream was closed without errors, and not because it was cancelled.
+  bool scan_completed = stream_ and not stream_is_open_ and
+                        not operation_cancelled_ and status_.ok();
+  if (limit_reached or scan_completed) {
+    return ScanCheckpoint(RowSet(RowRange::Empty()), rows_limit_, rows_count_,
+                          filter_);
+  }
+  if (last_read_row_key_.empty()) {
+    return ScanCheckpoint(row_set_, rows_limit_, rows_count_, filter_);
+  }
+  return ScanCheckpoint(
+      row_set_.Intersect(RowRange::Open(last_read_row_key_, "")), rows_limit_,
+      rows_count_, filter_);
+}
+
 void RowReader::Cancel() {
   operation_cancelled_ = true;
   if (not stream_is_open_) {
@@ -25,8 +25,10 @@
 #include "google/cloud/bigtable/row_set.h"
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
+#include "google/cloud/bigtable/scan_checkpoint.h"
 #include "google/cloud/bigtable/table_strong_types.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <google/protobuf/arena.h>
 #include <grpcpp/grpcpp.h>
 #include <cinttypes>
 #include <iterator>
@@ -82,6 +84,16 @@ class RowReader {
             std::unique_ptr<internal::ReadRowsParserFactory> parser_factory,
             bool raise_on_error);
 
+  /// Resume a scan from the state saved in @p checkpoint.
+  RowReader(std::shared_ptr<DataClient> client,
+            bigtable::AppProfileId app_profile_id, bigtable::TableId table_name,
+            ScanCheckpoint const& checkpoint,
+            std::unique_ptr<RPCRetryPolicy> retry_policy,
+            std::unique_ptr<RPCBackoffPolicy> backoff_policy,
+            MetadataUpdatePolicy metadata_update_policy,
+            std::unique_ptr<internal::ReadRowsParserFactory> parser_factory,
+            bool raise_on_error);
+
   RowReader(RowReader&& rhs) noexcept = default;
 
   ~RowReader();
@@ -121,6 +133,17 @@ class RowReader {
     return status_;
   }
 
+  /**
+   * Capture the state needed to resume the scan after the last returned row.
+   *
+   * The checkpoint can be obtained at any time, including after the scan
+   * failed or was cancelled.  Rows that were received but not yet returned by
+   * the iterator are not considered read, they are included in the
+   * checkpoint.  If the scan completed successfully, or reached its row
+   * limit, the checkpoint is complete, i.e., `IsComplete()` returns true.
+   */
+  ScanCheckpoint Checkpoint() const;
+
  private:
   /**
    * Read and parse the next row in the response.
@@ -143,7 +166,7 @@ class RowReader {
    *
    * This call is used internally by AdvanceOrFail to prepare data for
    * parsing. When it returns true, the value of
-   * `response_.chunks(processed_chunks_count_)` is valid and holds
+   * `response_->chunks(processed_chunks_count_)` is valid and holds
    * the next chunk to parse.
    */
   bool NextChunk();
@@ -151,6 +174,9 @@ class RowReader {
   /// Sends the ReadRows request to the stub.
   void MakeRequest();
 
+  /// Releases the previous response and allocates a new one in `arena_`.
+  void ResetResponse();
+
   std::shared_ptr<DataClient> client_;
   bigtable::AppProfileId app_profile_id_;
   bigtable::TableId table_name_;
@@ -171,8 +197,17 @@ class RowReader {
   bool stream_is_open_;
   bool operation_cancelled_;
 
+  /**
+   * Owns the memory for `response_`.
+   *
+   * The responses are allocated in an arena, which is reset (but its blocks
+   * are kept) after each response is fully parsed.  Once the arena is warmed
+   * up, parsing a response does not need any further heap allocations for the
+   * protos themselves.
+   */
+  std::unique_ptr<google::protobuf::Arena> arena_;
   /// The last received response, chunks are being parsed one by one from it.
-  google::bigtable::v2::ReadRowsResponse response_;
+  google::bigtable::v2::ReadRowsResponse* response_;
   /// Number of chunks already parsed in response_.
   int processed_chunks_count_;
 
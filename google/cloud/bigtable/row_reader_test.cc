@@ -45,7 +45,7 @@ class ReadRowsParserMock : public bigtable::internal::ReadRowsParser {
  public:
   MOCK_METHOD2(HandleChunkHook,
                void(ReadRowsResponse_CellChunk chunk, grpc::Status& status));
-  void HandleChunk(ReadRowsResponse_CellChunk chunk,
+  void HandleChunk(ReadRowsResponse_CellChunk&& chunk,
                    grpc::Status& status) override {
     HandleChunkHook(chunk, status);
   }
@@ -426,6 +426,82 @@ TEST_F(RowReaderTest, FailedStreamRetriesSkipAlreadyReadRows) {
   EXPECT_EQ(++it, reader.end());
 }
 
+TEST_F(RowReaderTest, CheckpointAfterCompleteScan) {
+  auto* stream = new MockReadRowsReader;  // wrapped in unique_ptr by ReadRows
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(stream->MakeMockReturner()));
+  EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*stream, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  bigtable::RowReader reader(
+      client_, bigtable::TableId(""), bigtable::RowSet("r1", "r2"),
+      bigtable::RowReader::NO_ROWS_LIMIT, bigtable::Filter::PassAllFilter(),
+      std::move(retry_policy_), std::move(backoff_policy_),
+      metadata_update_policy_, std::move(parser_factory_));
+
+  EXPECT_FALSE(reader.Checkpoint().IsComplete());
+  EXPECT_EQ(reader.begin(), reader.end());
+  EXPECT_TRUE(reader.Checkpoint().IsComplete());
+}
+
+TEST_F(RowReaderTest, CheckpointResumesAfterLastRow) {
+  auto* stream = new MockReadRowsReader;  // wrapped in unique_ptr by ReadRows
+  auto parser = google::cloud::internal::make_unique<ReadRowsParserMock>();
+  parser->SetRows({"r1"});
+  {
+    testing::InSequence s;
+    EXPECT_CALL(*client_, ReadRows(_, RequestWithRowKeysCount(3)))
+        .WillOnce(Invoke(stream->MakeMockReturner()));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(true));
+    EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream, Finish())
+        .WillOnce(Return(grpc::Status(grpc::StatusCode::INTERNAL, "fail")));
+    EXPECT_CALL(*retry_policy_, OnFailureHook(_)).WillOnce(Return(false));
+  }
+
+  parser_factory_->AddParser(std::move(parser));
+  bigtable::ScanCheckpoint checkpoint = [this] {
+    bigtable::RowReader reader(
+        client_, bigtable::TableId(""), bigtable::RowSet("r1", "r2", "r3"), 10,
+        bigtable::Filter::PassAllFilter(), std::move(retry_policy_),
+        std::move(backoff_policy_), metadata_update_policy_,
+        std::move(parser_factory_), false);
+    auto it = reader.begin();
+    EXPECT_NE(it, reader.end());
+    EXPECT_EQ(it->row_key(), "r1");
+    EXPECT_EQ(++it, reader.end());
+    EXPECT_FALSE(reader.Finish().ok());
+    return reader.Checkpoint();
+  }();
+  EXPECT_FALSE(checkpoint.IsComplete());
+  EXPECT_EQ(1, checkpoint.rows_count());
+  EXPECT_EQ(10, checkpoint.rows_limit());
+
+  // Resume the scan, possibly in a different process.
+  auto restored = bigtable::ScanCheckpoint::Deserialize(checkpoint.Serialize());
+  auto* stream_resume = new MockReadRowsReader;  // the stub will free it
+  {
+    testing::InSequence s;
+    // Only the rows not returned by the first reader are requested, and the
+    // limit accounts for the rows already returned.
+    EXPECT_CALL(*client_,
+                ReadRows(_, testing::AllOf(RequestWithRowKeysCount(2),
+                                           RequestWithRowsLimit(9))))
+        .WillOnce(Invoke(stream_resume->MakeMockReturner()));
+    EXPECT_CALL(*stream_resume, Read(_)).WillOnce(Return(false));
+    EXPECT_CALL(*stream_resume, Finish()).WillOnce(Return(grpc::Status::OK));
+  }
+  bigtable::RowReader resumed(
+      client_, bigtable::AppProfileId(""), bigtable::TableId(""), restored,
+      google::cloud::internal::make_unique<RetryPolicyMock>(),
+      google::cloud::internal::make_unique<BackoffPolicyMock>(),
+      metadata_update_policy_,
+      google::cloud::internal::make_unique<ReadRowsParserMockFactory>(), true);
+  EXPECT_EQ(resumed.begin(), resumed.end());
+  EXPECT_TRUE(resumed.Checkpoint().IsComplete());
+  EXPECT_EQ(1, resumed.Checkpoint().rows_count());
+}
+
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 
 using testing::Throw;
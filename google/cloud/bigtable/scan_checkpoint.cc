@@ -0,0 +1,118 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/scan_checkpoint.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <google/bigtable/v2/bigtable.pb.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+
+namespace {
+using google::protobuf::internal::WireFormatLite;
+
+// The checkpoint is encoded as if it was the following proto message:
+//   message ScanCheckpoint {
+//     google.bigtable.v2.ReadRowsRequest request = 1;
+//     int64 rows_count = 2;
+//   }
+// where `request` only contains the rows, filter, and rows_limit fields.
+int const REQUEST_FIELD = 1;
+int const ROWS_COUNT_FIELD = 2;
+}  // anonymous namespace
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+ScanCheckpoint::ScanCheckpoint(RowSet row_set, std::int64_t rows_limit,
+                               std::int64_t rows_count, Filter filter)
+    : row_set_(std::move(row_set)),
+      rows_limit_(rows_limit),
+      rows_count_(rows_count),
+      filter_(std::move(filter)) {}
+
+std::string ScanCheckpoint::Serialize() const {
+  google::bigtable::v2::ReadRowsRequest request;
+  *request.mutable_rows() = row_set_.as_proto();
+  *request.mutable_filter() = filter_.as_proto();
+  request.set_rows_limit(rows_limit_);
+
+  std::string result;
+  {
+    google::protobuf::io::StringOutputStream raw(&result);
+    google::protobuf::io::CodedOutputStream output(&raw);
+    WireFormatLite::WriteBytes(REQUEST_FIELD, request.SerializeAsString(),
+                               &output);
+    WireFormatLite::WriteInt64(ROWS_COUNT_FIELD, rows_count_, &output);
+  }
+  return result;
+}
+
+ScanCheckpoint ScanCheckpoint::Deserialize(std::string const& data) {
+  google::protobuf::io::CodedInputStream input(
+      reinterpret_cast<std::uint8_t const*>(data.data()),
+      static_cast<int>(data.size()));
+  auto const request_tag = WireFormatLite::MakeTag(
+      REQUEST_FIELD, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  auto const rows_count_tag = WireFormatLite::MakeTag(
+      ROWS_COUNT_FIELD, WireFormatLite::WIRETYPE_VARINT);
+
+  google::bigtable::v2::ReadRowsRequest request;
+  google::protobuf::int64 rows_count = 0;
+  bool has_request = false;
+  for (auto tag = input.ReadTag(); tag != 0; tag = input.ReadTag()) {
+    bool valid;
+    if (tag == request_tag) {
+      std::string buffer;
+      valid = WireFormatLite::ReadBytes(&input, &buffer) and
+              request.ParseFromString(buffer);
+      has_request = true;
+    } else if (tag == rows_count_tag) {
+      valid = WireFormatLite::ReadPrimitive<google::protobuf::int64,
+                                            WireFormatLite::TYPE_INT64>(
+          &input, &rows_count);
+    } else {
+      // Ignore unknown fields, they may be added by future versions.
+      valid = WireFormatLite::SkipField(&input, tag);
+    }
+    if (not valid) {
+      google::cloud::internal::RaiseInvalidArgument(
+          "ScanCheckpoint::Deserialize - cannot parse checkpoint");
+    }
+  }
+  if (not input.ConsumedEntireMessage() or not has_request) {
+    google::cloud::internal::RaiseInvalidArgument(
+        "ScanCheckpoint::Deserialize - incomplete checkpoint");
+  }
+  if (rows_count < 0 or request.rows_limit() < 0) {
+    google::cloud::internal::RaiseInvalidArgument(
+        "ScanCheckpoint::Deserialize - negative rows_count or rows_limit");
+  }
+
+  RowSet row_set;
+  for (auto& key : *request.mutable_rows()->mutable_row_keys()) {
+    row_set.Append(std::move(key));
+  }
+  for (auto& range : *request.mutable_rows()->mutable_row_ranges()) {
+    row_set.Append(RowRange(std::move(range)));
+  }
+  return ScanCheckpoint(std::move(row_set), request.rows_limit(), rows_count,
+                        Filter(std::move(*request.mutable_filter())));
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
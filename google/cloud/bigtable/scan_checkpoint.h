@@ -0,0 +1,104 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SCAN_CHECKPOINT_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SCAN_CHECKPOINT_H_
+
+#include "google/cloud/bigtable/filters.h"
+#include "google/cloud/bigtable/row_set.h"
+#include <cinttypes>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * The state needed to resume a partially completed `Table::ReadRows()` scan.
+ *
+ * A checkpoint is obtained from `RowReader::Checkpoint()`, it contains the
+ * rows that have not been returned yet, the filter, the original row limit,
+ * and the number of rows already returned.  Applications can serialize the
+ * checkpoint, store it, and later resume the scan with
+ * `Table::ReadRows(ScanCheckpoint)`, possibly in a different process.
+ *
+ * Because `row_set()` is a regular `bigtable::RowSet`, a checkpoint can also be
+ * split into smaller scans using `RowSet::Intersect()`, for example to hand
+ * off part of the remaining work to another worker.
+ *
+ * @par Example
+ * @code
+ * auto reader = table.ReadRows(bigtable::RowSet(range), filter);
+ * for (auto& row : reader) {
+ *   Process(row);
+ *   if (TimeToSave()) {
+ *     Save(reader.Checkpoint().Serialize());
+ *   }
+ * }
+ * // ... later, possibly in a different process ...
+ * auto checkpoint = bigtable::ScanCheckpoint::Deserialize(Load());
+ * for (auto& row : table.ReadRows(std::move(checkpoint))) {
+ *   Process(row);
+ * }
+ * @endcode
+ */
+class ScanCheckpoint {
+ public:
+  ScanCheckpoint(RowSet row_set, std::int64_t rows_limit,
+                 std::int64_t rows_count, Filter filter);
+
+  /// The rows that remain to be read.
+  RowSet const& row_set() const { return row_set_; }
+
+  /// The limit for the whole scan, `RowReader::NO_ROWS_LIMIT` if none.
+  std::int64_t rows_limit() const { return rows_limit_; }
+
+  /// The number of rows returned before the checkpoint was created.
+  std::int64_t rows_count() const { return rows_count_; }
+
+  /// The filter applied to the rows in the scan.
+  Filter const& filter() const { return filter_; }
+
+  /// Return true if there are no more rows to read.
+  bool IsComplete() const { return row_set_.IsEmpty(); }
+
+  /**
+   * Serialize the checkpoint into a string.
+   *
+   * The format is a binary protobuf encoding, it is stable across versions of
+   * the library and it does not include the table name, the application is
+   * responsible for resuming the scan on the same table.
+   */
+  std::string Serialize() const;
+
+  /**
+   * Create a checkpoint from the output of `Serialize()`.
+   *
+   * @throws std::invalid_argument if @p data is not a valid checkpoint.
+   */
+  static ScanCheckpoint Deserialize(std::string const& data);
+
+ private:
+  RowSet row_set_;
+  std::int64_t rows_limit_;
+  std::int64_t rows_count_;
+  Filter filter_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_SCAN_CHECKPOINT_H_
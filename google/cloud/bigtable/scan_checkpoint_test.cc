@@ -0,0 +1,77 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/scan_checkpoint.h"
+#include <google/protobuf/util/message_differencer.h>
+#include <gtest/gtest.h>
+
+namespace bigtable = google::cloud::bigtable;
+using google::protobuf::util::MessageDifferencer;
+
+/// @test Verify that a checkpoint survives a round-trip through a string.
+TEST(ScanCheckpointTest, SerializeRoundTrip) {
+  bigtable::ScanCheckpoint original(
+      bigtable::RowSet("k1", bigtable::RowRange::Range("a", "c"), "k2"), 1000,
+      42,
+      bigtable::Filter::Chain(bigtable::Filter::FamilyRegex("fam"),
+                              bigtable::Filter::Latest(1)));
+
+  auto actual = bigtable::ScanCheckpoint::Deserialize(original.Serialize());
+  EXPECT_EQ(1000, actual.rows_limit());
+  EXPECT_EQ(42, actual.rows_count());
+  EXPECT_TRUE(MessageDifferencer::Equals(original.row_set().as_proto(),
+                                         actual.row_set().as_proto()));
+  EXPECT_TRUE(MessageDifferencer::Equals(original.filter().as_proto(),
+                                         actual.filter().as_proto()));
+  EXPECT_FALSE(actual.IsComplete());
+}
+
+/// @test Verify that a complete checkpoint remains complete.
+TEST(ScanCheckpointTest, SerializeComplete) {
+  bigtable::ScanCheckpoint original(
+      bigtable::RowSet(bigtable::RowRange::Empty()), 0, 7,
+      bigtable::Filter::PassAllFilter());
+  EXPECT_TRUE(original.IsComplete());
+
+  auto actual = bigtable::ScanCheckpoint::Deserialize(original.Serialize());
+  EXPECT_TRUE(actual.IsComplete());
+  EXPECT_EQ(7, actual.rows_count());
+}
+
+/// @test Verify that "all rows" is not confused with "no rows".
+TEST(ScanCheckpointTest, SerializeAllRows) {
+  bigtable::ScanCheckpoint original(bigtable::RowSet(), 0, 0,
+                                    bigtable::Filter::PassAllFilter());
+  auto actual = bigtable::ScanCheckpoint::Deserialize(original.Serialize());
+  EXPECT_FALSE(actual.IsComplete());
+  EXPECT_EQ(0, actual.row_set().as_proto().row_keys_size());
+  EXPECT_EQ(0, actual.row_set().as_proto().row_ranges_size());
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that invalid data is rejected.
+TEST(ScanCheckpointTest, DeserializeInvalid) {
+  EXPECT_THROW(bigtable::ScanCheckpoint::Deserialize(""),
+               std::invalid_argument);
+  EXPECT_THROW(bigtable::ScanCheckpoint::Deserialize("not a checkpoint"),
+               std::invalid_argument);
+
+  bigtable::ScanCheckpoint original(bigtable::RowSet("k1"), 0, 0,
+                                    bigtable::Filter::PassAllFilter());
+  auto data = original.Serialize();
+  EXPECT_THROW(
+      bigtable::ScanCheckpoint::Deserialize(data.substr(0, data.size() - 3)),
+      std::invalid_argument);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
@@ -75,6 +75,10 @@ RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
                         true);
 }
 
+RowReader Table::ReadRows(ScanCheckpoint checkpoint) {
+  return impl_.ReadRows(std::move(checkpoint), true);
+}
+
 std::pair<bool, Row> Table::ReadRow(std::string row_key, Filter filter) {
   grpc::Status status;
   auto result = impl_.ReadRow(std::move(row_key), std::move(filter), status);
@@ -109,10 +109,14 @@ class Table {
    *       allowed. Use `LimitedTimeRetryPolicy` to bound the time for any
    *       request. You can also create your own policies that combine time and
    *       error counts.
+   *     - `std::shared_ptr<MutationFlowController>` to limit the mutations,
+   *       bytes, and RPCs in flight for `Apply()` and `BulkApply()`. The
+   *       controller is shared, not copied, so multiple tables (and threads)
+   *       can use the same limits.
    *
    * @see SafeIdempotentMutationPolicy, AlwaysRetryMutationPolicy,
    *     ExponentialBackoffPolicy, LimitedErrorCountRetryPolicy,
-   *     LimitedTimeRetryPolicy.
+   *     LimitedTimeRetryPolicy, MutationFlowController.
    */
   template <typename... Policies>
   Table(std::shared_ptr<DataClient> client, std::string const& table_id,
@@ -163,10 +167,14 @@ class Table {
    *       allowed. Use `LimitedTimeRetryPolicy` to bound the time for any
    *       request. You can also create your own policies that combine time and
    *       error counts.
+   *     - `std::shared_ptr<MutationFlowController>` to limit the mutations,
+   *       bytes, and RPCs in flight for `Apply()` and `BulkApply()`. The
+   *       controller is shared, not copied, so multiple tables (and threads)
+   *       can use the same limits.
    *
    * @see SafeIdempotentMutationPolicy, AlwaysRetryMutationPolicy,
    *     ExponentialBackoffPolicy, LimitedErrorCountRetryPolicy,
-   *     LimitedTimeRetryPolicy.
+   *     LimitedTimeRetryPolicy, MutationFlowController.
    */
   template <typename... Policies>
   Table(std::shared_ptr<DataClient> client,
@@ -244,6 +252,24 @@ class Table {
    */
   RowReader ReadRows(RowSet row_set, std::int64_t rows_limit, Filter filter);
 
+  /**
+   * Resumes a scan from a checkpoint.
+   *
+   * @param checkpoint the state of a previous scan, as returned by
+   *     `RowReader::Checkpoint()`, possibly after serializing and deserializing
+   *     it.  The scan continues after the last row returned by the previous
+   *     reader, with the same filter, and the remainder of its row limit.
+   *
+   * @par Example
+   * @code
+   * auto checkpoint = bigtable::ScanCheckpoint::Deserialize(saved);
+   * for (auto& row : table.ReadRows(std::move(checkpoint))) {
+   *   // ... process the remaining rows ...
+   * }
+   * @endcode
+   */
+  RowReader ReadRows(ScanCheckpoint checkpoint);
+
   /**
    * Read and return a single row from the table.
    *
@@ -102,6 +102,58 @@ TEST_F(TableBulkApplyTest, RetryPartialFailure) {
   SUCCEED();
 }
 
+/// @test Verify that Table::BulkApply() reports pushback to flow control.
+TEST_F(TableBulkApplyTest, FlowControlPushback) {
+  auto flow_control = std::make_shared<bt::MutationFlowController>(
+      bt::MutationFlowControlOptions()
+          .set_max_outstanding_mutations(100)
+          .set_max_outstanding_bytes(100000));
+  bt::Table custom_table(client_, "foo_table", flow_control,
+                         // Use much shorter backoff than the default to test
+                         // faster.
+                         bt::ExponentialBackoffPolicy(10_us, 40_us));
+
+  auto r1 = google::cloud::internal::make_unique<MockMutateRowsReader>();
+  EXPECT_CALL(*r1, Read(_))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse* r) {
+        // Simulate a partial (recoverable) failure.
+        auto& e0 = *r->add_entries();
+        e0.set_index(0);
+        e0.mutable_status()->set_code(grpc::StatusCode::UNAVAILABLE);
+        auto& e1 = *r->add_entries();
+        e1.set_index(1);
+        e1.mutable_status()->set_code(grpc::StatusCode::OK);
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*r1, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  auto r2 = google::cloud::internal::make_unique<MockMutateRowsReader>();
+  EXPECT_CALL(*r2, Read(_))
+      .WillOnce(Invoke([](btproto::MutateRowsResponse* r) {
+        auto& e = *r->add_entries();
+        e.set_index(0);
+        e.mutable_status()->set_code(grpc::StatusCode::OK);
+        return true;
+      }))
+      .WillOnce(Return(false));
+  EXPECT_CALL(*r2, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  EXPECT_CALL(*client_, MutateRows(_, _))
+      .WillOnce(Invoke(r1.release()->MakeMockReturner()))
+      .WillOnce(Invoke(r2.release()->MakeMockReturner()));
+
+  custom_table.BulkApply(bt::BulkMutation(
+      bt::SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+      bt::SingleRowMutation("bar", {bt::SetCell("fam", "col", 0_ms, "qux")})));
+
+  // The first request was pushed back (halving the limit), the second one
+  // succeeded (growing the limit by 10% of the maximum).
+  EXPECT_EQ(60U, flow_control->mutations_limit());
+  EXPECT_EQ(0U, flow_control->outstanding_mutations());
+  EXPECT_EQ(0U, flow_control->outstanding_bytes());
+}
+
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 /// @test Verify that Table::BulkApply() handles permanent failures.
 TEST_F(TableBulkApplyTest, PermanentFailure) {
@@ -13,6 +13,7 @@ google_cloud_cpp_common_HDRS = [
     "internal/setenv.h",
     "internal/throw_delegate.h",
     "log.h",
+    "rpc_metrics.h",
     "version.h",
 ]
 
@@ -23,4 +24,5 @@ google_cloud_cpp_common_SRCS = [
     "internal/setenv.cc",
     "internal/throw_delegate.cc",
     "log.cc",
+    "rpc_metrics.cc",
 ]
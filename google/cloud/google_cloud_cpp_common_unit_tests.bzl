@@ -7,4 +7,5 @@ google_cloud_cpp_common_unit_tests = [
     "internal/retry_policy_test.cc",
     "internal/throw_delegate_test.cc",
     "log_test.cc",
+    "rpc_metrics_test.cc",
 ]
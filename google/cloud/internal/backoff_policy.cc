@@ -25,11 +25,14 @@ std::unique_ptr<BackoffPolicy> ExponentialBackoffPolicy::clone() const {
 
 std::chrono::milliseconds ExponentialBackoffPolicy::OnCompletion() {
   using namespace std::chrono;
+  if (not generator_) {
+    generator_.reset(new DefaultPRNG(MakeDefaultPRNG()));
+  }
   std::uniform_int_distribution<long> rng_distribution(
       current_delay_range_.count() / 2, current_delay_range_.count());
   // Randomized sleep period because it is possible that after some time all
   // client have same sleep period if we use only exponential backoff policy.
-  auto delay = microseconds(rng_distribution(generator_));
+  auto delay = microseconds(rng_distribution(*generator_));
   current_delay_range_ = microseconds(
       static_cast<microseconds::rep>(current_delay_range_.count() * scaling_));
   if (current_delay_range_ >= maximum_delay_) {
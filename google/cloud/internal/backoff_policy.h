@@ -129,14 +129,36 @@ class ExponentialBackoffPolicy : public BackoffPolicy {
                 2 * initial_delay)),
         maximum_delay_(std::chrono::duration_cast<std::chrono::microseconds>(
             maximum_delay)),
-        scaling_(scaling),
-        generator_(google::cloud::internal::MakeDefaultPRNG()) {
+        scaling_(scaling) {
     if (scaling_ <= 1.0) {
       google::cloud::internal::RaiseInvalidArgument(
           "scaling factor must be > 1.0");
     }
   }
 
+  /**
+   * Copy the policy parameters and current delay, but not the PRNG.
+   *
+   * The client libraries clone the policy for every operation, and most
+   * operations never fail. The PRNG is only created (and seeded) on the first
+   * call to `OnCompletion()`, so copies are cheap, and each copy uses an
+   * independent sequence for the randomized delays.
+   */
+  ExponentialBackoffPolicy(ExponentialBackoffPolicy const& rhs)
+      : current_delay_range_(rhs.current_delay_range_),
+        maximum_delay_(rhs.maximum_delay_),
+        scaling_(rhs.scaling_) {}
+  ExponentialBackoffPolicy& operator=(ExponentialBackoffPolicy const& rhs) {
+    current_delay_range_ = rhs.current_delay_range_;
+    maximum_delay_ = rhs.maximum_delay_;
+    scaling_ = rhs.scaling_;
+    generator_.reset();
+    return *this;
+  }
+  ExponentialBackoffPolicy(ExponentialBackoffPolicy&& rhs) noexcept = default;
+  ExponentialBackoffPolicy& operator=(ExponentialBackoffPolicy&& rhs) noexcept =
+      default;
+
   std::unique_ptr<BackoffPolicy> clone() const override;
   std::chrono::milliseconds OnCompletion() override;
 
@@ -144,7 +166,7 @@ class ExponentialBackoffPolicy : public BackoffPolicy {
   std::chrono::microseconds current_delay_range_;
   std::chrono::microseconds maximum_delay_;
   double scaling_;
-  google::cloud::internal::DefaultPRNG generator_;
+  std::unique_ptr<google::cloud::internal::DefaultPRNG> generator_;
 };
 
 }  // namespace internal
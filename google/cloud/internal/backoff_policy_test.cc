@@ -107,3 +107,40 @@ TEST(ExponentialBackoffPolicy, Randomness) {
   }
   EXPECT_NE(output1, output2);
 }
+
+/// @test Verify that clones of the same prototype do not share the PRNG.
+TEST(ExponentialBackoffPolicy, ClonesAreIndependent) {
+  ExponentialBackoffPolicy original(ms(10), ms(1500), 2.0);
+  // Advance the prototype, a clone should copy the delay, but not the PRNG.
+  original.OnCompletion();
+  auto tested1 = original.clone();
+  auto tested2 = original.clone();
+
+  auto delay = tested1->OnCompletion();
+  EXPECT_LE(ms(20), delay);
+  EXPECT_GE(ms(40), delay);
+  tested2->OnCompletion();
+
+  std::vector<int> output1, output2;
+  for (int i = 0; i != 100; ++i) {
+    output1.push_back(tested1->OnCompletion().count());
+    output2.push_back(tested2->OnCompletion().count());
+  }
+  EXPECT_NE(output1, output2);
+}
+
+/// @test Verify that the policy can be copy-assigned.
+TEST(ExponentialBackoffPolicy, CopyAssign) {
+  ExponentialBackoffPolicy original(ms(10), ms(50), 2.0);
+  original.OnCompletion();
+  ExponentialBackoffPolicy tested(ms(100), ms(1500), 2.0);
+  tested.OnCompletion();
+  tested = original;
+
+  auto delay = tested.OnCompletion();
+  EXPECT_LE(ms(20), delay);
+  EXPECT_GE(ms(40), delay);
+  delay = tested.OnCompletion();
+  EXPECT_LE(ms(25), delay);
+  EXPECT_GE(ms(50), delay);
+}
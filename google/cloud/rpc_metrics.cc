@@ -0,0 +1,101 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/rpc_metrics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+namespace {
+std::size_t LatencyBucket(std::chrono::microseconds latency) {
+  auto count = latency.count();
+  std::size_t bucket = 0;
+  while (count > 0 and bucket + 1 < HistogramRpcMetrics::LATENCY_BUCKETS) {
+    count >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+}  // namespace
+
+std::size_t constexpr HistogramRpcMetrics::LATENCY_BUCKETS;
+
+std::chrono::microseconds RpcMetricsSummary::LatencyPercentile(
+    double p) const {
+  std::int64_t total = 0;
+  for (auto c : latency_buckets) {
+    total += c;
+  }
+  if (total == 0) {
+    return std::chrono::microseconds(0);
+  }
+  p = std::min(1.0, std::max(0.0, p));
+  auto const rank = std::max<std::int64_t>(
+      1, static_cast<std::int64_t>(std::ceil(p * static_cast<double>(total))));
+  std::int64_t seen = 0;
+  for (std::size_t i = 0; i != latency_buckets.size(); ++i) {
+    seen += latency_buckets[i];
+    if (seen >= rank) {
+      return std::chrono::microseconds(std::int64_t(1) << i);
+    }
+  }
+  return std::chrono::microseconds(std::int64_t(1) << latency_buckets.size());
+}
+
+void HistogramRpcMetrics::OnAttemptComplete(RpcMetricsRecord const& record) {
+  auto const bucket = LatencyBucket(record.latency);
+  std::lock_guard<std::mutex> lk(mu_);
+  auto& summary = Summary(record.rpc);
+  ++summary.attempts;
+  summary.bytes_sent += record.bytes_sent;
+  summary.bytes_received += record.bytes_received;
+  summary.messages_received += record.messages_received;
+  if (not record.ok) {
+    ++summary.failures[record.status_code];
+  }
+  ++summary.latency_buckets[bucket];
+}
+
+std::map<std::string, RpcMetricsSummary> HistogramRpcMetrics::Snapshot()
+    const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return summaries_;
+}
+
+void HistogramRpcMetrics::Reset() {
+  std::lock_guard<std::mutex> lk(mu_);
+  by_rpc_.clear();
+  summaries_.clear();
+}
+
+RpcMetricsSummary& HistogramRpcMetrics::Summary(char const* rpc) {
+  auto loc = by_rpc_.find(rpc);
+  if (loc != by_rpc_.end()) {
+    return *loc->second;
+  }
+  // Different pointers with the same name, e.g. `__func__` in two decorators,
+  // share the summary.
+  auto& summary = summaries_[rpc];
+  if (summary.latency_buckets.empty()) {
+    summary.latency_buckets.resize(LATENCY_BUCKETS);
+  }
+  by_rpc_.emplace(rpc, &summary);
+  return summary;
+}
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,173 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RPC_METRICS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RPC_METRICS_H_
+/**
+ * @file rpc_metrics.h
+ *
+ * Google Cloud Platform C++ Libraries instrumentation surface.
+ *
+ * The libraries can report the latency, outcome, and size of each RPC attempt
+ * to an application-provided `RpcMetrics` object.  The reporting is installed
+ * as a decorator around the low-level client (for example,
+ * `bigtable::MetricsDataClient` or via
+ * `storage::ClientOptions::set_rpc_metrics()`), so it has no cost at all when
+ * it is not configured.
+ *
+ * Because the decorator sits below the retry loops, every attempt is reported.
+ * The number of records for an RPC is the number of attempts, and the status
+ * code of failed attempts is the reason for each retry.
+ *
+ * @par Example: Collect Histograms
+ * @code
+ * auto metrics = std::make_shared<google::cloud::HistogramRpcMetrics>();
+ * // ... configure the client to use `metrics`, run the application ...
+ * for (auto const& kv : metrics->Snapshot()) {
+ *   std::cout << kv.first << " p99="
+ *             << kv.second.LatencyPercentile(0.99).count() << "us\n";
+ * }
+ * @endcode
+ */
+
+#include "google/cloud/version.h"
+#include <chrono>
+#include <cinttypes>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace google {
+namespace cloud {
+inline namespace GOOGLE_CLOUD_CPP_NS {
+/**
+ * The measurements for a single RPC attempt.
+ */
+struct RpcMetricsRecord {
+  /**
+   * The name of the RPC, e.g. "ReadRows" or "ListObjects".
+   *
+   * This must point to a string with static storage duration, such as a string
+   * literal or `__func__`. Implementations may use the pointer itself as a key.
+   */
+  char const* rpc;
+  /// The time elapsed from the start of the call until it completed.
+  std::chrono::microseconds latency;
+  /**
+   * The status code for the attempt.
+   *
+   * This is the `grpc::StatusCode` for gRPC-based libraries, and the HTTP
+   * status code for HTTP-based libraries.
+   */
+  int status_code;
+  /// Whether the attempt was successful.
+  bool ok;
+  /// The number of payload bytes sent, if known.
+  std::int64_t bytes_sent;
+  /// The number of payload bytes received, if known.
+  std::int64_t bytes_received;
+  /**
+   * The number of messages or items received.
+   *
+   * For streaming RPCs this is the length of the stream, for paginated list
+   * RPCs this is the number of items in the page.
+   */
+  std::int64_t messages_received;
+};
+
+/**
+ * The interface to receive measurements from the client libraries.
+ *
+ * Applications implement this interface to forward the measurements to their
+ * monitoring system.  The member functions are called from the thread that
+ * made the RPC, and may be called concurrently from many threads, the
+ * implementation must be thread-safe, and should be fast.
+ */
+class RpcMetrics {
+ public:
+  virtual ~RpcMetrics() = default;
+
+  /// Called once for each completed RPC attempt.
+  virtual void OnAttemptComplete(RpcMetricsRecord const& record) = 0;
+};
+
+/**
+ * Aggregated measurements for one RPC, as returned by `HistogramRpcMetrics`.
+ */
+struct RpcMetricsSummary {
+  std::int64_t attempts = 0;
+  std::int64_t bytes_sent = 0;
+  std::int64_t bytes_received = 0;
+  std::int64_t messages_received = 0;
+  /// The number of failed attempts, indexed by status code.
+  std::map<int, std::int64_t> failures;
+  /**
+   * The latency histogram.
+   *
+   * Bucket `i` counts the attempts with latency in `[2^(i-1), 2^i)`
+   * microseconds, bucket 0 counts the attempts under 1 microsecond, and the
+   * last bucket also counts all the attempts above its lower bound.
+   */
+  std::vector<std::int64_t> latency_buckets;
+
+  /**
+   * Estimate the latency at the given percentile.
+   *
+   * @param p a value in the `[0.0, 1.0]` range.
+   * @return the upper bound of the histogram bucket containing the
+   *     percentile, or zero if there are no measurements.
+   */
+  std::chrono::microseconds LatencyPercentile(double p) const;
+};
+
+/**
+ * An `RpcMetrics` implementation that keeps per-RPC histograms in memory.
+ *
+ * The histograms use power-of-two buckets, recording a measurement only
+ * takes a mutex and increments a few counters. The summary for each RPC is
+ * found using the `RpcMetricsRecord::rpc` pointer, the name is only compared
+ * the first time a pointer is seen.
+ */
+class HistogramRpcMetrics : public RpcMetrics {
+ public:
+  /// The number of latency buckets, the last one starts at ~36 minutes.
+  static std::size_t constexpr LATENCY_BUCKETS = 33;
+
+  HistogramRpcMetrics() = default;
+
+  void OnAttemptComplete(RpcMetricsRecord const& record) override;
+
+  /// Return a copy of the current measurements, indexed by RPC name.
+  std::map<std::string, RpcMetricsSummary> Snapshot() const;
+
+  /// Discard all the measurements.
+  void Reset();
+
+ private:
+  RpcMetricsSummary& Summary(char const* rpc);
+
+  mutable std::mutex mu_;
+  std::map<std::string, RpcMetricsSummary> summaries_;
+  // The elements of `summaries_` are never moved, cache their address for
+  // each RPC name pointer.
+  std::unordered_map<char const*, RpcMetricsSummary*> by_rpc_;
+};
+
+}  // namespace GOOGLE_CLOUD_CPP_NS
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_RPC_METRICS_H_
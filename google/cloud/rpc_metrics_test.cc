@@ -0,0 +1,105 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/rpc_metrics.h"
+#include <gmock/gmock.h>
+
+using namespace google::cloud;
+using namespace ::testing;
+
+namespace {
+RpcMetricsRecord MakeRecord(char const* rpc, std::int64_t latency_us,
+                            int status_code, bool ok) {
+  return RpcMetricsRecord{rpc, std::chrono::microseconds(latency_us),
+                          status_code, ok, 10, 20, 3};
+}
+}  // namespace
+
+/// @test Verify that measurements are aggregated by RPC name.
+TEST(HistogramRpcMetricsTest, AggregateByRpc) {
+  HistogramRpcMetrics metrics;
+  metrics.OnAttemptComplete(MakeRecord("ReadRows", 100, 0, true));
+  metrics.OnAttemptComplete(MakeRecord("ReadRows", 200, 14, false));
+  metrics.OnAttemptComplete(MakeRecord("ReadRows", 300, 14, false));
+  metrics.OnAttemptComplete(MakeRecord("MutateRow", 5, 0, true));
+
+  auto snapshot = metrics.Snapshot();
+  ASSERT_EQ(2U, snapshot.size());
+  auto const& read_rows = snapshot["ReadRows"];
+  EXPECT_EQ(3, read_rows.attempts);
+  EXPECT_EQ(30, read_rows.bytes_sent);
+  EXPECT_EQ(60, read_rows.bytes_received);
+  EXPECT_EQ(9, read_rows.messages_received);
+  EXPECT_THAT(read_rows.failures, ElementsAre(Pair(14, 2)));
+  EXPECT_EQ(1, snapshot["MutateRow"].attempts);
+  EXPECT_TRUE(snapshot["MutateRow"].failures.empty());
+
+  metrics.Reset();
+  EXPECT_TRUE(metrics.Snapshot().empty());
+}
+
+/// @test Verify that different pointers to the same name share a summary.
+TEST(HistogramRpcMetricsTest, SameNameDifferentPointers) {
+  static char const kFirst[] = "Get";
+  static char const kSecond[] = "Get";
+  HistogramRpcMetrics metrics;
+  metrics.OnAttemptComplete(MakeRecord(kFirst, 100, 200, true));
+  metrics.OnAttemptComplete(MakeRecord(kSecond, 100, 200, true));
+  metrics.OnAttemptComplete(MakeRecord(kFirst, 100, 200, true));
+
+  auto snapshot = metrics.Snapshot();
+  ASSERT_EQ(1U, snapshot.size());
+  EXPECT_EQ(3, snapshot["Get"].attempts);
+
+  // The cached summaries are discarded too.
+  metrics.Reset();
+  metrics.OnAttemptComplete(MakeRecord(kFirst, 100, 200, true));
+  EXPECT_EQ(1, metrics.Snapshot()["Get"].attempts);
+}
+
+/// @test Verify the histogram buckets and the percentile estimates.
+TEST(HistogramRpcMetricsTest, LatencyPercentile) {
+  HistogramRpcMetrics metrics;
+  EXPECT_EQ(0, RpcMetricsSummary().LatencyPercentile(0.5).count());
+
+  // 90 fast requests in [64, 128) us, and 10 slow ones in [8192, 16384) us.
+  for (int i = 0; i != 90; ++i) {
+    metrics.OnAttemptComplete(MakeRecord("Get", 100, 200, true));
+  }
+  for (int i = 0; i != 10; ++i) {
+    metrics.OnAttemptComplete(MakeRecord("Get", 10000, 200, true));
+  }
+  auto summary = metrics.Snapshot()["Get"];
+  ASSERT_EQ(HistogramRpcMetrics::LATENCY_BUCKETS,
+            summary.latency_buckets.size());
+  EXPECT_EQ(90, summary.latency_buckets[7]);
+  EXPECT_EQ(10, summary.latency_buckets[14]);
+  EXPECT_EQ(128, summary.LatencyPercentile(0.5).count());
+  EXPECT_EQ(128, summary.LatencyPercentile(0.9).count());
+  EXPECT_EQ(16384, summary.LatencyPercentile(0.99).count());
+  EXPECT_EQ(16384, summary.LatencyPercentile(1.0).count());
+}
+
+/// @test Verify that very large and zero latencies are recorded.
+TEST(HistogramRpcMetricsTest, ExtremeLatencies) {
+  HistogramRpcMetrics metrics;
+  metrics.OnAttemptComplete(MakeRecord("Get", 0, 200, true));
+  auto const one_day =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::hours(24));
+  metrics.OnAttemptComplete(MakeRecord("Get", one_day.count(), 200, true));
+  auto summary = metrics.Snapshot()["Get"];
+  EXPECT_EQ(1, summary.latency_buckets.front());
+  EXPECT_EQ(1, summary.latency_buckets.back());
+}
@@ -0,0 +1,84 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/batch.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+/// Return a function to satisfy @p promise with an exception.
+template <typename T>
+std::function<void(std::exception_ptr)> MakeFailure(
+    std::shared_ptr<std::promise<T>> promise) {
+  return [promise](std::exception_ptr error) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      promise->set_exception(std::move(error));
+    } catch (std::future_error const&) {
+      // The operation already has a result, nothing else to report.
+    }
+#else
+    promise->set_exception(std::move(error));
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  };
+}
+}  // namespace
+
+std::future<Status> Batch::AddStatusOperation(
+    internal::BatchOperation operation) {
+  auto promise = std::make_shared<std::promise<Status>>();
+  auto future = promise->get_future();
+  operations_.emplace_back(std::move(operation));
+  completions_.push_back(Completion{
+      [promise](internal::HttpResponse response) {
+        if (response.status_code >= 300) {
+          promise->set_value(
+              Status(response.status_code, std::move(response.payload)));
+          return;
+        }
+        promise->set_value(Status());
+      },
+      MakeFailure(promise)});
+  return future;
+}
+
+std::future<std::pair<Status, ObjectAccessControl>>
+Batch::AddObjectAccessControlOperation(internal::BatchOperation operation) {
+  auto promise =
+      std::make_shared<std::promise<std::pair<Status, ObjectAccessControl>>>();
+  auto future = promise->get_future();
+  operations_.emplace_back(std::move(operation));
+  completions_.push_back(Completion{
+      [promise](internal::HttpResponse response) {
+        if (response.status_code >= 300) {
+          promise->set_value(std::make_pair(
+              Status(response.status_code, std::move(response.payload)),
+              ObjectAccessControl{}));
+          return;
+        }
+        // If the payload cannot be parsed `Client::ExecuteBatch()` reports
+        // the exception through `on_failure`.
+        auto acl = ObjectAccessControl::ParseFromString(response.payload);
+        promise->set_value(std::make_pair(Status(), std::move(acl)));
+      },
+      MakeFailure(promise)});
+  return future;
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,167 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BATCH_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BATCH_H_
+
+#include "google/cloud/storage/internal/batch_request.h"
+#include "google/cloud/storage/internal/delete_object_request.h"
+#include "google/cloud/storage/internal/object_acl_requests.h"
+#include "google/cloud/storage/object_access_control.h"
+#include "google/cloud/storage/status.h"
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+class Client;
+
+/**
+ * Accumulate operations to execute them using `Client::ExecuteBatch()`.
+ *
+ * Each operation in a `Batch` would be a separate HTTP request if made with
+ * the corresponding `Client` member function. `Client::ExecuteBatch()` sends
+ * up to 100 operations in each HTTP request, which greatly reduces the cost of
+ * bulk operations, such as deleting or changing the ACL of many objects.
+ *
+ * The member functions return a `std::future` that is satisfied with the
+ * result of the operation once the batch is executed. Operations in a batch
+ * succeed or fail independently, and they may be executed in any order. The
+ * batch is not retried, some operations may have completed even if the batch
+ * request fails, and operations such as `DeleteObject()` are not idempotent.
+ * Applications can retry the failed operations in a new batch.
+ *
+ * @par Example
+ * @code
+ * storage::Batch batch;
+ * std::vector<std::future<storage::Status>> results;
+ * for (auto const& name : names) {
+ *   results.emplace_back(batch.DeleteObject(bucket_name, name));
+ * }
+ * client.ExecuteBatch(std::move(batch));
+ * for (auto& r : results) {
+ *   auto status = r.get();
+ *   if (not status.ok()) std::cerr << status << "\n";
+ * }
+ * @endcode
+ */
+class Batch {
+ public:
+  Batch() = default;
+
+  Batch(Batch&&) = default;
+  Batch& operator=(Batch&&) = default;
+
+  /**
+   * Delete an object.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be deleted.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `Generation`,
+   *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, and `UserProject`.
+   */
+  template <typename... Options>
+  std::future<Status> DeleteObject(std::string const& bucket_name,
+                                   std::string const& object_name,
+                                   Options&&... options) {
+    internal::DeleteObjectRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    internal::BatchOperationBuilder builder(
+        "DELETE", {"b", bucket_name, "o", object_name});
+    request.AddOptionsToHttpRequest(builder);
+    return AddStatusOperation(builder.Build(std::string{}));
+  }
+
+  /**
+   * Delete one access control entry in one object.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object.
+   * @param entity the name of the entity to be removed from the object's ACL.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `Generation`, and `UserProject`.
+   */
+  template <typename... Options>
+  std::future<Status> DeleteObjectAcl(std::string const& bucket_name,
+                                      std::string const& object_name,
+                                      std::string const& entity,
+                                      Options&&... options) {
+    internal::ObjectAclRequest request(bucket_name, object_name, entity);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    internal::BatchOperationBuilder builder(
+        "DELETE", {"b", bucket_name, "o", object_name, "acl", entity});
+    request.AddOptionsToHttpRequest(builder);
+    return AddStatusOperation(builder.Build(std::string{}));
+  }
+
+  /**
+   * Patch the value of an existing object ACL.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object.
+   * @param entity the identifier for the user, group, service account, or
+   *     predefined set of actors holding the permission.
+   * @param builder a builder ready to create the patch.
+   * @param options a list of optional query parameters and/or request
+   *     headers. Valid types for this operation include `Generation`,
+   *     `UserProject`, `IfMatchEtag`, and `IfNoneMatchEtag`.
+   */
+  template <typename... Options>
+  std::future<std::pair<Status, ObjectAccessControl>> PatchObjectAcl(
+      std::string const& bucket_name, std::string const& object_name,
+      std::string const& entity, ObjectAccessControlPatchBuilder const& builder,
+      Options&&... options) {
+    internal::PatchObjectAclRequest request(bucket_name, object_name, entity,
+                                            builder);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    internal::BatchOperationBuilder op(
+        "PATCH", {"b", bucket_name, "o", object_name, "acl", entity});
+    request.AddOptionsToHttpRequest(op);
+    op.AddHeader("Content-Type: application/json");
+    return AddObjectAccessControlOperation(op.Build(request.payload()));
+  }
+
+  /// The number of operations in the batch.
+  std::size_t size() const { return operations_.size(); }
+  bool empty() const { return operations_.empty(); }
+
+ private:
+  friend class Client;
+
+  /// Deliver the result of an operation, or the error that prevented it.
+  struct Completion {
+    std::function<void(internal::HttpResponse)> on_response;
+    std::function<void(std::exception_ptr)> on_failure;
+  };
+
+  std::future<Status> AddStatusOperation(internal::BatchOperation operation);
+  std::future<std::pair<Status, ObjectAccessControl>>
+  AddObjectAccessControlOperation(internal::BatchOperation operation);
+
+  std::vector<internal::BatchOperation> operations_;
+  std::vector<Completion> completions_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BATCH_H_
@@ -0,0 +1,296 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/benchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+double const kResultPercentiles[] = {0, 50, 90, 95, 99, 99.9, 100};
+
+void SortByLatency(google::cloud::storage::benchmarks::BenchmarkResult& r) {
+  using google::cloud::storage::benchmarks::OperationResult;
+  std::sort(r.operations.begin(), r.operations.end(),
+            [](OperationResult const& lhs, OperationResult const& rhs) {
+              return lhs.latency < rhs.latency;
+            });
+}
+
+/// Merge the results from several threads.
+void MergeResult(google::cloud::storage::benchmarks::BenchmarkResult& dest,
+                 google::cloud::storage::benchmarks::BenchmarkResult src) {
+  dest.item_count += src.item_count;
+  dest.operations.insert(dest.operations.end(), src.operations.begin(),
+                         src.operations.end());
+}
+}  // anonymous namespace
+
+namespace google {
+namespace cloud {
+namespace storage {
+namespace benchmarks {
+Benchmark::Benchmark(BenchmarkSetup const& setup)
+    : setup_(setup),
+      name_width_(static_cast<int>(
+          std::to_string((std::max)(setup.object_count() - 1, 0L)).size())),
+      client_options_(setup.use_embedded_server()
+                          ? storage::ClientOptions(CreateInsecureCredentials())
+                          : storage::ClientOptions()) {
+  if (setup_.use_embedded_server()) {
+    EmbeddedServerConfig config;
+    config.object_size = setup_.object_size();
+    config.object_count = setup_.object_count();
+    config.latency = setup_.server_latency();
+    server_ = CreateEmbeddedServer(config);
+    std::string address = server_->address();
+    std::cout << "Running embedded Cloud Storage server at " << address
+              << std::endl;
+    server_thread_ = std::thread([this]() { server_->Wait(); });
+
+    client_options_.set_endpoint(address);
+  }
+}
+
+Benchmark::~Benchmark() {
+  if (server_) {
+    server_->Shutdown();
+    server_thread_.join();
+  }
+}
+
+storage::Client Benchmark::MakeClient() const {
+  return storage::Client(client_options_);
+}
+
+std::string Benchmark::MakeObjectName(long id) const {
+  std::ostringstream os;
+  os << setup_.object_prefix() << "/" << std::setw(name_width_)
+     << std::setfill('0') << id;
+  return os.str();
+}
+
+std::string Benchmark::MakeRandomObjectName(
+    google::cloud::internal::DefaultPRNG& gen) const {
+  std::uniform_int_distribution<long> dist(0, setup_.object_count() - 1);
+  return MakeObjectName(dist(gen));
+}
+
+BenchmarkResult Benchmark::PopulateBucket() {
+  auto gen = google::cloud::internal::MakeDefaultPRNG();
+  std::string const contents = google::cloud::internal::Sample(
+      gen, static_cast<int>(setup_.object_size()),
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789");
+  auto const& bucket = setup_.bucket_name();
+  return ForEachObject([this, &bucket, &contents](storage::Client& client,
+                                                  long id) -> std::int64_t {
+    client.InsertObject(bucket, MakeObjectName(id), contents);
+    return static_cast<std::int64_t>(contents.size());
+  });
+}
+
+BenchmarkResult Benchmark::DeleteObjects() {
+  auto const& bucket = setup_.bucket_name();
+  return ForEachObject(
+      [this, &bucket](storage::Client& client, long id) -> std::int64_t {
+        client.DeleteObject(bucket, MakeObjectName(id));
+        return 1;
+      });
+}
+
+BenchmarkResult Benchmark::RunTest(Operation const& op) const {
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + setup_.test_duration();
+  auto worker = [this, &op, deadline]() {
+    auto client = MakeClient();
+    auto gen = google::cloud::internal::MakeDefaultPRNG();
+    BenchmarkResult result{};
+    while (std::chrono::steady_clock::now() < deadline) {
+      std::int64_t items = 0;
+      result.operations.emplace_back(
+          TimeOperation([&]() { items = op(client, gen); }));
+      result.item_count += items;
+    }
+    return result;
+  };
+
+  std::vector<std::future<BenchmarkResult>> tasks;
+  for (int i = 0; i != setup_.thread_count(); ++i) {
+    tasks.emplace_back(std::async(std::launch::async, worker));
+  }
+  BenchmarkResult result{};
+  for (auto& t : tasks) {
+    MergeResult(result, t.get());
+  }
+  using std::chrono::duration_cast;
+  result.elapsed = duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  return result;
+}
+
+BenchmarkResult Benchmark::ForEachObject(
+    std::function<std::int64_t(storage::Client&, long)> const& op) const {
+  auto start = std::chrono::steady_clock::now();
+  std::atomic<long> next(0);
+  long const count = setup_.object_count();
+  long progress_period = count / kPopulateProgressMarks;
+  if (progress_period == 0) {
+    progress_period = count;
+  }
+  auto worker = [this, &op, &next, count, progress_period]() {
+    auto client = MakeClient();
+    BenchmarkResult result{};
+    for (long id = next++; id < count; id = next++) {
+      std::int64_t items = 0;
+      result.operations.emplace_back(
+          TimeOperation([&]() { items = op(client, id); }));
+      result.item_count += items;
+      if ((id + 1) % progress_period == 0) {
+        std::cout << "." << std::flush;
+      }
+    }
+    return result;
+  };
+
+  std::vector<std::future<BenchmarkResult>> tasks;
+  for (int i = 0; i != setup_.thread_count(); ++i) {
+    tasks.emplace_back(std::async(std::launch::async, worker));
+  }
+  BenchmarkResult result{};
+  for (auto& t : tasks) {
+    MergeResult(result, t.get());
+  }
+  using std::chrono::duration_cast;
+  result.elapsed = duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  return result;
+}
+
+void Benchmark::PrintThroughputResult(std::ostream& os,
+                                      std::string const& test_name,
+                                      std::string const& phase,
+                                      std::string const& units,
+                                      BenchmarkResult const& result) const {
+  auto elapsed =
+      (std::max)(result.elapsed, std::chrono::milliseconds(1)).count();
+  auto item_throughput = 1000 * result.item_count / elapsed;
+  os << "# Test=" << test_name << ", " << phase
+     << " throughput=" << item_throughput << " " << units << "/s\n";
+  auto ops_throughput = 1000 * static_cast<long>(result.operations.size()) /
+                        elapsed;
+  os << "# Test=" << test_name << ", " << phase
+     << " op throughput=" << ops_throughput << " ops/s" << std::endl;
+}
+
+void Benchmark::PrintLatencyResult(std::ostream& os,
+                                   std::string const& test_name,
+                                   std::string const& operation,
+                                   BenchmarkResult& result) const {
+  if (result.operations.empty()) {
+    os << "# Test=" << test_name << ", " << operation << " no samples"
+       << std::endl;
+    return;
+  }
+  SortByLatency(result);
+  auto const nsamples = result.operations.size();
+  auto elapsed =
+      (std::max)(result.elapsed, std::chrono::milliseconds(1)).count();
+  auto ops_throughput = 1000 * static_cast<long>(nsamples) / elapsed;
+  os << "# Test=" << test_name << ", " << operation
+     << " Throughput = " << ops_throughput << " ops/s, Latency: ";
+  char const* sep = "";
+  for (double p : kResultPercentiles) {
+    auto index =
+        static_cast<std::size_t>(std::round((nsamples - 1) * p / 100.0));
+    os << sep << "p" << std::setprecision(3) << p << "="
+       << result.operations[index].latency.count() << "us";
+    sep = ", ";
+  }
+  os << std::endl;
+}
+
+std::string Benchmark::ResultsCsvHeader() {
+  return "name,start,op.name,measurement,nsamples,min,p50,p90,p95,p99,p99.9,max"
+         ",units,throughput.items,throughput.ops,notes";
+}
+
+void Benchmark::PrintResultCsv(std::ostream& os, std::string const& test_name,
+                               std::string const& op_name,
+                               std::string const& measurement,
+                               BenchmarkResult& result) const {
+  SortByLatency(result);
+  auto const nsamples = result.operations.size();
+  os << test_name << "," << setup_.start_time() << "," << op_name << ","
+     << measurement << "," << nsamples;
+  for (double p : kResultPercentiles) {
+    if (nsamples == 0) {
+      os << ",0";
+      continue;
+    }
+    auto index =
+        static_cast<std::size_t>(std::round((nsamples - 1) * p / 100.0));
+    os << "," << result.operations[index].latency.count();
+  }
+  auto elapsed =
+      (std::max)(result.elapsed, std::chrono::milliseconds(1)).count();
+  auto item_throughput = 1000 * result.item_count / elapsed;
+  auto ops_throughput = 1000 * static_cast<long>(nsamples) / elapsed;
+
+  os << ",us," << item_throughput << "," << ops_throughput << ","
+     << setup_.notes() << "\n";
+}
+
+int Benchmark::insert_count() const {
+  if (not server_) {
+    return 0;
+  }
+  return server_->insert_count();
+}
+
+int Benchmark::read_count() const {
+  if (not server_) {
+    return 0;
+  }
+  return server_->read_count();
+}
+
+int Benchmark::metadata_count() const {
+  if (not server_) {
+    return 0;
+  }
+  return server_->metadata_count();
+}
+
+int Benchmark::list_count() const {
+  if (not server_) {
+    return 0;
+  }
+  return server_->list_count();
+}
+
+int Benchmark::delete_count() const {
+  if (not server_) {
+    return 0;
+  }
+  return server_->delete_count();
+}
+
+}  // namespace benchmarks
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
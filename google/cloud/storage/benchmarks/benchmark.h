@@ -0,0 +1,151 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_BENCHMARK_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_BENCHMARK_H_
+
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/benchmarks/embedded_server.h"
+#include "google/cloud/storage/benchmarks/setup.h"
+#include "google/cloud/storage/client.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+namespace benchmarks {
+/// The result of a single operation.
+struct OperationResult {
+  bool successful;
+  std::chrono::microseconds latency;
+};
+
+struct BenchmarkResult {
+  std::chrono::milliseconds elapsed;
+  std::deque<OperationResult> operations;
+  /// The number of bytes transferred, or objects listed, by the operations.
+  std::int64_t item_count;
+};
+
+/**
+ * Common code used by the Cloud Storage C++ Client benchmarks.
+ */
+class Benchmark {
+ public:
+  /**
+   * An operation measured by `RunTest()`.
+   *
+   * Returns the number of items (bytes or objects) processed by the operation.
+   */
+  using Operation = std::function<std::int64_t(
+      storage::Client&, google::cloud::internal::DefaultPRNG&)>;
+
+  explicit Benchmark(BenchmarkSetup const& setup);
+  ~Benchmark();
+
+  Benchmark(Benchmark const&) = delete;
+  Benchmark& operator=(Benchmark const&) = delete;
+
+  /// Return a `storage::Client` configured for this benchmark.
+  storage::Client MakeClient() const;
+
+  /// Return the name of object @p id, all the names share the setup prefix.
+  std::string MakeObjectName(long id) const;
+
+  /// Return the name of a random object in the benchmark data set.
+  std::string MakeRandomObjectName(
+      google::cloud::internal::DefaultPRNG& gen) const;
+
+  /// Upload the objects used by the benchmark, measuring the throughput.
+  BenchmarkResult PopulateBucket();
+
+  /// Delete the objects created by `PopulateBucket()`.
+  BenchmarkResult DeleteObjects();
+
+  /// Run @p op from `thread_count()` threads until `test_duration()` expires.
+  BenchmarkResult RunTest(Operation const& op) const;
+
+  /// Measure the time to compute an operation.
+  template <typename Op>
+  static OperationResult TimeOperation(Op&& op) {
+    auto start = std::chrono::steady_clock::now();
+    bool successful = false;
+    try {
+      op();
+      successful = true;
+    } catch (...) {
+    }
+    using std::chrono::duration_cast;
+    auto elapsed = duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    return OperationResult{successful, elapsed};
+  }
+
+  /// Print the result of a throughput test in human readable form.
+  void PrintThroughputResult(std::ostream& os, std::string const& test_name,
+                             std::string const& phase, std::string const& units,
+                             BenchmarkResult const& result) const;
+
+  /// Print the result of a latency test in human readable form.
+  void PrintLatencyResult(std::ostream& os, std::string const& test_name,
+                          std::string const& operation,
+                          BenchmarkResult& result) const;
+
+  /// Return the header for CSV results.
+  static std::string ResultsCsvHeader();
+
+  /// Print the result of a benchmark as a CSV line.
+  void PrintResultCsv(std::ostream& os, std::string const& test_name,
+                      std::string const& op_name,
+                      std::string const& measurement,
+                      BenchmarkResult& result) const;
+
+  //@{
+  /**
+   * @name Embedded server counter accessors.
+   *
+   * Return 0 if there is no embedded server, or the value from the
+   * corresponding embedded server counter.  The embedded server has no memory,
+   * so these counters are the only observable effect when unit testing this
+   * class.
+   */
+  int insert_count() const;
+  int read_count() const;
+  int metadata_count() const;
+  int list_count() const;
+  int delete_count() const;
+  //@}
+
+ private:
+  /// Run @p op for each object id in [0, object_count()) using several threads.
+  BenchmarkResult ForEachObject(
+      std::function<std::int64_t(storage::Client&, long)> const& op) const;
+
+  BenchmarkSetup setup_;
+  int name_width_;
+  storage::ClientOptions client_options_;
+  std::unique_ptr<EmbeddedServer> server_;
+  std::thread server_thread_;
+};
+
+}  // namespace benchmarks
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_BENCHMARK_H_
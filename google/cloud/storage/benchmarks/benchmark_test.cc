@@ -0,0 +1,136 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/storage/benchmarks/benchmark.h"
+#include <gmock/gmock.h>
+#include <sstream>
+
+namespace gcs = google::cloud::storage;
+using namespace google::cloud::storage::benchmarks;
+using testing::HasSubstr;
+
+namespace {
+char arg0[] = "program";
+char arg1[] = "my-bucket";
+char arg2[] = "2";
+char arg3[] = "1";
+char arg4[] = "1024";
+char arg5[] = "20";
+char arg6[] = "True";
+}  // anonymous namespace
+
+TEST(BenchmarkTest, Create) {
+  char* argv[] = {arg0, arg1, arg2, arg3, arg4, arg5, arg6};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+  BenchmarkSetup setup("create", argc, argv);
+
+  {
+    Benchmark bm(setup);
+    EXPECT_EQ(0, bm.insert_count());
+    EXPECT_EQ(0, bm.delete_count());
+  }
+  SUCCEED() << "Benchmark object successfully destroyed";
+}
+
+TEST(BenchmarkTest, PopulateAndDelete) {
+  char* argv[] = {arg0, arg1, arg2, arg3, arg4, arg5, arg6};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+  BenchmarkSetup setup("populate", argc, argv);
+
+  Benchmark bm(setup);
+  auto upload = bm.PopulateBucket();
+  // The magic 20 and 1024 come from arg5 and arg4.
+  EXPECT_EQ(20, bm.insert_count());
+  EXPECT_EQ(20U, upload.operations.size());
+  EXPECT_EQ(20 * 1024, upload.item_count);
+  for (auto const& op : upload.operations) {
+    EXPECT_TRUE(op.successful);
+  }
+
+  auto cleanup = bm.DeleteObjects();
+  EXPECT_EQ(20, bm.delete_count());
+  EXPECT_EQ(20, cleanup.item_count);
+}
+
+TEST(BenchmarkTest, MakeObjectName) {
+  char* argv[] = {arg0, arg1, arg2, arg3, arg4, arg5, arg6};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+  BenchmarkSetup setup("name", argc, argv);
+
+  Benchmark bm(setup);
+  // With 20 objects the ids use two digits.
+  EXPECT_EQ(setup.object_prefix() + "/07", bm.MakeObjectName(7));
+  auto gen = google::cloud::internal::MakeDefaultPRNG();
+  for (int i = 0; i != 100; ++i) {
+    auto name = bm.MakeRandomObjectName(gen);
+    EXPECT_EQ(0U, name.find(setup.object_prefix() + "/"));
+    EXPECT_GE(bm.MakeObjectName(19), name);
+  }
+}
+
+TEST(BenchmarkTest, RunTest) {
+  char* argv[] = {arg0, arg1, arg2, arg3, arg4, arg5, arg6};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+  BenchmarkSetup setup("run", argc, argv);
+
+  Benchmark bm(setup);
+  auto result = bm.RunTest(
+      [](gcs::Client& client,
+         google::cloud::internal::DefaultPRNG&) -> std::int64_t {
+        client.GetObjectMetadata("my-bucket", "obj");
+        return 3;
+      });
+  EXPECT_FALSE(result.operations.empty());
+  EXPECT_EQ(static_cast<int>(result.operations.size()), bm.metadata_count());
+  EXPECT_EQ(3 * static_cast<std::int64_t>(result.operations.size()),
+            result.item_count);
+  // The magic 1 comes from arg3, allow some slack for the last operations.
+  EXPECT_LE(1000, result.elapsed.count());
+}
+
+TEST(BenchmarkTest, PrintResults) {
+  char* argv[] = {arg0, arg1, arg2, arg3, arg4, arg5, arg6};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+  BenchmarkSetup setup("print", argc, argv);
+  Benchmark bm(setup);
+
+  BenchmarkResult result{};
+  result.elapsed = std::chrono::milliseconds(2000);
+  result.item_count = 4000;
+  for (int i = 0; i != 100; ++i) {
+    result.operations.push_back(
+        OperationResult{true, std::chrono::microseconds(100 - i)});
+  }
+
+  std::ostringstream throughput;
+  bm.PrintThroughputResult(throughput, "test", "Upload", "bytes", result);
+  EXPECT_THAT(throughput.str(), HasSubstr("Upload throughput=2000 bytes/s"));
+  EXPECT_THAT(throughput.str(), HasSubstr("Upload op throughput=50 ops/s"));
+
+  std::ostringstream latency;
+  bm.PrintLatencyResult(latency, "test", "Op", result);
+  EXPECT_THAT(latency.str(), HasSubstr("p0=1us"));
+  EXPECT_THAT(latency.str(), HasSubstr("p100=100us"));
+
+  std::ostringstream csv;
+  bm.PrintResultCsv(csv, "test", "Upload", "Latency", result);
+  auto header = Benchmark::ResultsCsvHeader();
+  auto line = csv.str();
+  EXPECT_EQ(0U, line.find("test," + setup.start_time() +
+                          ",Upload,Latency,100,1,51,90,95,99,100,100,us,2000,"
+                          "50,"));
+  // The notes may contain commas, so only compare the fields before them.
+  EXPECT_EQ(std::count(header.begin(), header.end(), ','),
+            std::count(line.begin(), line.begin() + line.find(setup.notes()),
+                       ','));
+}
@@ -0,0 +1,45 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_CONSTANTS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_CONSTANTS_H_
+
+namespace google {
+namespace cloud {
+namespace storage {
+namespace benchmarks {
+
+/**
+ * @name Test constants.
+ */
+constexpr int kDefaultThreads = 4;
+
+constexpr int kDefaultTestDuration = 30;
+
+constexpr long kDefaultObjectSize = 1024 * 1024;
+
+constexpr long kDefaultObjectCount = 1000;
+
+constexpr long kDefaultServerLatency = 0;
+
+constexpr int kPopulateProgressMarks = 4;
+
+constexpr int kObjectPrefixRandomLetters = 8;
+
+}  // namespace benchmarks
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_CONSTANTS_H_
@@ -0,0 +1,274 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/embedded_server.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/testing/fake_http_server.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+namespace benchmarks {
+namespace {
+using testing::FakeHttpConnection;
+using testing::FakeHttpRequest;
+
+/// The timestamps reported in the object metadata.
+constexpr char kObjectTimestamp[] = "2018-06-01T12:34:56.789Z";
+
+class DefaultEmbeddedServer : public EmbeddedServer {
+ public:
+  explicit DefaultEmbeddedServer(EmbeddedServerConfig const& config)
+      : config_(config),
+        data_(static_cast<std::size_t>(config.object_size), '\0'),
+        shutdown_(false),
+        insert_count_(0),
+        read_count_(0),
+        metadata_count_(0),
+        list_count_(0),
+        delete_count_(0) {
+    for (std::size_t i = 0; i != data_.size(); ++i) {
+      data_[i] = static_cast<char>('A' + i % 26);
+    }
+    // Start the server only after all the other members are initialized.
+    server_.reset(new testing::FakeHttpServer(
+        [this](FakeHttpConnection& c) { HandleConnection(c); }));
+  }
+
+  ~DefaultEmbeddedServer() override {
+    // Stop the server and wait for its connections before the members used
+    // by the handlers are destroyed.
+    server_.reset();
+  }
+
+  std::string address() const override { return server_->url(); }
+
+  void Shutdown() override {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      shutdown_ = true;
+    }
+    cv_.notify_all();
+    server_->Shutdown();
+  }
+
+  void Wait() override {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return shutdown_; });
+  }
+
+  int insert_count() const override { return insert_count_.load(); }
+  int read_count() const override { return read_count_.load(); }
+  int metadata_count() const override { return metadata_count_.load(); }
+  int list_count() const override { return list_count_.load(); }
+  int delete_count() const override { return delete_count_.load(); }
+
+ private:
+  void HandleConnection(FakeHttpConnection& connection) {
+    FakeHttpRequest request;
+    while (connection.ReadRequest(request)) {
+      if (config_.latency.count() != 0) {
+        std::this_thread::sleep_for(config_.latency);
+      }
+      if (not Dispatch(connection, request)) {
+        break;
+      }
+    }
+  }
+
+  bool Dispatch(FakeHttpConnection& connection,
+                FakeHttpRequest const& request) {
+    // All the requests have the form [/upload]/storage/v1/b/<bucket>/o[/<o>]
+    static std::string const upload_prefix = "/upload/storage/v1/b/";
+    static std::string const prefix = "/storage/v1/b/";
+    bool is_upload = request.path.compare(0, upload_prefix.size(),
+                                          upload_prefix) == 0;
+    auto start = is_upload ? upload_prefix.size() : prefix.size();
+    if (not is_upload and request.path.compare(0, prefix.size(), prefix) != 0) {
+      return SendResponse(connection, 404, "{}");
+    }
+    auto slash = request.path.find('/', start);
+    if (slash == std::string::npos or
+        request.path.compare(slash, 2, "/o") != 0) {
+      return SendResponse(connection, 404, "{}");
+    }
+    std::string bucket = request.path.substr(start, slash - start);
+    std::string object;
+    if (request.path.size() > slash + 3) {
+      object = request.path.substr(slash + 3);
+    }
+
+    if (is_upload and request.method == "POST") {
+      ++insert_count_;
+      return SendResponse(
+          connection, 200,
+          ObjectMetadata(bucket, Query(request, "name"), request.body_size)
+              .dump());
+    }
+    if (request.method == "GET" and object.empty()) {
+      ++list_count_;
+      return SendResponse(connection, 200, ListResponse(request, bucket));
+    }
+    if (request.method == "GET" and Query(request, "alt") == "media") {
+      ++read_count_;
+      return SendMedia(connection, request);
+    }
+    if (request.method == "GET") {
+      ++metadata_count_;
+      return SendResponse(
+          connection, 200,
+          ObjectMetadata(bucket, object, config_.object_size).dump());
+    }
+    if (request.method == "DELETE") {
+      ++delete_count_;
+      return SendResponse(connection, 204, "");
+    }
+    return SendResponse(connection, 404, "{}");
+  }
+
+  static std::string Query(FakeHttpRequest const& request,
+                           std::string const& name) {
+    auto i = request.query.find(name);
+    if (i == request.query.end()) {
+      return std::string{};
+    }
+    return i->second;
+  }
+
+  static storage::internal::nl::json ObjectMetadata(std::string const& bucket,
+                                                    std::string const& name,
+                                                    std::int64_t size) {
+    return storage::internal::nl::json{
+        {"kind", "storage#object"},
+        {"id", bucket + "/" + name + "/1"},
+        {"bucket", bucket},
+        {"name", name},
+        {"generation", "1"},
+        {"metageneration", "1"},
+        {"size", std::to_string(size)},
+        {"contentType", "application/octet-stream"},
+        {"storageClass", "STANDARD"},
+        {"timeCreated", kObjectTimestamp},
+        {"updated", kObjectTimestamp},
+        {"timeStorageClassUpdated", kObjectTimestamp},
+    };
+  }
+
+  std::string ListResponse(FakeHttpRequest const& request,
+                           std::string const& bucket) const {
+    long page_size = 1000;
+    auto max_results = Query(request, "maxResults");
+    if (not max_results.empty()) {
+      page_size = (std::max)(1L, std::stol(max_results));
+    }
+    long begin = 0;
+    auto token = Query(request, "pageToken");
+    if (not token.empty()) {
+      begin = std::stol(token);
+    }
+    long end = (std::min)(config_.object_count, begin + page_size);
+    auto prefix = Query(request, "prefix");
+
+    auto items = storage::internal::nl::json::array();
+    for (long i = begin; i < end; ++i) {
+      char name[32];
+      std::snprintf(name, sizeof(name), "%08ld", i);
+      items.push_back(
+          ObjectMetadata(bucket, prefix + name, config_.object_size));
+    }
+    storage::internal::nl::json response{{"kind", "storage#objects"},
+                                         {"items", std::move(items)}};
+    if (end < config_.object_count) {
+      response["nextPageToken"] = std::to_string(end);
+    }
+    return response.dump();
+  }
+
+  bool SendMedia(FakeHttpConnection& connection,
+                 FakeHttpRequest const& request) {
+    std::size_t begin = 0;
+    std::size_t end = data_.size();
+    int status_code = 200;
+    auto range = request.headers.find("range");
+    if (range != request.headers.end() and
+        range->second.compare(0, 6, "bytes=") == 0) {
+      // Only the `bytes=N-` and `bytes=N-M` forms are used by the client.
+      char* dash;
+      begin = std::strtoull(range->second.c_str() + 6, &dash, 10);
+      if (*dash == '-' and dash[1] != '\0') {
+        end = std::strtoull(dash + 1, nullptr, 10) + 1;
+      }
+      begin = (std::min)(begin, data_.size());
+      end = (std::max)(begin, (std::min)(end, data_.size()));
+      status_code = 206;
+    }
+    std::ostringstream os;
+    os << "HTTP/1.1 " << status_code
+       << (status_code == 200 ? " OK" : " Partial Content") << "\r\n"
+       << "Content-Type: application/octet-stream\r\n"
+       << "Content-Length: " << end - begin << "\r\n"
+       << "x-goog-generation: 1\r\n\r\n";
+    return connection.Write(os.str()) and
+           connection.Write(data_.data() + begin, end - begin);
+  }
+
+  static bool SendResponse(FakeHttpConnection& connection,
+                           int status_code, std::string const& payload) {
+    char const* reason = "OK";
+    if (status_code == 204) {
+      reason = "No Content";
+    } else if (status_code == 404) {
+      reason = "Not Found";
+    }
+    std::ostringstream os;
+    os << "HTTP/1.1 " << status_code << " " << reason << "\r\n"
+       << "Content-Type: application/json; charset=UTF-8\r\n"
+       << "Content-Length: " << payload.size() << "\r\n\r\n"
+       << payload;
+    return connection.Write(os.str());
+  }
+
+  EmbeddedServerConfig config_;
+  std::string data_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool shutdown_;
+
+  std::atomic<int> insert_count_;
+  std::atomic<int> read_count_;
+  std::atomic<int> metadata_count_;
+  std::atomic<int> list_count_;
+  std::atomic<int> delete_count_;
+  std::unique_ptr<testing::FakeHttpServer> server_;
+};
+}  // anonymous namespace
+
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(
+    EmbeddedServerConfig const& config) {
+  return std::unique_ptr<EmbeddedServer>(new DefaultEmbeddedServer(config));
+}
+
+}  // namespace benchmarks
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,81 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_EMBEDDED_SERVER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_EMBEDDED_SERVER_H_
+
+#include "google/cloud/storage/benchmarks/constants.h"
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+namespace benchmarks {
+/**
+ * Configure the responses of the embedded server.
+ */
+struct EmbeddedServerConfig {
+  /// The size of the objects returned by downloads and metadata requests.
+  long object_size = kDefaultObjectSize;
+
+  /// The number of objects returned when listing a bucket.
+  long object_count = kDefaultObjectCount;
+
+  /// Delay each response by this amount, to emulate the network latency.
+  std::chrono::milliseconds latency =
+      std::chrono::milliseconds(kDefaultServerLatency);
+};
+
+/**
+ * An abstract class to run and stop the embedded Cloud Storage server.
+ *
+ * Sometimes it is interesting to run performance benchmarks against an
+ * embedded server, as this eliminates sources of variation when measuring
+ * small changes to the library, and the Python testbench is too slow to
+ * measure anything but the testbench itself.  This class is used to run (using
+ * Wait()) and stop (using Shutdown()) such a server, without exposing the
+ * implementation details to the application.
+ *
+ * The server implements just enough of the JSON API for the benchmarks: simple
+ * and streaming uploads, downloads (including ranged downloads), object
+ * metadata, listing and deleting objects. It does not store any data, all
+ * objects in any bucket exist and have the configured size.
+ */
+class EmbeddedServer {
+ public:
+  virtual ~EmbeddedServer() = default;
+
+  /// The endpoint for `ClientOptions::set_endpoint()`.
+  virtual std::string address() const = 0;
+  virtual void Shutdown() = 0;
+  virtual void Wait() = 0;
+
+  virtual int insert_count() const = 0;
+  virtual int read_count() const = 0;
+  virtual int metadata_count() const = 0;
+  virtual int list_count() const = 0;
+  virtual int delete_count() const = 0;
+};
+
+std::unique_ptr<EmbeddedServer> CreateEmbeddedServer(
+    EmbeddedServerConfig const& config = EmbeddedServerConfig());
+
+}  // namespace benchmarks
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_EMBEDDED_SERVER_H_
@@ -0,0 +1,135 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/storage/benchmarks/embedded_server.h"
+#include "google/cloud/storage/client.h"
+#include <gmock/gmock.h>
+#include <thread>
+
+namespace gcs = google::cloud::storage;
+using namespace google::cloud::storage::benchmarks;
+
+namespace {
+class EmbeddedServerTest : public ::testing::Test {
+ protected:
+  void StartServer(EmbeddedServerConfig const& config) {
+    server_ = CreateEmbeddedServer(config);
+    server_thread_ = std::thread([this]() { server_->Wait(); });
+  }
+
+  void TearDown() override {
+    if (server_) {
+      server_->Shutdown();
+      server_thread_.join();
+    }
+  }
+
+  gcs::Client MakeClient() {
+    return gcs::Client(gcs::ClientOptions(gcs::CreateInsecureCredentials())
+                           .set_endpoint(server_->address()));
+  }
+
+  std::unique_ptr<EmbeddedServer> server_;
+  std::thread server_thread_;
+};
+
+TEST_F(EmbeddedServerTest, InsertObject) {
+  StartServer(EmbeddedServerConfig());
+  auto client = MakeClient();
+  EXPECT_EQ(0, server_->insert_count());
+  auto meta = client.InsertObject("bkt", "foo/bar", std::string(5000, 'x'));
+  EXPECT_EQ(1, server_->insert_count());
+  EXPECT_EQ("bkt", meta.bucket());
+  EXPECT_EQ("foo/bar", meta.name());
+  EXPECT_EQ(5000U, meta.size());
+}
+
+TEST_F(EmbeddedServerTest, WriteObject) {
+  StartServer(EmbeddedServerConfig());
+  auto client = MakeClient();
+  auto stream = client.WriteObject("bkt", "obj");
+  for (int i = 0; i != 100; ++i) {
+    stream << std::string(1000, static_cast<char>('a' + i % 26)) << "\n";
+  }
+  auto meta = stream.Close();
+  EXPECT_EQ(1, server_->insert_count());
+  EXPECT_EQ(100 * 1001U, meta.size());
+}
+
+TEST_F(EmbeddedServerTest, ReadObject) {
+  EmbeddedServerConfig config;
+  config.object_size = 3 * 1024 * 1024 + 17;
+  StartServer(config);
+  auto client = MakeClient();
+  auto stream = client.ReadObject("bkt", "obj");
+  std::string contents(std::istreambuf_iterator<char>{stream}, {});
+  EXPECT_EQ(1, server_->read_count());
+  EXPECT_EQ(static_cast<std::size_t>(config.object_size), contents.size());
+}
+
+TEST_F(EmbeddedServerTest, GetObjectMetadata) {
+  EmbeddedServerConfig config;
+  config.object_size = 1234;
+  StartServer(config);
+  auto client = MakeClient();
+  auto meta = client.GetObjectMetadata("bkt", "obj");
+  EXPECT_EQ(1, server_->metadata_count());
+  EXPECT_EQ("obj", meta.name());
+  EXPECT_EQ(1234U, meta.size());
+  EXPECT_EQ(1, meta.generation());
+}
+
+TEST_F(EmbeddedServerTest, ListObjects) {
+  EmbeddedServerConfig config;
+  config.object_count = 2500;
+  StartServer(config);
+  auto client = MakeClient();
+  long count = 0;
+  for (auto const& o : client.ListObjects("bkt", gcs::Prefix("p/"))) {
+    EXPECT_EQ(0U, o.name().find("p/"));
+    ++count;
+  }
+  EXPECT_EQ(2500, count);
+  // The default page size is 1,000 objects.
+  EXPECT_EQ(3, server_->list_count());
+}
+
+TEST_F(EmbeddedServerTest, DeleteObject) {
+  StartServer(EmbeddedServerConfig());
+  auto client = MakeClient();
+  client.DeleteObject("bkt", "obj");
+  EXPECT_EQ(1, server_->delete_count());
+}
+
+TEST_F(EmbeddedServerTest, Latency) {
+  EmbeddedServerConfig config;
+  config.latency = std::chrono::milliseconds(50);
+  StartServer(config);
+  auto client = MakeClient();
+  auto start = std::chrono::steady_clock::now();
+  client.GetObjectMetadata("bkt", "obj");
+  EXPECT_LE(config.latency, std::chrono::steady_clock::now() - start);
+}
+
+TEST_F(EmbeddedServerTest, ShutdownWithOpenConnections) {
+  StartServer(EmbeddedServerConfig());
+  auto client = MakeClient();
+  client.GetObjectMetadata("bkt", "obj");
+  // The client keeps the connection open, Shutdown() must still terminate the
+  // server, TearDown() would block otherwise.
+  server_->Shutdown();
+  server_thread_.join();
+  server_.reset();
+  SUCCEED() << "Server successfully stopped";
+}
+}  // anonymous namespace
@@ -0,0 +1,108 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/benchmark.h"
+#include <iostream>
+
+/**
+ * @file
+ *
+ * Measure the latency of `storage::Client` metadata operations.
+ *
+ * This benchmark measures the latency of
+ * `storage::Client::GetObjectMetadata()`, of listing a single page with
+ * `storage::Client::ListObjects()`, and of `storage::Client::DeleteObject()`.
+ * The benchmark:
+ * - Uploads N objects (1,000 by default), using multiple threads.  The object
+ *   size is configurable, use a small value (e.g. 0) to reduce the time
+ *   spent in this phase.  The names of the objects start with `mlat-`,
+ *   followed by random characters.
+ * - Executes the following loop for S seconds, from each thread:
+ *   - Pick one of the N objects at random, with uniform probability.
+ *   - Get the metadata for the object.
+ * - Executes the following loop for S seconds, from each thread:
+ *   - Get the first page (with up to 10 objects) of the objects created by
+ *     the benchmark.
+ * - Deletes all the objects, measuring the latency of each request.
+ *
+ * The benchmark reports the latency percentiles for each operation, both in
+ * human readable form and as CSV lines.
+ *
+ * Using a command-line parameter the benchmark can be configured to create a
+ * local HTTP server that implements the Cloud Storage APIs used by the
+ * benchmark, optionally with an injected latency for each response.  If this
+ * parameter is not used, the benchmark uses the default configuration, that
+ * is, the production Cloud Storage service unless the
+ * CLOUD_STORAGE_TESTBENCH_ENDPOINT environment variable is set.
+ */
+
+/// Helper functions and types for the metadata_latency_benchmark.
+namespace {
+namespace gcs = google::cloud::storage;
+using namespace gcs::benchmarks;
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  BenchmarkSetup setup("mlat", argc, argv);
+  Benchmark benchmark(setup);
+
+  // Upload the objects used in the benchmark.
+  auto upload = benchmark.PopulateBucket();
+  std::cout << std::endl;
+  benchmark.PrintThroughputResult(std::cout, "mlat", "Upload", "bytes",
+                                  upload);
+
+  std::string const bucket_name = setup.bucket_name();
+  auto get_metadata = benchmark.RunTest(
+      [&benchmark, &bucket_name](
+          gcs::Client& client,
+          google::cloud::internal::DefaultPRNG& gen) -> std::int64_t {
+        client.GetObjectMetadata(bucket_name,
+                                 benchmark.MakeRandomObjectName(gen));
+        return 1;
+      });
+  benchmark.PrintLatencyResult(std::cout, "mlat", "GetObjectMetadata()",
+                               get_metadata);
+
+  auto list_page = benchmark.RunTest(
+      [&bucket_name, &setup](gcs::Client& client,
+                              google::cloud::internal::DefaultPRNG&)
+          -> std::int64_t {
+        // Only fetch the first page, the iterator fetches the next page when
+        // advanced past the last object in the current page.
+        auto reader = client.ListObjects(
+            bucket_name, gcs::Prefix(setup.object_prefix() + "/"),
+            gcs::MaxResults(10));
+        return reader.begin() == reader.end() ? 0 : 1;
+      });
+  benchmark.PrintLatencyResult(std::cout, "mlat", "ListObjects(page)",
+                               list_page);
+
+  auto cleanup = benchmark.DeleteObjects();
+  std::cout << std::endl;
+  benchmark.PrintLatencyResult(std::cout, "mlat", "DeleteObject()", cleanup);
+
+  std::cout << Benchmark::ResultsCsvHeader() << std::endl;
+  benchmark.PrintResultCsv(std::cout, "mlat", "GetObjectMetadata", "Latency",
+                           get_metadata);
+  benchmark.PrintResultCsv(std::cout, "mlat", "ListObjectsPage", "Latency",
+                           list_page);
+  benchmark.PrintResultCsv(std::cout, "mlat", "DeleteObject", "Latency",
+                           cleanup);
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
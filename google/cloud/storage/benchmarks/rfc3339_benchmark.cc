@@ -0,0 +1,139 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/format_rfc3339.h"
+#include "google/cloud/storage/internal/parse_rfc3339.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Compare the RFC 3339 timestamp functions against their general purpose
+ * versions.
+ *
+ * The benchmark creates a set of timestamps in the format used by Google Cloud
+ * Storage (with and without fractional seconds), and then measures the time
+ * to parse all of them, and to format all of them, with:
+ * - `ParseRfc3339()` and `ParseRfc3339Generic()`
+ * - `FormatRfc3339()` and `FormatRfc3339Generic()`
+ *
+ * The benchmark reports the average time per call and the speedup. The number
+ * of iterations over the data can be changed with the first command-line
+ * argument.
+ */
+
+namespace {
+namespace gcs_internal = google::cloud::storage::internal;
+using std::chrono::system_clock;
+
+constexpr int kDefaultIterations = 100;
+constexpr int kTimestampCount = 10000;
+
+/// Run @p function over all the @p inputs @p iterations times, return ns/call.
+template <typename Input, typename Function>
+double Measure(std::vector<Input> const& inputs, int iterations,
+               Function&& function, std::size_t& checksum) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i != iterations; ++i) {
+    for (auto const& input : inputs) {
+      checksum += function(input);
+    }
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+  return static_cast<double>(elapsed.count()) /
+         (static_cast<double>(iterations) * inputs.size());
+}
+
+void Report(char const* name, double fast, double generic) {
+  std::cout << std::left << std::setw(8) << name << std::right << std::fixed
+            << std::setprecision(1) << " fast=" << std::setw(8) << fast
+            << "ns generic=" << std::setw(8) << generic
+            << "ns speedup=" << std::setprecision(2) << generic / fast << "x\n";
+}
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  int iterations = kDefaultIterations;
+  if (argc > 2) {
+    std::cerr << "Usage: " << argv[0] << " [iterations]\n";
+    return 1;
+  }
+  if (argc == 2) {
+    iterations = std::stoi(argv[1]);
+  }
+
+  // Spread the timestamps over several decades, with a mix of whole seconds,
+  // milliseconds and microseconds, as returned by the service.
+  std::vector<system_clock::time_point> time_points;
+  std::vector<std::string> timestamps;
+  system_clock::time_point tp =
+      gcs_internal::ParseRfc3339("2000-01-01T00:00:00Z");
+  for (int i = 0; i != kTimestampCount; ++i) {
+    tp += std::chrono::seconds(86400 + 3607);
+    auto fraction = i % 3 == 0 ? std::chrono::microseconds(0)
+                               : i % 3 == 1 ? std::chrono::microseconds(123000)
+                                            : std::chrono::microseconds(i);
+    auto t = tp + std::chrono::duration_cast<system_clock::duration>(fraction);
+    time_points.push_back(t);
+    timestamps.push_back(gcs_internal::FormatRfc3339(t));
+  }
+
+  // Accumulate something from each result so the calls are not optimized out.
+  std::size_t checksum = 0;
+  auto parse = [](std::string const& s) {
+    return static_cast<std::size_t>(
+        gcs_internal::ParseRfc3339(s).time_since_epoch().count());
+  };
+  auto parse_generic = [](std::string const& s) {
+    return static_cast<std::size_t>(
+        gcs_internal::ParseRfc3339Generic(s).time_since_epoch().count());
+  };
+  auto format = [](system_clock::time_point const& t) {
+    return gcs_internal::FormatRfc3339(t).size();
+  };
+  auto format_generic = [](system_clock::time_point const& t) {
+    return gcs_internal::FormatRfc3339Generic(t).size();
+  };
+
+  // Verify both versions produce the same results before measuring anything.
+  for (std::size_t i = 0; i != timestamps.size(); ++i) {
+    auto const& s = timestamps[i];
+    if (gcs_internal::ParseRfc3339(s) != gcs_internal::ParseRfc3339Generic(s) or
+        s != gcs_internal::FormatRfc3339Generic(time_points[i])) {
+      std::cerr << "Mismatched results for " << s << "\n";
+      return 1;
+    }
+  }
+
+  std::cout << "# Timestamps: " << timestamps.size()
+            << ", Iterations: " << iterations << "\n";
+  double parse_fast = Measure(timestamps, iterations, parse, checksum);
+  double parse_slow = Measure(timestamps, iterations, parse_generic, checksum);
+  Report("Parse", parse_fast, parse_slow);
+  double format_fast = Measure(time_points, iterations, format, checksum);
+  double format_slow =
+      Measure(time_points, iterations, format_generic, checksum);
+  Report("Format", format_fast, format_slow);
+  std::cout << "# Checksum: " << checksum << "\n";
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << "\n";
+  return 1;
+}
@@ -0,0 +1,145 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/setup.h"
+#include "google/cloud/internal/build_info.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include "google/cloud/storage/internal/format_rfc3339.h"
+#include "google/cloud/storage/version.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <sstream>
+
+namespace {
+std::string FormattedStartTime() {
+  auto start = std::chrono::time_point_cast<std::chrono::seconds>(
+      std::chrono::system_clock::now());
+  return google::cloud::storage::internal::FormatRfc3339(start);
+}
+
+std::string FormattedAnnotations() {
+  std::string notes = google::cloud::storage::version_string() + ";" +
+                      google::cloud::internal::compiler() + ";" +
+                      google::cloud::internal::compiler_flags();
+  std::transform(notes.begin(), notes.end(), notes.begin(),
+                 [](char c) { return c == '\n' ? ';' : c; });
+  return notes;
+}
+
+std::string MakeRandomObjectPrefix(std::string const& prefix) {
+  static std::string const object_prefix_chars(
+      "abcdefghijklmnopqrstuvwxyz0123456789");
+  auto gen = google::cloud::internal::MakeDefaultPRNG();
+  return prefix + "-" +
+         google::cloud::internal::Sample(
+             gen,
+             google::cloud::storage::benchmarks::kObjectPrefixRandomLetters,
+             object_prefix_chars);
+}
+}  // anonymous namespace
+
+namespace google {
+namespace cloud {
+namespace storage {
+namespace benchmarks {
+BenchmarkSetup::BenchmarkSetup(std::string const& prefix, int& argc,
+                               char* argv[])
+    : start_time_(FormattedStartTime()),
+      notes_(FormattedAnnotations()),
+      bucket_name_(),
+      object_prefix_(MakeRandomObjectPrefix(prefix)) {
+  auto usage = [argv](char const* msg) {
+    std::string const cmd = argv[0];
+    auto last_slash = std::string(argv[0]).find_last_of('/');
+    std::cerr << "Usage: " << cmd.substr(last_slash + 1) << " <bucket>"
+              << " [thread-count (" << kDefaultThreads << ")]"
+              << " [test-duration-seconds (" << kDefaultTestDuration << "s)]"
+              << " [object-size (" << kDefaultObjectSize << ")]"
+              << " [object-count (" << kDefaultObjectCount << ")]"
+              << " [use-embedded-server (false)]"
+              << " [server-latency-ms (" << kDefaultServerLatency << ")]"
+              << std::endl;
+    google::cloud::internal::RaiseRuntimeError(msg);
+  };
+
+  if (argc < 2) {
+    usage("too few arguments for program.");
+  }
+
+  auto shift = [&argc, &argv]() {
+    char* r = argv[1];
+    std::copy(argv + 2, argv + argc, argv + 1);
+    --argc;
+    return r;
+  };
+
+  bucket_name_ = shift();
+
+  if (argc == 1) {
+    return;
+  }
+  thread_count_ = std::stoi(shift());
+  if (thread_count_ <= 0) {
+    usage("thread-count should be > 0");
+  }
+
+  if (argc == 1) {
+    return;
+  }
+  long seconds = std::stol(shift());
+  if (seconds <= 0) {
+    usage("test-duration-seconds should be > 0");
+  }
+  test_duration_ = std::chrono::seconds(seconds);
+
+  if (argc == 1) {
+    return;
+  }
+  object_size_ = std::stol(shift());
+  if (object_size_ < 0) {
+    usage("object-size should be >= 0");
+  }
+
+  if (argc == 1) {
+    return;
+  }
+  object_count_ = std::stol(shift());
+  if (object_count_ <= 0) {
+    usage("object-count should be > 0");
+  }
+
+  if (argc == 1) {
+    return;
+  }
+  std::string value = shift();
+  std::transform(value.begin(), value.end(), value.begin(),
+                 [](char x) { return std::tolower(x); });
+  use_embedded_server_ = value == "true";
+
+  if (argc == 1) {
+    return;
+  }
+  long latency = std::stol(shift());
+  if (latency < 0) {
+    usage("server-latency-ms should be >= 0");
+  }
+  server_latency_ = std::chrono::milliseconds(latency);
+}
+
+}  // namespace benchmarks
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
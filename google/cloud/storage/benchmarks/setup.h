@@ -0,0 +1,71 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_SETUP_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_SETUP_H_
+
+#include "google/cloud/storage/benchmarks/constants.h"
+#include <chrono>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+namespace benchmarks {
+/**
+ * The configuration for a benchmark.
+ */
+class BenchmarkSetup {
+ public:
+  BenchmarkSetup(std::string const& prefix, int& argc, char* argv[]);
+
+  /// When did the benchmark start, this is used in reporting the results.
+  std::string const& start_time() const { return start_time_; }
+  /// Benchmark annotations, e.g., compiler version and flags.
+  std::string const& notes() const { return notes_; }
+  std::string const& bucket_name() const { return bucket_name_; }
+
+  /// The randomly generated prefix for the objects created by the benchmark.
+  std::string const& object_prefix() const { return object_prefix_; }
+
+  int thread_count() const { return thread_count_; }
+  std::chrono::seconds test_duration() const { return test_duration_; }
+  long object_size() const { return object_size_; }
+  long object_count() const { return object_count_; }
+  bool use_embedded_server() const { return use_embedded_server_; }
+
+  /// The latency injected by the embedded server in each response.
+  std::chrono::milliseconds server_latency() const { return server_latency_; }
+
+ private:
+  std::string start_time_;
+  std::string notes_;
+  std::string bucket_name_;
+  std::string object_prefix_;
+  int thread_count_ = kDefaultThreads;
+  std::chrono::seconds test_duration_ =
+      std::chrono::seconds(kDefaultTestDuration);
+  long object_size_ = kDefaultObjectSize;
+  long object_count_ = kDefaultObjectCount;
+  bool use_embedded_server_ = false;
+  std::chrono::milliseconds server_latency_ =
+      std::chrono::milliseconds(kDefaultServerLatency);
+};
+
+}  // namespace benchmarks
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_SETUP_H_
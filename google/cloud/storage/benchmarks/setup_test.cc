@@ -0,0 +1,110 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/storage/benchmarks/setup.h"
+#include <gmock/gmock.h>
+
+using namespace google::cloud::storage::benchmarks;
+
+namespace {
+char arg0[] = "program";
+char arg1[] = "my-bucket";
+char arg2[] = "2";
+char arg3[] = "5";
+char arg4[] = "4096";
+char arg5[] = "100";
+char arg6[] = "True";
+char arg7[] = "20";
+char arg8[] = "Unused";
+}  // anonymous namespace
+
+TEST(BenchmarkSetup, Basic) {
+  char* argv[] = {arg0, arg1};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+  BenchmarkSetup setup("pre", argc, argv);
+  EXPECT_EQ("my-bucket", setup.bucket_name());
+  EXPECT_EQ(0U, setup.object_prefix().find("pre-"));
+  std::size_t expected = 4 + kObjectPrefixRandomLetters;
+  EXPECT_EQ(expected, setup.object_prefix().size());
+
+  EXPECT_EQ(kDefaultThreads, setup.thread_count());
+  EXPECT_EQ(kDefaultTestDuration, setup.test_duration().count());
+  EXPECT_EQ(kDefaultObjectSize, setup.object_size());
+  EXPECT_EQ(kDefaultObjectCount, setup.object_count());
+  EXPECT_FALSE(setup.use_embedded_server());
+  EXPECT_EQ(kDefaultServerLatency, setup.server_latency().count());
+}
+
+TEST(BenchmarkSetup, Different) {
+  char* argv_0[] = {arg0, arg1};
+  int argc_0 = sizeof(argv_0) / sizeof(argv_0[0]);
+  char* argv_1[] = {arg0, arg1};
+  int argc_1 = sizeof(argv_1) / sizeof(argv_1[0]);
+  BenchmarkSetup s0("pre", argc_0, argv_0);
+  BenchmarkSetup s1("pre", argc_1, argv_1);
+  // The probability of this test failing is tiny, but if it does, run it again.
+  // Sorry for the flakiness, but randomness is hard.
+  EXPECT_NE(s0.object_prefix(), s1.object_prefix());
+}
+
+TEST(BenchmarkSetup, Parse) {
+  char* argv[] = {arg0, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+  BenchmarkSetup setup("pre", argc, argv);
+
+  EXPECT_EQ(2, argc);
+  EXPECT_EQ(std::string("program"), argv[0]);
+  EXPECT_EQ(std::string("Unused"), argv[1]);
+
+  EXPECT_EQ("my-bucket", setup.bucket_name());
+  EXPECT_EQ(2, setup.thread_count());
+  EXPECT_EQ(5, setup.test_duration().count());
+  EXPECT_EQ(4096, setup.object_size());
+  EXPECT_EQ(100, setup.object_count());
+  EXPECT_TRUE(setup.use_embedded_server());
+  EXPECT_EQ(20, setup.server_latency().count());
+}
+
+TEST(BenchmarkSetup, TooFew) {
+  char* argv[] = {arg0};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+  EXPECT_THROW(BenchmarkSetup("pre", argc, argv), std::exception);
+}
+
+TEST(BenchmarkSetup, InvalidThreadCount) {
+  char zero[] = "0";
+  char* argv[] = {arg0, arg1, zero};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+  EXPECT_THROW(BenchmarkSetup("pre", argc, argv), std::exception);
+}
+
+TEST(BenchmarkSetup, InvalidDuration) {
+  char zero[] = "0";
+  char* argv[] = {arg0, arg1, arg2, zero};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+  EXPECT_THROW(BenchmarkSetup("pre", argc, argv), std::exception);
+}
+
+TEST(BenchmarkSetup, InvalidObjectCount) {
+  char zero[] = "0";
+  char* argv[] = {arg0, arg1, arg2, arg3, arg4, zero};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+  EXPECT_THROW(BenchmarkSetup("pre", argc, argv), std::exception);
+}
+
+TEST(BenchmarkSetup, InvalidLatency) {
+  char negative[] = "-1";
+  char* argv[] = {arg0, arg1, arg2, arg3, arg4, arg5, arg6, negative};
+  int argc = sizeof(argv) / sizeof(argv[0]);
+  EXPECT_THROW(BenchmarkSetup("pre", argc, argv), std::exception);
+}
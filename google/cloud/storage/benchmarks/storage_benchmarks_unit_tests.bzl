@@ -0,0 +1,6 @@
+# DO NOT EDIT -- GENERATED BY CMake -- Change the CMakeLists.txt file if needed
+storage_benchmarks_unit_tests = [
+    "benchmark_test.cc",
+    "embedded_server_test.cc",
+    "setup_test.cc",
+]
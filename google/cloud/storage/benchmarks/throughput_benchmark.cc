@@ -0,0 +1,119 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/benchmark.h"
+#include <iostream>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Measure the throughput of uploads, downloads and listing objects.
+ *
+ * This benchmark measures the throughput of `storage::Client::InsertObject()`,
+ * `storage::Client::ReadObject()`, and `storage::Client::ListObjects()`. The
+ * benchmark:
+ * - Uploads N objects (1,000 by default), each with the configured object size
+ *   (1MiB by default), using multiple threads.  The names of the objects start
+ *   with `thru-`, followed by random characters.
+ * - The benchmark reports the throughput of this upload phase.
+ *
+ * After successfully uploading the initial data, the main phase of the
+ * benchmark starts.  During this phase the benchmark will:
+ *
+ * - Execute the following loop for S seconds, from each thread:
+ *   - Pick one of the N objects at random, with uniform probability.
+ *   - Download the full object.
+ * - Execute the following loop for S seconds, from each thread:
+ *   - List all the objects created by the benchmark.
+ *
+ * Finally, the benchmark deletes the objects.  The benchmark reports the
+ * throughput in bytes per second for uploads and downloads, and in objects per
+ * second for listing, both in human readable form and as CSV lines.
+ *
+ * Using a command-line parameter the benchmark can be configured to create a
+ * local HTTP server that implements the Cloud Storage APIs used by the
+ * benchmark, optionally with an injected latency for each response.  If this
+ * parameter is not used, the benchmark uses the default configuration, that
+ * is, the production Cloud Storage service unless the
+ * CLOUD_STORAGE_TESTBENCH_ENDPOINT environment variable is set.
+ */
+
+/// Helper functions and types for the throughput_benchmark.
+namespace {
+namespace gcs = google::cloud::storage;
+using namespace gcs::benchmarks;
+
+constexpr std::size_t kReadBufferSize = 1024 * 1024;
+}  // anonymous namespace
+
+int main(int argc, char* argv[]) try {
+  BenchmarkSetup setup("thru", argc, argv);
+  Benchmark benchmark(setup);
+
+  // Upload the objects used in the benchmark.
+  auto upload = benchmark.PopulateBucket();
+  std::cout << std::endl;
+  benchmark.PrintThroughputResult(std::cout, "thru", "Upload", "bytes",
+                                  upload);
+
+  std::string const bucket_name = setup.bucket_name();
+  auto download = benchmark.RunTest(
+      [&benchmark, &bucket_name](
+          gcs::Client& client,
+          google::cloud::internal::DefaultPRNG& gen) -> std::int64_t {
+        auto stream = client.ReadObject(
+            bucket_name, benchmark.MakeRandomObjectName(gen));
+        std::vector<char> buffer(kReadBufferSize);
+        std::int64_t count = 0;
+        while (stream.read(buffer.data(), buffer.size()) or
+               stream.gcount() != 0) {
+          count += stream.gcount();
+        }
+        return count;
+      });
+  benchmark.PrintThroughputResult(std::cout, "thru", "Download", "bytes",
+                                  download);
+
+  auto list = benchmark.RunTest(
+      [&bucket_name, &setup](gcs::Client& client,
+                              google::cloud::internal::DefaultPRNG&)
+          -> std::int64_t {
+        std::int64_t count = 0;
+        auto reader = client.ListObjects(
+            bucket_name, gcs::Prefix(setup.object_prefix() + "/"));
+        for (auto const& object : reader) {
+          static_cast<void>(object);
+          ++count;
+        }
+        return count;
+      });
+  benchmark.PrintThroughputResult(std::cout, "thru", "List", "objects", list);
+
+  auto cleanup = benchmark.DeleteObjects();
+  std::cout << std::endl;
+  benchmark.PrintThroughputResult(std::cout, "thru", "Delete", "objects",
+                                  cleanup);
+
+  std::cout << Benchmark::ResultsCsvHeader() << std::endl;
+  benchmark.PrintResultCsv(std::cout, "thru", "Upload", "Latency", upload);
+  benchmark.PrintResultCsv(std::cout, "thru", "Download", "Latency", download);
+  benchmark.PrintResultCsv(std::cout, "thru", "List", "Latency", list);
+  benchmark.PrintResultCsv(std::cout, "thru", "Delete", "Latency", cleanup);
+
+  return 0;
+} catch (std::exception const& ex) {
+  std::cerr << "Standard exception raised: " << ex.what() << std::endl;
+  return 1;
+}
@@ -16,6 +16,9 @@
 #include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/storage/internal/curl_client.h"
 #include "google/cloud/storage/internal/logging_client.h"
+#include "google/cloud/storage/internal/metrics_client.h"
+#include "google/cloud/storage/internal/object_disk_cache_client.h"
+#include "google/cloud/storage/internal/object_metadata_cache_client.h"
 #include "google/cloud/storage/internal/retry_client.h"
 #include <sstream>
 #include <thread>
@@ -30,8 +33,39 @@ static_assert(std::is_copy_assignable<storage::Client>::value,
               "storage::Client must be assignable");
 
 Client::Client(ClientOptions options)
-    : Client(std::shared_ptr<internal::RawClient>(
-          new internal::CurlClient(std::move(options)))) {}
+    : Client(CreateDefaultClient(std::move(options))) {}
+
+std::shared_ptr<internal::RawClient> Client::CreateDefaultClient(
+    ClientOptions options) {
+  auto metrics = options.rpc_metrics();
+  auto cache_size = options.object_metadata_cache_size();
+  auto cache_ttl = options.object_metadata_cache_ttl();
+  auto disk_cache_directory = options.object_disk_cache_directory();
+  auto disk_cache_max_size = options.object_disk_cache_max_size();
+  std::shared_ptr<internal::RawClient> client =
+      std::make_shared<internal::CurlClient>(std::move(options));
+  if (metrics) {
+    // Install the metrics decorator below the retry loop, so each attempt is
+    // reported.
+    client = std::make_shared<internal::MetricsClient>(std::move(client),
+                                                       std::move(metrics));
+  }
+  if (cache_size != 0) {
+    // The cache must be below the retry loop, which would treat the "not
+    // modified" responses as permanent errors. It is above the metrics
+    // decorator, so only the requests that reach the service are reported.
+    client = std::make_shared<internal::ObjectMetadataCacheClient>(
+        std::move(client), cache_size, cache_ttl);
+  }
+  if (not disk_cache_directory.empty()) {
+    // Above the metadata cache, which can then find the current generation of
+    // the objects without contacting the service.
+    client = std::make_shared<internal::ObjectDiskCacheClient>(
+        std::move(client), std::move(disk_cache_directory),
+        disk_cache_max_size);
+  }
+  return client;
+}
 
 BucketMetadata Client::GetBucketMetadataImpl(
     internal::GetBucketMetadataRequest const& request) {
@@ -43,6 +77,62 @@ ObjectMetadata Client::InsertObjectMediaImpl(
   return raw_client_->InsertObjectMedia(request).second;
 }
 
+void Client::ExecuteBatch(Batch batch) {
+  auto completion = batch.completions_.begin();
+  auto op = batch.operations_.begin();
+  auto const end = batch.operations_.end();
+  while (op != end) {
+    internal::BatchRequest request;
+    for (; op != end and
+           request.size() < internal::BatchRequest::MAX_OPERATIONS;
+         ++op) {
+      request.AddOperation(std::move(*op));
+    }
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    std::pair<Status, internal::BatchResponse> result;
+    try {
+      result = raw_client_->ExecuteBatch(request);
+    } catch (...) {
+      // None of the remaining operations can be sent, report the error to all
+      // of them.
+      auto error = std::current_exception();
+      for (; completion != batch.completions_.end(); ++completion) {
+        completion->on_failure(error);
+      }
+      return;
+    }
+#else
+    auto result = raw_client_->ExecuteBatch(request);
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    auto& responses = result.second.responses;
+    // The operations are numbered starting at 1, matching the Content-ID of
+    // each part in the request.
+    for (std::size_t id = 1; id <= request.size(); ++id, ++completion) {
+      internal::HttpResponse response;
+      auto loc = responses.find(id);
+      if (not result.first.ok()) {
+        response = internal::HttpResponse{result.first.status_code(),
+                                          result.first.error_message(),
+                                          {}};
+      } else if (loc != responses.end()) {
+        response = std::move(loc->second);
+      } else {
+        response = internal::HttpResponse{
+            500, "missing response for operation in batch request", {}};
+      }
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+      try {
+        completion->on_response(std::move(response));
+      } catch (...) {
+        completion->on_failure(std::current_exception());
+      }
+#else
+      completion->on_response(std::move(response));
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    }
+  }
+}
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
@@ -15,11 +15,18 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_H_
 
+#include "google/cloud/storage/batch.h"
+#include "google/cloud/storage/compression_options.h"
+#include "google/cloud/storage/hashing_options.h"
 #include "google/cloud/storage/internal/logging_client.h"
 #include "google/cloud/storage/internal/retry_client.h"
+#include "google/cloud/storage/internal/seekable_object_read_streambuf.h"
 #include "google/cloud/storage/list_buckets_reader.h"
 #include "google/cloud/storage/list_objects_reader.h"
 #include "google/cloud/storage/object_stream.h"
+#include "google/cloud/storage/parallel_list_objects_reader.h"
+#include "google/cloud/storage/read_ranges.h"
+#include "google/cloud/storage/rewrite_objects.h"
 
 namespace google {
 namespace cloud {
@@ -192,7 +199,8 @@ class Client {
    * @param options a list of optional query parameters and/or request headers.
    *     Valid types for this operation include `Generation`,
    *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
-   *     `IfMetagenerationNotMatch`, `Projection`, and `UserProject`.
+   *     `IfMetagenerationNotMatch`, `IfNoneMatchEtag`, `Fields`, `Projection`,
+   *     and `UserProject`.
    *
    *
    * @throw std::runtime_error if the metadata cannot be fetched using the
@@ -217,7 +225,9 @@ class Client {
    * @param options a list of optional query parameters and/or request headers.
    *     Valid types for this operation include
    *     `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `UserProject`,
-   *     `Projection`, `Prefix`.
+   *     `Projection`, `Prefix`, `Delimiter`, and `Fields`. Use
+   *     `ListObjectsInventoryFields()` to only fetch the name, size, and
+   *     generation of each object.
    *
    * @throw std::runtime_error if the operation cannot be completed using the
    *   current policies.
@@ -232,16 +242,47 @@ class Client {
                              std::forward<Options>(options)...);
   }
 
+  /**
+   * List the objects in a bucket using multiple concurrent requests.
+   *
+   * Discovers the "directories" in the bucket using the delimiter in
+   * @p parallel_options, and lists them concurrently. The result contains the
+   * same objects as `ListObjects()`, but for large buckets with many
+   * "directories" it can be much faster.
+   *
+   * @param bucket_name the name of the bucket to list.
+   * @param parallel_options control the concurrency, ordering, and delimiter.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `UserProject`, `Projection`,
+   *     `Prefix`, `MaxResults`, and `Fields`.
+   *
+   * @throw std::runtime_error if the operation cannot be completed using the
+   *   current policies.
+   */
+  template <typename... Options>
+  ParallelListObjectsReader ParallelListObjects(
+      std::string const& bucket_name,
+      ParallelListObjectsOptions const& parallel_options,
+      Options&&... options) {
+    return ParallelListObjectsReader(raw_client_, bucket_name,
+                                     parallel_options,
+                                     std::forward<Options>(options)...);
+  }
+
   /**
    * Read the contents of an object.
    *
    * @param bucket_name the name of the bucket that contains the object.
    * @param object_name the name of the object to be read.
    * @param options a list of optional query parameters and/or request headers.
-   *     Valid types for this operation include
-   *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     Valid types for this operation include `DisableCrc32cChecksum`,
+   *     `EnableGzipDecompression`, `EnableMD5Hash`, `IfGenerationMatch`,
+   *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
    *     `IfMetagenerationNotMatch`, `Generation`, and `UserProject`.
    *
+   * The CRC32C checksum of the data is validated when the download completes,
+   * see `ObjectReadStream::received_hash()` for details.
+   *
    * @par Example
    * @snippet storage_object_samples.cc read object
    */
@@ -254,15 +295,90 @@ class Client {
     return ObjectReadStream(raw_client_->ReadObject(request).second);
   }
 
+  /**
+   * Read an object with random access.
+   *
+   * The returned stream supports `seekg()` and `tellg()`, including seeks
+   * relative to the end of the object. Seeks within the buffered window do not
+   * make any requests, longer seeks start a new download at the new position.
+   * The stream detects the access pattern: sequential reads use a single
+   * download for the rest of the object, while scattered reads use small
+   * ranged downloads, as configured in @p access_options.
+   *
+   * The object metadata is fetched when the stream is created, and all the
+   * downloads use the generation it reports, so the object cannot change
+   * while it is read. The hashes are not validated.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be read.
+   * @param access_options control the buffer size and the access pattern
+   *     detection.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `IfGenerationMatch`,
+   *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `Generation`, and `UserProject`.
+   *
+   * @throw std::runtime_error if the metadata or any download fails.
+   */
+  template <typename... Options>
+  ObjectReadStream ReadObjectRandomAccess(
+      std::string const& bucket_name, std::string const& object_name,
+      RandomAccessOptions const& access_options, Options&&... options) {
+    internal::ReadObjectRangeRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return ObjectReadStream(internal::SeekableObjectReadStreambuf::Create(
+        raw_client_, std::move(request), access_options));
+  }
+
+  /**
+   * Read several ranges of an object into application buffers.
+   *
+   * Nearby ranges are read with a single request, as configured in
+   * @p range_options, and the remaining requests are made concurrently. This
+   * is useful to read file formats with an index, where the application
+   * needs many small, scattered, pieces of the object.
+   *
+   * All the ranges are read from the same generation of the object. If
+   * @p options does not include a `Generation` the first request is made
+   * before any others, to discover the current generation.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be read.
+   * @param ranges the ranges to read, on return the `bytes_read` field of each
+   *     range contains the number of bytes stored in its buffer.
+   * @param range_options control the concurrency and how ranges are merged.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `IfGenerationMatch`,
+   *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `Generation`, and `UserProject`.
+   *
+   * @throw std::runtime_error if any of the requests fails.
+   */
+  template <typename... Options>
+  void ReadRanges(std::string const& bucket_name,
+                  std::string const& object_name,
+                  std::vector<ReadRange>& ranges,
+                  ReadRangesOptions const& range_options,
+                  Options&&... options) {
+    internal::ReadObjectRangeRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    internal::ReadRanges(*raw_client_, std::move(request), ranges,
+                         range_options);
+  }
+
   /**
    * Write contents into an object.
    *
    * @param bucket_name the name of the bucket that contains the object.
    * @param object_name the name of the object to be read.
    * @param options a list of optional query parameters and/or request headers.
-   *   Valid types for this operation include `IfGenerationMatch`,
-   *   `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *   Valid types for this operation include `ContentEncoding`,
+   *   `DisableCrc32cChecksum`, `EnableGzipCompression`, `EnableMD5Hash`,
+   *   `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
    *   `IfMetagenerationNotMatch`, `Generation`, and `UserProject`.
+   *
+   * The CRC32C checksum of the data is validated when the stream is closed,
+   * see `ObjectWriteStream::received_hash()` for details.
    */
   template <typename... Options>
   ObjectWriteStream WriteObject(std::string const& bucket_name,
@@ -294,6 +410,139 @@ class Client {
     raw_client_->DeleteObject(request);
   }
 
+  /**
+   * Copy an object with a single request.
+   *
+   * The service rejects copies that cannot complete in a single request, e.g.
+   * large objects copied across locations or storage classes. Use
+   * `RewriteObject()` for those.
+   *
+   * @param source_bucket_name the bucket that contains the object to copy.
+   * @param source_object_name the object to copy.
+   * @param destination_bucket_name the bucket for the new object.
+   * @param destination_object_name the name of the new object.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `DestinationKmsKeyName`,
+   *     `DestinationPredefinedAcl`, `IfGenerationMatch`,
+   *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `IfSourceGenerationMatch`,
+   *     `IfSourceGenerationNotMatch`, `IfSourceMetagenerationMatch`,
+   *     `IfSourceMetagenerationNotMatch`, `Projection`, `SourceGeneration`,
+   *     and `UserProject`.
+   *
+   * @return the metadata of the new object.
+   */
+  template <typename... Options>
+  ObjectMetadata CopyObject(std::string const& source_bucket_name,
+                            std::string const& source_object_name,
+                            std::string const& destination_bucket_name,
+                            std::string const& destination_object_name,
+                            Options&&... options) {
+    internal::CopyObjectRequest request(source_bucket_name, source_object_name,
+                                        destination_bucket_name,
+                                        destination_object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return raw_client_->CopyObject(request).second;
+  }
+
+  /**
+   * Create an `ObjectRewriter` to copy the source object.
+   *
+   * Unlike `CopyObject()`, rewrites can copy objects of any size across
+   * locations, storage classes, and encryption keys. The rewrite may take
+   * several requests, the returned object makes no requests until the
+   * application calls `ObjectRewriter::Iterate()` or
+   * `ObjectRewriter::Result()`.
+   *
+   * @param source_bucket_name the bucket that contains the object to copy.
+   * @param source_object_name the object to copy.
+   * @param destination_bucket_name the bucket for the new object.
+   * @param destination_object_name the name of the new object.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include the types valid for
+   *     `CopyObject()` and `MaxBytesRewrittenPerCall`.
+   */
+  template <typename... Options>
+  ObjectRewriter RewriteObject(std::string const& source_bucket_name,
+                               std::string const& source_object_name,
+                               std::string const& destination_bucket_name,
+                               std::string const& destination_object_name,
+                               Options&&... options) {
+    return ResumeRewriteObject(source_bucket_name, source_object_name,
+                               destination_bucket_name, destination_object_name,
+                               std::string{},
+                               std::forward<Options>(options)...);
+  }
+
+  /**
+   * Create an `ObjectRewriter` to resume a previously started rewrite.
+   *
+   * @param rewrite_token the value of `ObjectRewriter::token()` saved from the
+   *     previous rewrite. The other parameters must match the previous
+   *     rewrite.
+   *
+   * @see `RewriteObject()` for the other parameters.
+   */
+  template <typename... Options>
+  ObjectRewriter ResumeRewriteObject(
+      std::string const& source_bucket_name,
+      std::string const& source_object_name,
+      std::string const& destination_bucket_name,
+      std::string const& destination_object_name,
+      std::string const& rewrite_token, Options&&... options) {
+    internal::RewriteObjectRequest request(
+        source_bucket_name, source_object_name, destination_bucket_name,
+        destination_object_name);
+    request.set_rewrite_token(rewrite_token);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return ObjectRewriter(raw_client_, std::move(request));
+  }
+
+  /**
+   * Rewrite an object, blocking until the rewrite completes.
+   *
+   * @see `RewriteObject()` for the parameters.
+   *
+   * @return the metadata of the new object.
+   * @throw std::runtime_error if any of the requests fails.
+   */
+  template <typename... Options>
+  ObjectMetadata RewriteObjectBlocking(
+      std::string const& source_bucket_name,
+      std::string const& source_object_name,
+      std::string const& destination_bucket_name,
+      std::string const& destination_object_name, Options&&... options) {
+    return RewriteObject(source_bucket_name, source_object_name,
+                         destination_bucket_name, destination_object_name,
+                         std::forward<Options>(options)...)
+        .Result();
+  }
+
+  /**
+   * Rewrite many objects, running several rewrites concurrently.
+   *
+   * This is useful to move or re-encrypt large numbers of objects, where the
+   * time is dominated by waiting on the service. Each rewrite runs to
+   * completion, the failure of one rewrite does not stop the others.
+   *
+   * @param entries the source and destination of each rewrite.
+   * @param rewrite_options control the concurrency and progress reporting.
+   * @param options a list of optional query parameters and/or request headers,
+   *     applied to every rewrite. Valid types for this operation include the
+   *     types valid for `RewriteObject()`.
+   *
+   * @return the result of each rewrite, in the same order as @p entries.
+   */
+  template <typename... Options>
+  std::vector<RewriteObjectsResult> RewriteObjects(
+      std::vector<RewriteObjectsEntry> const& entries,
+      RewriteObjectsOptions const& rewrite_options, Options&&... options) {
+    internal::RewriteObjectRequest prototype;
+    prototype.set_multiple_options(std::forward<Options>(options)...);
+    return internal::RewriteObjects(raw_client_, prototype, entries,
+                                    rewrite_options);
+  }
+
   /**
    * Retrieves the list of BucketAccessControls for a bucket.
    *
@@ -510,7 +759,27 @@ class Client {
     return raw_client_->PatchObjectAcl(request).second;
   }
 
+  /**
+   * Execute the operations in @p batch.
+   *
+   * The operations are sent in batch requests of up to 100 operations each.
+   * The result of each operation is delivered through the future returned
+   * when the operation was added to @p batch, an operation that fails does not
+   * stop the other operations.
+   *
+   * Batch requests are not retried, as some of the operations in a failed
+   * request may have completed. If a batch request fails, each of its
+   * operations reports that error. If the request cannot be made at all, the
+   * futures for all the remaining operations hold the exception.
+   *
+   * @param batch the operations to execute.
+   */
+  void ExecuteBatch(Batch batch);
+
  private:
+  static std::shared_ptr<internal::RawClient> CreateDefaultClient(
+      ClientOptions options);
+
   BucketMetadata GetBucketMetadataImpl(
       internal::GetBucketMetadataRequest const& request);
 
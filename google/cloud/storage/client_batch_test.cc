@@ -0,0 +1,256 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+namespace {
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::ReturnRef;
+using testing::canonical_errors::PermanentError;
+using testing::canonical_errors::TransientError;
+
+/**
+ * Test the batch functions in storage::Client.
+ */
+class BatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mock = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*mock, client_options())
+        .WillRepeatedly(ReturnRef(client_options));
+    client.reset(new Client{std::shared_ptr<internal::RawClient>(mock)});
+  }
+  void TearDown() override {
+    client.reset();
+    mock.reset();
+  }
+
+  std::shared_ptr<testing::MockClient> mock;
+  std::unique_ptr<Client> client;
+  ClientOptions client_options = ClientOptions(CreateInsecureCredentials());
+};
+
+TEST_F(BatchTest, DeleteAndPatch) {
+  Batch batch;
+  auto delete_result =
+      batch.DeleteObject("test-bucket", "test-object-1", Generation(42));
+  auto missing_result = batch.DeleteObject("test-bucket", "test-object-2");
+  auto patch_result = batch.PatchObjectAcl(
+      "test-bucket", "test-object-3", "user-test-user",
+      ObjectAccessControlPatchBuilder().set_role("READER"));
+  EXPECT_EQ(3U, batch.size());
+
+  EXPECT_CALL(*mock, ExecuteBatch(_))
+      .WillOnce(Invoke([](internal::BatchRequest const& r) {
+        EXPECT_EQ(3U, r.size());
+        auto const& ops = r.operations();
+        EXPECT_EQ("DELETE", ops[0].method);
+        EXPECT_EQ("/b/test-bucket/o/test-object-1?generation=42",
+                  ops[0].target);
+        EXPECT_EQ("PATCH", ops[2].method);
+        EXPECT_EQ("/b/test-bucket/o/test-object-3/acl/user-test-user",
+                  ops[2].target);
+        EXPECT_EQ(R"""({"role":"READER"})""", ops[2].payload);
+
+        internal::BatchResponse response;
+        response.responses.emplace(1, internal::HttpResponse{204, "", {}});
+        response.responses.emplace(
+            2, internal::HttpResponse{404, "not found", {}});
+        response.responses.emplace(3, internal::HttpResponse{
+            200,
+            R"""({"entity": "user-test-user", "role": "READER"})""",
+            {}});
+        return std::make_pair(Status(), response);
+      }));
+  client->ExecuteBatch(std::move(batch));
+
+  EXPECT_TRUE(delete_result.get().ok());
+  auto missing = missing_result.get();
+  EXPECT_EQ(404, missing.status_code());
+  EXPECT_EQ("not found", missing.error_message());
+  auto patch = patch_result.get();
+  EXPECT_TRUE(patch.first.ok());
+  EXPECT_EQ("user-test-user", patch.second.entity());
+  EXPECT_EQ("READER", patch.second.role());
+}
+
+/// @test Verify that large batches are split into multiple requests.
+TEST_F(BatchTest, SplitLargeBatch) {
+  Batch batch;
+  std::vector<std::future<Status>> results;
+  for (int i = 0; i != 250; ++i) {
+    results.emplace_back(
+        batch.DeleteObject("test-bucket", "object-" + std::to_string(i)));
+  }
+
+  std::vector<std::size_t> sizes;
+  EXPECT_CALL(*mock, ExecuteBatch(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([&sizes](internal::BatchRequest const& r) {
+        sizes.push_back(r.size());
+        internal::BatchResponse response;
+        for (std::size_t id = 1; id <= r.size(); ++id) {
+          response.responses.emplace(id, internal::HttpResponse{204, "", {}});
+        }
+        return std::make_pair(Status(), response);
+      }));
+  client->ExecuteBatch(std::move(batch));
+
+  EXPECT_THAT(sizes, ::testing::ElementsAre(100U, 100U, 50U));
+  for (auto& r : results) {
+    EXPECT_TRUE(r.get().ok());
+  }
+}
+
+/// @test Verify that missing responses are reported as errors.
+TEST_F(BatchTest, MissingResponses) {
+  Batch batch;
+  auto r0 = batch.DeleteObject("test-bucket", "test-object-1");
+  auto r1 = batch.DeleteObjectAcl("test-bucket", "test-object-2", "user-x");
+
+  EXPECT_CALL(*mock, ExecuteBatch(_))
+      .WillOnce(Invoke([](internal::BatchRequest const& r) {
+        EXPECT_EQ("/b/test-bucket/o/test-object-2/acl/user-x",
+                  r.operations()[1].target);
+        internal::BatchResponse response;
+        response.responses.emplace(1, internal::HttpResponse{204, "", {}});
+        return std::make_pair(Status(), response);
+      }));
+  client->ExecuteBatch(std::move(batch));
+
+  EXPECT_TRUE(r0.get().ok());
+  EXPECT_FALSE(r1.get().ok());
+}
+
+/// @test Verify that a missing response does not shift the other responses.
+TEST_F(BatchTest, MissingMiddleResponse) {
+  Batch batch;
+  auto r0 = batch.DeleteObject("test-bucket", "test-object-1");
+  auto r1 = batch.DeleteObject("test-bucket", "test-object-2");
+  auto r2 = batch.DeleteObject("test-bucket", "test-object-3");
+
+  EXPECT_CALL(*mock, ExecuteBatch(_))
+      .WillOnce(Invoke([](internal::BatchRequest const&) {
+        internal::BatchResponse response;
+        response.responses.emplace(1, internal::HttpResponse{204, "", {}});
+        response.responses.emplace(
+            3, internal::HttpResponse{404, "not found", {}});
+        return std::make_pair(Status(), response);
+      }));
+  client->ExecuteBatch(std::move(batch));
+
+  EXPECT_TRUE(r0.get().ok());
+  EXPECT_EQ(500, r1.get().status_code());
+  auto status = r2.get();
+  EXPECT_EQ(404, status.status_code());
+  EXPECT_EQ("not found", status.error_message());
+}
+
+/// @test Verify that batch requests are not retried.
+TEST_F(BatchTest, TransientFailure) {
+  Batch batch;
+  auto r0 = batch.DeleteObject("test-bucket", "test-object-1");
+  auto r1 = batch.PatchObjectAcl(
+      "test-bucket", "test-object-2", "user-test-user",
+      ObjectAccessControlPatchBuilder().set_role("READER"));
+  EXPECT_CALL(*mock, ExecuteBatch(_))
+      .WillOnce(
+          Return(std::make_pair(TransientError(), internal::BatchResponse{})));
+  client->ExecuteBatch(std::move(batch));
+
+  EXPECT_EQ(TransientError().status_code(), r0.get().status_code());
+  EXPECT_EQ(TransientError().status_code(), r1.get().first.status_code());
+}
+
+TEST_F(BatchTest, PermanentFailure) {
+  Batch batch;
+  auto result = batch.DeleteObject("test-bucket", "test-object");
+  EXPECT_CALL(*mock, ExecuteBatch(_))
+      .WillOnce(
+          Return(std::make_pair(PermanentError(), internal::BatchResponse{})));
+  client->ExecuteBatch(std::move(batch));
+
+  auto status = result.get();
+  EXPECT_EQ(PermanentError().status_code(), status.status_code());
+  EXPECT_EQ(PermanentError().error_message(), status.error_message());
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that an exception is delivered to all the remaining operations.
+TEST_F(BatchTest, ExceptionInRequest) {
+  Batch batch;
+  std::vector<std::future<Status>> results;
+  for (int i = 0; i != 150; ++i) {
+    results.emplace_back(
+        batch.DeleteObject("test-bucket", "object-" + std::to_string(i)));
+  }
+
+  EXPECT_CALL(*mock, ExecuteBatch(_))
+      .WillOnce(Invoke([](internal::BatchRequest const& r) {
+        internal::BatchResponse response;
+        for (std::size_t id = 1; id <= r.size(); ++id) {
+          response.responses.emplace(id, internal::HttpResponse{204, "", {}});
+        }
+        return std::make_pair(Status(), response);
+      }))
+      .WillOnce(Invoke([](internal::BatchRequest const&)
+                           -> std::pair<Status, internal::BatchResponse> {
+        throw std::runtime_error("connection reset");
+      }));
+  EXPECT_NO_THROW(client->ExecuteBatch(std::move(batch)));
+
+  for (int i = 0; i != 100; ++i) {
+    EXPECT_TRUE(results[i].get().ok());
+  }
+  for (int i = 100; i != 150; ++i) {
+    EXPECT_THROW(results[i].get(), std::runtime_error);
+  }
+}
+
+/// @test Verify that a response that cannot be parsed does not affect others.
+TEST_F(BatchTest, ExceptionInCompletion) {
+  Batch batch;
+  auto r0 = batch.PatchObjectAcl(
+      "test-bucket", "test-object-1", "user-test-user",
+      ObjectAccessControlPatchBuilder().set_role("READER"));
+  auto r1 = batch.DeleteObject("test-bucket", "test-object-2");
+
+  EXPECT_CALL(*mock, ExecuteBatch(_))
+      .WillOnce(Invoke([](internal::BatchRequest const&) {
+        internal::BatchResponse response;
+        response.responses.emplace(
+            1, internal::HttpResponse{200, "not-json{", {}});
+        response.responses.emplace(2, internal::HttpResponse{204, "", {}});
+        return std::make_pair(Status(), response);
+      }));
+  client->ExecuteBatch(std::move(batch));
+
+  EXPECT_THROW(r0.get(), std::exception);
+  EXPECT_TRUE(r1.get().ok());
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+}  // namespace
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
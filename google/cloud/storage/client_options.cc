@@ -18,6 +18,35 @@
 #include <set>
 #include <sstream>
 
+// Define the defaults using a pre-processor macro, this allows the application
+// developers to change the defaults for their application by compiling with
+// different values.
+#ifndef STORAGE_CLIENT_DEFAULT_OBJECT_METADATA_CACHE_TTL
+#define STORAGE_CLIENT_DEFAULT_OBJECT_METADATA_CACHE_TTL \
+  std::chrono::seconds(10)
+#endif  // STORAGE_CLIENT_DEFAULT_OBJECT_METADATA_CACHE_TTL
+
+#ifndef STORAGE_CLIENT_DEFAULT_OBJECT_DISK_CACHE_MAX_SIZE
+#define STORAGE_CLIENT_DEFAULT_OBJECT_DISK_CACHE_MAX_SIZE \
+  (std::int64_t(1) << 30)
+#endif  // STORAGE_CLIENT_DEFAULT_OBJECT_DISK_CACHE_MAX_SIZE
+
+#ifndef STORAGE_CLIENT_DEFAULT_UPLOAD_PIPELINE_DEPTH
+#define STORAGE_CLIENT_DEFAULT_UPLOAD_PIPELINE_DEPTH 4
+#endif  // STORAGE_CLIENT_DEFAULT_UPLOAD_PIPELINE_DEPTH
+
+#ifndef STORAGE_CLIENT_DEFAULT_DOWNLOAD_READ_AHEAD
+#define STORAGE_CLIENT_DEFAULT_DOWNLOAD_READ_AHEAD 0
+#endif  // STORAGE_CLIENT_DEFAULT_DOWNLOAD_READ_AHEAD
+
+#ifndef STORAGE_CLIENT_DEFAULT_DOWNLOAD_STALL_TIMEOUT
+#define STORAGE_CLIENT_DEFAULT_DOWNLOAD_STALL_TIMEOUT std::chrono::minutes(2)
+#endif  // STORAGE_CLIENT_DEFAULT_DOWNLOAD_STALL_TIMEOUT
+
+#ifndef STORAGE_CLIENT_DEFAULT_DOWNLOAD_STALL_MINIMUM_RATE
+#define STORAGE_CLIENT_DEFAULT_DOWNLOAD_STALL_MINIMUM_RATE 1
+#endif  // STORAGE_CLIENT_DEFAULT_DOWNLOAD_STALL_MINIMUM_RATE
+
 namespace google {
 namespace cloud {
 namespace storage {
@@ -41,7 +70,19 @@ ClientOptions::ClientOptions(std::shared_ptr<Credentials> credentials)
       endpoint_("https://www.googleapis.com"),
       version_("v1"),
       enable_http_tracing_(false),
-      enable_raw_client_tracing_(false) {
+      enable_raw_client_tracing_(false),
+      object_metadata_cache_size_(0),
+      object_metadata_cache_ttl_(
+          STORAGE_CLIENT_DEFAULT_OBJECT_METADATA_CACHE_TTL),
+      object_disk_cache_max_size_(
+          STORAGE_CLIENT_DEFAULT_OBJECT_DISK_CACHE_MAX_SIZE),
+      upload_pipeline_depth_(STORAGE_CLIENT_DEFAULT_UPLOAD_PIPELINE_DEPTH),
+      download_read_ahead_(STORAGE_CLIENT_DEFAULT_DOWNLOAD_READ_AHEAD),
+      download_first_byte_timeout_(0),
+      download_stall_timeout_(STORAGE_CLIENT_DEFAULT_DOWNLOAD_STALL_TIMEOUT),
+      download_stall_minimum_rate_(
+          STORAGE_CLIENT_DEFAULT_DOWNLOAD_STALL_MINIMUM_RATE),
+      download_hedge_percentile_(0) {
   char const* emulator = std::getenv("CLOUD_STORAGE_TESTBENCH_ENDPOINT");
   if (emulator != nullptr) {
     endpoint_ = emulator;
@@ -15,7 +15,10 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_OPTIONS_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_OPTIONS_H_
 
+#include "google/cloud/rpc_metrics.h"
 #include "google/cloud/storage/credentials.h"
+#include <chrono>
+#include <cstdint>
 
 namespace google {
 namespace cloud {
@@ -77,6 +80,155 @@ class ClientOptions {
     return *this;
   }
 
+  /**
+   * Report the latency and outcome of each request to @p metrics.
+   *
+   * By default no measurements are collected, and there is no overhead.
+   */
+  std::shared_ptr<google::cloud::RpcMetrics> rpc_metrics() const {
+    return rpc_metrics_;
+  }
+  ClientOptions& set_rpc_metrics(
+      std::shared_ptr<google::cloud::RpcMetrics> metrics) {
+    rpc_metrics_ = std::move(metrics);
+    return *this;
+  }
+
+  /**
+   * Cache up to @p size results of `GetObjectMetadata()`.
+   *
+   * The cache is disabled (the size is 0) by default. Cached values are used
+   * without contacting the service for `object_metadata_cache_ttl()`, after
+   * that they are revalidated with a conditional request. Changes to an object
+   * made through the same client invalidate its cached values.
+   */
+  std::size_t object_metadata_cache_size() const {
+    return object_metadata_cache_size_;
+  }
+  ClientOptions& set_object_metadata_cache_size(std::size_t size) {
+    object_metadata_cache_size_ = size;
+    return *this;
+  }
+
+  std::chrono::milliseconds object_metadata_cache_ttl() const {
+    return object_metadata_cache_ttl_;
+  }
+  ClientOptions& set_object_metadata_cache_ttl(std::chrono::milliseconds ttl) {
+    object_metadata_cache_ttl_ = ttl;
+    return *this;
+  }
+
+  /**
+   * Cache the contents of downloaded objects in @p directory.
+   *
+   * The cache is disabled (the directory is empty) by default. Entries are
+   * keyed by the object generation, so they never become stale. The least
+   * recently used entries are removed once the total size of the cached files
+   * exceeds `object_disk_cache_max_size()`. Use
+   * `ObjectReadStream::cache_hit()` to find out if a download was served from
+   * the cache.
+   */
+  std::string const& object_disk_cache_directory() const {
+    return object_disk_cache_directory_;
+  }
+  ClientOptions& set_object_disk_cache_directory(std::string directory) {
+    object_disk_cache_directory_ = std::move(directory);
+    return *this;
+  }
+
+  std::int64_t object_disk_cache_max_size() const {
+    return object_disk_cache_max_size_;
+  }
+  ClientOptions& set_object_disk_cache_max_size(std::int64_t size) {
+    object_disk_cache_max_size_ = size;
+    return *this;
+  }
+
+  /**
+   * The number of buffers queued by `WriteObject()` streams.
+   *
+   * The buffers are sent by a background thread, the application only blocks
+   * once all of them are waiting to be sent. Each buffer uses about 128KiB.
+   */
+  std::size_t upload_pipeline_depth() const { return upload_pipeline_depth_; }
+  ClientOptions& set_upload_pipeline_depth(std::size_t depth) {
+    upload_pipeline_depth_ = depth;
+    return *this;
+  }
+
+  /**
+   * The number of buffers received ahead of the application in `ReadObject()`.
+   *
+   * Read-ahead is disabled (the value is 0) by default, and the data is only
+   * received while the application reads from the stream. If enabled, a
+   * background thread keeps receiving data while the application processes
+   * each buffer. Each buffer uses about 128KiB.
+   */
+  std::size_t download_read_ahead() const { return download_read_ahead_; }
+  ClientOptions& set_download_read_ahead(std::size_t buffers) {
+    download_read_ahead_ = buffers;
+    return *this;
+  }
+
+  /**
+   * Abort downloads that receive no response within this time.
+   *
+   * The check is disabled (the value is 0) by default. Aborted downloads are
+   * reported as transient errors, and restarted on a new connection by the
+   * retry policy.
+   */
+  std::chrono::milliseconds download_first_byte_timeout() const {
+    return download_first_byte_timeout_;
+  }
+  ClientOptions& set_download_first_byte_timeout(
+      std::chrono::milliseconds timeout) {
+    download_first_byte_timeout_ = timeout;
+    return *this;
+  }
+
+  /**
+   * Abort downloads that receive too little data over this time.
+   *
+   * The throughput is only measured while the application waits for data, a
+   * download is stalled if it receives less than
+   * `download_stall_minimum_rate()` bytes per second over this period. A zero
+   * value disables the check. Like downloads aborted by
+   * `download_first_byte_timeout()`, the download is restarted on a new
+   * connection by the retry policy.
+   */
+  std::chrono::milliseconds download_stall_timeout() const {
+    return download_stall_timeout_;
+  }
+  ClientOptions& set_download_stall_timeout(std::chrono::milliseconds timeout) {
+    download_stall_timeout_ = timeout;
+    return *this;
+  }
+
+  std::int64_t download_stall_minimum_rate() const {
+    return download_stall_minimum_rate_;
+  }
+  ClientOptions& set_download_stall_minimum_rate(std::int64_t rate) {
+    download_stall_minimum_rate_ = rate;
+    return *this;
+  }
+
+  /**
+   * Send a duplicate request for slow downloads.
+   *
+   * If set, the client keeps track of the time to receive the first byte of
+   * recent downloads. A download that takes longer than this percentile of
+   * the recent values (e.g. 0.95 for the 95th percentile) starts a second,
+   * identical, request, and the data is read from whichever request responds
+   * first. Hedging is disabled (the value is 0) by default.
+   */
+  double download_hedge_percentile() const {
+    return download_hedge_percentile_;
+  }
+  ClientOptions& set_download_hedge_percentile(double percentile) {
+    download_hedge_percentile_ = percentile;
+    return *this;
+  }
+
  private:
   void SetupFromEnvironment();
 
@@ -87,6 +239,17 @@ class ClientOptions {
   bool enable_http_tracing_;
   bool enable_raw_client_tracing_;
   std::string project_id_;
+  std::shared_ptr<google::cloud::RpcMetrics> rpc_metrics_;
+  std::size_t object_metadata_cache_size_;
+  std::chrono::milliseconds object_metadata_cache_ttl_;
+  std::string object_disk_cache_directory_;
+  std::int64_t object_disk_cache_max_size_;
+  std::size_t upload_pipeline_depth_;
+  std::size_t download_read_ahead_;
+  std::chrono::milliseconds download_first_byte_timeout_;
+  std::chrono::milliseconds download_stall_timeout_;
+  std::int64_t download_stall_minimum_rate_;
+  double download_hedge_percentile_;
 };
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
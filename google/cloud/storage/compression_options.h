@@ -0,0 +1,60 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_COMPRESSION_OPTIONS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_COMPRESSION_OPTIONS_H_
+
+#include "google/cloud/storage/internal/complex_option.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * Compress the data in `WriteObject()` using gzip.
+ *
+ * The data is compressed as it is written to the stream, and the object is
+ * created with `contentEncoding` set to `gzip` (unless the application sets a
+ * different `ContentEncoding`). The service decompresses the object for any
+ * clients that do not accept gzip-encoded data.
+ *
+ * Note that the object size, and the object hashes, are computed over the
+ * compressed data.
+ */
+struct EnableGzipCompression
+    : public internal::ComplexOption<EnableGzipCompression, bool> {
+  using internal::ComplexOption<EnableGzipCompression, bool>::ComplexOption;
+  static char const* name() { return "enable-gzip-compression"; }
+};
+
+/**
+ * Download gzip-encoded objects in compressed form and decompress them locally.
+ *
+ * With this option `ReadObject()` sends the `Accept-Encoding: gzip` header. If
+ * the object is stored with `contentEncoding: gzip` the service sends the
+ * compressed data, and the client library decompresses it as it is read.
+ * Other objects are not affected.
+ */
+struct EnableGzipDecompression
+    : public internal::ComplexOption<EnableGzipDecompression, bool> {
+  using internal::ComplexOption<EnableGzipDecompression, bool>::ComplexOption;
+  static char const* name() { return "enable-gzip-decompression"; }
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_COMPRESSION_OPTIONS_H_
@@ -0,0 +1,56 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_HASHING_OPTIONS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_HASHING_OPTIONS_H_
+
+#include "google/cloud/storage/internal/complex_option.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * Disable the CRC32C checksum validation in `ReadObject()` and `WriteObject()`.
+ *
+ * By default the client library computes the CRC32C checksum of the data as it
+ * is uploaded or downloaded, and compares it against the checksum reported by
+ * the service when the transfer completes. Applications that validate the data
+ * by other means can disable this computation, e.g.
+ * `DisableCrc32cChecksum(true)`.
+ */
+struct DisableCrc32cChecksum
+    : public internal::ComplexOption<DisableCrc32cChecksum, bool> {
+  using internal::ComplexOption<DisableCrc32cChecksum, bool>::ComplexOption;
+  static char const* name() { return "disable-crc32c-checksum"; }
+};
+
+/**
+ * Enable the MD5 hash validation in `ReadObject()` and `WriteObject()`.
+ *
+ * Computing MD5 hashes is much slower than computing CRC32C checksums, and the
+ * service does not report an MD5 hash for composite objects, so this
+ * validation is disabled by default. Use `EnableMD5Hash(true)` to enable it.
+ */
+struct EnableMD5Hash : public internal::ComplexOption<EnableMD5Hash, bool> {
+  using internal::ComplexOption<EnableMD5Hash, bool>::ComplexOption;
+  static char const* name() { return "enable-md5-hash"; }
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_HASHING_OPTIONS_H_
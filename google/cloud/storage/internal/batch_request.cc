@@ -0,0 +1,298 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/batch_request.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+/**
+ * Read one line from @p text starting at @p pos.
+ *
+ * The multipart payloads should use CRLF line terminators, but we also accept
+ * LF, the trailing CR (if any) is not included in the result.
+ */
+std::string ReadLine(std::string const& text, std::string::size_type& pos) {
+  auto end = text.find('\n', pos);
+  if (end == std::string::npos) {
+    end = text.size();
+  }
+  auto line = text.substr(pos, end - pos);
+  pos = end == text.size() ? end : end + 1;
+  if (not line.empty() and line.back() == '\r') {
+    line.pop_back();
+  }
+  return line;
+}
+
+/// Read a block of headers, up to and including the empty line after them.
+std::multimap<std::string, std::string> ReadHeaders(
+    std::string const& text, std::string::size_type& pos) {
+  std::multimap<std::string, std::string> headers;
+  while (pos < text.size()) {
+    auto line = ReadLine(text, pos);
+    if (line.empty()) {
+      break;
+    }
+    auto separator = line.find(':');
+    if (separator == std::string::npos) {
+      google::cloud::internal::RaiseRuntimeError(
+          "BatchResponse - invalid header <" + line + ">");
+    }
+    auto name = line.substr(0, separator);
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](char x) { return std::tolower(x); });
+    auto value_begin = line.find_first_not_of(' ', separator + 1);
+    auto value = value_begin == std::string::npos ? std::string{}
+                                                  : line.substr(value_begin);
+    headers.emplace(std::move(name), std::move(value));
+  }
+  return headers;
+}
+
+/**
+ * Extract the operation number from a `Content-ID` header.
+ *
+ * The service echoes the `Content-ID` of each operation, with a "response-"
+ * prefix, i.e., `<1>` in the request becomes `<response-1>`.
+ *
+ * @return the operation number, or 0 if it cannot be determined.
+ */
+std::size_t ParseContentId(std::multimap<std::string, std::string> const& h) {
+  auto loc = h.find("content-id");
+  if (loc == h.end()) {
+    return 0;
+  }
+  auto const& id = loc->second;
+  auto end = id.find_last_of("0123456789");
+  if (end == std::string::npos) {
+    return 0;
+  }
+  auto begin = id.find_last_not_of("0123456789", end);
+  begin = begin == std::string::npos ? 0 : begin + 1;
+  return static_cast<std::size_t>(
+      std::strtoul(id.substr(begin, end - begin + 1).c_str(), nullptr, 10));
+}
+
+/// Parse one part of the payload, i.e., an embedded HTTP response.
+std::pair<std::size_t, HttpResponse> ParsePart(std::string const& part) {
+  std::string::size_type pos = 0;
+  auto part_headers = ReadHeaders(part, pos);
+  auto status_line = ReadLine(part, pos);
+  // The status line is "HTTP/1.1 <code> <reason>".
+  auto code_begin = status_line.find(' ');
+  if (status_line.compare(0, 5, "HTTP/") != 0 or
+      code_begin == std::string::npos) {
+    google::cloud::internal::RaiseRuntimeError(
+        "BatchResponse - invalid status line <" + status_line + ">");
+  }
+  HttpResponse response;
+  response.status_code =
+      std::strtol(status_line.c_str() + code_begin + 1, nullptr, 10);
+  if (response.status_code == 0) {
+    google::cloud::internal::RaiseRuntimeError(
+        "BatchResponse - invalid status line <" + status_line + ">");
+  }
+  response.headers = ReadHeaders(part, pos);
+  response.payload = part.substr(pos);
+  return std::make_pair(ParseContentId(part_headers), std::move(response));
+}
+}  // namespace
+
+std::size_t constexpr BatchRequest::MAX_OPERATIONS;
+
+BatchOperationBuilder::BatchOperationBuilder(std::string method,
+                                             std::vector<std::string> path)
+    : query_parameter_separator_("?") {
+  operation_.method = std::move(method);
+  for (auto const& segment : path) {
+    operation_.target += '/';
+    AppendEscaped(segment);
+  }
+}
+
+BatchOperation BatchOperationBuilder::Build(std::string payload) {
+  operation_.payload = std::move(payload);
+  return std::move(operation_);
+}
+
+BatchOperationBuilder& BatchOperationBuilder::AddHeader(std::string header) {
+  operation_.headers.emplace_back(std::move(header));
+  return *this;
+}
+
+BatchOperationBuilder& BatchOperationBuilder::AddQueryParameter(
+    std::string const& key, std::string const& value) {
+  operation_.target += query_parameter_separator_;
+  AppendEscaped(key);
+  operation_.target += '=';
+  AppendEscaped(value);
+  query_parameter_separator_ = "&";
+  return *this;
+}
+
+void BatchOperationBuilder::AppendEscaped(std::string const& s) {
+  operation_.target += handle_.MakeEscapedString(s).get();
+}
+
+void BatchRequest::AddOperation(BatchOperation operation) {
+  if (operations_.size() >= MAX_OPERATIONS) {
+    google::cloud::internal::RaiseInvalidArgument(
+        "BatchRequest::AddOperation - too many operations in a batch");
+  }
+  operations_.emplace_back(std::move(operation));
+}
+
+std::string BatchRequest::FormatPayload(std::string const& boundary,
+                                        std::string const& path_prefix) const {
+  std::string payload;
+  std::size_t id = 0;
+  for (auto const& op : operations_) {
+    payload += "--" + boundary + "\r\n";
+    payload += "Content-Type: application/http\r\n";
+    payload += "Content-ID: <" + std::to_string(++id) + ">\r\n\r\n";
+    payload += op.method + " " + path_prefix + op.target + " HTTP/1.1\r\n";
+    for (auto const& header : op.headers) {
+      payload += header + "\r\n";
+    }
+    if (not op.payload.empty()) {
+      payload += "Content-Length: " + std::to_string(op.payload.size());
+      payload += "\r\n";
+    }
+    payload += "\r\n";
+    payload += op.payload;
+    payload += "\r\n";
+  }
+  payload += "--" + boundary + "--\r\n";
+  return payload;
+}
+
+std::ostream& operator<<(std::ostream& os, BatchRequest const& r) {
+  os << "BatchRequest={operations={";
+  char const* sep = "";
+  for (auto const& op : r.operations()) {
+    os << sep << op.method << " " << op.target;
+    sep = ", ";
+  }
+  return os << "}}";
+}
+
+BatchResponse BatchResponse::ParsePayload(std::string const& payload,
+                                          std::string const& boundary) {
+  auto const delimiter = "--" + boundary;
+  // The delimiter must start a line, the line terminator before it is part of
+  // the delimiter, and not of the previous part.
+  auto find_delimiter = [&payload, &delimiter](std::string::size_type pos) {
+    for (auto loc = payload.find(delimiter, pos); loc != std::string::npos;
+         loc = payload.find(delimiter, loc + 1)) {
+      if (loc == 0 or payload[loc - 1] == '\n') {
+        return loc;
+      }
+    }
+    return std::string::npos;
+  };
+
+  std::vector<std::pair<std::size_t, HttpResponse>> parts;
+  auto loc = find_delimiter(0);
+  while (loc != std::string::npos) {
+    auto pos = loc + delimiter.size();
+    if (payload.compare(pos, 2, "--") == 0) {
+      break;
+    }
+    ReadLine(payload, pos);
+    auto next = find_delimiter(pos);
+    if (next == std::string::npos) {
+      google::cloud::internal::RaiseRuntimeError(
+          "BatchResponse::ParsePayload - missing closing delimiter");
+    }
+    auto end = next;
+    if (end > pos and payload[end - 1] == '\n') {
+      --end;
+    }
+    if (end > pos and payload[end - 1] == '\r') {
+      --end;
+    }
+    parts.emplace_back(ParsePart(payload.substr(pos, end - pos)));
+    loc = next;
+  }
+  if (loc == std::string::npos) {
+    google::cloud::internal::RaiseRuntimeError(
+        "BatchResponse::ParsePayload - missing closing delimiter");
+  }
+
+  // Only number the parts by position if none of them has a Content-ID. If
+  // some do, guessing the operation for the others could deliver a response
+  // to the wrong operation.
+  bool has_ids = std::any_of(
+      parts.begin(), parts.end(),
+      [](std::pair<std::size_t, HttpResponse> const& p) { return p.first; });
+  BatchResponse result;
+  std::size_t position = 0;
+  for (auto& p : parts) {
+    auto id = has_ids ? p.first : ++position;
+    if (id == 0) {
+      continue;
+    }
+    result.responses.emplace(id, std::move(p.second));
+  }
+  return result;
+}
+
+BatchResponse BatchResponse::FromHttpResponse(HttpResponse const& response) {
+  auto loc = response.headers.find("content-type");
+  if (loc == response.headers.end() or
+      loc->second.compare(0, 15, "multipart/mixed") != 0) {
+    google::cloud::internal::RaiseRuntimeError(
+        "BatchResponse::FromHttpResponse - expected multipart/mixed payload");
+  }
+  auto const& content_type = loc->second;
+  auto pos = content_type.find("boundary=");
+  if (pos == std::string::npos) {
+    google::cloud::internal::RaiseRuntimeError(
+        "BatchResponse::FromHttpResponse - missing boundary in content type");
+  }
+  auto boundary = content_type.substr(pos + 9);
+  boundary = boundary.substr(0, boundary.find(';'));
+  if (boundary.size() >= 2 and boundary.front() == '"' and
+      boundary.back() == '"') {
+    boundary = boundary.substr(1, boundary.size() - 2);
+  }
+  return ParsePayload(response.payload, boundary);
+}
+
+std::ostream& operator<<(std::ostream& os, BatchResponse const& r) {
+  os << "BatchResponse={responses={";
+  char const* sep = "";
+  for (auto const& kv : r.responses) {
+    os << sep << "{id=" << kv.first
+       << ", status_code=" << kv.second.status_code
+       << ", payload=" << kv.second.payload << "}";
+    sep = ", ";
+  }
+  return os << "}}";
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,197 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUEST_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUEST_H_
+
+#include "google/cloud/storage/internal/complex_option.h"
+#include "google/cloud/storage/internal/curl_handle.h"
+#include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/well_known_headers.h"
+#include "google/cloud/storage/well_known_parameters.h"
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * One operation in a batch request, formatted as an embedded HTTP request.
+ */
+struct BatchOperation {
+  std::string method;
+  /// The path, relative to the storage endpoint, and the query string.
+  std::string target;
+  std::vector<std::string> headers;
+  std::string payload;
+};
+
+/**
+ * Implement the Builder pattern for `BatchOperation`.
+ *
+ * This class has the same `AddOption()` member functions as
+ * `CurlRequestBuilder`, so the `*Request` classes can add their optional query
+ * parameters and headers to an operation in a batch.
+ */
+class BatchOperationBuilder {
+ public:
+  /**
+   * Start building an operation.
+   *
+   * @param method the http method, e.g. "DELETE".
+   * @param path the path segments relative to the storage endpoint, e.g.
+   *     `{"b", bucket_name, "o", object_name}`, each segment is escaped.
+   */
+  BatchOperationBuilder(std::string method, std::vector<std::string> path);
+
+  /// Create the operation with the given payload.
+  BatchOperation Build(std::string payload);
+
+  /// Add one of the well-known parameters as a query parameter
+  template <typename P>
+  BatchOperationBuilder& AddOption(
+      WellKnownParameter<P, std::string> const& p) {
+    if (p.has_value()) {
+      AddQueryParameter(p.parameter_name(), p.value());
+    }
+    return *this;
+  }
+
+  /// Add one of the well-known parameters as a query parameter
+  template <typename P>
+  BatchOperationBuilder& AddOption(
+      WellKnownParameter<P, std::int64_t> const& p) {
+    if (p.has_value()) {
+      AddQueryParameter(p.parameter_name(), std::to_string(p.value()));
+    }
+    return *this;
+  }
+
+  /// Add one of the well-known headers to the request.
+  template <typename P>
+  BatchOperationBuilder& AddOption(WellKnownHeader<P, std::string> const& p) {
+    if (p.has_value()) {
+      AddHeader(std::string(p.header_name()) + ": " + p.value());
+    }
+    return *this;
+  }
+
+  /// Ignore options that are not sent to the service.
+  template <typename P, typename T>
+  BatchOperationBuilder& AddOption(ComplexOption<P, T> const&) {
+    return *this;
+  }
+
+  BatchOperationBuilder& AddHeader(std::string header);
+  BatchOperationBuilder& AddQueryParameter(std::string const& key,
+                                           std::string const& value);
+
+ private:
+  void AppendEscaped(std::string const& s);
+
+  CurlHandle handle_;
+  BatchOperation operation_;
+  char const* query_parameter_separator_;
+};
+
+/**
+ * A request to execute several operations in a single HTTP request.
+ *
+ * GCS accepts up to 100 operations in each batch request. The operations are
+ * sent as the parts of a `multipart/mixed` payload, and the results are
+ * returned in the same format.
+ */
+class BatchRequest {
+ public:
+  /// The maximum number of operations in a single batch request.
+  static std::size_t constexpr MAX_OPERATIONS = 100;
+
+  BatchRequest() = default;
+
+  /**
+   * Add an operation to the batch.
+   *
+   * @throw std::invalid_argument if the batch already has `MAX_OPERATIONS`
+   *     operations.
+   */
+  void AddOperation(BatchOperation operation);
+
+  std::vector<BatchOperation> const& operations() const { return operations_; }
+  std::size_t size() const { return operations_.size(); }
+  bool empty() const { return operations_.empty(); }
+
+  /**
+   * Format the `multipart/mixed` payload for the batch.
+   *
+   * @param boundary the delimiter for the parts, it must not appear in any of
+   *     the operations.
+   * @param path_prefix the path of the storage endpoint, e.g. "/storage/v1",
+   *     prepended to the target of each operation.
+   */
+  std::string FormatPayload(std::string const& boundary,
+                            std::string const& path_prefix) const;
+
+ private:
+  std::vector<BatchOperation> operations_;
+};
+
+std::ostream& operator<<(std::ostream& os, BatchRequest const& r);
+
+/**
+ * The results of a batch request, one `HttpResponse` per operation.
+ */
+struct BatchResponse {
+  /**
+   * Parse a `multipart/mixed` payload.
+   *
+   * Each part is stored under the operation number in its `Content-ID` header.
+   * If none of the parts have a `Content-ID` they are numbered in the order
+   * received. Otherwise the parts without one are discarded, as are repeated
+   * numbers after the first.
+   *
+   * @throw std::runtime_error if the payload cannot be parsed.
+   */
+  static BatchResponse ParsePayload(std::string const& payload,
+                                    std::string const& boundary);
+
+  /**
+   * Parse the response for a batch request.
+   *
+   * @throw std::runtime_error if the response does not have a
+   *     `multipart/mixed` content type, or if the payload cannot be parsed.
+   */
+  static BatchResponse FromHttpResponse(HttpResponse const& response);
+
+  /**
+   * The responses, indexed by operation number.
+   *
+   * The operations are numbered starting at 1, in the order they appear in the
+   * `BatchRequest`. Operations the service did not answer have no entry.
+   */
+  std::map<std::size_t, HttpResponse> responses;
+};
+
+std::ostream& operator<<(std::ostream& os, BatchResponse const& r);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_BATCH_REQUEST_H_
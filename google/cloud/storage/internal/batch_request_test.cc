@@ -0,0 +1,213 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/batch_request.h"
+#include "google/cloud/storage/internal/object_acl_requests.h"
+#include <gmock/gmock.h>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::testing::HasSubstr;
+
+/// @test Verify that the request options are added to batch operations.
+TEST(BatchRequestTest, OperationBuilder) {
+  PatchObjectAclRequest request(
+      "my-bucket", "dir/my object", "user-x",
+      ObjectAccessControlPatchBuilder().set_role("READER"));
+  request.set_multiple_options(Generation(7), IfMatchEtag("xyz"));
+  BatchOperationBuilder builder(
+      "PATCH", {"b", "my-bucket", "o", "dir/my object", "acl", "user-x"});
+  request.AddOptionsToHttpRequest(builder);
+  auto op = builder.Build(request.payload());
+
+  EXPECT_EQ("PATCH", op.method);
+  EXPECT_EQ("/b/my-bucket/o/dir%2Fmy%20object/acl/user-x?generation=7",
+            op.target);
+  EXPECT_THAT(op.headers, ::testing::ElementsAre("If-Match: xyz"));
+  EXPECT_EQ(request.payload(), op.payload);
+}
+
+TEST(BatchRequestTest, FormatPayload) {
+  BatchRequest request;
+  request.AddOperation(
+      BatchOperationBuilder("DELETE", {"b", "bkt", "o", "obj1"})
+          .Build(std::string{}));
+  request.AddOperation(
+      BatchOperationBuilder("PATCH", {"b", "bkt", "o", "obj2", "acl", "e"})
+          .AddHeader("Content-Type: application/json")
+          .Build(R"""({"role":"READER"})"""));
+
+  auto actual = request.FormatPayload("BOUNDARY", "/storage/v1");
+  std::string expected =
+      "--BOUNDARY\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <1>\r\n"
+      "\r\n"
+      "DELETE /storage/v1/b/bkt/o/obj1 HTTP/1.1\r\n"
+      "\r\n"
+      "\r\n"
+      "--BOUNDARY\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <2>\r\n"
+      "\r\n"
+      "PATCH /storage/v1/b/bkt/o/obj2/acl/e HTTP/1.1\r\n"
+      "Content-Type: application/json\r\n"
+      "Content-Length: 17\r\n"
+      "\r\n"
+      "{\"role\":\"READER\"}\r\n"
+      "--BOUNDARY--\r\n";
+  EXPECT_EQ(expected, actual);
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST(BatchRequestTest, TooManyOperations) {
+  BatchRequest request;
+  for (std::size_t i = 0; i != BatchRequest::MAX_OPERATIONS; ++i) {
+    request.AddOperation(BatchOperation{});
+  }
+  EXPECT_THROW(request.AddOperation(BatchOperation{}), std::invalid_argument);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+/// @test Verify that responses are parsed and indexed by their Content-ID.
+TEST(BatchResponseTest, ParsePayload) {
+  std::string payload =
+      "--batch_abc\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-2>\r\n"
+      "\r\n"
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Type: application/json; charset=UTF-8\r\n"
+      "Content-Length: 17\r\n"
+      "\r\n"
+      "{\"role\":\"READER\"}\r\n"
+      "--batch_abc\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-1>\r\n"
+      "\r\n"
+      "HTTP/1.1 204 No Content\r\n"
+      "Content-Length: 0\r\n"
+      "\r\n"
+      "\r\n"
+      "--batch_abc--\r\n";
+  HttpResponse response{200, payload,
+                        {{"content-type",
+                          "multipart/mixed; boundary=batch_abc"}}};
+  auto actual = BatchResponse::FromHttpResponse(response);
+  ASSERT_EQ(2U, actual.responses.size());
+  EXPECT_EQ(204, actual.responses[1].status_code);
+  EXPECT_EQ("", actual.responses[1].payload);
+  EXPECT_EQ(200, actual.responses[2].status_code);
+  EXPECT_EQ("{\"role\":\"READER\"}", actual.responses[2].payload);
+  auto loc = actual.responses[2].headers.find("content-length");
+  ASSERT_NE(actual.responses[2].headers.end(), loc);
+  EXPECT_EQ("17", loc->second);
+}
+
+/// @test Verify that payloads using LF line terminators are accepted.
+TEST(BatchResponseTest, ParsePayloadNoContentId) {
+  std::string payload =
+      "preamble\n"
+      "--xyz\n"
+      "Content-Type: application/http\n"
+      "\n"
+      "HTTP/1.1 404 Not Found\n"
+      "\n"
+      "not found\n"
+      "--xyz\n"
+      "Content-Type: application/http\n"
+      "\n"
+      "HTTP/1.1 204 No Content\n"
+      "\n"
+      "\n"
+      "--xyz--\n";
+  auto actual = BatchResponse::ParsePayload(payload, "xyz");
+  ASSERT_EQ(2U, actual.responses.size());
+  EXPECT_EQ(404, actual.responses[1].status_code);
+  EXPECT_EQ("not found", actual.responses[1].payload);
+  EXPECT_EQ(204, actual.responses[2].status_code);
+}
+
+/// @test Verify that a missing part does not shift the other responses.
+TEST(BatchResponseTest, ParsePayloadMissingPart) {
+  std::string payload =
+      "--xyz\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-3>\r\n"
+      "\r\n"
+      "HTTP/1.1 404 Not Found\r\n"
+      "\r\n"
+      "not found\r\n"
+      "--xyz\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <response-1>\r\n"
+      "\r\n"
+      "HTTP/1.1 204 No Content\r\n"
+      "\r\n"
+      "\r\n"
+      "--xyz\r\n"
+      "Content-Type: application/http\r\n"
+      "\r\n"
+      "HTTP/1.1 200 OK\r\n"
+      "\r\n"
+      "no content id\r\n"
+      "--xyz--\r\n";
+  auto actual = BatchResponse::ParsePayload(payload, "xyz");
+  ASSERT_EQ(2U, actual.responses.size());
+  EXPECT_EQ(204, actual.responses.at(1).status_code);
+  EXPECT_EQ(0U, actual.responses.count(2));
+  EXPECT_EQ(404, actual.responses.at(3).status_code);
+  EXPECT_EQ("not found", actual.responses.at(3).payload);
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST(BatchResponseTest, ParseInvalid) {
+  EXPECT_THROW(BatchResponse::ParsePayload("--xyz\r\n\r\nHTTP/1.1 200 OK\r\n",
+                                           "xyz"),
+               std::runtime_error);
+  EXPECT_THROW(BatchResponse::ParsePayload(
+                   "--xyz\r\n\r\nnot-http\r\n\r\n--xyz--\r\n", "xyz"),
+               std::runtime_error);
+  EXPECT_THROW(BatchResponse::FromHttpResponse(HttpResponse{
+                   200, "{}", {{"content-type", "application/json"}}}),
+               std::runtime_error);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+TEST(BatchRequestTest, OStream) {
+  BatchRequest request;
+  request.AddOperation(BatchOperationBuilder("DELETE", {"b", "bkt", "o", "o1"})
+                           .Build(std::string{}));
+  std::ostringstream os;
+  os << request;
+  EXPECT_THAT(os.str(), HasSubstr("DELETE /b/bkt/o/o1"));
+
+  BatchResponse response;
+  response.responses.emplace(1, HttpResponse{404, "not found", {}});
+  os.str("");
+  os << response;
+  EXPECT_THAT(os.str(), HasSubstr("status_code=404"));
+  EXPECT_THAT(os.str(), HasSubstr("not found"));
+}
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/bucket_requests.h"
+#include "google/cloud/storage/internal/json_items_parser.h"
 #include <iostream>
 
 namespace google {
@@ -28,16 +29,9 @@ std::ostream& operator<<(std::ostream& os, ListBucketsRequest const& r) {
 
 ListBucketsResponse ListBucketsResponse::FromHttpResponse(
     HttpResponse&& response) {
-  auto json = storage::internal::nl::json::parse(response.payload);
-
-  ListBucketsResponse result;
-  result.next_page_token = json.value("nextPageToken", "");
-
-  for (auto const& kv : json["items"].items()) {
-    result.items.emplace_back(BucketMetadata::ParseFromJson(kv.value()));
-  }
-
-  return result;
+  ListResponseParser<ListBucketsResponse> parser;
+  parser.Append(response.payload.data(), response.payload.size());
+  return parser.Finish();
 }
 
 std::ostream& operator<<(std::ostream& os, ListBucketsResponse const& r) {
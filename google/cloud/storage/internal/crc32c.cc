@@ -0,0 +1,146 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c.h"
+#include "google/cloud/storage/internal/openssl_util.h"
+#include <cstring>
+
+// The SSE4.2 implementation is compiled with a function-level `target`
+// attribute, so the library does not need to be compiled with `-msse4.2`, and
+// the instruction is only used if the CPU supports it.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GOOGLE_CLOUD_CPP_STORAGE_HAVE_SSE42_CRC32C 1
+#include <nmmintrin.h>
+#else
+#define GOOGLE_CLOUD_CPP_STORAGE_HAVE_SSE42_CRC32C 0
+#endif  // __x86_64__
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+/// The CRC32C (Castagnoli) polynomial, in reversed bit order.
+std::uint32_t const CRC32C_POLYNOMIAL = 0x82F63B78U;
+
+/**
+ * The lookup tables for the slicing-by-8 algorithm.
+ *
+ * `table[0]` is the usual byte-at-a-time table, `table[k][i]` is the CRC of
+ * byte `i` followed by `k` zero bytes.
+ */
+struct Crc32cTables {
+  Crc32cTables() {
+    for (std::uint32_t i = 0; i != 256; ++i) {
+      std::uint32_t crc = i;
+      for (int bit = 0; bit != 8; ++bit) {
+        crc = (crc >> 1) ^ ((crc & 1U) != 0 ? CRC32C_POLYNOMIAL : 0U);
+      }
+      table[0][i] = crc;
+    }
+    for (std::uint32_t i = 0; i != 256; ++i) {
+      for (int k = 1; k != 8; ++k) {
+        auto previous = table[k - 1][i];
+        table[k][i] = (previous >> 8) ^ table[0][previous & 0xFFU];
+      }
+    }
+  }
+
+  std::uint32_t table[8][256];
+};
+
+Crc32cTables const& Tables() {
+  static Crc32cTables const tables;
+  return tables;
+}
+
+std::uint32_t LoadLittleEndian32(unsigned char const* p) {
+  return static_cast<std::uint32_t>(p[0]) |
+         (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) |
+         (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_SSE42_CRC32C
+__attribute__((target("sse4.2"))) std::uint32_t Crc32cExtendSse42(
+    std::uint32_t crc, char const* data, std::size_t size) {
+  auto const* p = reinterpret_cast<unsigned char const*>(data);
+  std::uint64_t state = ~crc;
+  // Process any unaligned prefix one byte at a time.
+  while (size != 0 and reinterpret_cast<std::uintptr_t>(p) % 8 != 0) {
+    state = _mm_crc32_u8(static_cast<std::uint32_t>(state), *p++);
+    --size;
+  }
+  for (; size >= 8; size -= 8, p += 8) {
+    std::uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    state = _mm_crc32_u64(state, word);
+  }
+  for (; size != 0; --size) {
+    state = _mm_crc32_u8(static_cast<std::uint32_t>(state), *p++);
+  }
+  return ~static_cast<std::uint32_t>(state);
+}
+
+bool CpuHasSse42() {
+  static bool const has_sse42 = __builtin_cpu_supports("sse4.2") != 0;
+  return has_sse42;
+}
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_SSE42_CRC32C
+}  // namespace
+
+std::uint32_t Crc32cExtend(std::uint32_t crc, char const* data,
+                           std::size_t size) {
+#if GOOGLE_CLOUD_CPP_STORAGE_HAVE_SSE42_CRC32C
+  if (CpuHasSse42()) {
+    return Crc32cExtendSse42(crc, data, size);
+  }
+#endif  // GOOGLE_CLOUD_CPP_STORAGE_HAVE_SSE42_CRC32C
+  return Crc32cExtendPortable(crc, data, size);
+}
+
+std::uint32_t Crc32cExtendPortable(std::uint32_t crc, char const* data,
+                                   std::size_t size) {
+  auto const& t = Tables().table;
+  auto const* p = reinterpret_cast<unsigned char const*>(data);
+  crc = ~crc;
+  for (; size >= 8; size -= 8, p += 8) {
+    std::uint32_t lo = crc ^ LoadLittleEndian32(p);
+    std::uint32_t hi = LoadLittleEndian32(p + 4);
+    crc = t[7][lo & 0xFFU] ^ t[6][(lo >> 8) & 0xFFU] ^
+          t[5][(lo >> 16) & 0xFFU] ^ t[4][lo >> 24] ^ t[3][hi & 0xFFU] ^
+          t[2][(hi >> 8) & 0xFFU] ^ t[1][(hi >> 16) & 0xFFU] ^ t[0][hi >> 24];
+  }
+  for (; size != 0; --size) {
+    crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFFU];
+  }
+  return ~crc;
+}
+
+std::string Crc32cToBase64(std::uint32_t crc) {
+  std::string big_endian{
+      static_cast<char>((crc >> 24) & 0xFFU),
+      static_cast<char>((crc >> 16) & 0xFFU),
+      static_cast<char>((crc >> 8) & 0xFFU),
+      static_cast<char>(crc & 0xFFU),
+  };
+  return OpenSslUtils::Base64Encode(big_endian);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
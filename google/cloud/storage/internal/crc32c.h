@@ -0,0 +1,58 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CRC32C_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CRC32C_H_
+
+#include "google/cloud/storage/version.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Extend the CRC32C checksum @p crc with the contents of a buffer.
+ *
+ * The checksum of an empty buffer is 0, and
+ * `Crc32cExtend(Crc32cExtend(0, a), b)` is the checksum of the concatenation
+ * of `a` and `b`, so the checksum can be computed incrementally.
+ *
+ * This function uses the SSE4.2 `crc32` instruction when the CPU supports it,
+ * and falls back to `Crc32cExtendPortable()` otherwise.
+ */
+std::uint32_t Crc32cExtend(std::uint32_t crc, char const* data,
+                           std::size_t size);
+
+/// Compute the CRC32C checksum using slicing-by-8 lookup tables.
+std::uint32_t Crc32cExtendPortable(std::uint32_t crc, char const* data,
+                                   std::size_t size);
+
+inline std::uint32_t Crc32cExtend(std::uint32_t crc, std::string const& data) {
+  return Crc32cExtend(crc, data.data(), data.size());
+}
+
+/// Format a CRC32C checksum like the service: base64 of the big-endian value.
+std::string Crc32cToBase64(std::uint32_t crc);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CRC32C_H_
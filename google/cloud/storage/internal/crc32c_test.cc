@@ -0,0 +1,80 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+/// @test Verify the checksums using well-known values, see RFC 3720.
+TEST(Crc32cTest, KnownValues) {
+  EXPECT_EQ(0U, Crc32cExtend(0, std::string{}));
+  EXPECT_EQ(0xE3069283U, Crc32cExtend(0, std::string("123456789")));
+  EXPECT_EQ(0x8A9136AAU, Crc32cExtend(0, std::string(32, '\0')));
+  EXPECT_EQ(0x62A8AB43U, Crc32cExtend(0, std::string(32, '\xFF')));
+  std::string ascending;
+  for (int i = 0; i != 32; ++i) {
+    ascending.push_back(static_cast<char>(i));
+  }
+  EXPECT_EQ(0x46DD794EU, Crc32cExtend(0, ascending));
+}
+
+/// @test Verify the portable version computes the same values.
+TEST(Crc32cTest, PortableMatches) {
+  std::string data;
+  for (int i = 0; i != 4096; ++i) {
+    data.push_back(static_cast<char>((i * 131 + 7) % 251));
+  }
+  // Use different offsets and lengths to exercise the unaligned prefix and
+  // suffix in the accelerated version.
+  for (std::size_t offset = 0; offset != 9; ++offset) {
+    for (std::size_t size : {0, 1, 7, 8, 9, 63, 1000, 4000}) {
+      EXPECT_EQ(Crc32cExtend(0, data.data() + offset, size),
+                Crc32cExtendPortable(0, data.data() + offset, size))
+          << "offset=" << offset << ", size=" << size;
+    }
+  }
+}
+
+/// @test Verify that checksums can be computed incrementally.
+TEST(Crc32cTest, Incremental) {
+  std::string const data = "The quick brown fox jumps over the lazy dog";
+  auto expected = Crc32cExtend(0, data);
+  for (std::size_t split = 0; split != data.size(); ++split) {
+    auto crc = Crc32cExtend(0, data.substr(0, split));
+    EXPECT_EQ(expected, Crc32cExtend(crc, data.substr(split)));
+    crc = Crc32cExtendPortable(0, data.data(), split);
+    EXPECT_EQ(expected, Crc32cExtendPortable(crc, data.data() + split,
+                                             data.size() - split));
+  }
+}
+
+/// @test Verify the checksums are formatted like the service does.
+TEST(Crc32cTest, Base64) {
+  EXPECT_EQ("AAAAAA==", Crc32cToBase64(0));
+  std::string const quick_fox = "The quick brown fox jumps over the lazy dog";
+  EXPECT_EQ("ImIEBA==", Crc32cToBase64(Crc32cExtend(0, quick_fox)));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -15,6 +15,7 @@
 #include "google/cloud/storage/internal/curl_client.h"
 #include "google/cloud/storage/internal/curl_request_builder.h"
 #include "google/cloud/storage/internal/curl_streambuf.h"
+#include "google/cloud/storage/internal/json_items_parser.h"
 
 namespace google {
 namespace cloud {
@@ -25,17 +26,22 @@ std::pair<Status, ListBucketsResponse> CurlClient::ListBuckets(
     ListBucketsRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b");
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   builder.AddQueryParameter("project", request.project_id());
   request.AddOptionsToHttpRequest(builder);
-  auto payload = builder.BuildRequest(std::string{}).MakeRequest();
+  // Parse the items as they are received, instead of buffering the payload.
+  ListResponseParser<ListBucketsResponse> parser;
+  auto payload = builder.BuildRequest(std::string{}).MakeRequest(
+      [&parser](char const* data, std::size_t size) {
+        parser.Append(data, size);
+      });
   if (payload.status_code >= 300) {
     return std::make_pair(
         Status{payload.status_code, std::move(payload.payload)},
         ListBucketsResponse{});
   }
-  return std::make_pair(
-      Status(), ListBucketsResponse::FromHttpResponse(std::move(payload)));
+  return std::make_pair(Status(), parser.Finish());
 }
 
 std::pair<Status, BucketMetadata> CurlClient::GetBucketMetadata(
@@ -43,6 +49,7 @@ std::pair<Status, BucketMetadata> CurlClient::GetBucketMetadata(
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name());
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   auto payload = builder.BuildRequest(std::string{}).MakeRequest();
@@ -60,6 +67,7 @@ std::pair<Status, EmptyResponse> CurlClient::DeleteBucket(
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name());
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   builder.SetMethod("DELETE");
@@ -78,6 +86,7 @@ std::pair<Status, ObjectMetadata> CurlClient::InsertObjectMedia(
   CurlRequestBuilder builder(upload_endpoint_ + "/b/" + request.bucket_name() +
                              "/o");
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   builder.AddQueryParameter("uploadType", "media");
@@ -100,6 +109,7 @@ std::pair<Status, ObjectMetadata> CurlClient::GetObjectMetadata(
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                              "/o/" + request.object_name());
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   auto payload = builder.BuildRequest(std::string{}).MakeRequest();
@@ -114,17 +124,112 @@ std::pair<Status, ObjectMetadata> CurlClient::GetObjectMetadata(
 
 std::pair<Status, std::unique_ptr<ObjectReadStreambuf>> CurlClient::ReadObject(
     ReadObjectRangeRequest const& request) {
+  auto const& gzip = request.get_option<EnableGzipDecompression>();
+  bool decompress_gzip = gzip.has_value() and gzip.value();
+  // TODO(#937) - use client options to configure buffer size.
+  std::unique_ptr<CurlReadStreambuf> buf(new CurlReadStreambuf(
+      options_.download_hedge_percentile() > 0
+          ? HedgedDownload(request, decompress_gzip)
+          : MakeDownload(request, decompress_gzip),
+      128 * 1024, options_.download_read_ahead(), CreateHashValidator(request),
+      decompress_gzip));
+  return std::make_pair(Status(),
+                        std::unique_ptr<ObjectReadStreambuf>(std::move(buf)));
+}
+
+CurlDownloadRequest CurlClient::MakeDownload(
+    ReadObjectRangeRequest const& request, bool decompress_gzip) {
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                              "/o/" + request.object_name());
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
+  builder.SetStallDetection(options_.download_first_byte_timeout(),
+                            options_.download_stall_timeout(),
+                            options_.download_stall_minimum_rate());
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   builder.AddQueryParameter("alt", "media");
-  // TODO(#937) - use client options to configure buffer size.
-  std::unique_ptr<CurlReadStreambuf> buf(new CurlReadStreambuf(
-      builder.BuildDownloadRequest(std::string{}), 128 * 1024));
-  return std::make_pair(Status(),
-                        std::unique_ptr<ObjectReadStreambuf>(std::move(buf)));
+  request.AddOptionsToHttpRequest(builder);
+  if (request.begin() != 0 or request.end() != 0) {
+    // The `end()` of the request is exclusive, HTTP ranges include the last
+    // byte.
+    std::string range =
+        "Range: bytes=" + std::to_string(request.begin()) + "-";
+    if (request.end() != 0) {
+      range += std::to_string(request.end() - 1);
+    }
+    builder.AddHeader(range);
+  }
+  if (decompress_gzip) {
+    builder.AddHeader("Accept-Encoding: gzip");
+  }
+  return builder.BuildDownloadRequest(std::string{});
+}
+
+CurlDownloadRequest CurlClient::HedgedDownload(
+    ReadObjectRangeRequest const& request, bool decompress_gzip) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  using std::chrono::milliseconds;
+  using std::chrono::steady_clock;
+  milliseconds const poll_period(10);
+
+  auto record = [this](CurlDownloadRequest const& download,
+                       steady_clock::time_point start) {
+    if (not download.stalled()) {
+      first_byte_latency_.Record(
+          duration_cast<microseconds>(steady_clock::now() - start));
+    }
+  };
+
+  auto start = steady_clock::now();
+  auto timeout = options_.download_first_byte_timeout().count() != 0
+                     ? options_.download_first_byte_timeout()
+                     : options_.download_stall_timeout();
+  auto expired = [start, timeout] {
+    return timeout.count() != 0 and steady_clock::now() - start >= timeout;
+  };
+
+  auto primary = MakeDownload(request, decompress_gzip);
+  auto delay =
+      first_byte_latency_.Percentile(options_.download_hedge_percentile());
+  if (delay.count() == 0) {
+    // Not enough samples to compute the delay, just measure this download.
+    while (not expired()) {
+      if (primary.WaitForFirstByte(poll_period)) {
+        record(primary, start);
+        break;
+      }
+    }
+    return primary;
+  }
+  if (primary.WaitForFirstByte(duration_cast<milliseconds>(delay) +
+                               milliseconds(1))) {
+    record(primary, start);
+    return primary;
+  }
+  GCP_LOG(INFO) << __func__ << "() no response for " << request.object_name()
+                << " after " << delay.count() << "us, sending a hedged request";
+  auto hedge_start = steady_clock::now();
+  auto hedge = MakeDownload(request, decompress_gzip);
+  // The losing request is aborted when it goes out of scope. A request that
+  // stalls also completes the wait, but the other one may still succeed.
+  while (not expired()) {
+    bool primary_ready = primary.WaitForFirstByte(poll_period);
+    if (primary_ready and not primary.stalled()) {
+      record(primary, start);
+      return primary;
+    }
+    bool hedge_ready = hedge.WaitForFirstByte(poll_period);
+    if (hedge_ready and not hedge.stalled()) {
+      record(hedge, hedge_start);
+      return hedge;
+    }
+    if (primary.stalled() and hedge.stalled()) {
+      break;
+    }
+  }
+  return primary;
 }
 
 std::pair<Status, std::unique_ptr<ObjectWriteStreambuf>>
@@ -132,14 +237,24 @@ CurlClient::WriteObject(InsertObjectStreamingRequest const& request) {
   auto url = upload_endpoint_ + "/b/" + request.bucket_name() + "/o";
   CurlRequestBuilder builder(url);
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   builder.AddQueryParameter("uploadType", "media");
   builder.AddQueryParameter("name", request.object_name());
   builder.AddHeader("Content-Type: application/octet-stream");
+  std::unique_ptr<GzipCompressor> compressor;
+  auto const& gzip = request.get_option<EnableGzipCompression>();
+  if (gzip.has_value() and gzip.value()) {
+    if (not request.get_option<ContentEncoding>().has_value()) {
+      builder.AddQueryParameter("contentEncoding", "gzip");
+    }
+    compressor.reset(new GzipCompressor);
+  }
   // TODO(#937) - use client options to configure buffer size.
-  std::unique_ptr<internal::CurlStreambuf> buf(
-      new internal::CurlStreambuf(builder.BuildUpload(), 128 * 1024));
+  std::unique_ptr<internal::CurlStreambuf> buf(new internal::CurlStreambuf(
+      builder.BuildUpload(), 128 * 1024, options_.upload_pipeline_depth(),
+      CreateHashValidator(request), std::move(compressor)));
   return std::make_pair(
       Status(),
       std::unique_ptr<internal::ObjectWriteStreambuf>(std::move(buf)));
@@ -151,18 +266,24 @@ std::pair<Status, ListObjectsResponse> CurlClient::ListObjects(
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                              "/o");
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   builder.AddQueryParameter("pageToken", request.page_token());
-  auto payload = builder.BuildRequest(std::string{}).MakeRequest();
-  if (200 != payload.status_code) {
+  // Parse the items as they are received, instead of buffering the payload.
+  ListResponseParser<ListObjectsResponse> parser;
+  auto payload = builder.BuildRequest(std::string{}).MakeRequest(
+      [&parser](char const* data, std::size_t size) {
+        parser.Append(data, size);
+      });
+  // The payload callback is only used for responses below 300, any other
+  // response is buffered in the payload and reported as an error.
+  if (payload.status_code >= 300) {
     return std::make_pair(
         Status{payload.status_code, std::move(payload.payload)},
         internal::ListObjectsResponse{});
   }
-  return std::make_pair(
-      Status(),
-      internal::ListObjectsResponse::FromHttpResponse(std::move(payload)));
+  return std::make_pair(Status(), parser.Finish());
 }
 
 std::pair<Status, EmptyResponse> CurlClient::DeleteObject(
@@ -171,6 +292,7 @@ std::pair<Status, EmptyResponse> CurlClient::DeleteObject(
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                              "/o/" + request.object_name());
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   builder.SetMethod("DELETE");
@@ -183,11 +305,57 @@ std::pair<Status, EmptyResponse> CurlClient::DeleteObject(
   return std::make_pair(Status(), internal::EmptyResponse{});
 }
 
+std::pair<Status, ObjectMetadata> CurlClient::CopyObject(
+    CopyObjectRequest const& request) {
+  CurlRequestBuilder builder(
+      storage_endpoint_ + "/b/" + request.source_bucket() + "/o/" +
+      request.source_object() + "/copyTo/b/" + request.destination_bucket() +
+      "/o/" + request.destination_object());
+  builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
+  builder.AddHeader(options_.credentials()->AuthorizationHeader());
+  request.AddOptionsToHttpRequest(builder);
+  builder.AddHeader("Content-Type: application/json");
+  auto payload = builder.BuildRequest("{}").MakeRequest();
+  if (payload.status_code >= 300) {
+    return std::make_pair(
+        Status{payload.status_code, std::move(payload.payload)},
+        ObjectMetadata{});
+  }
+  return std::make_pair(Status(),
+                        ObjectMetadata::ParseFromString(payload.payload));
+}
+
+std::pair<Status, RewriteObjectResponse> CurlClient::RewriteObject(
+    RewriteObjectRequest const& request) {
+  CurlRequestBuilder builder(
+      storage_endpoint_ + "/b/" + request.source_bucket() + "/o/" +
+      request.source_object() + "/rewriteTo/b/" +
+      request.destination_bucket() + "/o/" + request.destination_object());
+  builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
+  builder.AddHeader(options_.credentials()->AuthorizationHeader());
+  request.AddOptionsToHttpRequest(builder);
+  if (not request.rewrite_token().empty()) {
+    builder.AddQueryParameter("rewriteToken", request.rewrite_token());
+  }
+  builder.AddHeader("Content-Type: application/json");
+  auto payload = builder.BuildRequest("{}").MakeRequest();
+  if (payload.status_code >= 300) {
+    return std::make_pair(
+        Status{payload.status_code, std::move(payload.payload)},
+        RewriteObjectResponse{});
+  }
+  return std::make_pair(
+      Status(), RewriteObjectResponse::FromHttpResponse(std::move(payload)));
+}
+
 std::pair<Status, ListBucketAclResponse> CurlClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                              "/acl");
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   auto payload = builder.BuildRequest(std::string{}).MakeRequest();
@@ -207,6 +375,7 @@ std::pair<Status, ListObjectAclResponse> CurlClient::ListObjectAcl(
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                              "/o/" + request.object_name() + "/acl");
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   auto payload = builder.BuildRequest(std::string{}).MakeRequest();
@@ -225,6 +394,7 @@ std::pair<Status, ObjectAccessControl> CurlClient::CreateObjectAcl(
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
                              "/o/" + request.object_name() + "/acl");
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   nl::json object;
@@ -247,6 +417,7 @@ std::pair<Status, EmptyResponse> CurlClient::DeleteObjectAcl(
                              "/o/" + request.object_name() + "/acl/" +
                              request.entity());
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   builder.SetMethod("DELETE");
@@ -265,6 +436,7 @@ std::pair<Status, ObjectAccessControl> CurlClient::GetObjectAcl(
                              "/o/" + request.object_name() + "/acl/" +
                              request.entity());
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   auto payload = builder.BuildRequest(std::string{}).MakeRequest();
@@ -283,6 +455,7 @@ std::pair<Status, ObjectAccessControl> CurlClient::UpdateObjectAcl(
                              "/o/" + request.object_name() + "/acl/" +
                              request.entity());
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   builder.SetMethod("PUT");
@@ -306,6 +479,7 @@ std::pair<Status, ObjectAccessControl> CurlClient::PatchObjectAcl(
                              "/o/" + request.object_name() + "/acl/" +
                              request.entity());
   builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
   builder.AddHeader(options_.credentials()->AuthorizationHeader());
   request.AddOptionsToHttpRequest(builder);
   builder.SetMethod("PATCH");
@@ -320,6 +494,31 @@ std::pair<Status, ObjectAccessControl> CurlClient::PatchObjectAcl(
                         ObjectAccessControl::ParseFromString(payload.payload));
 }
 
+std::pair<Status, BatchResponse> CurlClient::ExecuteBatch(
+    BatchRequest const& request) {
+  std::string boundary;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    boundary = "batch_" + google::cloud::internal::Sample(
+                              generator_, 32,
+                              "abcdefghijklmnopqrstuvwxyz0123456789");
+  }
+  CurlRequestBuilder builder(batch_endpoint_);
+  builder.SetDebugLogging(options_.enable_http_tracing());
+  builder.SetCurlShare(share_);
+  builder.AddHeader(options_.credentials()->AuthorizationHeader());
+  builder.AddHeader("Content-Type: multipart/mixed; boundary=" + boundary);
+  auto contents =
+      request.FormatPayload(boundary, "/storage/" + options_.version());
+  auto payload = builder.BuildRequest(std::move(contents)).MakeRequest();
+  if (payload.status_code >= 300) {
+    return std::make_pair(
+        Status{payload.status_code, std::move(payload.payload)},
+        BatchResponse{});
+  }
+  return std::make_pair(Status(), BatchResponse::FromHttpResponse(payload));
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -15,7 +15,12 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_CLIENT_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_CLIENT_H_
 
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/internal/curl_download_request.h"
+#include "google/cloud/storage/internal/curl_share.h"
+#include "google/cloud/storage/internal/latency_tracker.h"
 #include "google/cloud/storage/internal/raw_client.h"
+#include <mutex>
 
 namespace google {
 namespace cloud {
@@ -32,10 +37,16 @@ class CurlClient : public RawClient {
   explicit CurlClient(std::shared_ptr<Credentials> credentials)
       : CurlClient(ClientOptions(std::move(credentials))) {}
 
-  explicit CurlClient(ClientOptions options) : options_(std::move(options)) {
+  explicit CurlClient(ClientOptions options)
+      : options_(std::move(options)),
+        share_(std::make_shared<CurlShare>()),
+        generator_(google::cloud::internal::MakeDefaultPRNG()),
+        first_byte_latency_(128, 16) {
     storage_endpoint_ = options_.endpoint() + "/storage/" + options_.version();
     upload_endpoint_ =
         options_.endpoint() + "/upload/storage/" + options_.version();
+    batch_endpoint_ =
+        options_.endpoint() + "/batch/storage/" + options_.version();
   }
 
   ClientOptions const& client_options() const override { return options_; }
@@ -59,6 +70,10 @@ class CurlClient : public RawClient {
       ListObjectsRequest const& request) override;
   std::pair<Status, EmptyResponse> DeleteObject(
       DeleteObjectRequest const& request) override;
+  std::pair<Status, ObjectMetadata> CopyObject(
+      CopyObjectRequest const& request) override;
+  std::pair<Status, RewriteObjectResponse> RewriteObject(
+      RewriteObjectRequest const& request) override;
 
   std::pair<Status, ListBucketAclResponse> ListBucketAcl(
       ListBucketAclRequest const& request) override;
@@ -75,11 +90,38 @@ class CurlClient : public RawClient {
       UpdateObjectAclRequest const&) override;
   std::pair<Status, ObjectAccessControl> PatchObjectAcl(
       PatchObjectAclRequest const&) override;
+  std::pair<Status, BatchResponse> ExecuteBatch(BatchRequest const&) override;
 
  private:
+  /// Start a download for @p request.
+  CurlDownloadRequest MakeDownload(ReadObjectRangeRequest const& request,
+                                   bool decompress_gzip);
+
+  /**
+   * Start a download for @p request, hedging it if the response is slow.
+   *
+   * This blocks until the first response starts, and records its latency to
+   * compute the hedging delay for future downloads. The wait is bounded by the
+   * first byte timeout, or the stall timeout if the former is disabled, after
+   * that the primary request is returned and reports the error.
+   */
+  CurlDownloadRequest HedgedDownload(ReadObjectRangeRequest const& request,
+                                     bool decompress_gzip);
+
   ClientOptions options_;
   std::string storage_endpoint_;
   std::string upload_endpoint_;
+  std::string batch_endpoint_;
+  // All the requests share the DNS cache and TLS sessions.
+  std::shared_ptr<CurlShare> share_;
+
+  // Generate the delimiters for batch requests.
+  std::mutex mu_;
+  google::cloud::internal::DefaultPRNG generator_;
+
+  // The time to receive the first byte of recent downloads, used to compute
+  // the hedging delay.
+  LatencyTracker first_byte_latency_;
 };
 
 }  // namespace internal
@@ -0,0 +1,169 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_download_pipeline.h"
+#include "google/cloud/internal/throw_delegate.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+CurlDownloadPipeline::CurlDownloadPipeline(CurlDownloadRequest&& download,
+                                           std::size_t read_ahead)
+    : download_(std::move(download)),
+      read_ahead_(read_ahead),
+      done_(false),
+      closed_(false),
+      shutdown_(false),
+      status_code_(0) {
+  if (read_ahead_ != 0) {
+    // Start the thread only after all the other members are initialized.
+    thread_ = std::thread(&CurlDownloadPipeline::Run, this);
+  }
+}
+
+CurlDownloadPipeline::~CurlDownloadPipeline() {
+  if (read_ahead_ != 0) {
+    Stop();
+  }
+}
+
+bool CurlDownloadPipeline::IsOpen() const {
+  if (read_ahead_ == 0) {
+    return download_.IsOpen();
+  }
+  std::lock_guard<std::mutex> lk(mu_);
+  return not closed_;
+}
+
+HttpResponse CurlDownloadPipeline::Close() {
+  if (read_ahead_ != 0) {
+    Stop();
+  }
+  return download_.Close();
+}
+
+CurlReceivedHeaders CurlDownloadPipeline::received_headers() const {
+  if (read_ahead_ == 0) {
+    return download_.received_headers();
+  }
+  std::lock_guard<std::mutex> lk(mu_);
+  return headers_;
+}
+
+HttpResponse CurlDownloadPipeline::GetMore(std::string& buffer) {
+  if (read_ahead_ == 0) {
+    return download_.GetMore(buffer);
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return not chunks_.empty() or done_; });
+  if (chunks_.empty()) {
+    // There is no more data, the download completed, failed, or was closed.
+    closed_ = true;
+    auto exception = exception_;
+    auto status_code = status_code_;
+    lk.unlock();
+    if (exception) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+      std::rethrow_exception(exception);
+#else
+      google::cloud::internal::RaiseRuntimeError(
+          "CurlDownloadPipeline: error in background download thread");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    }
+    buffer.clear();
+    return HttpResponse{status_code, {}, {}};
+  }
+  Chunk chunk = std::move(chunks_.front());
+  chunks_.pop_front();
+  status_code_ = chunk.response.status_code;
+  if (chunk.response.status_code != 100) {
+    closed_ = true;
+  }
+  lk.unlock();
+  cv_.notify_all();
+  buffer.swap(chunk.data);
+  return std::move(chunk.response);
+}
+
+void CurlDownloadPipeline::Stop() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+    closed_ = true;
+    done_ = true;
+  }
+  // Interrupt the background thread if it is waiting for data, the
+  // application will not read any more.
+  download_.Cancel();
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void CurlDownloadPipeline::Run() {
+  bool first_chunk = true;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      cv_.wait(lk,
+               [this] { return shutdown_ or chunks_.size() < read_ahead_; });
+      if (shutdown_) {
+        return;
+      }
+    }
+    Chunk chunk;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      chunk.response = download_.GetMore(chunk.data);
+    } catch (...) {
+      std::lock_guard<std::mutex> lk(mu_);
+      exception_ = std::current_exception();
+      done_ = true;
+      cv_.notify_all();
+      return;
+    }
+#else
+    chunk.response = download_.GetMore(chunk.data);
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    bool const last_chunk = chunk.response.status_code != 100;
+    std::lock_guard<std::mutex> lk(mu_);
+    if (shutdown_) {
+      // The application closed the download while this thread was waiting
+      // for data, discard it.
+      return;
+    }
+    if (first_chunk) {
+      // All the headers arrive before any data, but once the download
+      // completes they are moved to the last response.
+      headers_ = last_chunk ? chunk.response.headers
+                            : download_.received_headers();
+      first_chunk = false;
+    }
+    chunks_.push_back(std::move(chunk));
+    done_ = last_chunk;
+    cv_.notify_all();
+    if (last_chunk) {
+      return;
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,112 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_DOWNLOAD_PIPELINE_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_DOWNLOAD_PIPELINE_H_
+
+#include "google/cloud/storage/internal/curl_download_request.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Receive the data of a `CurlDownloadRequest` ahead of the application.
+ *
+ * libcurl only receives data while `CurlDownloadRequest::GetMore()` runs, so
+ * the connection is idle while the application processes each buffer. If
+ * @p read_ahead is not zero this class starts a background thread that calls
+ * `GetMore()` until @p read_ahead buffers are queued, and `GetMore()` on this
+ * class simply returns the next queued buffer. With @p read_ahead set to zero
+ * all calls are forwarded to the `CurlDownloadRequest`.
+ *
+ * The `CurlDownloadRequest` is only used by the background thread until
+ * `Close()` is called, at that point the thread is stopped and the request is
+ * closed in the calling thread. `Close()` and the destructor cancel any
+ * transfer in progress, so they do not wait for more data.
+ */
+class CurlDownloadPipeline {
+ public:
+  CurlDownloadPipeline(CurlDownloadRequest&& download, std::size_t read_ahead);
+  ~CurlDownloadPipeline();
+
+  CurlDownloadPipeline(CurlDownloadPipeline const&) = delete;
+  CurlDownloadPipeline& operator=(CurlDownloadPipeline const&) = delete;
+
+  bool IsOpen() const;
+  HttpResponse Close();
+
+  /**
+   * The headers received so far.
+   *
+   * With read-ahead enabled the headers are only available after the first
+   * call to `GetMore()`.
+   */
+  CurlReceivedHeaders received_headers() const;
+
+  /**
+   * Return the next buffer, blocking until it is available.
+   *
+   * @see `CurlDownloadRequest::GetMore()` for the semantics of the result.
+   *     Once the download completes, further calls return no data and the
+   *     final status code.
+   * @throw the exception raised by the background thread, if any, after all
+   *     the buffers received before the error are returned.
+   */
+  HttpResponse GetMore(std::string& buffer);
+
+ private:
+  void Run();
+
+  /// Cancel the transfer and wait for the background thread to exit.
+  void Stop();
+
+  struct Chunk {
+    std::string data;
+    HttpResponse response;
+  };
+
+  CurlDownloadRequest download_;
+  std::size_t read_ahead_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<Chunk> chunks_;
+  // A copy of the headers, made by the background thread before it queues the
+  // first chunk.
+  CurlReceivedHeaders headers_;
+  // Set once the background thread has queued the last chunk, or failed.
+  bool done_;
+  // Set once the application has received the last chunk.
+  bool closed_;
+  bool shutdown_;
+  // The status code of the last chunk returned to the application.
+  long status_code_;
+  std::exception_ptr exception_;
+  std::thread thread_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_DOWNLOAD_PIPELINE_H_
@@ -0,0 +1,142 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_download_pipeline.h"
+#include "google/cloud/storage/internal/curl_request_builder.h"
+#include "google/cloud/storage/testing/fake_http_server.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using storage::testing::FakeHttpConnection;
+using storage::testing::FakeHttpServer;
+
+/// The size of the buffers returned by the downloads in these tests.
+std::size_t const BUFFER_SIZE = 1024;
+
+CurlDownloadRequest MakeDownload(std::string const& url) {
+  CurlRequestBuilder builder(url);
+  builder.SetInitialBufferSize(BUFFER_SIZE);
+  return builder.BuildDownloadRequest(std::string{});
+}
+
+/// Respond with @p body, and keep the connection open.
+FakeHttpServer::Handler Respond(std::string body) {
+  return [body](FakeHttpConnection& connection) {
+    connection.ReadRequestHeaders();
+    connection.Write("HTTP/1.1 200 OK\r\nContent-Length: " +
+                     std::to_string(body.size()) + "\r\n\r\n" + body);
+    connection.WaitForShutdown();
+  };
+}
+
+/// Read all the data, returns the last response.
+HttpResponse ReadAll(CurlDownloadPipeline& pipeline, std::string& contents) {
+  HttpResponse response;
+  do {
+    std::string buffer;
+    response = pipeline.GetMore(buffer);
+    contents += buffer;
+  } while (response.status_code == 100);
+  return response;
+}
+
+TEST(CurlDownloadPipelineTest, ReadToEof) {
+  std::string const body(8 * BUFFER_SIZE + 7, 'x');
+  FakeHttpServer server(Respond(body));
+  CurlDownloadPipeline pipeline(MakeDownload(server.url() + "/data"), 2);
+
+  std::string contents;
+  auto response = ReadAll(pipeline, contents);
+  EXPECT_EQ(200, response.status_code) << ", payload=" << response.payload;
+  EXPECT_EQ(body, contents);
+  EXPECT_EQ(1U, response.headers.count("content-length"));
+  EXPECT_EQ(1U, pipeline.received_headers().count("content-length"));
+  EXPECT_FALSE(pipeline.IsOpen());
+
+  // Reading past the end returns no data, instead of an empty exception.
+  std::string buffer = "not empty";
+  response = pipeline.GetMore(buffer);
+  EXPECT_EQ(200, response.status_code);
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(CurlDownloadPipelineTest, ErrorAfterData) {
+  // The connection is closed before the full body is sent.
+  FakeHttpServer server([](FakeHttpConnection& connection) {
+    connection.ReadRequestHeaders();
+    connection.Write(
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 4096\r\n"
+        "\r\n"
+        "0123456789");
+  });
+  CurlDownloadPipeline pipeline(MakeDownload(server.url() + "/data"), 2);
+
+  std::string contents;
+  auto response = ReadAll(pipeline, contents);
+  EXPECT_EQ(503, response.status_code) << ", payload=" << response.payload;
+  EXPECT_EQ("0123456789", contents);
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST(CurlDownloadPipelineTest, ErrorBeforeResponse) {
+  CurlDownloadPipeline pipeline(
+      MakeDownload(storage::testing::UnusedLoopbackUrl() + "/data"), 2);
+
+  std::string buffer;
+  EXPECT_THROW(pipeline.GetMore(buffer), std::runtime_error);
+  EXPECT_FALSE(pipeline.IsOpen());
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+TEST(CurlDownloadPipelineTest, DestroyWhileWaitingForData) {
+  FakeHttpServer server([](FakeHttpConnection& connection) {
+    connection.ReadRequestHeaders();
+    connection.WaitForShutdown();
+  });
+  auto start = std::chrono::steady_clock::now();
+  {
+    CurlDownloadPipeline pipeline(MakeDownload(server.url() + "/wedged"), 2);
+    // Give the background thread time to block waiting for the response.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST(CurlDownloadPipelineTest, CloseBeforeEof) {
+  std::string const body(64 * BUFFER_SIZE, 'x');
+  FakeHttpServer server(Respond(body));
+  auto start = std::chrono::steady_clock::now();
+  CurlDownloadPipeline pipeline(MakeDownload(server.url() + "/data"), 2);
+
+  std::string buffer;
+  auto response = pipeline.GetMore(buffer);
+  EXPECT_EQ(100, response.status_code);
+  EXPECT_FALSE(buffer.empty());
+  pipeline.Close();
+  EXPECT_FALSE(pipeline.IsOpen());
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
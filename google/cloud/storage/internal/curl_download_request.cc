@@ -32,7 +32,19 @@ CurlDownloadRequest::CurlDownloadRequest(std::size_t initial_buffer_size)
       multi_(nullptr, &curl_multi_cleanup),
       closing_(false),
       curl_closed_(false),
-      initial_buffer_size_(initial_buffer_size) {
+      transfer_result_(CURLE_OK),
+      pending_error_(false),
+      initial_buffer_size_(initial_buffer_size),
+      first_byte_timeout_(0),
+      stall_timeout_(0),
+      stall_minimum_rate_(0),
+      started_(false),
+      response_started_(false),
+      window_bytes_(0),
+      window_paused_(false),
+      stalled_(false),
+      handle_removed_(false),
+      cancelled_(false) {
   buffer_.reserve(initial_buffer_size);
 }
 
@@ -44,8 +56,10 @@ HttpResponse CurlDownloadRequest::Close() {
   Wait([this] { return curl_closed_; });
 
   // Now remove the handle from the CURLM* interface and wait for the response.
-  auto error = curl_multi_remove_handle(multi_.get(), handle_.handle_.get());
-  RaiseOnError(__func__, error);
+  if (not handle_removed_) {
+    auto error = curl_multi_remove_handle(multi_.get(), handle_.handle_.get());
+    RaiseOnError(__func__, error);
+  }
 
   long http_code = handle_.GetResponseCode();
   return HttpResponse{http_code, std::string{}, std::move(received_headers_)};
@@ -58,22 +72,55 @@ HttpResponse CurlDownloadRequest::GetMore(std::string& buffer) {
   });
   GCP_LOG(DEBUG) << __func__ << "(), curl.size=" << buffer_.size()
                  << ", closing=" << closing_ << ", closed=" << curl_closed_;
+  if (curl_closed_ and transfer_result_ != CURLE_OK and not buffer_.empty()) {
+    // Return the data received before the error, callers can use it to resume
+    // the download.
+    pending_error_ = true;
+    buffer_.swap(buffer);
+    buffer_.clear();
+    return HttpResponse{100, {}, {}};
+  }
   if (curl_closed_) {
+    pending_error_ = false;
     // Remove the handle from the CURLM* interface and wait for the response.
-    auto error = curl_multi_remove_handle(multi_.get(), handle_.handle_.get());
-    RaiseOnError(__func__, error);
+    if (not handle_removed_) {
+      auto error =
+          curl_multi_remove_handle(multi_.get(), handle_.handle_.get());
+      RaiseOnError(__func__, error);
+    }
 
     buffer_.swap(buffer);
     buffer_.clear();
     long http_code = handle_.GetResponseCode();
     GCP_LOG(DEBUG) << __func__ << "(), size=" << buffer.size()
                    << ", closing=" << closing_ << ", closed=" << curl_closed_
-                   << ", code=" << http_code;
+                   << ", code=" << http_code
+                   << ", result=" << transfer_result_;
+    if (transfer_result_ != CURLE_OK) {
+      std::ostringstream os;
+      os << "Error [" << transfer_result_
+         << "]=" << curl_easy_strerror(transfer_result_) << " in " << __func__;
+      if (stalled_) {
+        os << ", the download stalled";
+      }
+      if (cancelled_) {
+        os << ", the download was cancelled";
+      }
+      if (http_code == 0 and not stalled_) {
+        google::cloud::internal::RaiseRuntimeError(os.str());
+      }
+      if (http_code < 300) {
+        // The transfer was interrupted, report a transient error so the
+        // caller can retry, the data received so far is valid.
+        return HttpResponse{503, os.str(), std::move(received_headers_)};
+      }
+    }
     return HttpResponse{http_code, std::string{}, std::move(received_headers_)};
   }
   buffer_.swap(buffer);
   buffer_.clear();
   buffer_.reserve(initial_buffer_size_);
+  window_paused_ = true;
   handle_.EasyPause(CURLPAUSE_RECV_CONT);
   GCP_LOG(DEBUG) << __func__ << "(), size=" << buffer.size()
                  << ", closing=" << closing_ << ", closed=" << curl_closed_
@@ -81,6 +128,15 @@ HttpResponse CurlDownloadRequest::GetMore(std::string& buffer) {
   return HttpResponse{100, {}, {}};
 }
 
+bool CurlDownloadRequest::WaitForFirstByte(std::chrono::milliseconds timeout) {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  Wait([this, deadline] {
+    return curl_closed_ or response_started_ or
+           std::chrono::steady_clock::now() >= deadline;
+  });
+  return curl_closed_ or response_started_;
+}
+
 void CurlDownloadRequest::SetOptions() {
   ResetOptions();
   auto error = curl_multi_add_handle(multi_.get(), handle_.handle_.get());
@@ -105,6 +161,7 @@ void CurlDownloadRequest::ResetOptions() {
       });
   handle_.SetHeaderCallback([this](char* contents, std::size_t size,
                                    std::size_t nitems) {
+    response_started_ = true;
     return CurlAppendHeaderData(
         received_headers_, static_cast<char const*>(contents), size * nitems);
   });
@@ -128,6 +185,7 @@ std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
   }
 
   buffer_.append(static_cast<char const*>(ptr), size * nmemb);
+  window_bytes_ += static_cast<std::int64_t>(size * nmemb);
   return size * nmemb;
 }
 
@@ -167,6 +225,7 @@ int CurlDownloadRequest::PerformWork() {
                      << "]=" << curl_easy_strerror(msg->data.result);
       // The transfer is done, set the state flags appropriately.
       curl_closed_ = true;
+      transfer_result_ = msg->data.result;
     } while (remaining > 0);
   }
   return running_handles;
@@ -177,6 +236,67 @@ void CurlDownloadRequest::WaitForHandles() {
   RaiseOnError(__func__, result);
 }
 
+void CurlDownloadRequest::StartStallWindow() {
+  auto now = std::chrono::steady_clock::now();
+  if (not started_) {
+    started_ = true;
+    transfer_start_ = now;
+  } else if (not window_paused_) {
+    return;
+  }
+  window_paused_ = false;
+  window_start_ = now;
+  window_bytes_ = 0;
+}
+
+bool CurlDownloadRequest::CheckStalled() {
+  auto now = std::chrono::steady_clock::now();
+  char const* reason = nullptr;
+  if (not response_started_ and first_byte_timeout_.count() != 0 and
+      now - transfer_start_ >= first_byte_timeout_) {
+    reason = "no response before the first byte timeout";
+  } else if (stall_timeout_.count() != 0 and
+             now - window_start_ >= stall_timeout_) {
+    // A window without any data is always a stall, even if the minimum rate
+    // rounds down to zero bytes over the window.
+    auto minimum = (std::max)(
+        std::int64_t(1), stall_minimum_rate_ * stall_timeout_.count() / 1000);
+    if (window_bytes_ >= minimum) {
+      // Start a new measurement window.
+      window_start_ = now;
+      window_bytes_ = 0;
+      return false;
+    }
+    reason = "throughput below the minimum rate";
+  }
+  if (reason == nullptr) {
+    return false;
+  }
+  GCP_LOG(WARNING) << __func__ << "() aborting download from " << url_ << ": "
+                   << reason;
+  stalled_ = true;
+  AbortTransfer(CURLE_OPERATION_TIMEDOUT);
+  return true;
+}
+
+bool CurlDownloadRequest::CheckCancelled() {
+  if (not cancelled_.load()) {
+    return false;
+  }
+  GCP_LOG(DEBUG) << __func__ << "() aborting download from " << url_;
+  AbortTransfer(CURLE_ABORTED_BY_CALLBACK);
+  return true;
+}
+
+void CurlDownloadRequest::AbortTransfer(CURLcode result) {
+  // Removing the handle aborts the transfer, the connection is not reused.
+  auto error = curl_multi_remove_handle(multi_.get(), handle_.handle_.get());
+  RaiseOnError(__func__, error);
+  handle_removed_ = true;
+  curl_closed_ = true;
+  transfer_result_ = result;
+}
+
 void CurlDownloadRequest::RaiseOnError(char const* where, CURLMcode result) {
   if (result == CURLM_OK) {
     return;
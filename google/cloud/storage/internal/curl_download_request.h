@@ -18,6 +18,8 @@
 #include "google/cloud/log.h"
 #include "google/cloud/storage/internal/curl_request.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include <atomic>
+#include <chrono>
 
 namespace google {
 namespace cloud {
@@ -43,12 +45,28 @@ class CurlDownloadRequest {
         headers_(std::move(rhs.headers_)),
         payload_(std::move(rhs.payload_)),
         user_agent_(std::move(rhs.user_agent_)),
+        received_headers_(std::move(rhs.received_headers_)),
         logging_enabled_(rhs.logging_enabled_),
         handle_(std::move(rhs.handle_)),
         multi_(std::move(rhs.multi_)),
+        buffer_(std::move(rhs.buffer_)),
         closing_(rhs.closing_),
         curl_closed_(rhs.curl_closed_),
-        initial_buffer_size_(rhs.initial_buffer_size_) {
+        transfer_result_(rhs.transfer_result_),
+        pending_error_(rhs.pending_error_),
+        initial_buffer_size_(rhs.initial_buffer_size_),
+        first_byte_timeout_(rhs.first_byte_timeout_),
+        stall_timeout_(rhs.stall_timeout_),
+        stall_minimum_rate_(rhs.stall_minimum_rate_),
+        started_(rhs.started_),
+        transfer_start_(rhs.transfer_start_),
+        response_started_(rhs.response_started_),
+        window_start_(rhs.window_start_),
+        window_bytes_(rhs.window_bytes_),
+        window_paused_(rhs.window_paused_),
+        stalled_(rhs.stalled_),
+        handle_removed_(rhs.handle_removed_),
+        cancelled_(rhs.cancelled_.load()) {
     ResetOptions();
   }
 
@@ -57,19 +75,46 @@ class CurlDownloadRequest {
     headers_ = std::move(rhs.headers_);
     payload_ = std::move(rhs.payload_);
     user_agent_ = std::move(rhs.user_agent_);
+    received_headers_ = std::move(rhs.received_headers_);
     logging_enabled_ = rhs.logging_enabled_;
     handle_ = std::move(rhs.handle_);
     multi_ = std::move(rhs.multi_);
+    buffer_ = std::move(rhs.buffer_);
     closing_ = rhs.closing_;
     curl_closed_ = rhs.curl_closed_;
+    transfer_result_ = rhs.transfer_result_;
+    pending_error_ = rhs.pending_error_;
     initial_buffer_size_ = rhs.initial_buffer_size_;
+    first_byte_timeout_ = rhs.first_byte_timeout_;
+    stall_timeout_ = rhs.stall_timeout_;
+    stall_minimum_rate_ = rhs.stall_minimum_rate_;
+    started_ = rhs.started_;
+    transfer_start_ = rhs.transfer_start_;
+    response_started_ = rhs.response_started_;
+    window_start_ = rhs.window_start_;
+    window_bytes_ = rhs.window_bytes_;
+    window_paused_ = rhs.window_paused_;
+    stalled_ = rhs.stalled_;
+    handle_removed_ = rhs.handle_removed_;
+    cancelled_.store(rhs.cancelled_.load());
     ResetOptions();
     return *this;
   }
 
-  bool IsOpen() const { return not curl_closed_; }
+  bool IsOpen() const { return not curl_closed_ or pending_error_; }
   HttpResponse Close();
 
+  /**
+   * The headers received so far.
+   *
+   * All the headers are received before any data, so this is useful to
+   * examine the headers before the download completes. Once the download
+   * completes the headers are moved to the response returned by `GetMore()`.
+   */
+  CurlReceivedHeaders const& received_headers() const {
+    return received_headers_;
+  }
+
   /**
    * Wait for additional data or the end of the transfer.
    *
@@ -78,10 +123,35 @@ class CurlDownloadRequest {
    *
    * @param buffer the location to return the new data. Note that the contents
    *     of this parameter are completely replaced with the new data.
-   * @returns 100-Continue if the transfer is not yet completed.
+   * @returns 100-Continue if the transfer is not yet completed. If the
+   *     transfer fails after the response starts, e.g. because the connection
+   *     is reset, the status code is 503 (Service Unavailable) and the payload
+   *     contains the libcurl error. Any data received before the error is
+   *     returned first, with a 100-Continue status.
+   * @throw std::runtime_error if the transfer fails before any response is
+   *     received.
    */
   HttpResponse GetMore(std::string& buffer);
 
+  /**
+   * Wait until the response starts, the transfer completes, or @p timeout.
+   *
+   * @return true if the response started or the transfer completed.
+   */
+  bool WaitForFirstByte(std::chrono::milliseconds timeout);
+
+  /// Return true if the transfer was aborted by the stall detection.
+  bool stalled() const { return stalled_; }
+
+  /**
+   * Abort the transfer, this is the only member function safe to call from
+   * another thread.
+   *
+   * A thread blocked in `GetMore()`, `WaitForFirstByte()` or `Close()` returns
+   * promptly, as if the connection was reset.
+   */
+  void Cancel() { cancelled_.store(true); }
+
  private:
   friend class CurlRequestBuilder;
   /// Set the underlying CurlHandle options initially.
@@ -96,6 +166,7 @@ class CurlDownloadRequest {
   /// Wait until a condition is met.
   template <typename Predicate>
   void Wait(Predicate&& predicate) {
+    StartStallWindow();
     // We can assert that the current thread is the leader, because the
     // predicate is satisfied, and the condition variable exited. Therefore,
     // this thread must run the I/O event loop.
@@ -111,6 +182,9 @@ class CurlDownloadRequest {
       if (running_handles == 0 or predicate()) {
         return;
       }
+      if (CheckCancelled() or CheckStalled()) {
+        return;
+      }
       WaitForHandles();
     }
   }
@@ -121,6 +195,32 @@ class CurlDownloadRequest {
   /// Use libcurl to wait until the underlying data can perform work.
   void WaitForHandles();
 
+  /**
+   * Start measuring the throughput while the caller waits for data.
+   *
+   * A new window starts only for the first wait and after `GetMore()` returns
+   * data to the application. Callers polling with short timeouts, such as
+   * `WaitForFirstByte()`, continue the current window.
+   */
+  void StartStallWindow();
+
+  /**
+   * Abort the transfer if it is stalled.
+   *
+   * @return true if the transfer was aborted.
+   */
+  bool CheckStalled();
+
+  /**
+   * Abort the transfer if `Cancel()` was called.
+   *
+   * @return true if the transfer was aborted.
+   */
+  bool CheckCancelled();
+
+  /// Remove the handle from the CURLM* interface, terminating the transfer.
+  void AbortTransfer(CURLcode result);
+
   /// Simplify handling of errors in the curl_multi_* API.
   void RaiseOnError(char const* where, CURLMcode result);
 
@@ -146,8 +246,34 @@ class CurlDownloadRequest {
   // The curl_closed_ flag is set when we enter step 2, or when the transfer
   // completes.
   bool curl_closed_;
+  // The result of the transfer, as reported by curl_multi_info_read().
+  CURLcode transfer_result_;
+  // Set while the data received before a transfer error is returned, the
+  // error is reported by the next call to GetMore().
+  bool pending_error_;
 
   std::size_t initial_buffer_size_;
+
+  // The stall detection parameters, a zero duration disables each check.
+  std::chrono::milliseconds first_byte_timeout_;
+  std::chrono::milliseconds stall_timeout_;
+  std::int64_t stall_minimum_rate_;
+  // The throughput is only measured while the caller waits for data, if the
+  // application stops reading the transfer is paused, and that is not a stall.
+  bool started_;
+  std::chrono::steady_clock::time_point transfer_start_;
+  bool response_started_;
+  std::chrono::steady_clock::time_point window_start_;
+  std::int64_t window_bytes_;
+  // Set when `GetMore()` returns data, the application may not call again for
+  // a while and that time does not count against the transfer.
+  bool window_paused_;
+  // Set when the stall detection aborts the transfer.
+  bool stalled_;
+  // Set when the transfer is aborted, by the stall detection or `Cancel()`,
+  // the handle is already removed from the CURLM* interface in that case.
+  bool handle_removed_;
+  std::atomic<bool> cancelled_;
 };
 
 }  // namespace internal
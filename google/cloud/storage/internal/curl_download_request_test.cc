@@ -0,0 +1,111 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_download_request.h"
+#include "google/cloud/storage/internal/curl_client.h"
+#include "google/cloud/storage/internal/curl_request_builder.h"
+#include "google/cloud/storage/testing/fake_http_server.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::testing::HasSubstr;
+using storage::testing::FakeHttpConnection;
+using storage::testing::FakeHttpServer;
+
+/// Accept the connection and read the request, but never respond.
+void NeverRespond(FakeHttpConnection& connection) {
+  connection.ReadRequestHeaders();
+  connection.WaitForShutdown();
+}
+
+TEST(CurlDownloadRequestTest, StallWhilePollingForFirstByte) {
+  FakeHttpServer server(NeverRespond);
+  CurlRequestBuilder builder(server.url() + "/wedged");
+  builder.SetStallDetection(std::chrono::milliseconds(0),
+                            std::chrono::milliseconds(500), 1);
+  auto download = builder.BuildDownloadRequest(std::string{});
+
+  // Poll like `CurlClient::HedgedDownload()`, each call must continue the same
+  // measurement window.
+  auto start = std::chrono::steady_clock::now();
+  auto const limit = start + std::chrono::seconds(10);
+  while (not download.WaitForFirstByte(std::chrono::milliseconds(10)) and
+         std::chrono::steady_clock::now() < limit) {
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_TRUE(download.stalled());
+  EXPECT_LT(elapsed, std::chrono::seconds(5));
+
+  std::string buffer;
+  auto response = download.GetMore(buffer);
+  EXPECT_EQ(503, response.status_code) << ", payload=" << response.payload;
+  EXPECT_THAT(response.payload, HasSubstr("stalled"));
+}
+
+TEST(CurlDownloadRequestTest, StallWhileReading) {
+  FakeHttpServer server([](FakeHttpConnection& connection) {
+    connection.ReadRequestHeaders();
+    connection.Write(
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 1024\r\n"
+        "\r\n"
+        "0123456789");
+    connection.WaitForShutdown();
+  });
+  CurlRequestBuilder builder(server.url() + "/wedged");
+  builder.SetStallDetection(std::chrono::milliseconds(0),
+                            std::chrono::milliseconds(500), 1);
+  auto download = builder.BuildDownloadRequest(std::string{});
+
+  auto start = std::chrono::steady_clock::now();
+  std::string received;
+  HttpResponse response;
+  do {
+    std::string buffer;
+    response = download.GetMore(buffer);
+    received += buffer;
+  } while (response.status_code == 100);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(503, response.status_code) << ", payload=" << response.payload;
+  EXPECT_TRUE(download.stalled());
+  EXPECT_EQ("0123456789", received);
+  EXPECT_LT(elapsed, std::chrono::seconds(5));
+}
+
+TEST(CurlDownloadRequestTest, HedgedDownloadIsBounded) {
+  FakeHttpServer server(NeverRespond);
+  auto options = ClientOptions(CreateInsecureCredentials())
+                     .set_endpoint(server.url())
+                     .set_download_stall_timeout(std::chrono::milliseconds(500))
+                     .set_download_hedge_percentile(0.5);
+  CurlClient client(options);
+
+  auto start = std::chrono::steady_clock::now();
+  auto result = client.ReadObject(ReadObjectRangeRequest("bkt", "obj"));
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_TRUE(result.first.ok());
+  EXPECT_LT(elapsed, std::chrono::seconds(5));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -90,6 +90,11 @@ CurlHandle::CurlHandle() : handle_(curl_easy_init(), &curl_easy_cleanup) {
 
 CurlHandle::~CurlHandle() { FlushDebug(__func__); }
 
+void CurlHandle::SetShare(std::shared_ptr<CurlShare> share) {
+  SetOption(CURLOPT_SHARE, share ? share->get() : nullptr);
+  share_ = std::move(share);
+}
+
 void CurlHandle::SetReaderCallback(ReaderCallback callback) {
   reader_callback_ = std::move(callback);
   SetOption(CURLOPT_READDATA, &reader_callback_);
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_HANDLE_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_HANDLE_H_
 
+#include "google/cloud/storage/internal/curl_share.h"
 #include "google/cloud/storage/internal/curl_wrappers.h"
 #include <curl/curl.h>
 
@@ -40,13 +41,15 @@ class CurlHandle {
   CurlHandle& operator=(CurlHandle const&) = delete;
 
   // Allow moves, they immediately disable callbacks.
-  CurlHandle(CurlHandle&& rhs) : handle_(std::move(rhs.handle_)) {
+  CurlHandle(CurlHandle&& rhs)
+      : share_(std::move(rhs.share_)), handle_(std::move(rhs.handle_)) {
     ResetHeaderCallback();
     ResetReaderCallback();
     ResetWriterCallback();
   }
   CurlHandle& operator=(CurlHandle&& rhs) {
     handle_ = std::move(rhs.handle_);
+    share_ = std::move(rhs.share_);
     ResetHeaderCallback();
     ResetReaderCallback();
     ResetWriterCallback();
@@ -167,6 +170,9 @@ class CurlHandle {
 
   void EnableLogging(bool enabled);
 
+  /// Share the DNS cache and TLS sessions with other handles using @p share.
+  void SetShare(std::shared_ptr<CurlShare> share);
+
   /// Flush any debug data using GCP_LOG().
   void FlushDebug(char const* where);
 
@@ -190,6 +196,9 @@ class CurlHandle {
     RaiseSetOptionError(e, opt, param.c_str());
   }
 
+  // The share must outlive the handle, it is declared first so it is
+  // destroyed last.
+  std::shared_ptr<CurlShare> share_;
   using CurlPtr = std::unique_ptr<CURL, decltype(&curl_easy_cleanup)>;
   CurlPtr handle_;
   std::string debug_buffer_;
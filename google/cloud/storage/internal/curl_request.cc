@@ -23,7 +23,13 @@ namespace internal {
 CurlRequest::CurlRequest() : headers_(nullptr, &curl_slist_free_all) {}
 
 HttpResponse CurlRequest::MakeRequest() {
+  return MakeRequest(PayloadCallback());
+}
+
+HttpResponse CurlRequest::MakeRequest(PayloadCallback callback) {
+  payload_callback_ = std::move(callback);
   handle_.EasyPerform();
+  payload_callback_ = PayloadCallback();
   handle_.FlushDebug(__func__);
   long code = handle_.GetResponseCode();
   return HttpResponse{code, std::move(response_payload_),
@@ -40,6 +46,12 @@ void CurlRequest::ResetOptions() {
   }
   handle_.SetWriterCallback(
       [this](void* ptr, std::size_t size, std::size_t nmemb) {
+        // The headers, including the status line, are received before any
+        // of the payload, so the response code is known at this point.
+        if (payload_callback_ and handle_.GetResponseCode() < 300) {
+          payload_callback_(static_cast<char const*>(ptr), size * nmemb);
+          return size * nmemb;
+        }
         response_payload_.append(static_cast<char*>(ptr), size * nmemb);
         return size * nmemb;
       });
@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include <functional>
 
 namespace google {
 namespace cloud {
@@ -73,6 +74,24 @@ class CurlRequest {
    */
   HttpResponse MakeRequest();
 
+  /// The type of the callbacks to receive the payload as it arrives.
+  using PayloadCallback = std::function<void(char const* data, std::size_t)>;
+
+  /**
+   * Make the prepared request, passing the payload to @p callback.
+   *
+   * If the request is successful (the HTTP status code is less than 300), the
+   * response payload is passed to @p callback as it is received, and the
+   * `payload` field in the returned `HttpResponse` is empty. Otherwise the
+   * payload contains the error details and @p callback is not called.
+   *
+   * @param callback receives the response payload, it must not raise
+   *     exceptions because it is called from a libcurl callback.
+   *
+   * @throw std::runtime_error if the request cannot be made at all.
+   */
+  HttpResponse MakeRequest(PayloadCallback callback);
+
  private:
   friend class CurlRequestBuilder;
   void ResetOptions();
@@ -85,6 +104,7 @@ class CurlRequest {
   CurlReceivedHeaders received_headers_;
   bool logging_enabled_;
   CurlHandle handle_;
+  PayloadCallback payload_callback_;
 };
 
 }  // namespace internal
@@ -29,7 +29,10 @@ CurlRequestBuilder::CurlRequestBuilder(std::string base_url)
       url_(std::move(base_url)),
       query_parameter_separator_("?"),
       logging_enabled_(false),
-      initial_buffer_size_(GOOGLE_CLOUD_CPP_STORAGE_INITIAL_BUFFER_SIZE) {}
+      initial_buffer_size_(GOOGLE_CLOUD_CPP_STORAGE_INITIAL_BUFFER_SIZE),
+      first_byte_timeout_(0),
+      stall_timeout_(0),
+      stall_minimum_rate_(0) {}
 
 CurlRequest CurlRequestBuilder::BuildRequest(std::string payload) {
   ValidateBuilderState(__func__);
@@ -65,6 +68,9 @@ CurlDownloadRequest CurlRequestBuilder::BuildDownloadRequest(
   request.headers_ = std::move(headers_);
   request.user_agent_ = user_agent_prefix_ + UserAgentSuffix();
   request.payload_ = std::move(payload);
+  request.first_byte_timeout_ = first_byte_timeout_;
+  request.stall_timeout_ = stall_timeout_;
+  request.stall_minimum_rate_ = stall_minimum_rate_;
   request.handle_ = std::move(handle_);
   request.multi_.reset(curl_multi_init());
   request.logging_enabled_ = logging_enabled_;
@@ -111,12 +117,29 @@ CurlRequestBuilder& CurlRequestBuilder::SetDebugLogging(bool enabled) {
   return *this;
 }
 
+CurlRequestBuilder& CurlRequestBuilder::SetCurlShare(
+    std::shared_ptr<CurlShare> share) {
+  ValidateBuilderState(__func__);
+  handle_.SetShare(std::move(share));
+  return *this;
+}
+
 CurlRequestBuilder& CurlRequestBuilder::SetInitialBufferSize(std::size_t size) {
   ValidateBuilderState(__func__);
   initial_buffer_size_ = size;
   return *this;
 }
 
+CurlRequestBuilder& CurlRequestBuilder::SetStallDetection(
+    std::chrono::milliseconds first_byte_timeout,
+    std::chrono::milliseconds stall_timeout, std::int64_t stall_minimum_rate) {
+  ValidateBuilderState(__func__);
+  first_byte_timeout_ = first_byte_timeout;
+  stall_timeout_ = stall_timeout;
+  stall_minimum_rate_ = stall_minimum_rate;
+  return *this;
+}
+
 std::string CurlRequestBuilder::UserAgentSuffix() const {
   ValidateBuilderState(__func__);
   // Pre-compute and cache the user agent string:
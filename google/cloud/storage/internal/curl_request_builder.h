@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_BUILDER_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_BUILDER_H_
 
+#include "google/cloud/storage/internal/complex_option.h"
 #include "google/cloud/storage/internal/curl_download_request.h"
 #include "google/cloud/storage/internal/curl_request.h"
 #include "google/cloud/storage/internal/curl_upload_request.h"
@@ -89,6 +90,12 @@ class CurlRequestBuilder {
     return *this;
   }
 
+  /// Ignore options that are not sent to the service.
+  template <typename P, typename T>
+  CurlRequestBuilder& AddOption(ComplexOption<P, T> const&) {
+    return *this;
+  }
+
   /// Add a prefix to the user-agent string.
   CurlRequestBuilder& AddUserAgentPrefix(std::string const& prefix);
 
@@ -104,8 +111,23 @@ class CurlRequestBuilder {
 
   CurlRequestBuilder& SetDebugLogging(bool enabled);
 
+  /// Share the DNS cache and TLS sessions with other requests.
+  CurlRequestBuilder& SetCurlShare(std::shared_ptr<CurlShare> share);
+
   CurlRequestBuilder& SetInitialBufferSize(std::size_t size);
 
+  /**
+   * Configure the stall detection for download requests.
+   *
+   * The download is aborted if no response is received within
+   * @p first_byte_timeout, or if less than @p stall_minimum_rate bytes per
+   * second are received over @p stall_timeout while the caller waits for data.
+   * A zero duration disables each check.
+   */
+  CurlRequestBuilder& SetStallDetection(
+      std::chrono::milliseconds first_byte_timeout,
+      std::chrono::milliseconds stall_timeout, std::int64_t stall_minimum_rate);
+
   /// Get the user-agent suffix.
   std::string UserAgentSuffix() const;
 
@@ -128,6 +150,10 @@ class CurlRequestBuilder {
   bool logging_enabled_;
 
   std::size_t initial_buffer_size_;
+
+  std::chrono::milliseconds first_byte_timeout_;
+  std::chrono::milliseconds stall_timeout_;
+  std::int64_t stall_minimum_rate_;
 };
 
 }  // namespace internal
@@ -0,0 +1,80 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_share.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+extern "C" void CurlShareLock(CURL*, curl_lock_data data, curl_lock_access,
+                              void* userptr) {
+  static_cast<CurlShare*>(userptr)->Lock(data);
+}
+
+extern "C" void CurlShareUnlock(CURL*, curl_lock_data data, void* userptr) {
+  static_cast<CurlShare*>(userptr)->Unlock(data);
+}
+
+void RaiseOnError(char const* where, CURLSHcode e) {
+  if (e == CURLSHE_OK) {
+    return;
+  }
+  std::ostringstream os;
+  os << "CurlShare: error in " << where << " [" << e
+     << "]=" << curl_share_strerror(e);
+  google::cloud::internal::RaiseRuntimeError(os.str());
+}
+}  // namespace
+
+CurlShare::CurlShare() : share_(curl_share_init(), &curl_share_cleanup) {
+  if (not share_) {
+    google::cloud::internal::RaiseRuntimeError(
+        "Cannot initialize CURLSH handle");
+  }
+  RaiseOnError("CURLSHOPT_USERDATA",
+               curl_share_setopt(share_.get(), CURLSHOPT_USERDATA, this));
+  RaiseOnError("CURLSHOPT_LOCKFUNC",
+               curl_share_setopt(share_.get(), CURLSHOPT_LOCKFUNC,
+                                 &CurlShareLock));
+  RaiseOnError("CURLSHOPT_UNLOCKFUNC",
+               curl_share_setopt(share_.get(), CURLSHOPT_UNLOCKFUNC,
+                                 &CurlShareUnlock));
+  RaiseOnError("CURLSHOPT_SHARE(DNS)",
+               curl_share_setopt(share_.get(), CURLSHOPT_SHARE,
+                                 CURL_LOCK_DATA_DNS));
+  RaiseOnError("CURLSHOPT_SHARE(SSL_SESSION)",
+               curl_share_setopt(share_.get(), CURLSHOPT_SHARE,
+                                 CURL_LOCK_DATA_SSL_SESSION));
+}
+
+std::mutex& CurlShare::mutex(curl_lock_data data) {
+  // libcurl also locks the share object itself, using CURL_LOCK_DATA_SHARE,
+  // any value out of range uses that mutex too.
+  auto index = static_cast<int>(data);
+  if (index < 0 or index >= CURL_LOCK_DATA_LAST) {
+    index = CURL_LOCK_DATA_SHARE;
+  }
+  return mu_[index];
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
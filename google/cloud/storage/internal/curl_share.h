@@ -0,0 +1,71 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_SHARE_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_SHARE_H_
+
+#include "google/cloud/storage/version.h"
+#include <curl/curl.h>
+#include <memory>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A wrapper around CURLSH* handles.
+ *
+ * The handles created with the same `CurlShare` share their DNS cache and TLS
+ * sessions. New connections skip the DNS lookups, and resume the TLS session,
+ * which saves a round trip and most of the CPU cost of the handshake.
+ *
+ * The handles can be used from multiple threads, the shared data is protected
+ * by a mutex for each type of data. The `CurlHandle` objects keep a
+ * `std::shared_ptr` to this class, libcurl requires the share to outlive all
+ * the handles using it.
+ */
+class CurlShare {
+ public:
+  CurlShare();
+  ~CurlShare() = default;
+
+  CurlShare(CurlShare const&) = delete;
+  CurlShare& operator=(CurlShare const&) = delete;
+
+  CURLSH* get() const { return share_.get(); }
+
+  /// Called by libcurl to lock the shared @p data.
+  void Lock(curl_lock_data data) { mutex(data).lock(); }
+
+  /// Called by libcurl to unlock the shared @p data.
+  void Unlock(curl_lock_data data) { mutex(data).unlock(); }
+
+ private:
+  std::mutex& mutex(curl_lock_data data);
+
+  // curl_share_cleanup() locks the share through the callbacks, the mutexes
+  // must be declared first so they are destroyed after the share.
+  std::mutex mu_[CURL_LOCK_DATA_LAST];
+  std::unique_ptr<CURLSH, decltype(&curl_share_cleanup)> share_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_SHARE_H_
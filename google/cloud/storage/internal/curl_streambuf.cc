@@ -20,9 +20,17 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
-CurlReadStreambuf::CurlReadStreambuf(CurlDownloadRequest&& download,
-                                     std::size_t target_buffer_size)
-    : download_(std::move(download)), target_buffer_size_(target_buffer_size) {
+CurlReadStreambuf::CurlReadStreambuf(
+    CurlDownloadRequest&& download, std::size_t target_buffer_size,
+    std::size_t read_ahead, std::unique_ptr<HashValidator> hash_validator,
+    bool decompress_gzip)
+    : download_(std::move(download), read_ahead),
+      target_buffer_size_(target_buffer_size),
+      hash_validator_(std::move(hash_validator)),
+      hash_validator_result_{{}, {}, false},
+      decompress_gzip_(decompress_gzip),
+      content_encoding_checked_(false),
+      completed_(false) {
   // Start with an empty read area, to force an underflow() on the first
   // extraction.
   current_ios_buffer_.push_back('\0');
@@ -34,29 +42,112 @@ bool CurlReadStreambuf::IsOpen() const { return download_.IsOpen(); }
 
 HttpResponse CurlReadStreambuf::Close() { return download_.Close(); }
 
+std::multimap<std::string, std::string> CurlReadStreambuf::headers() const {
+  if (completed_) {
+    return headers_;
+  }
+  return download_.received_headers();
+}
+
 CurlReadStreambuf::int_type CurlReadStreambuf::underflow() {
-  if (not IsOpen()) {
-    current_ios_buffer_.clear();
-    current_ios_buffer_.push_back('\0');
-    char* data = &current_ios_buffer_[0];
-    setg(data, data + 1, data + 1);
-    return traits_type::eof();
+  while (true) {
+    if (decompressor_ and decompressor_->HasPendingData()) {
+      decompressor_->Decompress(current_ios_buffer_, target_buffer_size_);
+      if (not current_ios_buffer_.empty()) {
+        return SetGetArea();
+      }
+      continue;
+    }
+    if (not IsOpen()) {
+      if (decompressor_ and not decompressor_->stream_end()) {
+        google::cloud::internal::RaiseRuntimeError(
+            "CurlReadStreambuf: the gzip-encoded download is truncated");
+      }
+      return ReturnEof();
+    }
+    if (decompressor_) {
+      ReadRawData(compressed_buffer_);
+      decompressor_->Append(compressed_buffer_);
+      continue;
+    }
+    ReadRawData(current_ios_buffer_);
+    if (decompressor_) {
+      // This was the first chunk of a gzip-encoded download.
+      decompressor_->Append(current_ios_buffer_);
+      continue;
+    }
+    if (not current_ios_buffer_.empty()) {
+      return SetGetArea();
+    }
   }
+}
 
-  current_ios_buffer_.reserve(target_buffer_size_);
-  auto response = download_.GetMore(current_ios_buffer_);
+void CurlReadStreambuf::ReadRawData(std::string& buffer) {
+  buffer.reserve(target_buffer_size_);
+  auto response = download_.GetMore(buffer);
   if (response.status_code >= 300) {
+    status_ = Status(response.status_code, response.payload);
+    completed_ = true;
+    headers_ = std::move(response.headers);
     std::ostringstream os;
     os << "CurlDownloadRequest reports error: " << response.status_code
        << ", payload=" << response.payload;
     google::cloud::internal::RaiseRuntimeError(os.str());
   }
+  hash_validator_->Update(buffer.data(), buffer.size());
+  if (response.status_code == 100) {
+    CheckContentEncoding(download_.received_headers());
+    return;
+  }
+  // The download has completed, the headers are only available in the
+  // response at this point.
+  completed_ = true;
+  headers_ = response.headers;
+  CheckContentEncoding(response.headers);
+  bool transcoded = false;
+  for (auto const& kv : response.headers) {
+    hash_validator_->ProcessHeader(kv.first, kv.second);
+    // The service reports the hashes of the stored data, but decompresses
+    // gzip-encoded objects for clients that do not accept gzip. The hashes
+    // cannot be validated in that case.
+    if (kv.first == "x-guploader-response-body-transformations" and
+        kv.second.find("gunzipped") != std::string::npos) {
+      transcoded = true;
+    }
+  }
+  hash_validator_result_ = hash_validator_->Finish();
+  if (hash_validator_result_.is_mismatch and not transcoded) {
+    google::cloud::internal::RaiseRuntimeError(
+        FormatHashMismatch(__func__, hash_validator_result_));
+  }
+}
 
-  if (not current_ios_buffer_.empty()) {
-    char* data = &current_ios_buffer_[0];
-    setg(data, data, data + current_ios_buffer_.size());
-    return traits_type::to_int_type(*data);
+void CurlReadStreambuf::CheckContentEncoding(
+    CurlReceivedHeaders const& headers) {
+  if (content_encoding_checked_) {
+    return;
+  }
+  content_encoding_checked_ = true;
+  if (not decompress_gzip_) {
+    return;
+  }
+  auto range = headers.equal_range("content-encoding");
+  for (auto i = range.first; i != range.second; ++i) {
+    if (i->second == "gzip") {
+      decompressor_.reset(new GzipDecompressor);
+      return;
+    }
   }
+}
+
+CurlReadStreambuf::int_type CurlReadStreambuf::SetGetArea() {
+  char* data = &current_ios_buffer_[0];
+  setg(data, data, data + current_ios_buffer_.size());
+  return traits_type::to_int_type(*data);
+}
+
+CurlReadStreambuf::int_type CurlReadStreambuf::ReturnEof() {
+  current_ios_buffer_.clear();
   current_ios_buffer_.push_back('\0');
   char* data = &current_ios_buffer_[0];
   setg(data, data + 1, data + 1);
@@ -64,8 +155,15 @@ CurlReadStreambuf::int_type CurlReadStreambuf::underflow() {
 }
 
 CurlStreambuf::CurlStreambuf(CurlUploadRequest&& upload,
-                             std::size_t max_buffer_size)
-    : upload_(std::move(upload)), max_buffer_size_(max_buffer_size) {
+                             std::size_t max_buffer_size,
+                             std::size_t pipeline_depth,
+                             std::unique_ptr<HashValidator> hash_validator,
+                             std::unique_ptr<GzipCompressor> compressor)
+    : upload_(std::move(upload), pipeline_depth),
+      max_buffer_size_(max_buffer_size),
+      hash_validator_(std::move(hash_validator)),
+      hash_validator_result_{{}, {}, false},
+      compressor_(std::move(compressor)) {
   current_ios_buffer_.reserve(max_buffer_size);
 }
 
@@ -106,7 +204,25 @@ HttpResponse CurlStreambuf::DoClose() {
   GCP_LOG(INFO) << __func__ << "()";
   Validate(__func__);
   SwapBuffers();
-  return upload_.Close();
+  if (compressor_) {
+    compressed_buffer_.clear();
+    compressor_->Finish(compressed_buffer_);
+    SendBuffer(compressed_buffer_);
+  }
+  auto response = upload_.Close();
+  if (response.status_code >= 300) {
+    return response;
+  }
+  if (not response.payload.empty()) {
+    hash_validator_->ProcessMetadata(
+        ObjectMetadata::ParseFromString(response.payload));
+  }
+  hash_validator_result_ = hash_validator_->Finish();
+  if (hash_validator_result_.is_mismatch) {
+    google::cloud::internal::RaiseRuntimeError(
+        FormatHashMismatch(__func__, hash_validator_result_));
+  }
+  return response;
 }
 
 void CurlStreambuf::Validate(char const* where) const {
@@ -121,14 +237,27 @@ void CurlStreambuf::Validate(char const* where) const {
 void CurlStreambuf::SwapBuffers() {
   // Shorten the buffer to the actual used size.
   current_ios_buffer_.resize(pptr() - pbase());
-  // Push the buffer to the libcurl wrapper to be written as needed
-  upload_.NextBuffer(current_ios_buffer_);
+  if (compressor_) {
+    compressed_buffer_.clear();
+    compressor_->Compress(current_ios_buffer_.data(),
+                          current_ios_buffer_.size(), compressed_buffer_);
+    SendBuffer(compressed_buffer_);
+  } else {
+    SendBuffer(current_ios_buffer_);
+  }
   // Make the buffer big enough to receive more data before needing a flush.
   current_ios_buffer_.clear();
   current_ios_buffer_.reserve(max_buffer_size_);
   setp(&current_ios_buffer_[0], &current_ios_buffer_[0] + max_buffer_size_);
 }
 
+void CurlStreambuf::SendBuffer(std::string& buffer) {
+  hash_validator_->Update(buffer.data(), buffer.size());
+  // Queue the buffer, the pipeline sends it in the background and returns an
+  // empty buffer to fill.
+  upload_.NextBuffer(buffer);
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -15,8 +15,10 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_STREAMBUF_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_STREAMBUF_H_
 
-#include "google/cloud/storage/internal/curl_download_request.h"
-#include "google/cloud/storage/internal/curl_upload_request.h"
+#include "google/cloud/storage/internal/curl_download_pipeline.h"
+#include "google/cloud/storage/internal/curl_upload_pipeline.h"
+#include "google/cloud/storage/internal/gzip_codec.h"
+#include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/storage/internal/object_streambuf.h"
 
 namespace google {
@@ -26,37 +28,101 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 /**
  * Implement a wrapper for libcurl-based streaming downloads.
+ *
+ * The data is passed to @p hash_validator as it is received. When the download
+ * completes the hashes are compared against the `x-goog-hash` headers, and a
+ * mismatch raises an exception from `underflow()`, which sets the `badbit` in
+ * the stream.
+ *
+ * If @p decompress_gzip is true, and the response has a `Content-Encoding:
+ * gzip` header, the data is decompressed as it is read. The hashes are always
+ * computed over the data as received.
+ *
+ * If @p read_ahead is not zero a `CurlDownloadPipeline` receives up to that
+ * many buffers in the background, while the application consumes the data.
  */
 class CurlReadStreambuf : public ObjectReadStreambuf {
  public:
   explicit CurlReadStreambuf(CurlDownloadRequest&& download,
-                             std::size_t target_buffer_size);
+                             std::size_t target_buffer_size,
+                             std::size_t read_ahead,
+                             std::unique_ptr<HashValidator> hash_validator,
+                             bool decompress_gzip);
 
   ~CurlReadStreambuf() override = default;
 
   HttpResponse Close() override;
   bool IsOpen() const override;
+  std::string received_hash() const override {
+    return hash_validator_result_.received;
+  }
+  std::string computed_hash() const override {
+    return hash_validator_result_.computed;
+  }
+  Status status() const override { return status_; }
+  std::multimap<std::string, std::string> headers() const override;
 
  protected:
   int_type underflow() override;
 
  private:
-  CurlDownloadRequest download_;
+  /// Receive more data from the download, and validate it if it is complete.
+  void ReadRawData(std::string& buffer);
+
+  /// Create the decompressor if the response is gzip-encoded.
+  void CheckContentEncoding(CurlReceivedHeaders const& headers);
+
+  /// Set the iostream get area to the contents of `current_ios_buffer_`.
+  int_type SetGetArea();
+
+  /// Reset the iostream get area and return EOF.
+  int_type ReturnEof();
+
+  CurlDownloadPipeline download_;
   std::string current_ios_buffer_;
   std::size_t target_buffer_size_;
+  std::unique_ptr<HashValidator> hash_validator_;
+  HashValidator::Result hash_validator_result_;
+  bool decompress_gzip_;
+  bool content_encoding_checked_;
+  std::unique_ptr<GzipDecompressor> decompressor_;
+  std::string compressed_buffer_;
+  Status status_;
+  // Once the download completes the headers are moved to the last response.
+  bool completed_;
+  CurlReceivedHeaders headers_;
 };
 
 /**
  * Implement a wrapper for libcurl-based streaming uploads.
+ *
+ * The data is passed to @p hash_validator as it is sent. When the upload is
+ * closed the hashes are compared against the metadata of the new object, and a
+ * mismatch raises an exception from `Close()`.
+ *
+ * If @p compressor is not null the data is compressed before it is sent, and
+ * the hashes are computed over the compressed data.
+ *
+ * The buffers are sent by a `CurlUploadPipeline`, which keeps up to
+ * @p pipeline_depth buffers queued while the application fills the next one.
  */
 class CurlStreambuf : public ObjectWriteStreambuf {
  public:
   explicit CurlStreambuf(CurlUploadRequest&& upload,
-                         std::size_t max_buffer_size);
+                         std::size_t max_buffer_size,
+                         std::size_t pipeline_depth,
+                         std::unique_ptr<HashValidator> hash_validator,
+                         std::unique_ptr<GzipCompressor> compressor);
 
   ~CurlStreambuf() override = default;
 
   bool IsOpen() const override;
+  std::string received_hash() const override {
+    return hash_validator_result_.received;
+  }
+  std::string computed_hash() const override {
+    return hash_validator_result_.computed;
+  }
 
  protected:
   int sync() override;
@@ -71,9 +137,16 @@ class CurlStreambuf : public ObjectWriteStreambuf {
   /// Flush the libcurl buffer and swap it with the iostream buffer.
   void SwapBuffers();
 
-  CurlUploadRequest upload_;
+  /// Send @p buffer to the libcurl wrapper, updating the hashes.
+  void SendBuffer(std::string& buffer);
+
+  CurlUploadPipeline upload_;
   std::string current_ios_buffer_;
   std::size_t max_buffer_size_;
+  std::unique_ptr<HashValidator> hash_validator_;
+  HashValidator::Result hash_validator_result_;
+  std::unique_ptr<GzipCompressor> compressor_;
+  std::string compressed_buffer_;
 };
 
 }  // namespace internal
@@ -0,0 +1,150 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_upload_pipeline.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+CurlUploadPipeline::CurlUploadPipeline(CurlUploadRequest&& upload,
+                                       std::size_t max_pending)
+    : upload_(std::move(upload)),
+      max_pending_((std::max)(max_pending, std::size_t(1))),
+      sending_(false),
+      shutdown_(false),
+      closed_(false),
+      failed_(false) {
+  // Start the thread only after all the other members are initialized.
+  thread_ = std::thread(&CurlUploadPipeline::Run, this);
+}
+
+CurlUploadPipeline::~CurlUploadPipeline() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+    pending_.clear();
+  }
+  // The application did not call Close(), or Close() failed. Nobody waits for
+  // the upload to complete, so interrupt any transfer in progress.
+  upload_.Cancel();
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+bool CurlUploadPipeline::IsOpen() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return not closed_;
+}
+
+void CurlUploadPipeline::NextBuffer(std::string& buffer) {
+  if (buffer.empty()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] {
+    return failed_ or pending_.size() + (sending_ ? 1 : 0) < max_pending_;
+  });
+  RaiseIfFailed(lk);
+  pending_.emplace_back();
+  pending_.back().swap(buffer);
+  if (not free_.empty()) {
+    buffer.swap(free_.back());
+    free_.pop_back();
+  }
+  lk.unlock();
+  cv_.notify_all();
+}
+
+void CurlUploadPipeline::Flush() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk,
+           [this] { return failed_ or (pending_.empty() and not sending_); });
+  RaiseIfFailed(lk);
+}
+
+HttpResponse CurlUploadPipeline::Close() {
+  Flush();
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+    closed_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+  return upload_.Close();
+}
+
+void CurlUploadPipeline::Run() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (true) {
+    cv_.wait(lk, [this] { return shutdown_ or not pending_.empty(); });
+    // Close() flushes all the pending buffers before stopping this thread, on
+    // any other shutdown the remaining data is discarded.
+    if (shutdown_) {
+      return;
+    }
+    std::string buffer = std::move(pending_.front());
+    pending_.pop_front();
+    sending_ = true;
+    lk.unlock();
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      upload_.NextBuffer(buffer);
+      upload_.Flush();
+    } catch (...) {
+      lk.lock();
+      exception_ = std::current_exception();
+      failed_ = true;
+      sending_ = false;
+      pending_.clear();
+      cv_.notify_all();
+      return;
+    }
+#else
+    upload_.NextBuffer(buffer);
+    upload_.Flush();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    // `buffer` now holds the previous libcurl buffer, which was fully sent.
+    buffer.clear();
+    lk.lock();
+    free_.push_back(std::move(buffer));
+    sending_ = false;
+    cv_.notify_all();
+  }
+}
+
+void CurlUploadPipeline::RaiseIfFailed(std::unique_lock<std::mutex>& lk) {
+  if (not failed_) {
+    return;
+  }
+  lk.unlock();
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  std::rethrow_exception(exception_);
+#else
+  google::cloud::internal::RaiseRuntimeError(
+      "CurlUploadPipeline: error in background upload thread");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,104 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_UPLOAD_PIPELINE_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_UPLOAD_PIPELINE_H_
+
+#include "google/cloud/storage/internal/curl_upload_request.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Transfer the buffers of a `CurlUploadRequest` in a background thread.
+ *
+ * `CurlUploadRequest::NextBuffer()` blocks until libcurl has sent the previous
+ * buffer, so the application cannot produce more data while the network
+ * transfer runs. This class queues up to @p max_pending buffers, which are
+ * sent by a background thread. `NextBuffer()` only blocks once all the
+ * buffers are queued. The buffers are recycled, so their memory is allocated
+ * only once.
+ *
+ * The `CurlUploadRequest` is only used by the background thread until
+ * `Close()` is called, at that point the thread is stopped and the request is
+ * closed in the calling thread. Destroying the object without calling
+ * `Close()` abandons the upload, the queued buffers are discarded and the
+ * transfer is cancelled.
+ */
+class CurlUploadPipeline {
+ public:
+  CurlUploadPipeline(CurlUploadRequest&& upload, std::size_t max_pending);
+  ~CurlUploadPipeline();
+
+  CurlUploadPipeline(CurlUploadPipeline const&) = delete;
+  CurlUploadPipeline& operator=(CurlUploadPipeline const&) = delete;
+
+  bool IsOpen() const;
+
+  /**
+   * Queue the contents of @p buffer and replace it with an empty buffer.
+   *
+   * @throw the exception raised by the background thread, if any.
+   */
+  void NextBuffer(std::string& buffer);
+
+  /**
+   * Block until all the queued buffers are transferred.
+   *
+   * @throw the exception raised by the background thread, if any.
+   */
+  void Flush();
+
+  /// Transfer all the queued buffers and wait for the server's response.
+  HttpResponse Close();
+
+ private:
+  void Run();
+
+  /// Raise the exception captured from the background thread, if any.
+  void RaiseIfFailed(std::unique_lock<std::mutex>& lk);
+
+  CurlUploadRequest upload_;
+  std::size_t max_pending_;
+
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  // The buffers waiting to be sent, in order.
+  std::deque<std::string> pending_;
+  // Buffers already sent, ready to be reused.
+  std::vector<std::string> free_;
+  // True while the background thread is sending a buffer.
+  bool sending_;
+  bool shutdown_;
+  bool closed_;
+  bool failed_;
+  std::exception_ptr exception_;
+  std::thread thread_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_UPLOAD_PIPELINE_H_
@@ -0,0 +1,105 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_upload_pipeline.h"
+#include "google/cloud/storage/internal/curl_request_builder.h"
+#include "google/cloud/storage/testing/fake_http_server.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using storage::testing::FakeHttpConnection;
+using storage::testing::FakeHttpServer;
+
+CurlUploadRequest MakeUpload(std::string const& url) {
+  CurlRequestBuilder builder(url);
+  return builder.BuildUpload();
+}
+
+TEST(CurlUploadPipelineTest, Close) {
+  std::mutex mu;
+  std::string received;
+  FakeHttpServer server([&](FakeHttpConnection& connection) {
+    connection.ReadRequestHeaders();
+    auto body = connection.ReadChunkedBody();
+    {
+      std::lock_guard<std::mutex> lk(mu);
+      received = std::move(body);
+    }
+    connection.Write("HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n{}");
+    connection.WaitForShutdown();
+  });
+  CurlUploadPipeline pipeline(MakeUpload(server.url() + "/upload"), 2);
+
+  std::string expected;
+  for (char c = 'a'; c != 'i'; ++c) {
+    std::string buffer(1024, c);
+    expected += buffer;
+    pipeline.NextBuffer(buffer);
+  }
+  auto response = pipeline.Close();
+  EXPECT_EQ(200, response.status_code);
+  EXPECT_EQ("{}", response.payload);
+  EXPECT_FALSE(pipeline.IsOpen());
+  std::lock_guard<std::mutex> lk(mu);
+  EXPECT_EQ(expected, received);
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST(CurlUploadPipelineTest, ErrorInBackgroundThread) {
+  CurlUploadPipeline pipeline(
+      MakeUpload(storage::testing::UnusedLoopbackUrl() + "/upload"), 2);
+
+  // The buffer may be queued before the background thread fails, in that
+  // case the error is reported by `Flush()`.
+  std::string buffer(1024, 'x');
+  EXPECT_THROW(
+      {
+        pipeline.NextBuffer(buffer);
+        pipeline.Flush();
+      },
+      std::runtime_error);
+  EXPECT_THROW(pipeline.Close(), std::runtime_error);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+TEST(CurlUploadPipelineTest, DestroyWithoutClose) {
+  // The server never reads the data, so the upload cannot complete.
+  FakeHttpServer server([](FakeHttpConnection& connection) {
+    connection.ReadRequestHeaders();
+    connection.WaitForShutdown();
+  });
+  auto start = std::chrono::steady_clock::now();
+  {
+    CurlUploadPipeline pipeline(MakeUpload(server.url() + "/upload"), 2);
+    // More data than the socket buffers can hold, and few enough buffers that
+    // `NextBuffer()` does not block.
+    for (int i = 0; i != 2; ++i) {
+      std::string buffer(16 * 1024 * 1024, 'x');
+      pipeline.NextBuffer(buffer);
+    }
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
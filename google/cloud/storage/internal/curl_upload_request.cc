@@ -30,7 +30,10 @@ CurlUploadRequest::CurlUploadRequest(std::size_t initial_buffer_size)
     : headers_(nullptr, &curl_slist_free_all),
       multi_(nullptr, &curl_multi_cleanup),
       closing_(false),
-      curl_closed_(false) {
+      curl_closed_(false),
+      transfer_result_(CURLE_OK),
+      handle_removed_(false),
+      cancelled_(false) {
   buffer_.reserve(initial_buffer_size);
   buffer_rdptr_ = buffer_.end();
 }
@@ -44,6 +47,7 @@ void CurlUploadRequest::Flush() {
                  << ", curl.end="
                  << std::distance(buffer_.begin(), buffer_.end());
   Wait([this] { return buffer_rdptr_ == buffer_.end(); });
+  RaiseOnTransferError(__func__);
 }
 
 HttpResponse CurlUploadRequest::Close() {
@@ -57,8 +61,11 @@ HttpResponse CurlUploadRequest::Close() {
   Wait([this] { return curl_closed_; });
 
   // Now remove the handle from the CURLM* interface and wait for the response.
-  auto error = curl_multi_remove_handle(multi_.get(), handle_.handle_.get());
-  RaiseOnError(__func__, error);
+  if (not handle_removed_) {
+    auto error = curl_multi_remove_handle(multi_.get(), handle_.handle_.get());
+    RaiseOnError(__func__, error);
+  }
+  RaiseOnTransferError(__func__);
 
   long http_code = handle_.GetResponseCode();
   return HttpResponse{http_code, std::move(response_payload_),
@@ -170,6 +177,7 @@ int CurlUploadRequest::PerformWork() {
                      << "]=" << curl_easy_strerror(msg->data.result);
       // The transfer is done, set the state flags appropriately.
       curl_closed_ = true;
+      transfer_result_ = msg->data.result;
     } while (remaining > 0);
   }
   return running_handles;
@@ -180,6 +188,20 @@ void CurlUploadRequest::WaitForHandles() {
   RaiseOnError(__func__, result);
 }
 
+bool CurlUploadRequest::CheckCancelled() {
+  if (not cancelled_.load()) {
+    return false;
+  }
+  GCP_LOG(DEBUG) << __func__ << "() aborting upload to " << url_;
+  // Removing the handle aborts the transfer, the connection is not reused.
+  auto error = curl_multi_remove_handle(multi_.get(), handle_.handle_.get());
+  RaiseOnError(__func__, error);
+  handle_removed_ = true;
+  curl_closed_ = true;
+  transfer_result_ = CURLE_ABORTED_BY_CALLBACK;
+  return true;
+}
+
 void CurlUploadRequest::RaiseOnError(char const* where, CURLMcode result) {
   if (result == CURLM_OK) {
     return;
@@ -190,6 +212,24 @@ void CurlUploadRequest::RaiseOnError(char const* where, CURLMcode result) {
   google::cloud::internal::RaiseRuntimeError(os.str());
 }
 
+void CurlUploadRequest::RaiseOnTransferError(char const* where) {
+  if (not curl_closed_ or transfer_result_ == CURLE_OK) {
+    return;
+  }
+  // If the server responded the error is in the response, which is returned
+  // by Close(). Interim responses, such as 100-Continue, do not count.
+  if (handle_.GetResponseCode() >= 200) {
+    return;
+  }
+  std::ostringstream os;
+  os << "Error [" << transfer_result_
+     << "]=" << curl_easy_strerror(transfer_result_) << " in " << where;
+  if (cancelled_) {
+    os << ", the upload was cancelled";
+  }
+  google::cloud::internal::RaiseRuntimeError(os.str());
+}
+
 void CurlUploadRequest::ValidateOpen(char const* where) {
   if (not closing_) {
     return;
@@ -18,6 +18,7 @@
 #include "google/cloud/log.h"
 #include "google/cloud/storage/internal/curl_request.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include <atomic>
 
 namespace google {
 namespace cloud {
@@ -48,7 +49,10 @@ class CurlUploadRequest {
         buffer_(std::move(rhs.buffer_)),
         buffer_rdptr_(rhs.buffer_rdptr_),
         closing_(rhs.closing_),
-        curl_closed_(rhs.curl_closed_) {
+        curl_closed_(rhs.curl_closed_),
+        transfer_result_(rhs.transfer_result_),
+        handle_removed_(rhs.handle_removed_),
+        cancelled_(rhs.cancelled_.load()) {
     ResetOptions();
   }
 
@@ -63,18 +67,35 @@ class CurlUploadRequest {
     buffer_rdptr_ = rhs.buffer_rdptr_;
     closing_ = rhs.closing_;
     curl_closed_ = rhs.curl_closed_;
+    transfer_result_ = rhs.transfer_result_;
+    handle_removed_ = rhs.handle_removed_;
+    cancelled_.store(rhs.cancelled_.load());
     ResetOptions();
     return *this;
   }
 
   bool IsOpen() const { return not closing_; }
 
-  /// Block until the current buffer has been transferred.
+  /**
+   * Block until the current buffer has been transferred.
+   *
+   * @throw std::runtime_error if the transfer fails before the server
+   *     responds, e.g. because the connection cannot be established.
+   */
   void Flush();
 
   /// Close the transfer and wait for the server's response.
   HttpResponse Close();
 
+  /**
+   * Abort the transfer, this is the only member function safe to call from
+   * another thread.
+   *
+   * A thread blocked in `Flush()`, `NextBuffer()` or `Close()` returns
+   * promptly, with an exception if the server has not responded.
+   */
+  void Cancel() { cancelled_.store(true); }
+
   /**
    * Flush the current buffer and swap the current buffer with @p next_buffer.
    *
@@ -115,6 +136,9 @@ class CurlUploadRequest {
       if (running_handles == 0 or predicate()) {
         return;
       }
+      if (CheckCancelled()) {
+        return;
+      }
       WaitForHandles();
     }
   }
@@ -125,9 +149,19 @@ class CurlUploadRequest {
   /// Use libcurl to wait until the underlying data can perform work.
   void WaitForHandles();
 
+  /**
+   * Abort the transfer if `Cancel()` was called.
+   *
+   * @return true if the transfer was aborted.
+   */
+  bool CheckCancelled();
+
   /// Simplify handling of errors in the curl_multi_* API.
   void RaiseOnError(char const* where, CURLMcode result);
 
+  /// Raise an exception if the transfer failed without a response.
+  void RaiseOnTransferError(char const* where);
+
   /// Raise an exception if the application tries to use a closed request.
   void ValidateOpen(char const* where);
 
@@ -155,6 +189,12 @@ class CurlUploadRequest {
   bool closing_;
   // The curl_closed_ flag is set when we enter step 2.
   bool curl_closed_;
+  // The result of the transfer, as reported by curl_multi_info_read().
+  CURLcode transfer_result_;
+  // Set when `Cancel()` aborts the transfer, the handle is already removed
+  // from the CURLM* interface in that case.
+  bool handle_removed_;
+  std::atomic<bool> cancelled_;
 };
 
 }  // namespace internal
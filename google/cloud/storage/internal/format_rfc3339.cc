@@ -15,6 +15,7 @@
 #include "google/cloud/storage/internal/format_rfc3339.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include <cctype>
+#include <cstdint>
 #include <cstdio>
 #include <iomanip>
 #include <iostream>
@@ -48,6 +49,30 @@ std::string FormatFractional(std::chrono::nanoseconds ns) {
   result += buffer;
   return result;
 }
+
+/// Convert days since 1970-01-01 to a civil date (in the proleptic Gregorian
+/// calendar), see http://howardhinnant.github.io/date_algorithms.html
+void CivilFromDays(std::int64_t days, std::int64_t& year, unsigned& month,
+                   unsigned& day) {
+  days += 719468;
+  std::int64_t const era = (days >= 0 ? days : days - 146096) / 146097;
+  auto const doe = static_cast<unsigned>(days - era * 146097);
+  unsigned const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  unsigned const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  unsigned const mp = (5 * doy + 2) / 153;
+  day = doy - (153 * mp + 2) / 5 + 1;
+  month = mp < 10 ? mp + 3 : mp - 9;
+  year = static_cast<std::int64_t>(yoe) + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+/// Write @p value as exactly @p width decimal digits, ending before @p end.
+char* WriteDigits(char* end, std::int64_t value, int width) {
+  for (int i = 0; i != width; ++i) {
+    *--end = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+  return end;
+}
 }  // namespace
 
 namespace google {
@@ -57,6 +82,50 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
 std::string FormatRfc3339(std::chrono::system_clock::time_point tp) {
+  using std::chrono::duration_cast;
+  auto const duration = tp.time_since_epoch();
+  auto whole_seconds = duration_cast<std::chrono::seconds>(duration);
+  // Round towards negative infinity, so the fractional part is positive.
+  if (whole_seconds > duration) {
+    whole_seconds -= std::chrono::seconds(1);
+  }
+  std::int64_t const nanos =
+      duration_cast<std::chrono::nanoseconds>(duration - whole_seconds).count();
+  std::int64_t days = whole_seconds.count() / 86400;
+  std::int64_t seconds_of_day = whole_seconds.count() % 86400;
+  if (seconds_of_day < 0) {
+    seconds_of_day += 86400;
+    --days;
+  }
+  std::int64_t year;
+  unsigned month, day;
+  CivilFromDays(days, year, month, day);
+  if (year < 0 or year > 9999) {
+    return FormatRfc3339Generic(tp);
+  }
+
+  // Fill a fixed layout: YYYY-MM-DDTHH:MM:SS.nnnnnnnnnZ
+  char buffer[] = "0000-00-00T00:00:00.000000000Z";
+  WriteDigits(buffer + 4, year, 4);
+  WriteDigits(buffer + 7, month, 2);
+  WriteDigits(buffer + 10, day, 2);
+  WriteDigits(buffer + 13, seconds_of_day / 3600, 2);
+  WriteDigits(buffer + 16, seconds_of_day / 60 % 60, 2);
+  WriteDigits(buffer + 19, seconds_of_day % 60, 2);
+  // Use the shortest of milliseconds, microseconds or nanoseconds that
+  // represents the fractional seconds exactly, as FormatFractional() does.
+  int fractional_digits = 0;
+  if (nanos != 0) {
+    fractional_digits = nanos % 1000000 == 0 ? 3 : nanos % 1000 == 0 ? 6 : 9;
+    WriteDigits(buffer + 29, nanos, 9);
+  }
+  std::size_t const length =
+      19 + (fractional_digits == 0 ? 0 : 1 + fractional_digits);
+  buffer[length] = 'Z';
+  return std::string(buffer, length + 1);
+}
+
+std::string FormatRfc3339Generic(std::chrono::system_clock::time_point tp) {
   std::time_t time = std::chrono::system_clock::to_time_t(tp);
   std::tm tm;
   // The standard C++ function to convert time_t to a struct tm is not thread
@@ -38,10 +38,21 @@ namespace internal {
  * most platforms time points have sub-second precision, and microseconds are
  * common.
  *
+ * The digits are written directly into a fixed layout, years outside the
+ * [0000, 9999] range are formatted by `FormatRfc3339Generic()`.
+ *
  * @see https://tools.ietf.org/html/rfc3339
  */
 std::string FormatRfc3339(std::chrono::system_clock::time_point tp);
 
+/**
+ * Format @p tp as a RFC-3339 timestamp using `strftime(3)`.
+ *
+ * Applications should use `FormatRfc3339()`, this function is only exposed to
+ * test and benchmark the fast path against it.
+ */
+std::string FormatRfc3339Generic(std::chrono::system_clock::time_point tp);
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
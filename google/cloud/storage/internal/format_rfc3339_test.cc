@@ -72,6 +72,36 @@ TEST(FormatRfc3339Test, FractionalNanos) {
   }
 }
 
+TEST(FormatRfc3339Test, BeforeEpoch) {
+  std::chrono::system_clock::time_point timestamp(
+      std::chrono::milliseconds(-750));
+  EXPECT_EQ("1969-12-31T23:59:59.250Z", FormatRfc3339(timestamp));
+}
+
+TEST(FormatRfc3339Test, LeapYear) {
+  auto timestamp = ParseRfc3339("2016-02-29T23:59:59Z");
+  EXPECT_EQ("2016-02-29T23:59:59Z", FormatRfc3339(timestamp));
+  timestamp += std::chrono::seconds(1);
+  EXPECT_EQ("2016-03-01T00:00:00Z", FormatRfc3339(timestamp));
+}
+
+/// @test Verify the fast path agrees with the strftime(3)-based formatter.
+TEST(FormatRfc3339Test, FastPathMatchesGeneric) {
+  using std::chrono::milliseconds;
+  using std::chrono::seconds;
+  std::chrono::system_clock::time_point timestamp;
+  // Use a step that is not a multiple of days, hours or minutes, to visit
+  // different values for all the fields, including the fractional seconds.
+  auto const step = seconds(86400 * 37 + 3600 * 5 + 60 * 7 + 11);
+  for (int i = 0; i != 1000; ++i) {
+    timestamp += step;
+    EXPECT_EQ(FormatRfc3339Generic(timestamp), FormatRfc3339(timestamp));
+    auto with_fraction = timestamp + milliseconds(i);
+    EXPECT_EQ(FormatRfc3339Generic(with_fraction),
+              FormatRfc3339(with_fraction));
+  }
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -46,6 +46,8 @@ class GenericRequestBase<Derived, Option> {
     return *static_cast<Derived*>(this);
   }
 
+  Option const& get_option(Option const* /*tag*/) const { return option_; }
+
   template <typename HttpRequest>
   void AddOptionsToHttpRequest(HttpRequest& request) const {
     request.AddOption(option_);
@@ -71,12 +73,15 @@ template <typename Derived, typename Option, typename... Options>
 class GenericRequestBase : public GenericRequestBase<Derived, Options...> {
  public:
   using GenericRequestBase<Derived, Options...>::set_option;
+  using GenericRequestBase<Derived, Options...>::get_option;
 
   Derived& set_option(Option&& p) {
     option_ = std::move(p);
     return *static_cast<Derived*>(this);
   }
 
+  Option const& get_option(Option const* /*tag*/) const { return option_; }
+
   template <typename HttpRequest>
   void AddOptionsToHttpRequest(HttpRequest& request) const {
     request.AddOption(option_);
@@ -149,6 +154,13 @@ class GenericRequest : public GenericRequestBase<Derived, Options...> {
   }
 
   Derived& set_multiple_options() { return *static_cast<Derived*>(this); }
+
+  /// Return the value of one of the options, e.g. `get_option<Prefix>()`.
+  template <typename Option>
+  Option const& get_option() const {
+    return GenericRequestBase<Derived, Options...>::get_option(
+        static_cast<Option const*>(nullptr));
+  }
 };
 
 }  // namespace internal
@@ -16,6 +16,7 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GET_OBJECT_METADATA_REQUEST_H_
 
 #include "google/cloud/storage/internal/generic_request.h"
+#include "google/cloud/storage/well_known_headers.h"
 #include "google/cloud/storage/well_known_parameters.h"
 #include <iosfwd>
 
@@ -28,10 +29,10 @@ namespace internal {
  * Request the metadata for a bucket.
  */
 class GetObjectMetadataRequest
-    : public GenericRequest<GetObjectMetadataRequest, Generation,
+    : public GenericRequest<GetObjectMetadataRequest, Fields, Generation,
                             IfGenerationMatch, IfGenerationNotMatch,
                             IfMetaGenerationMatch, IfMetaGenerationNotMatch,
-                            Projection, UserProject> {
+                            IfNoneMatchEtag, Projection, UserProject> {
  public:
   GetObjectMetadataRequest() = default;
   explicit GetObjectMetadataRequest(std::string bucket_name,
@@ -0,0 +1,147 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/gzip_codec.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <cstring>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+// Adding 16 to the window bits selects the gzip format in deflateInit2(), and
+// adding 32 enables automatic detection of gzip and zlib in inflateInit2().
+int const GZIP_WINDOW_BITS = 15 + 16;
+int const AUTODETECT_WINDOW_BITS = 15 + 32;
+int const DEFAULT_MEMORY_LEVEL = 8;
+std::size_t const DEFLATE_CHUNK_SIZE = 64 * 1024;
+
+void RaiseZlibError(char const* where, int result, z_stream const& stream) {
+  std::ostringstream os;
+  os << where << ": zlib error [" << result << "]";
+  if (stream.msg != nullptr) {
+    os << " " << stream.msg;
+  }
+  google::cloud::internal::RaiseRuntimeError(os.str());
+}
+}  // namespace
+
+GzipCompressor::GzipCompressor(int level) {
+  std::memset(&stream_, 0, sizeof(stream_));
+  auto result = deflateInit2(&stream_, level, Z_DEFLATED, GZIP_WINDOW_BITS,
+                             DEFAULT_MEMORY_LEVEL, Z_DEFAULT_STRATEGY);
+  if (result != Z_OK) {
+    RaiseZlibError(__func__, result, stream_);
+  }
+}
+
+GzipCompressor::~GzipCompressor() { deflateEnd(&stream_); }
+
+void GzipCompressor::Compress(char const* data, std::size_t size,
+                              std::string& output) {
+  stream_.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(size == 0 ? "" : data));
+  stream_.avail_in = static_cast<uInt>(size);
+  Deflate(Z_NO_FLUSH, output);
+}
+
+void GzipCompressor::Finish(std::string& output) {
+  stream_.next_in = nullptr;
+  stream_.avail_in = 0;
+  Deflate(Z_FINISH, output);
+}
+
+void GzipCompressor::Deflate(int flush, std::string& output) {
+  while (true) {
+    auto offset = output.size();
+    output.resize(offset + DEFLATE_CHUNK_SIZE);
+    stream_.next_out = reinterpret_cast<Bytef*>(&output[offset]);
+    stream_.avail_out = static_cast<uInt>(DEFLATE_CHUNK_SIZE);
+    auto result = deflate(&stream_, flush);
+    output.resize(output.size() - stream_.avail_out);
+    if (result == Z_STREAM_END) {
+      return;
+    }
+    if (result != Z_OK and result != Z_BUF_ERROR) {
+      RaiseZlibError(__func__, result, stream_);
+    }
+    // deflate() only leaves space in the output buffer once it has consumed
+    // all the input and (for Z_FINISH) written all the output.
+    if (stream_.avail_out != 0 and flush != Z_FINISH) {
+      return;
+    }
+  }
+}
+
+GzipDecompressor::GzipDecompressor()
+    : output_may_be_pending_(false), stream_end_(false) {
+  std::memset(&stream_, 0, sizeof(stream_));
+  auto result = inflateInit2(&stream_, AUTODETECT_WINDOW_BITS);
+  if (result != Z_OK) {
+    RaiseZlibError(__func__, result, stream_);
+  }
+}
+
+GzipDecompressor::~GzipDecompressor() { inflateEnd(&stream_); }
+
+void GzipDecompressor::Append(std::string const& data) {
+  // Discard the input already consumed by zlib before adding more data.
+  input_.erase(0, input_.size() - stream_.avail_in);
+  input_.append(data);
+  stream_.next_in = reinterpret_cast<Bytef*>(&input_[0]);
+  stream_.avail_in = static_cast<uInt>(input_.size());
+}
+
+void GzipDecompressor::Decompress(std::string& output, std::size_t max_size) {
+  output.resize(max_size);
+  stream_.next_out = reinterpret_cast<Bytef*>(&output[0]);
+  stream_.avail_out = static_cast<uInt>(max_size);
+  while (stream_.avail_out != 0) {
+    if (stream_end_ and stream_.avail_in != 0) {
+      // The data contains multiple gzip members, as produced by `cat a.gz
+      // b.gz`, decompress them as a single stream.
+      auto result = inflateReset(&stream_);
+      if (result != Z_OK) {
+        RaiseZlibError(__func__, result, stream_);
+      }
+      stream_end_ = false;
+    }
+    auto result = inflate(&stream_, Z_NO_FLUSH);
+    if (result == Z_STREAM_END) {
+      stream_end_ = true;
+      if (stream_.avail_in == 0) {
+        break;
+      }
+      continue;
+    }
+    if (result == Z_BUF_ERROR) {
+      // No progress is possible without more input.
+      break;
+    }
+    if (result != Z_OK) {
+      RaiseZlibError(__func__, result, stream_);
+    }
+  }
+  output_may_be_pending_ = stream_.avail_out == 0;
+  output.resize(max_size - stream_.avail_out);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,99 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GZIP_CODEC_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GZIP_CODEC_H_
+
+#include "google/cloud/storage/version.h"
+#include <zlib.h>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Compress a stream of data in gzip format, one buffer at a time.
+ *
+ * The memory used by this class is bounded by the zlib state, the output is
+ * appended to the caller's buffers as it is produced.
+ */
+class GzipCompressor {
+ public:
+  explicit GzipCompressor(int level = Z_DEFAULT_COMPRESSION);
+  ~GzipCompressor();
+
+  GzipCompressor(GzipCompressor const&) = delete;
+  GzipCompressor& operator=(GzipCompressor const&) = delete;
+
+  /// Compress @p size bytes from @p data, appending any output to @p output.
+  void Compress(char const* data, std::size_t size, std::string& output);
+
+  /// Flush any buffered data and the gzip trailer, appending to @p output.
+  void Finish(std::string& output);
+
+ private:
+  void Deflate(int flush, std::string& output);
+
+  z_stream stream_;
+};
+
+/**
+ * Decompress a stream of gzip data, one buffer at a time.
+ *
+ * The caller appends compressed data as it is received, and extracts the
+ * decompressed data in bounded chunks, so highly compressed data does not
+ * require large buffers.
+ */
+class GzipDecompressor {
+ public:
+  GzipDecompressor();
+  ~GzipDecompressor();
+
+  GzipDecompressor(GzipDecompressor const&) = delete;
+  GzipDecompressor& operator=(GzipDecompressor const&) = delete;
+
+  /// Add more compressed data.
+  void Append(std::string const& data);
+
+  /// Return true if `Decompress()` may produce more data without more input.
+  bool HasPendingData() const {
+    return stream_.avail_in != 0 or output_may_be_pending_;
+  }
+
+  /// Return true if the end of the (last) gzip member was found.
+  bool stream_end() const { return stream_end_; }
+
+  /**
+   * Decompress at most @p max_size bytes.
+   *
+   * @param output the decompressed data, its contents are replaced.
+   */
+  void Decompress(std::string& output, std::size_t max_size);
+
+ private:
+  z_stream stream_;
+  std::string input_;
+  bool output_may_be_pending_;
+  bool stream_end_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_GZIP_CODEC_H_
@@ -0,0 +1,120 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/gzip_codec.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+std::string const QUICK_FOX = "The quick brown fox jumps over the lazy dog";
+// The output of `gzip` (with a zero timestamp) for QUICK_FOX.
+std::string const QUICK_FOX_GZIP(
+    "\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\x03\x0b\xc9\x48\x55\x28\x2c\xcd\x4c"
+    "\xce\x56\x48\x2a\xca\x2f\xcf\x53\x48\xcb\xaf\x50\xc8\x2a\xcd\x2d\x28\x56"
+    "\xc8\x2f\x4b\x2d\x52\x28\x01\x4a\xe7\x24\x56\x55\x2a\xa4\xe4\xa7\x03\x00"
+    "\x39\xa3\x4f\x41\x2b\x00\x00\x00",
+    62);
+
+std::string Compress(std::string const& data, std::size_t chunk_size) {
+  GzipCompressor compressor;
+  std::string compressed;
+  for (std::size_t offset = 0; offset < data.size(); offset += chunk_size) {
+    auto size = (std::min)(chunk_size, data.size() - offset);
+    compressor.Compress(data.data() + offset, size, compressed);
+  }
+  compressor.Finish(compressed);
+  return compressed;
+}
+
+std::string Decompress(std::string const& compressed, std::size_t chunk_size,
+                       std::size_t max_output) {
+  GzipDecompressor decompressor;
+  std::string result;
+  std::string output;
+  for (std::size_t offset = 0; offset < compressed.size();
+       offset += chunk_size) {
+    decompressor.Append(compressed.substr(offset, chunk_size));
+    while (decompressor.HasPendingData()) {
+      decompressor.Decompress(output, max_output);
+      EXPECT_LE(output.size(), max_output);
+      result += output;
+    }
+  }
+  EXPECT_TRUE(decompressor.stream_end());
+  return result;
+}
+
+TEST(GzipCodecTest, DecompressKnownValue) {
+  EXPECT_EQ(QUICK_FOX, Decompress(QUICK_FOX_GZIP, 1024, 1024));
+  EXPECT_EQ(QUICK_FOX, Decompress(QUICK_FOX_GZIP, 3, 5));
+}
+
+TEST(GzipCodecTest, RoundTrip) {
+  std::string data;
+  for (int i = 0; i != 10000; ++i) {
+    data += std::to_string(i) + ": " + QUICK_FOX + "\n";
+  }
+  auto compressed = Compress(data, 4096);
+  EXPECT_LT(compressed.size(), data.size() / 4);
+  EXPECT_EQ(data, Decompress(compressed, 1000, 64 * 1024));
+}
+
+TEST(GzipCodecTest, BoundedOutput) {
+  // Highly compressible data must not require large output buffers.
+  std::string data(4 * 1024 * 1024, 'x');
+  auto compressed = Compress(data, data.size());
+  EXPECT_LT(compressed.size(), 16 * 1024U);
+  EXPECT_EQ(data, Decompress(compressed, compressed.size(), 8 * 1024));
+}
+
+TEST(GzipCodecTest, EmptyStream) {
+  auto compressed = Compress(std::string{}, 1);
+  EXPECT_FALSE(compressed.empty());
+  EXPECT_EQ("", Decompress(compressed, 1, 16));
+}
+
+TEST(GzipCodecTest, MultipleMembers) {
+  auto compressed = QUICK_FOX_GZIP + Compress("\nsecond member", 4);
+  EXPECT_EQ(QUICK_FOX + "\nsecond member", Decompress(compressed, 7, 11));
+}
+
+TEST(GzipCodecTest, Truncated) {
+  GzipDecompressor decompressor;
+  decompressor.Append(QUICK_FOX_GZIP.substr(0, 30));
+  std::string output;
+  decompressor.Decompress(output, 1024);
+  EXPECT_FALSE(decompressor.HasPendingData());
+  EXPECT_FALSE(decompressor.stream_end());
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST(GzipCodecTest, InvalidData) {
+  GzipDecompressor decompressor;
+  decompressor.Append("this is not compressed data");
+  std::string output;
+  EXPECT_THROW(decompressor.Decompress(output, 1024), std::runtime_error);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
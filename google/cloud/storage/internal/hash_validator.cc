@@ -0,0 +1,204 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include "google/cloud/storage/internal/crc32c.h"
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+/**
+ * Find a hash in the value of a `x-goog-hash` header.
+ *
+ * The service may return multiple `x-goog-hash` headers, or a single header
+ * with comma separated values, e.g. `crc32c=n03x6A==,md5=...`.
+ */
+std::string ExtractHashValue(std::string const& hash_key,
+                             std::string const& header_value) {
+  auto const prefix = hash_key + "=";
+  std::istringstream is(header_value);
+  std::string token;
+  while (std::getline(is, token, ',')) {
+    auto begin = token.find_first_not_of(' ');
+    if (begin == std::string::npos) {
+      continue;
+    }
+    if (token.compare(begin, prefix.size(), prefix) == 0) {
+      auto value = token.substr(begin + prefix.size());
+      auto end = value.find_last_not_of(' ');
+      return value.substr(0, end + 1);
+    }
+  }
+  return std::string{};
+}
+
+std::string FormatHash(char const* name, std::string const& value) {
+  if (value.empty()) {
+    return value;
+  }
+  return std::string(name) + "=" + value;
+}
+
+std::string JoinHashes(std::string const& a, std::string const& b) {
+  if (a.empty()) {
+    return b;
+  }
+  if (b.empty()) {
+    return a;
+  }
+  return a + "," + b;
+}
+
+bool IsRangeRead(ReadObjectRangeRequest const& request) {
+  return request.begin() != 0 or request.end() != 0;
+}
+
+template <typename Request>
+std::unique_ptr<HashValidator> CreateHashValidatorImpl(Request const& request,
+                                                       bool disable_all) {
+  auto const& crc32c = request.template get_option<DisableCrc32cChecksum>();
+  auto const& md5 = request.template get_option<EnableMD5Hash>();
+  bool enable_crc32c = not(crc32c.has_value() and crc32c.value());
+  bool enable_md5 = md5.has_value() and md5.value();
+  if (disable_all or (not enable_crc32c and not enable_md5)) {
+    return std::unique_ptr<HashValidator>(new NullHashValidator);
+  }
+  if (not enable_md5) {
+    return std::unique_ptr<HashValidator>(new Crc32cHashValidator);
+  }
+  if (not enable_crc32c) {
+    return std::unique_ptr<HashValidator>(new MD5HashValidator);
+  }
+  return std::unique_ptr<HashValidator>(new CompositeValidator(
+      std::unique_ptr<HashValidator>(new Crc32cHashValidator),
+      std::unique_ptr<HashValidator>(new MD5HashValidator)));
+}
+}  // namespace
+
+void Crc32cHashValidator::Update(char const* data, std::size_t size) {
+  current_ = Crc32cExtend(current_, data, size);
+}
+
+void Crc32cHashValidator::ProcessHeader(std::string const& key,
+                                        std::string const& value) {
+  if (key != "x-goog-hash") {
+    return;
+  }
+  auto hash = ExtractHashValue("crc32c", value);
+  if (not hash.empty()) {
+    received_hash_ = std::move(hash);
+  }
+}
+
+void Crc32cHashValidator::ProcessMetadata(ObjectMetadata const& metadata) {
+  received_hash_ = metadata.crc32c();
+}
+
+HashValidator::Result Crc32cHashValidator::Finish() {
+  auto computed = Crc32cToBase64(current_);
+  bool is_mismatch = not received_hash_.empty() and received_hash_ != computed;
+  return Result{FormatHash(Name(), received_hash_),
+                FormatHash(Name(), computed), is_mismatch};
+}
+
+MD5HashValidator::MD5HashValidator() : context_(OpenSslUtils::GetDigestCtx()) {
+  if (not context_ or
+      EVP_DigestInit_ex(context_.get(), EVP_md5(), nullptr) != 1) {
+    google::cloud::internal::RaiseRuntimeError(
+        "Cannot initialize the OpenSSL digest context for MD5.");
+  }
+}
+
+void MD5HashValidator::Update(char const* data, std::size_t size) {
+  EVP_DigestUpdate(context_.get(), data, size);
+}
+
+void MD5HashValidator::ProcessHeader(std::string const& key,
+                                     std::string const& value) {
+  if (key != "x-goog-hash") {
+    return;
+  }
+  auto hash = ExtractHashValue("md5", value);
+  if (not hash.empty()) {
+    received_hash_ = std::move(hash);
+  }
+}
+
+void MD5HashValidator::ProcessMetadata(ObjectMetadata const& metadata) {
+  received_hash_ = metadata.md5_hash();
+}
+
+HashValidator::Result MD5HashValidator::Finish() {
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int size = 0;
+  EVP_DigestFinal_ex(context_.get(), digest, &size);
+  auto computed = OpenSslUtils::Base64Encode(
+      std::string(reinterpret_cast<char const*>(digest), size));
+  bool is_mismatch = not received_hash_.empty() and received_hash_ != computed;
+  return Result{FormatHash(Name(), received_hash_),
+                FormatHash(Name(), computed), is_mismatch};
+}
+
+void CompositeValidator::Update(char const* data, std::size_t size) {
+  left_->Update(data, size);
+  right_->Update(data, size);
+}
+
+void CompositeValidator::ProcessHeader(std::string const& key,
+                                       std::string const& value) {
+  left_->ProcessHeader(key, value);
+  right_->ProcessHeader(key, value);
+}
+
+void CompositeValidator::ProcessMetadata(ObjectMetadata const& metadata) {
+  left_->ProcessMetadata(metadata);
+  right_->ProcessMetadata(metadata);
+}
+
+HashValidator::Result CompositeValidator::Finish() {
+  auto left = left_->Finish();
+  auto right = right_->Finish();
+  return Result{JoinHashes(left.received, right.received),
+                JoinHashes(left.computed, right.computed),
+                left.is_mismatch or right.is_mismatch};
+}
+
+std::unique_ptr<HashValidator> CreateHashValidator(
+    ReadObjectRangeRequest const& request) {
+  return CreateHashValidatorImpl(request, IsRangeRead(request));
+}
+
+std::unique_ptr<HashValidator> CreateHashValidator(
+    InsertObjectStreamingRequest const& request) {
+  return CreateHashValidatorImpl(request, false);
+}
+
+std::string FormatHashMismatch(char const* where,
+                               HashValidator::Result const& result) {
+  std::ostringstream os;
+  os << "Mismatched hashes in " << where << "(), computed=" << result.computed
+     << ", received=" << result.received;
+  return os.str();
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,150 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_HASH_VALIDATOR_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_HASH_VALIDATOR_H_
+
+#include "google/cloud/storage/internal/insert_object_media_request.h"
+#include "google/cloud/storage/internal/openssl_util.h"
+#include "google/cloud/storage/internal/read_object_range_request.h"
+#include "google/cloud/storage/object_metadata.h"
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Compute the hashes of the data in a streaming transfer and compare them
+ * against the values reported by the service.
+ *
+ * The hashes are formatted as in the `x-goog-hash` header, for example
+ * `crc32c=AAAAAA==`, with multiple hashes separated by commas.
+ */
+class HashValidator {
+ public:
+  virtual ~HashValidator() = default;
+
+  /// The name of the validator, useful for troubleshooting.
+  virtual char const* Name() const = 0;
+
+  /// Update the computed hashes with more data.
+  virtual void Update(char const* data, std::size_t size) = 0;
+
+  /// Extract the received hashes from a response header (downloads).
+  virtual void ProcessHeader(std::string const& key,
+                             std::string const& value) = 0;
+
+  /// Extract the received hashes from the object metadata (uploads).
+  virtual void ProcessMetadata(ObjectMetadata const& metadata) = 0;
+
+  struct Result {
+    /// The value reported by the service, empty if it was not reported.
+    std::string received;
+    /// The value computed from the data, empty if nothing was computed.
+    std::string computed;
+    /// True if the service reported a value, and it does not match.
+    bool is_mismatch;
+  };
+
+  /// Compute the final hash values, call once after all the data is processed.
+  virtual Result Finish() = 0;
+};
+
+/// A validator that does not compute any hashes.
+class NullHashValidator : public HashValidator {
+ public:
+  char const* Name() const override { return "null"; }
+  void Update(char const*, std::size_t) override {}
+  void ProcessHeader(std::string const&, std::string const&) override {}
+  void ProcessMetadata(ObjectMetadata const&) override {}
+  Result Finish() override { return Result{{}, {}, false}; }
+};
+
+/// A validator for the CRC32C checksum.
+class Crc32cHashValidator : public HashValidator {
+ public:
+  Crc32cHashValidator() : current_(0) {}
+
+  char const* Name() const override { return "crc32c"; }
+  void Update(char const* data, std::size_t size) override;
+  void ProcessHeader(std::string const& key, std::string const& value) override;
+  void ProcessMetadata(ObjectMetadata const& metadata) override;
+  Result Finish() override;
+
+ private:
+  std::uint32_t current_;
+  std::string received_hash_;
+};
+
+/// A validator for the MD5 hash.
+class MD5HashValidator : public HashValidator {
+ public:
+  MD5HashValidator();
+
+  char const* Name() const override { return "md5"; }
+  void Update(char const* data, std::size_t size) override;
+  void ProcessHeader(std::string const& key, std::string const& value) override;
+  void ProcessMetadata(ObjectMetadata const& metadata) override;
+  Result Finish() override;
+
+ private:
+  decltype(OpenSslUtils::GetDigestCtx()) context_;
+  std::string received_hash_;
+};
+
+/// A validator that combines two other validators.
+class CompositeValidator : public HashValidator {
+ public:
+  CompositeValidator(std::unique_ptr<HashValidator> left,
+                     std::unique_ptr<HashValidator> right)
+      : left_(std::move(left)), right_(std::move(right)) {}
+
+  char const* Name() const override { return "composite"; }
+  void Update(char const* data, std::size_t size) override;
+  void ProcessHeader(std::string const& key, std::string const& value) override;
+  void ProcessMetadata(ObjectMetadata const& metadata) override;
+  Result Finish() override;
+
+ private:
+  std::unique_ptr<HashValidator> left_;
+  std::unique_ptr<HashValidator> right_;
+};
+
+/**
+ * Create the validator for a download.
+ *
+ * The service reports the hashes of the full object, so no validation is
+ * possible when downloading a range.
+ */
+std::unique_ptr<HashValidator> CreateHashValidator(
+    ReadObjectRangeRequest const& request);
+
+/// Create the validator for a streaming upload.
+std::unique_ptr<HashValidator> CreateHashValidator(
+    InsertObjectStreamingRequest const& request);
+
+/// Format the result of a failed validation, e.g. for an exception message.
+std::string FormatHashMismatch(char const* where,
+                               HashValidator::Result const& result);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_HASH_VALIDATOR_H_
@@ -0,0 +1,123 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/hash_validator.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::testing::HasSubstr;
+
+std::string const QUICK_FOX = "The quick brown fox jumps over the lazy dog";
+// The values reported by the service for QUICK_FOX.
+std::string const QUICK_FOX_CRC32C = "ImIEBA==";
+std::string const QUICK_FOX_MD5 = "nhB9nTcrtoJr2B01QqQZ1g==";
+
+void UpdateValidator(HashValidator& validator, std::string const& data) {
+  validator.Update(data.data(), data.size());
+}
+
+TEST(HashValidatorTest, Crc32cHeader) {
+  Crc32cHashValidator validator;
+  UpdateValidator(validator, QUICK_FOX.substr(0, 10));
+  UpdateValidator(validator, QUICK_FOX.substr(10));
+  validator.ProcessHeader("x-goog-hash", "md5=" + QUICK_FOX_MD5);
+  validator.ProcessHeader("x-goog-hash", "crc32c=" + QUICK_FOX_CRC32C);
+  auto result = validator.Finish();
+  EXPECT_EQ("crc32c=" + QUICK_FOX_CRC32C, result.computed);
+  EXPECT_EQ("crc32c=" + QUICK_FOX_CRC32C, result.received);
+  EXPECT_FALSE(result.is_mismatch);
+}
+
+TEST(HashValidatorTest, Crc32cMismatch) {
+  Crc32cHashValidator validator;
+  UpdateValidator(validator, QUICK_FOX);
+  validator.ProcessHeader("x-goog-hash",
+                          "crc32c=AAAAAA==,md5=" + QUICK_FOX_MD5);
+  auto result = validator.Finish();
+  EXPECT_EQ("crc32c=AAAAAA==", result.received);
+  EXPECT_TRUE(result.is_mismatch);
+  EXPECT_THAT(FormatHashMismatch("Test", result), HasSubstr("crc32c=AAAAAA=="));
+}
+
+TEST(HashValidatorTest, Crc32cMissing) {
+  Crc32cHashValidator validator;
+  UpdateValidator(validator, QUICK_FOX);
+  validator.ProcessHeader("content-type", "crc32c=AAAAAA==");
+  auto result = validator.Finish();
+  EXPECT_EQ("", result.received);
+  EXPECT_EQ("crc32c=" + QUICK_FOX_CRC32C, result.computed);
+  EXPECT_FALSE(result.is_mismatch);
+}
+
+TEST(HashValidatorTest, MD5Metadata) {
+  MD5HashValidator validator;
+  UpdateValidator(validator, QUICK_FOX);
+  validator.ProcessMetadata(ObjectMetadata::ParseFromString(
+      R"""({"md5Hash": ")""" + QUICK_FOX_MD5 + R"""("})"""));
+  auto result = validator.Finish();
+  EXPECT_EQ("md5=" + QUICK_FOX_MD5, result.computed);
+  EXPECT_FALSE(result.is_mismatch);
+}
+
+TEST(HashValidatorTest, Composite) {
+  CompositeValidator validator(
+      std::unique_ptr<HashValidator>(new Crc32cHashValidator),
+      std::unique_ptr<HashValidator>(new MD5HashValidator));
+  UpdateValidator(validator, QUICK_FOX);
+  validator.ProcessHeader("x-goog-hash", "crc32c=" + QUICK_FOX_CRC32C +
+                                             ", md5=1B2M2Y8AsgTpgAmY7PhCfg==");
+  auto result = validator.Finish();
+  EXPECT_EQ("crc32c=" + QUICK_FOX_CRC32C + ",md5=" + QUICK_FOX_MD5,
+            result.computed);
+  EXPECT_EQ("crc32c=" + QUICK_FOX_CRC32C + ",md5=1B2M2Y8AsgTpgAmY7PhCfg==",
+            result.received);
+  EXPECT_TRUE(result.is_mismatch);
+}
+
+TEST(HashValidatorTest, CreateForDownload) {
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  EXPECT_STREQ("crc32c", CreateHashValidator(request)->Name());
+
+  request.set_multiple_options(EnableMD5Hash(true));
+  EXPECT_STREQ("composite", CreateHashValidator(request)->Name());
+
+  request.set_multiple_options(DisableCrc32cChecksum(true));
+  EXPECT_STREQ("md5", CreateHashValidator(request)->Name());
+
+  request.set_multiple_options(EnableMD5Hash(false));
+  EXPECT_STREQ("null", CreateHashValidator(request)->Name());
+
+  ReadObjectRangeRequest range("test-bucket", "test-object", 1024, 2048);
+  EXPECT_STREQ("null", CreateHashValidator(range)->Name());
+}
+
+TEST(HashValidatorTest, CreateForUpload) {
+  InsertObjectStreamingRequest request("test-bucket", "test-object");
+  EXPECT_STREQ("crc32c", CreateHashValidator(request)->Name());
+
+  request.set_multiple_options(DisableCrc32cChecksum(true));
+  EXPECT_STREQ("null", CreateHashValidator(request)->Name());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -15,6 +15,8 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_INSERT_OBJECT_MEDIA_REQUEST_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_INSERT_OBJECT_MEDIA_REQUEST_H_
 
+#include "google/cloud/storage/compression_options.h"
+#include "google/cloud/storage/hashing_options.h"
 #include "google/cloud/storage/internal/generic_object_request.h"
 #include "google/cloud/storage/well_known_parameters.h"
 
@@ -57,7 +59,8 @@ std::ostream& operator<<(std::ostream& os, InsertObjectMediaRequest const& r);
  */
 class InsertObjectStreamingRequest
     : public GenericObjectRequest<
-          InsertObjectStreamingRequest, ContentEncoding, IfGenerationMatch,
+          InsertObjectStreamingRequest, ContentEncoding, DisableCrc32cChecksum,
+          EnableGzipCompression, EnableMD5Hash, IfGenerationMatch,
           IfGenerationNotMatch, IfMetaGenerationMatch, IfMetaGenerationNotMatch,
           KmsKeyName, PredefinedAcl, Projection, UserProject> {
  public:
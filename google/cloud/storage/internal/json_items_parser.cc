@@ -0,0 +1,171 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/json_items_parser.h"
+#include "google/cloud/internal/throw_delegate.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+JsonItemsParser::JsonItemsParser(std::string field_name, ItemCallback callback)
+    : field_name_(std::move(field_name)),
+      callback_(std::move(callback)),
+      state_(State::kObject),
+      depth_(0),
+      in_string_(false),
+      escape_(false),
+      expect_array_(false),
+      string_begin_(0) {}
+
+void JsonItemsParser::Append(char const* data, std::size_t size) {
+  // Copy the data in blocks, `begin` is the start of the block that has not
+  // been copied to `envelope_` or `item_` yet.
+  char const* begin = data;
+  auto flush = [this, &begin](char const* p) {
+    if (state_ == State::kObject) {
+      envelope_.append(begin, p);
+    } else if (state_ == State::kItem) {
+      item_.append(begin, p);
+    }
+    begin = p;
+  };
+
+  char const* const end = data + size;
+  for (char const* p = data; p != end and error_.empty(); ++p) {
+    char const c = *p;
+    if (in_string_) {
+      if (escape_) {
+        escape_ = false;
+      } else if (c == '\\') {
+        escape_ = true;
+      } else if (c == '"') {
+        in_string_ = false;
+        if (state_ == State::kObject and depth_ == 1) {
+          // Remember the strings in the top-level object, they may be the
+          // name of the array field.
+          flush(p);
+          last_string_.assign(envelope_, string_begin_, std::string::npos);
+        }
+      }
+      continue;
+    }
+    switch (state_) {
+      case State::kObject:
+        if (depth_ != 1) {
+          if (c == '"') {
+            in_string_ = true;
+          } else if (c == '{' or c == '[') {
+            ++depth_;
+          } else if (c == '}' or c == ']') {
+            --depth_;
+          }
+        } else if (c == '"') {
+          in_string_ = true;
+          expect_array_ = false;
+          flush(p + 1);
+          string_begin_ = envelope_.size();
+        } else if (c == ':') {
+          expect_array_ = last_string_ == field_name_;
+        } else if (c == '[' and expect_array_) {
+          flush(p + 1);
+          ++depth_;
+          expect_array_ = false;
+          state_ = State::kArray;
+        } else if (c == '{' or c == '[') {
+          expect_array_ = false;
+          ++depth_;
+        } else if (c == '}' or c == ']') {
+          --depth_;
+        } else if (c == ',') {
+          expect_array_ = false;
+        }
+        break;
+      case State::kArray:
+        if (c == '{') {
+          state_ = State::kItem;
+          begin = p;
+          ++depth_;
+        } else if (c == ']') {
+          --depth_;
+          state_ = State::kObject;
+          begin = p;
+        } else if (c == ',' or c == ' ' or c == '\n' or c == '\r' or
+                   c == '\t') {
+          begin = p + 1;
+        } else {
+          error_ = "expected an object in the '" + field_name_ + "' array";
+        }
+        break;
+      case State::kItem:
+        if (c == '"') {
+          in_string_ = true;
+        } else if (c == '{' or c == '[') {
+          ++depth_;
+        } else if (c == '}' or c == ']') {
+          if (--depth_ == 2) {
+            flush(p + 1);
+            OnItem();
+            state_ = State::kArray;
+          }
+        }
+        break;
+    }
+  }
+  if (error_.empty()) {
+    flush(end);
+  }
+}
+
+nl::json JsonItemsParser::Finish() {
+  if (not error_.empty()) {
+    google::cloud::internal::RaiseRuntimeError(
+        "JsonItemsParser::Finish() - " + error_);
+  }
+  if (state_ != State::kObject or depth_ != 0 or in_string_) {
+    google::cloud::internal::RaiseRuntimeError(
+        "JsonItemsParser::Finish() - incomplete JSON object");
+  }
+  auto json = nl::json::parse(envelope_, nullptr, false);
+  if (json.is_discarded() or not json.is_object()) {
+    google::cloud::internal::RaiseRuntimeError(
+        "JsonItemsParser::Finish() - invalid JSON object");
+  }
+  return json;
+}
+
+void JsonItemsParser::OnItem() {
+  auto json = nl::json::parse(item_, nullptr, false);
+  item_.clear();
+  if (json.is_discarded()) {
+    error_ = "invalid JSON object in the '" + field_name_ + "' array";
+    return;
+  }
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  try {
+    callback_(json);
+  } catch (std::exception const& ex) {
+    error_ = ex.what();
+  }
+#else
+  callback_(json);
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
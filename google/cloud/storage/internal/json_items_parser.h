@@ -0,0 +1,135 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_JSON_ITEMS_PARSER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_JSON_ITEMS_PARSER_H_
+
+#include "google/cloud/storage/internal/nljson.h"
+#include <functional>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Incrementally parse a JSON object containing a (potentially large) array.
+ *
+ * The list RPCs in GCS return a JSON object with a few small fields (e.g.
+ * `nextPageToken`) and an `items` array with up to 1,000 elements. Parsing the
+ * complete page into a `nl::json` object uses several times more memory than
+ * the payload itself. This class scans the payload as it is received, splits
+ * each element of the array, and passes it to a callback as soon as the
+ * element is complete. Only one element is converted to a `nl::json` object
+ * at a time.
+ *
+ * The scanner only tracks strings and nesting, the elements and the rest of
+ * the object are validated by the `nl::json` parser. Only arrays of objects
+ * are supported, which is all the GCS list RPCs return.
+ */
+class JsonItemsParser {
+ public:
+  using ItemCallback = std::function<void(nl::json const&)>;
+
+  JsonItemsParser(std::string field_name, ItemCallback callback);
+
+  JsonItemsParser(JsonItemsParser const&) = delete;
+  JsonItemsParser& operator=(JsonItemsParser const&) = delete;
+
+  /**
+   * Consume the next block of the payload.
+   *
+   * This function does not raise exceptions, it is typically called from a
+   * libcurl callback. Any errors are reported by `Finish()`.
+   */
+  void Append(char const* data, std::size_t size);
+  void Append(std::string const& data) { Append(data.data(), data.size()); }
+
+  /**
+   * Finish parsing, return the object without the elements of the array.
+   *
+   * @throw std::runtime_error if the payload is not valid, or if any of the
+   *     callbacks raised an exception.
+   */
+  nl::json Finish();
+
+ private:
+  enum class State { kObject, kArray, kItem };
+
+  void OnItem();
+
+  std::string field_name_;
+  ItemCallback callback_;
+  State state_;
+  int depth_;
+  bool in_string_;
+  bool escape_;
+  bool expect_array_;
+  std::string::size_type string_begin_;
+  std::string last_string_;
+  std::string envelope_;
+  std::string item_;
+  std::string error_;
+};
+
+/**
+ * Parse the fields, other than the items, of a list response.
+ *
+ * Response types with additional fields provide a non-template overload,
+ * which is preferred over this function.
+ */
+template <typename Response>
+void ParseListResponseFields(nl::json const& json, Response& response) {
+  response.next_page_token = json.value("nextPageToken", "");
+}
+
+/**
+ * Incrementally parse the response for a list RPC, e.g. `ListObjects`.
+ *
+ * @tparam Response the response type, it must have `next_page_token` and
+ *     `items` fields, and the type of the elements in `items` must have a
+ *     static `ParseFromJson()` function.
+ */
+template <typename Response>
+class ListResponseParser {
+ public:
+  ListResponseParser()
+      : parser_("items", [this](nl::json const& item) {
+          response_.items.emplace_back(ItemType::ParseFromJson(item));
+        }) {}
+
+  void Append(char const* data, std::size_t size) {
+    parser_.Append(data, size);
+  }
+
+  Response Finish() {
+    ParseListResponseFields(parser_.Finish(), response_);
+    return std::move(response_);
+  }
+
+ private:
+  using ItemType = typename decltype(Response::items)::value_type;
+
+  Response response_;
+  JsonItemsParser parser_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_JSON_ITEMS_PARSER_H_
@@ -0,0 +1,122 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/json_items_parser.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include "google/cloud/storage/internal/list_objects_request.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::testing::ElementsAre;
+
+std::string const PAYLOAD = R"""({
+  "kind": "storage#objects",
+  "prefixes": ["items", "[{"],
+  "items": [
+    {"name": "a \"quoted\" } name", "metadata": {"items": "[1, 2]"}},
+    {"name": "b\\", "acl": [{"entity": "e1"}, {"entity": "e2"}]},
+    {"name": "c"}
+  ],
+  "nextPageToken": "token-42"
+})""";
+
+/// @test Verify that the items are split and the other fields preserved.
+TEST(JsonItemsParserTest, Simple) {
+  std::vector<std::string> names;
+  JsonItemsParser parser("items", [&names](nl::json const& item) {
+    names.push_back(item.value("name", ""));
+  });
+  parser.Append(PAYLOAD);
+  auto json = parser.Finish();
+
+  EXPECT_THAT(names, ElementsAre("a \"quoted\" } name", "b\\", "c"));
+  EXPECT_EQ("storage#objects", json.value("kind", ""));
+  EXPECT_EQ("token-42", json.value("nextPageToken", ""));
+  EXPECT_EQ(2U, json["prefixes"].size());
+  EXPECT_TRUE(json["items"].empty());
+}
+
+/// @test Verify that the payload can be split at any position.
+TEST(JsonItemsParserTest, SplitPayload) {
+  for (std::size_t chunk = 1; chunk != 8; ++chunk) {
+    std::vector<nl::json> items;
+    JsonItemsParser parser(
+        "items", [&items](nl::json const& item) { items.push_back(item); });
+    for (std::size_t i = 0; i < PAYLOAD.size(); i += chunk) {
+      auto size = (std::min)(chunk, PAYLOAD.size() - i);
+      parser.Append(PAYLOAD.data() + i, size);
+    }
+    auto json = parser.Finish();
+    auto expected = nl::json::parse(PAYLOAD);
+    EXPECT_EQ(expected["items"], nl::json(items)) << "chunk=" << chunk;
+    EXPECT_EQ(expected["nextPageToken"], json["nextPageToken"]);
+  }
+}
+
+/// @test Verify that payloads without items work.
+TEST(JsonItemsParserTest, NoItems) {
+  int count = 0;
+  JsonItemsParser parser("items", [&count](nl::json const&) { ++count; });
+  parser.Append(std::string(R"""({"kind": "storage#objects"})"""));
+  auto json = parser.Finish();
+  EXPECT_EQ(0, count);
+  EXPECT_EQ("storage#objects", json.value("kind", ""));
+}
+
+/// @test Verify that ListResponseParser builds a full response.
+TEST(JsonItemsParserTest, ListResponseParser) {
+  ListResponseParser<ListObjectsResponse> parser;
+  parser.Append(PAYLOAD.data(), PAYLOAD.size());
+  auto actual = parser.Finish();
+  EXPECT_EQ("token-42", actual.next_page_token);
+  ASSERT_EQ(3U, actual.items.size());
+  EXPECT_EQ("c", actual.items[2].name());
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that invalid payloads are reported by Finish().
+TEST(JsonItemsParserTest, Invalid) {
+  auto parse = [](std::string const& payload) {
+    JsonItemsParser parser("items", [](nl::json const&) {});
+    parser.Append(payload);
+    return parser.Finish();
+  };
+  EXPECT_THROW(parse(""), std::runtime_error);
+  EXPECT_THROW(parse(R"""({"items": [{"name": "a"})"""), std::runtime_error);
+  EXPECT_THROW(parse(R"""({"items": [{"name": }]})"""), std::runtime_error);
+  EXPECT_THROW(parse(R"""({"items": [1, 2]})"""), std::runtime_error);
+  EXPECT_THROW(parse(R"""({"kind": "storage#objects",})"""),
+               std::runtime_error);
+}
+
+/// @test Verify that exceptions in the callback are reported by Finish().
+TEST(JsonItemsParserTest, CallbackException) {
+  JsonItemsParser parser("items", [](nl::json const&) {
+    google::cloud::internal::RaiseInvalidArgument("bad item");
+  });
+  EXPECT_NO_THROW(parser.Append(PAYLOAD));
+  EXPECT_THROW(parser.Finish(), std::runtime_error);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,61 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/latency_tracker.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+LatencyTracker::LatencyTracker(std::size_t capacity,
+                               std::size_t minimum_samples)
+    : capacity_(capacity), minimum_samples_(minimum_samples), next_(0) {
+  samples_.reserve(capacity_);
+}
+
+void LatencyTracker::Record(std::chrono::microseconds latency) {
+  if (capacity_ == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lk(mu_);
+  if (samples_.size() < capacity_) {
+    samples_.push_back(latency);
+    return;
+  }
+  samples_[next_] = latency;
+  next_ = (next_ + 1) % capacity_;
+}
+
+std::chrono::microseconds LatencyTracker::Percentile(double percentile) const {
+  std::vector<std::chrono::microseconds> sorted;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (samples_.empty() or samples_.size() < minimum_samples_) {
+      return std::chrono::microseconds(0);
+    }
+    sorted = samples_;
+  }
+  percentile = (std::max)(0.0, (std::min)(1.0, percentile));
+  auto index = static_cast<std::size_t>(percentile * (sorted.size() - 1));
+  std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+  return sorted[index];
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
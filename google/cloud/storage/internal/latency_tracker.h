@@ -0,0 +1,70 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_LATENCY_TRACKER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_LATENCY_TRACKER_H_
+
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Keep the most recent latency samples to estimate percentiles.
+ *
+ * This class is thread-safe.
+ */
+class LatencyTracker {
+ public:
+  /**
+   * Create a tracker.
+   *
+   * @param capacity the number of samples kept, older samples are discarded.
+   *     With a capacity of 0 no samples are kept and `Percentile()` always
+   *     returns 0.
+   * @param minimum_samples `Percentile()` returns 0 until this many samples
+   *     are recorded.
+   */
+  LatencyTracker(std::size_t capacity, std::size_t minimum_samples);
+
+  void Record(std::chrono::microseconds latency);
+
+  /**
+   * Return the @p percentile (in the [0, 1] range) of the recent samples.
+   *
+   * @return the estimate, or 0 if there are not enough samples.
+   */
+  std::chrono::microseconds Percentile(double percentile) const;
+
+ private:
+  mutable std::mutex mu_;
+  std::vector<std::chrono::microseconds> samples_;
+  std::size_t capacity_;
+  std::size_t minimum_samples_;
+  // The index of the next sample to replace once `samples_` is full.
+  std::size_t next_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_LATENCY_TRACKER_H_
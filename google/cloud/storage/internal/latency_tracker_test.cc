@@ -0,0 +1,70 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/latency_tracker.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using std::chrono::microseconds;
+
+TEST(LatencyTrackerTest, NotEnoughSamples) {
+  LatencyTracker tracker(10, 3);
+  EXPECT_EQ(0, tracker.Percentile(0.5).count());
+  tracker.Record(microseconds(100));
+  tracker.Record(microseconds(200));
+  EXPECT_EQ(0, tracker.Percentile(0.5).count());
+  tracker.Record(microseconds(300));
+  EXPECT_EQ(200, tracker.Percentile(0.5).count());
+}
+
+TEST(LatencyTrackerTest, Percentile) {
+  LatencyTracker tracker(100, 1);
+  for (int i = 100; i != 0; --i) {
+    tracker.Record(microseconds(i));
+  }
+  EXPECT_EQ(1, tracker.Percentile(0.0).count());
+  EXPECT_EQ(95, tracker.Percentile(0.95).count());
+  EXPECT_EQ(100, tracker.Percentile(1.0).count());
+  EXPECT_EQ(100, tracker.Percentile(2.0).count());
+}
+
+TEST(LatencyTrackerTest, DiscardOldSamples) {
+  LatencyTracker tracker(4, 1);
+  for (int i = 0; i != 4; ++i) {
+    tracker.Record(microseconds(1000));
+  }
+  for (int i = 0; i != 4; ++i) {
+    tracker.Record(microseconds(10));
+  }
+  EXPECT_EQ(10, tracker.Percentile(1.0).count());
+}
+
+TEST(LatencyTrackerTest, ZeroCapacity) {
+  LatencyTracker tracker(0, 0);
+  tracker.Record(microseconds(100));
+  tracker.Record(microseconds(200));
+  EXPECT_EQ(0, tracker.Percentile(0.5).count());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,101 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/list_objects_prefetcher.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+ListObjectsPrefetcher::ListObjectsPrefetcher(std::shared_ptr<RawClient> client,
+                                             ListObjectsRequest request,
+                                             std::size_t max_pages)
+    : client_(std::move(client)),
+      request_(std::move(request)),
+      max_pages_(max_pages),
+      done_(false),
+      shutdown_(false) {
+  // Start the thread only after all the other members are initialized.
+  thread_ = std::thread(&ListObjectsPrefetcher::Run, this);
+}
+
+ListObjectsPrefetcher::~ListObjectsPrefetcher() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  // If the thread is waiting for a response this blocks until the request
+  // completes, there is no way to cancel a RawClient request.
+  thread_.join();
+}
+
+std::pair<Status, ListObjectsResponse> ListObjectsPrefetcher::Next() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return not pages_.empty() or done_; });
+  if (pages_.empty()) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    return std::make_pair(Status(), ListObjectsResponse{});
+  }
+  auto page = std::move(pages_.front());
+  pages_.pop_front();
+  lk.unlock();
+  cv_.notify_all();
+  return page;
+}
+
+void ListObjectsPrefetcher::Run() {
+  while (true) {
+    std::pair<Status, ListObjectsResponse> page;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      page = client_->ListObjects(request_);
+    } catch (...) {
+      std::lock_guard<std::mutex> lk(mu_);
+      exception_ = std::current_exception();
+      done_ = true;
+      cv_.notify_all();
+      return;
+    }
+#else
+    page = client_->ListObjects(request_);
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    bool const last_page =
+        not page.first.ok() or page.second.next_page_token.empty();
+    request_.set_page_token(page.second.next_page_token);
+
+    std::unique_lock<std::mutex> lk(mu_);
+    pages_.push_back(std::move(page));
+    done_ = last_page;
+    cv_.notify_all();
+    if (last_page) {
+      return;
+    }
+    cv_.wait(lk, [this] { return shutdown_ or pages_.size() < max_pages_; });
+    if (shutdown_) {
+      return;
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
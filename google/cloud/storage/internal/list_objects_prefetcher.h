@@ -0,0 +1,80 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_LIST_OBJECTS_PREFETCHER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_LIST_OBJECTS_PREFETCHER_H_
+
+#include "google/cloud/storage/internal/raw_client.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Fetch the pages of a `ListObjects` request in a background thread.
+ *
+ * The page token for page N+1 is only known once page N is received, so the
+ * pages are always fetched one at a time. This class fetches them ahead of
+ * the consumer, keeping at most @p max_pages pages buffered, and blocks the
+ * background thread once the buffer is full.
+ */
+class ListObjectsPrefetcher {
+ public:
+  ListObjectsPrefetcher(std::shared_ptr<RawClient> client,
+                        ListObjectsRequest request, std::size_t max_pages);
+  ~ListObjectsPrefetcher();
+
+  ListObjectsPrefetcher(ListObjectsPrefetcher const&) = delete;
+  ListObjectsPrefetcher& operator=(ListObjectsPrefetcher const&) = delete;
+
+  /**
+   * Return the next page, blocking until it is available.
+   *
+   * Must not be called after a page without a `next_page_token`, or after a
+   * page with an error status, is returned.
+   *
+   * @throw the exception raised by the `RawClient`, if any, after all the
+   *     pages received before the error are returned.
+   */
+  std::pair<Status, ListObjectsResponse> Next();
+
+ private:
+  void Run();
+
+  std::shared_ptr<RawClient> client_;
+  ListObjectsRequest request_;
+  std::size_t max_pages_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::pair<Status, ListObjectsResponse>> pages_;
+  bool done_;
+  bool shutdown_;
+  std::exception_ptr exception_;
+  std::thread thread_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_LIST_OBJECTS_PREFETCHER_H_
@@ -13,7 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/list_objects_request.h"
-#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/internal/json_items_parser.h"
 #include "google/cloud/storage/object_metadata.h"
 #include <sstream>
 
@@ -30,16 +30,19 @@ std::ostream& operator<<(std::ostream& os, ListObjectsRequest const& r) {
 
 ListObjectsResponse ListObjectsResponse::FromHttpResponse(
     HttpResponse&& response) {
-  auto json = storage::internal::nl::json::parse(response.payload);
-
-  ListObjectsResponse result;
-  result.next_page_token = json.value("nextPageToken", "");
+  ListResponseParser<ListObjectsResponse> parser;
+  parser.Append(response.payload.data(), response.payload.size());
+  return parser.Finish();
+}
 
-  for (auto const& kv : json["items"].items()) {
-    result.items.emplace_back(ObjectMetadata::ParseFromJson(kv.value()));
+void ParseListResponseFields(nl::json const& json,
+                             ListObjectsResponse& response) {
+  response.next_page_token = json.value("nextPageToken", "");
+  if (json.count("prefixes") != 0) {
+    for (auto const& p : json["prefixes"]) {
+      response.prefixes.emplace_back(p.get<std::string>());
+    }
   }
-
-  return result;
 }
 
 std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r) {
@@ -47,6 +50,9 @@ std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r) {
      << ", items={";
   std::copy(r.items.begin(), r.items.end(),
             std::ostream_iterator<ObjectMetadata>(os, "\n  "));
+  os << "}, prefixes={";
+  std::copy(r.prefixes.begin(), r.prefixes.end(),
+            std::ostream_iterator<std::string>(os, ", "));
   return os << "}}";
 }
 
@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/internal/generic_request.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/internal/nljson.h"
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/storage/well_known_parameters.h"
 
@@ -29,8 +30,8 @@ namespace internal {
  * Request the metadata for a bucket.
  */
 class ListObjectsRequest
-    : public GenericRequest<ListObjectsRequest, MaxResults, Prefix, Projection,
-                            UserProject> {
+    : public GenericRequest<ListObjectsRequest, Delimiter, Fields, MaxResults,
+                            Prefix, Projection, UserProject> {
  public:
   ListObjectsRequest() = default;
   explicit ListObjectsRequest(std::string bucket_name)
@@ -60,8 +61,14 @@ struct ListObjectsResponse {
 
   std::string next_page_token;
   std::vector<ObjectMetadata> items;
+  /// The prefixes of the objects that matched the `Delimiter` parameter.
+  std::vector<std::string> prefixes;
 };
 
+/// Parse the fields, other than `items`, of a `ListObjects` response.
+void ParseListResponseFields(nl::json const& json,
+                             ListObjectsResponse& response);
+
 std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r);
 
 }  // namespace internal
@@ -49,6 +49,14 @@ TEST(ListObjectsRequestTest, OStreamParameter) {
   EXPECT_THAT(os.str(), HasSubstr("prefix=foo-bar-baz/"));
 }
 
+TEST(ListObjectsRequestTest, OStreamFields) {
+  ListObjectsRequest request("my-bucket");
+  request.set_multiple_options(Fields("nextPageToken,items(name,size)"));
+  std::ostringstream os;
+  os << request;
+  EXPECT_THAT(os.str(), HasSubstr("fields=nextPageToken,items(name,size)"));
+}
+
 TEST(ListObjectsResponseTest, Parse) {
   std::string object1 = R"""({
       "bucket": "foo-bar",
@@ -104,6 +112,43 @@ TEST(ListObjectsResponseTest, Parse) {
   EXPECT_THAT(actual.items, ::testing::ElementsAre(o1, o2));
 }
 
+TEST(ListObjectsResponseTest, ParsePrefixes) {
+  std::string text = R"""({
+      "kind": "storage#objects",
+      "prefixes": ["dir1/", "dir2/"],
+      "items": [{"name": "dir0", "bucket": "foo-bar"}]
+})""";
+
+  auto actual =
+      ListObjectsResponse::FromHttpResponse(HttpResponse{200, text, {}});
+  EXPECT_EQ("", actual.next_page_token);
+  ASSERT_EQ(1U, actual.items.size());
+  EXPECT_EQ("dir0", actual.items[0].name());
+  EXPECT_THAT(actual.prefixes, ::testing::ElementsAre("dir1/", "dir2/"));
+}
+
+TEST(ListObjectsResponseTest, ParsePartial) {
+  std::string text = R"""({
+      "nextPageToken": "some-token-42",
+      "items": [
+        {"name": "foo", "size": "1024", "generation": "7"},
+        {"name": "bar", "size": "2048", "generation": "8"}
+      ]
+})""";
+
+  auto actual =
+      ListObjectsResponse::FromHttpResponse(HttpResponse{200, text, {}});
+  EXPECT_EQ("some-token-42", actual.next_page_token);
+  ASSERT_EQ(2U, actual.items.size());
+  EXPECT_EQ("foo", actual.items[0].name());
+  EXPECT_EQ(1024U, actual.items[0].size());
+  EXPECT_EQ(7, actual.items[0].generation());
+  EXPECT_TRUE(actual.items[0].acl().empty());
+  EXPECT_EQ("bar", actual.items[1].name());
+  EXPECT_EQ(2048U, actual.items[1].size());
+  EXPECT_EQ(8, actual.items[1].generation());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -130,6 +130,16 @@ std::pair<Status, EmptyResponse> LoggingClient::DeleteObject(
   return MakeCall(*client_, &RawClient::DeleteObject, request, __func__);
 }
 
+std::pair<Status, ObjectMetadata> LoggingClient::CopyObject(
+    CopyObjectRequest const& request) {
+  return MakeCall(*client_, &RawClient::CopyObject, request, __func__);
+}
+
+std::pair<Status, RewriteObjectResponse> LoggingClient::RewriteObject(
+    RewriteObjectRequest const& request) {
+  return MakeCall(*client_, &RawClient::RewriteObject, request, __func__);
+}
+
 std::pair<Status, ListBucketAclResponse> LoggingClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
   return MakeCall(*client_, &RawClient::ListBucketAcl, request, __func__);
@@ -165,6 +175,11 @@ std::pair<Status, ObjectAccessControl> LoggingClient::PatchObjectAcl(
   return MakeCall(*client_, &RawClient::PatchObjectAcl, request, __func__);
 }
 
+std::pair<Status, BatchResponse> LoggingClient::ExecuteBatch(
+    BatchRequest const& request) {
+  return MakeCall(*client_, &RawClient::ExecuteBatch, request, __func__);
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -58,6 +58,11 @@ class LoggingClient : public RawClient {
   std::pair<Status, EmptyResponse> DeleteObject(
       DeleteObjectRequest const&) override;
 
+  std::pair<Status, ObjectMetadata> CopyObject(
+      CopyObjectRequest const&) override;
+  std::pair<Status, RewriteObjectResponse> RewriteObject(
+      RewriteObjectRequest const&) override;
+
   std::pair<Status, ListBucketAclResponse> ListBucketAcl(
       ListBucketAclRequest const& request) override;
 
@@ -73,6 +78,7 @@ class LoggingClient : public RawClient {
       UpdateObjectAclRequest const&) override;
   std::pair<Status, ObjectAccessControl> PatchObjectAcl(
       PatchObjectAclRequest const&) override;
+  std::pair<Status, BatchResponse> ExecuteBatch(BatchRequest const&) override;
 
   std::shared_ptr<RawClient> client() const { return client_; }
 
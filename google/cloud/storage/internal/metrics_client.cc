@@ -0,0 +1,482 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/metrics_client.h"
+#include "google/cloud/storage/internal/raw_client_wrapper_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+namespace {
+using raw_client_wrapper_utils::CheckSignature;
+
+/// The payload sent by a request, most requests have no payload.
+template <typename Request>
+std::int64_t BytesSent(Request const&) {
+  return 0;
+}
+
+std::int64_t BytesSent(InsertObjectMediaRequest const& request) {
+  return static_cast<std::int64_t>(request.contents().size());
+}
+
+/// The number of items received by a response, only list responses have them.
+template <typename Response>
+std::int64_t ItemsReceived(Response const&) {
+  return 0;
+}
+
+template <typename Item>
+std::int64_t ItemsReceived(std::vector<Item> const& items) {
+  return static_cast<std::int64_t>(items.size());
+}
+
+std::int64_t ItemsReceived(ListBucketsResponse const& response) {
+  return ItemsReceived(response.items);
+}
+
+std::int64_t ItemsReceived(ListObjectsResponse const& response) {
+  return ItemsReceived(response.items);
+}
+
+std::int64_t ItemsReceived(ListBucketAclResponse const& response) {
+  return ItemsReceived(response.items);
+}
+
+std::int64_t ItemsReceived(ListObjectAclResponse const& response) {
+  return ItemsReceived(response.items);
+}
+
+std::int64_t ItemsReceived(BatchResponse const& response) {
+  return static_cast<std::int64_t>(response.responses.size());
+}
+
+/**
+ * Call a RawClient operation and report its latency and result.
+ *
+ * @tparam MemberFunction the signature of the member function.
+ * @param metrics receives the measurements.
+ * @param client the storage::RawClient object to make the call through.
+ * @param function the pointer to the member function to call.
+ * @param request an initialized request parameter for the call.
+ * @param rpc the name of the operation, used to aggregate the measurements.
+ * @return the result from making the call;
+ */
+template <typename MemberFunction>
+static typename std::enable_if<
+    CheckSignature<MemberFunction>::value,
+    typename CheckSignature<MemberFunction>::ReturnType>::type
+MakeCall(google::cloud::RpcMetrics& metrics, RawClient& client,
+         MemberFunction function,
+         typename CheckSignature<MemberFunction>::RequestType const& request,
+         char const* rpc) {
+  auto const start = std::chrono::steady_clock::now();
+  auto response = (client.*function)(request);
+  auto const elapsed = std::chrono::steady_clock::now() - start;
+  google::cloud::RpcMetricsRecord record{
+      rpc,
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed),
+      static_cast<int>(response.first.status_code()),
+      response.first.ok(),
+      BytesSent(request),
+      0,
+      ItemsReceived(response.second)};
+  metrics.OnAttemptComplete(record);
+  return response;
+}
+
+using Clock = std::chrono::steady_clock;
+
+/// Report a streaming operation that started at @p start.
+void ReportStream(google::cloud::RpcMetrics& metrics, char const* rpc,
+                  Clock::time_point start, long status_code, bool ok,
+                  std::int64_t bytes_sent, std::int64_t bytes_received,
+                  std::int64_t messages_received) {
+  google::cloud::RpcMetricsRecord record{
+      rpc,
+      std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                            start),
+      static_cast<int>(status_code),
+      ok,
+      bytes_sent,
+      bytes_received,
+      messages_received};
+  metrics.OnAttemptComplete(record);
+}
+
+/**
+ * Wrap the streambuf returned by `ReadObject()` to measure the download.
+ *
+ * The record is reported when the download reaches the end of the data, fails,
+ * or is closed, so the latency covers the complete transfer. This class has no
+ * buffer of its own: every read is forwarded to the wrapped streambuf and
+ * counted, so the data is not copied an extra time.
+ */
+class MetricsReadStreambuf : public ObjectReadStreambuf {
+ public:
+  MetricsReadStreambuf(std::unique_ptr<ObjectReadStreambuf> child,
+                       std::shared_ptr<google::cloud::RpcMetrics> metrics,
+                       Clock::time_point start)
+      : child_(std::move(child)),
+        metrics_(std::move(metrics)),
+        start_(start),
+        bytes_received_(0),
+        reported_(false) {}
+
+  ~MetricsReadStreambuf() override {
+    if (not reported_) {
+      Report(child_->status());
+    }
+  }
+
+  HttpResponse Close() override {
+    if (reported_) {
+      return child_->Close();
+    }
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      auto response = child_->Close();
+      Report(response);
+      return response;
+    } catch (...) {
+      Report(HttpResponse{0, {}, {}});
+      throw;
+    }
+#else
+    auto response = child_->Close();
+    Report(response);
+    return response;
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  }
+
+  bool IsOpen() const override { return child_->IsOpen(); }
+  std::string received_hash() const override {
+    return child_->received_hash();
+  }
+  std::string computed_hash() const override {
+    return child_->computed_hash();
+  }
+  bool cache_hit() const override { return child_->cache_hit(); }
+  Status status() const override { return child_->status(); }
+  std::multimap<std::string, std::string> headers() const override {
+    return child_->headers();
+  }
+
+ protected:
+  std::streamsize showmanyc() override { return child_->in_avail(); }
+
+  int_type underflow() override {
+    auto next = Forward([this] { return child_->sgetc(); });
+    if (traits_type::eq_int_type(next, traits_type::eof())) {
+      Report(child_->status());
+    }
+    return next;
+  }
+
+  int_type uflow() override {
+    auto next = Forward([this] { return child_->sbumpc(); });
+    if (traits_type::eq_int_type(next, traits_type::eof())) {
+      Report(child_->status());
+    } else {
+      ++bytes_received_;
+    }
+    return next;
+  }
+
+  std::streamsize xsgetn(char* s, std::streamsize count) override {
+    auto n = Forward([this, s, count] { return child_->sgetn(s, count); });
+    bytes_received_ += n;
+    if (n < count) {
+      // The wrapped streambuf only returns fewer bytes at the end of the data.
+      Report(child_->status());
+    }
+    return n;
+  }
+
+  int_type pbackfail(int_type ch) override {
+    auto r = traits_type::eq_int_type(ch, traits_type::eof())
+                 ? child_->sungetc()
+                 : child_->sputbackc(traits_type::to_char_type(ch));
+    if (not traits_type::eq_int_type(r, traits_type::eof())) {
+      --bytes_received_;
+    }
+    return r;
+  }
+
+ private:
+  /// Call @p f, and report the download as failed if it raises an exception.
+  template <typename Functor>
+  auto Forward(Functor f) -> decltype(f()) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      return f();
+    } catch (...) {
+      auto status = child_->status();
+      Report(status.ok() ? Status(0, "exception in ReadObject") : status);
+      throw;
+    }
+#else
+    return f();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  }
+
+  void Report(long status_code, bool ok) {
+    if (reported_) {
+      return;
+    }
+    reported_ = true;
+    ReportStream(*metrics_, "ReadObject", start_, status_code, ok, 0,
+                 bytes_received_, 0);
+  }
+
+  void Report(Status const& status) {
+    Report(status.status_code(), status.ok());
+  }
+
+  void Report(HttpResponse const& response) {
+    auto status = child_->status();
+    if (not status.ok()) {
+      Report(status);
+      return;
+    }
+    Report(response.status_code,
+           response.status_code != 0 and response.status_code < 300);
+  }
+
+  std::unique_ptr<ObjectReadStreambuf> child_;
+  std::shared_ptr<google::cloud::RpcMetrics> metrics_;
+  Clock::time_point start_;
+  std::int64_t bytes_received_;
+  bool reported_;
+};
+
+/**
+ * Wrap the streambuf returned by `WriteObject()` to measure the upload.
+ *
+ * The record is reported when the upload is closed, so the latency covers the
+ * complete transfer.
+ */
+class MetricsWriteStreambuf : public ObjectWriteStreambuf {
+ public:
+  MetricsWriteStreambuf(std::unique_ptr<ObjectWriteStreambuf> buf,
+                        std::shared_ptr<google::cloud::RpcMetrics> metrics,
+                        Clock::time_point start)
+      : buf_(std::move(buf)),
+        metrics_(std::move(metrics)),
+        start_(start),
+        bytes_sent_(0) {}
+
+  bool IsOpen() const override { return buf_->IsOpen(); }
+  std::string received_hash() const override { return buf_->received_hash(); }
+  std::string computed_hash() const override { return buf_->computed_hash(); }
+
+ protected:
+  int sync() override { return buf_->pubsync(); }
+
+  std::streamsize xsputn(char const* s, std::streamsize count) override {
+    auto n = buf_->sputn(s, count);
+    bytes_sent_ += n;
+    return n;
+  }
+
+  int_type overflow(int_type ch) override {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+      return traits_type::not_eof(ch);
+    }
+    auto r = buf_->sputc(traits_type::to_char_type(ch));
+    if (not traits_type::eq_int_type(r, traits_type::eof())) {
+      ++bytes_sent_;
+    }
+    return r;
+  }
+
+  HttpResponse DoClose() override {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      auto response = buf_->Close();
+      Report(response.status_code);
+      return response;
+    } catch (...) {
+      Report(0);
+      throw;
+    }
+#else
+    auto response = buf_->Close();
+    Report(response.status_code);
+    return response;
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  }
+
+ private:
+  void Report(long status_code) {
+    ReportStream(*metrics_, "WriteObject", start_, status_code,
+                 status_code != 0 and status_code < 300, bytes_sent_, 0, 0);
+  }
+
+  std::unique_ptr<ObjectWriteStreambuf> buf_;
+  std::shared_ptr<google::cloud::RpcMetrics> metrics_;
+  Clock::time_point start_;
+  std::int64_t bytes_sent_;
+};
+}  // namespace
+
+MetricsClient::MetricsClient(std::shared_ptr<RawClient> client,
+                             std::shared_ptr<google::cloud::RpcMetrics> metrics)
+    : client_(std::move(client)), metrics_(std::move(metrics)) {}
+
+ClientOptions const& MetricsClient::client_options() const {
+  return client_->client_options();
+}
+
+std::pair<Status, ListBucketsResponse> MetricsClient::ListBuckets(
+    ListBucketsRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::ListBuckets, request,
+                  __func__);
+}
+
+std::pair<Status, BucketMetadata> MetricsClient::GetBucketMetadata(
+    GetBucketMetadataRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::GetBucketMetadata, request,
+                  __func__);
+}
+
+std::pair<Status, EmptyResponse> MetricsClient::DeleteBucket(
+    DeleteBucketRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::DeleteBucket, request,
+                  __func__);
+}
+
+std::pair<Status, ObjectMetadata> MetricsClient::InsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::InsertObjectMedia, request,
+                  __func__);
+}
+
+std::pair<Status, ObjectMetadata> MetricsClient::GetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::GetObjectMetadata, request,
+                  __func__);
+}
+
+std::pair<Status, std::unique_ptr<ObjectReadStreambuf>>
+MetricsClient::ReadObject(ReadObjectRangeRequest const& request) {
+  auto const start = Clock::now();
+  auto result = client_->ReadObject(request);
+  if (not result.first.ok() or not result.second) {
+    ReportStream(*metrics_, __func__, start, result.first.status_code(),
+                 result.first.ok(), 0, 0, 0);
+    return result;
+  }
+  result.second.reset(
+      new MetricsReadStreambuf(std::move(result.second), metrics_, start));
+  return result;
+}
+
+std::pair<Status, std::unique_ptr<ObjectWriteStreambuf>>
+MetricsClient::WriteObject(InsertObjectStreamingRequest const& request) {
+  auto const start = Clock::now();
+  auto result = client_->WriteObject(request);
+  if (not result.first.ok() or not result.second) {
+    ReportStream(*metrics_, __func__, start, result.first.status_code(),
+                 result.first.ok(), 0, 0, 0);
+    return result;
+  }
+  result.second.reset(
+      new MetricsWriteStreambuf(std::move(result.second), metrics_, start));
+  return result;
+}
+
+std::pair<Status, ListObjectsResponse> MetricsClient::ListObjects(
+    ListObjectsRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::ListObjects, request,
+                  __func__);
+}
+
+std::pair<Status, EmptyResponse> MetricsClient::DeleteObject(
+    DeleteObjectRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::DeleteObject, request,
+                  __func__);
+}
+
+std::pair<Status, ObjectMetadata> MetricsClient::CopyObject(
+    CopyObjectRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::CopyObject, request,
+                  __func__);
+}
+
+std::pair<Status, RewriteObjectResponse> MetricsClient::RewriteObject(
+    RewriteObjectRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::RewriteObject, request,
+                  __func__);
+}
+
+std::pair<Status, ListBucketAclResponse> MetricsClient::ListBucketAcl(
+    ListBucketAclRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::ListBucketAcl, request,
+                  __func__);
+}
+
+std::pair<Status, ListObjectAclResponse> MetricsClient::ListObjectAcl(
+    ListObjectAclRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::ListObjectAcl, request,
+                  __func__);
+}
+
+std::pair<Status, ObjectAccessControl> MetricsClient::CreateObjectAcl(
+    CreateObjectAclRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::CreateObjectAcl, request,
+                  __func__);
+}
+
+std::pair<Status, EmptyResponse> MetricsClient::DeleteObjectAcl(
+    ObjectAclRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::DeleteObjectAcl, request,
+                  __func__);
+}
+
+std::pair<Status, ObjectAccessControl> MetricsClient::GetObjectAcl(
+    ObjectAclRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::GetObjectAcl, request,
+                  __func__);
+}
+
+std::pair<Status, ObjectAccessControl> MetricsClient::UpdateObjectAcl(
+    UpdateObjectAclRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::UpdateObjectAcl, request,
+                  __func__);
+}
+
+std::pair<Status, ObjectAccessControl> MetricsClient::PatchObjectAcl(
+    PatchObjectAclRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::PatchObjectAcl, request,
+                  __func__);
+}
+
+std::pair<Status, BatchResponse> MetricsClient::ExecuteBatch(
+    BatchRequest const& request) {
+  return MakeCall(*metrics_, *client_, &RawClient::ExecuteBatch, request,
+                  __func__);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,205 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/metrics_client.h"
+#include "google/cloud/storage/internal/retry_client.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/storage/testing/string_read_streambuf.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+using ::testing::Invoke;
+using ::testing::Return;
+using namespace storage::testing::canonical_errors;
+
+TEST(MetricsClientTest, InsertObjectMedia) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, InsertObjectMedia(_))
+      .WillOnce(Return(std::make_pair(Status(), ObjectMetadata())));
+
+  auto metrics = std::make_shared<google::cloud::HistogramRpcMetrics>();
+  MetricsClient client(mock, metrics);
+  client.InsertObjectMedia(
+      InsertObjectMediaRequest("foo-bar", "baz", "the contents"));
+
+  auto snapshot = metrics->Snapshot();
+  ASSERT_EQ(1U, snapshot.size());
+  auto const& summary = snapshot["InsertObjectMedia"];
+  EXPECT_EQ(1, summary.attempts);
+  EXPECT_EQ(12, summary.bytes_sent);
+  EXPECT_TRUE(summary.failures.empty());
+}
+
+TEST(MetricsClientTest, ListObjects) {
+  ListObjectsResponse response;
+  response.items.resize(3);
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillOnce(Return(std::make_pair(Status(), response)));
+
+  auto metrics = std::make_shared<google::cloud::HistogramRpcMetrics>();
+  MetricsClient client(mock, metrics);
+  client.ListObjects(ListObjectsRequest("foo-bar"));
+
+  auto summary = metrics->Snapshot()["ListObjects"];
+  EXPECT_EQ(1, summary.attempts);
+  EXPECT_EQ(3, summary.messages_received);
+}
+
+/// @test Verify that each attempt is reported when used below a RetryClient.
+TEST(MetricsClientTest, ReportsEachAttempt) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(std::make_pair(TransientError(), ObjectMetadata{})))
+      .WillOnce(Return(std::make_pair(TransientError(), ObjectMetadata{})))
+      .WillOnce(Return(std::make_pair(Status(), ObjectMetadata{})));
+
+  auto metrics = std::make_shared<google::cloud::HistogramRpcMetrics>();
+  RetryClient client(std::make_shared<MetricsClient>(mock, metrics),
+                     LimitedErrorCountRetryPolicy(3),
+                     ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                              std::chrono::milliseconds(1),
+                                              2.0));
+  client.GetObjectMetadata(GetObjectMetadataRequest("foo-bar", "baz"));
+
+  auto summary = metrics->Snapshot()["GetObjectMetadata"];
+  EXPECT_EQ(3, summary.attempts);
+  EXPECT_THAT(summary.failures,
+              ElementsAre(Pair(TransientError().status_code(), 2)));
+}
+
+/// @test Verify that downloads are reported once the stream reaches EOF.
+TEST(MetricsClientTest, ReadObjectReportsBytes) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce(Invoke([](ReadObjectRangeRequest const&) {
+        std::unique_ptr<ObjectReadStreambuf> buf(
+            new testing::StringReadStreambuf(testing::OBJECT_CONTENTS));
+        return std::make_pair(Status(), std::move(buf));
+      }));
+
+  auto metrics = std::make_shared<google::cloud::HistogramRpcMetrics>();
+  MetricsClient client(mock, metrics);
+  auto result = client.ReadObject(ReadObjectRangeRequest("foo-bar", "baz"));
+  ASSERT_TRUE(result.first.ok());
+  // Nothing is reported until the download completes.
+  EXPECT_TRUE(metrics->Snapshot().empty());
+
+  std::string actual;
+  char buffer[16];
+  while (auto n = result.second->sgetn(buffer, sizeof(buffer))) {
+    actual.append(buffer, static_cast<std::size_t>(n));
+  }
+  EXPECT_EQ(testing::OBJECT_CONTENTS, actual);
+
+  auto summary = metrics->Snapshot()["ReadObject"];
+  EXPECT_EQ(1, summary.attempts);
+  EXPECT_EQ(static_cast<std::int64_t>(testing::OBJECT_CONTENTS.size()),
+            summary.bytes_received);
+  EXPECT_TRUE(summary.failures.empty());
+
+  // Closing the stream after EOF does not report the download again.
+  result.second->Close();
+  EXPECT_EQ(1, metrics->Snapshot()["ReadObject"].attempts);
+}
+
+/// @test Verify that single character reads are counted too.
+TEST(MetricsClientTest, ReadObjectByCharacter) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce(Invoke([](ReadObjectRangeRequest const&) {
+        std::unique_ptr<ObjectReadStreambuf> buf(
+            new testing::StringReadStreambuf(testing::OBJECT_CONTENTS));
+        return std::make_pair(Status(), std::move(buf));
+      }));
+
+  auto metrics = std::make_shared<google::cloud::HistogramRpcMetrics>();
+  MetricsClient client(mock, metrics);
+  auto result = client.ReadObject(ReadObjectRangeRequest("foo-bar", "baz"));
+  ASSERT_TRUE(result.first.ok());
+
+  std::istream is(result.second.get());
+  EXPECT_EQ('0', is.peek());
+  EXPECT_EQ('0', is.get());
+  is.unget();
+  std::string actual(std::istreambuf_iterator<char>{is}, {});
+  EXPECT_EQ(testing::OBJECT_CONTENTS, actual);
+
+  auto summary = metrics->Snapshot()["ReadObject"];
+  EXPECT_EQ(1, summary.attempts);
+  EXPECT_EQ(static_cast<std::int64_t>(testing::OBJECT_CONTENTS.size()),
+            summary.bytes_received);
+}
+
+class StringWriteStreambuf : public ObjectWriteStreambuf {
+ public:
+  bool IsOpen() const override { return true; }
+
+ protected:
+  std::streamsize xsputn(char const* s, std::streamsize count) override {
+    contents_.append(s, static_cast<std::size_t>(count));
+    return count;
+  }
+  int_type overflow(int_type ch) override {
+    if (not traits_type::eq_int_type(ch, traits_type::eof())) {
+      contents_.push_back(traits_type::to_char_type(ch));
+    }
+    return traits_type::not_eof(ch);
+  }
+  HttpResponse DoClose() override { return HttpResponse{200, "{}", {}}; }
+
+ private:
+  std::string contents_;
+};
+
+/// @test Verify that uploads are reported when the stream is closed.
+TEST(MetricsClientTest, WriteObjectReportsBytes) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, WriteObject(_))
+      .WillOnce(Invoke([](InsertObjectStreamingRequest const&) {
+        std::unique_ptr<ObjectWriteStreambuf> buf(new StringWriteStreambuf);
+        return std::make_pair(Status(), std::move(buf));
+      }));
+
+  auto metrics = std::make_shared<google::cloud::HistogramRpcMetrics>();
+  MetricsClient client(mock, metrics);
+  auto result =
+      client.WriteObject(InsertObjectStreamingRequest("foo-bar", "baz"));
+  ASSERT_TRUE(result.first.ok());
+  std::string const data = "the contents";
+  result.second->sputn(data.data(), data.size());
+  result.second->sputc('\n');
+  EXPECT_TRUE(metrics->Snapshot().empty());
+
+  EXPECT_EQ(200, result.second->Close().status_code);
+  auto summary = metrics->Snapshot()["WriteObject"];
+  EXPECT_EQ(1, summary.attempts);
+  EXPECT_EQ(static_cast<std::int64_t>(data.size() + 1), summary.bytes_sent);
+  EXPECT_TRUE(summary.failures.empty());
+}
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,335 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_disk_cache.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include "google/cloud/log.h"
+#include "google/cloud/storage/internal/openssl_util.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+/// The suffix for complete cache entries, anything else is ignored.
+char const DATA_SUFFIX[] = ".data";
+
+bool EndsWith(std::string const& value, std::string const& suffix) {
+  return value.size() >= suffix.size() and
+         value.compare(value.size() - suffix.size(), suffix.size(), suffix) ==
+             0;
+}
+
+void CreateDirectory(std::string const& directory) {
+#ifdef _WIN32
+  int r = _mkdir(directory.c_str());
+#else
+  int r = mkdir(directory.c_str(), 0755);
+#endif  // _WIN32
+  if (r != 0 and errno != EEXIST) {
+    std::ostringstream os;
+    os << "Cannot create cache directory " << directory << ": "
+       << std::strerror(errno);
+    google::cloud::internal::RaiseRuntimeError(os.str());
+  }
+}
+}  // namespace
+
+std::unique_ptr<MappedFile> MappedFile::Open(std::string const& path) {
+#ifdef _WIN32
+  std::ifstream is(path, std::ios::binary);
+  if (not is) {
+    return std::unique_ptr<MappedFile>();
+  }
+  std::string contents(std::istreambuf_iterator<char>{is}, {});
+  std::unique_ptr<MappedFile> file(new MappedFile(nullptr, contents.size()));
+  file->contents_ = std::move(contents);
+  file->data_ = &file->contents_[0];
+  return file;
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return std::unique_ptr<MappedFile>();
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return std::unique_ptr<MappedFile>();
+  }
+  auto size = static_cast<std::size_t>(st.st_size);
+  char* data = nullptr;
+  // mmap(2) rejects empty mappings, empty files need no memory anyway.
+  if (size != 0) {
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      close(fd);
+      return std::unique_ptr<MappedFile>();
+    }
+    data = static_cast<char*>(addr);
+  }
+  // The mapping keeps a reference to the file, the descriptor is not needed.
+  close(fd);
+  return std::unique_ptr<MappedFile>(new MappedFile(data, size));
+#endif  // _WIN32
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+#endif  // _WIN32
+}
+
+ObjectDiskCache::ObjectDiskCache(std::string directory, std::int64_t max_size)
+    : directory_(std::move(directory)),
+      max_size_(max_size),
+      size_(0),
+      next_id_(0),
+      generator_(google::cloud::internal::MakeDefaultPRNG()) {
+  CreateDirectory(directory_);
+  LoadIndex();
+}
+
+std::string ObjectDiskCache::MakeKey(std::string const& bucket_name,
+                                     std::string const& object_name,
+                                     std::int64_t generation) {
+  // Object names can be longer than the maximum file name length, and contain
+  // characters that are not valid in file names. Use a hash of the name.
+  auto name =
+      bucket_name + '\n' + object_name + '\n' + std::to_string(generation);
+  auto context = OpenSslUtils::GetDigestCtx();
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int size = 0;
+  if (not context or
+      EVP_DigestInit_ex(context.get(), EVP_sha256(), nullptr) != 1 or
+      EVP_DigestUpdate(context.get(), name.data(), name.size()) != 1 or
+      EVP_DigestFinal_ex(context.get(), digest, &size) != 1) {
+    google::cloud::internal::RaiseRuntimeError(
+        "Cannot compute SHA256 hash for cache key");
+  }
+  char const HEX[] = "0123456789abcdef";
+  std::string key;
+  for (unsigned int i = 0; i != size; ++i) {
+    key.push_back(HEX[digest[i] >> 4]);
+    key.push_back(HEX[digest[i] & 0x0F]);
+  }
+  return key;
+}
+
+ObjectDiskCache::Result ObjectDiskCache::Lookup(std::string const& key) {
+  std::uint64_t id;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto loc = entries_.find(key);
+    if (loc == entries_.end()) {
+      return Result{std::shared_ptr<MappedFile>(), false};
+    }
+    lru_.splice(lru_.begin(), lru_, loc->second.lru);
+    id = loc->second.id;
+  }
+  auto file = MapEntry(key, id);
+  bool hit = static_cast<bool>(file);
+  return Result{std::move(file), hit};
+}
+
+ObjectDiskCache::Result ObjectDiskCache::LookupOrFill(std::string const& key,
+                                                      Writer const& writer) {
+  while (true) {
+    std::uint64_t id;
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      auto loc = entries_.find(key);
+      while (loc == entries_.end() and pending_.count(key) != 0) {
+        cv_.wait(lk);
+        loc = entries_.find(key);
+      }
+      if (loc == entries_.end()) {
+        pending_.insert(key);
+        break;
+      }
+      lru_.splice(lru_.begin(), lru_, loc->second.lru);
+      id = loc->second.id;
+    }
+    auto file = MapEntry(key, id);
+    if (file) {
+      return Result{std::move(file), true};
+    }
+  }
+  return Result{Fill(key, writer), false};
+}
+
+std::int64_t ObjectDiskCache::size() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return size_;
+}
+
+std::size_t ObjectDiskCache::entry_count() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return entries_.size();
+}
+
+void ObjectDiskCache::LoadIndex() {
+#ifndef _WIN32
+  DIR* dir = opendir(directory_.c_str());
+  if (dir == nullptr) {
+    return;
+  }
+  struct Found {
+    std::string key;
+    std::int64_t size;
+    time_t mtime;
+  };
+  std::vector<Found> found;
+  for (auto* entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (not EndsWith(name, DATA_SUFFIX)) {
+      continue;
+    }
+    struct stat st;
+    if (stat((directory_ + '/' + name).c_str(), &st) != 0 or
+        not S_ISREG(st.st_mode)) {
+      continue;
+    }
+    found.push_back(Found{name.substr(0, name.size() - sizeof(DATA_SUFFIX) + 1),
+                          static_cast<std::int64_t>(st.st_size),
+                          st.st_mtime});
+  }
+  closedir(dir);
+  // Insert the oldest files first, so they are the first ones evicted.
+  std::sort(found.begin(), found.end(), [](Found const& a, Found const& b) {
+    return a.mtime < b.mtime;
+  });
+  for (auto const& f : found) {
+    InsertImpl(f.key, f.size);
+  }
+#endif  // _WIN32
+}
+
+std::string ObjectDiskCache::PathFor(std::string const& key) const {
+  return directory_ + '/' + key + DATA_SUFFIX;
+}
+
+std::shared_ptr<MappedFile> ObjectDiskCache::MapEntry(std::string const& key,
+                                                      std::uint64_t id) {
+  // Mapping the file is relatively slow, do not block other threads. The file
+  // may be evicted and removed first, then the lookup fails.
+  std::shared_ptr<MappedFile> file = MappedFile::Open(PathFor(key));
+  if (file) {
+    return file;
+  }
+  std::lock_guard<std::mutex> lk(mu_);
+  auto loc = entries_.find(key);
+  if (loc != entries_.end() and loc->second.id == id) {
+    // The file was removed by some other process, the entry is stale.
+    EraseImpl(loc);
+  }
+  return file;
+}
+
+std::shared_ptr<MappedFile> ObjectDiskCache::Fill(std::string const& key,
+                                                  Writer const& writer) {
+  std::string tmp;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    tmp = directory_ + '/' + key + ".tmp-" +
+          google::cloud::internal::Sample(generator_, 16,
+                                          "abcdefghijklmnopqrstuvwxyz");
+  }
+  // Remove the temporary file and wake up any waiting threads, even if the
+  // writer raises an exception.
+  struct FillGuard {
+    ObjectDiskCache& cache;
+    std::string const& key;
+    std::string const& tmp;
+    ~FillGuard() {
+      std::remove(tmp.c_str());
+      std::lock_guard<std::mutex> lk(cache.mu_);
+      cache.pending_.erase(key);
+      cache.cv_.notify_all();
+    }
+  } guard{*this, key, tmp};
+
+  std::ofstream os(tmp, std::ios::binary | std::ios::trunc);
+  if (not os) {
+    GCP_LOG(WARNING) << "Cannot create cache file " << tmp;
+    return std::shared_ptr<MappedFile>();
+  }
+  bool success = writer(os);
+  os.close();
+  if (not success or os.fail()) {
+    return std::shared_ptr<MappedFile>();
+  }
+  std::shared_ptr<MappedFile> file = MappedFile::Open(tmp);
+  if (not file) {
+    return file;
+  }
+  auto size = static_cast<std::int64_t>(file->size());
+  std::lock_guard<std::mutex> lk(mu_);
+  // Objects larger than the cache are served from the (removed) temporary
+  // file.
+  if (size <= max_size_ and
+      std::rename(tmp.c_str(), PathFor(key).c_str()) == 0) {
+    InsertImpl(key, size);
+  }
+  return file;
+}
+
+void ObjectDiskCache::InsertImpl(std::string const& key, std::int64_t size) {
+  auto loc = entries_.find(key);
+  if (loc != entries_.end()) {
+    size_ -= loc->second.size;
+    loc->second.size = size;
+    loc->second.id = ++next_id_;
+    lru_.splice(lru_.begin(), lru_, loc->second.lru);
+  } else {
+    lru_.push_front(key);
+    entries_.emplace(key, Entry{size, lru_.begin(), ++next_id_});
+  }
+  size_ += size;
+  while (size_ > max_size_ and not lru_.empty()) {
+    auto victim = entries_.find(lru_.back());
+    std::remove(PathFor(victim->first).c_str());
+    EraseImpl(victim);
+  }
+}
+
+void ObjectDiskCache::EraseImpl(Map::iterator loc) {
+  size_ -= loc->second.size;
+  lru_.erase(loc->second.lru);
+  entries_.erase(loc);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
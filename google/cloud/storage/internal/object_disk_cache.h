@@ -0,0 +1,158 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_DISK_CACHE_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_DISK_CACHE_H_
+
+#include "google/cloud/internal/random.h"
+#include "google/cloud/storage/version.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A read-only view of a file, mapped into memory.
+ *
+ * The mapping remains valid after the file is removed, so the cache can evict
+ * files that are still being read.
+ */
+class MappedFile {
+ public:
+  /// Map the file at @p path, returns `nullptr` if the file cannot be mapped.
+  static std::unique_ptr<MappedFile> Open(std::string const& path);
+
+  ~MappedFile();
+
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+
+  char const* data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+ private:
+  MappedFile(char* data, std::size_t size) : data_(data), size_(size) {}
+
+  char* data_;
+  std::size_t size_;
+#ifdef _WIN32
+  // Without mmap(2) the contents are simply loaded into memory.
+  std::string contents_;
+#endif  // _WIN32
+};
+
+/**
+ * A local, on-disk, cache of object contents.
+ *
+ * Each entry is a file in `directory`, named after a hash of the bucket,
+ * object and generation. Object generations are immutable, so the entries
+ * never need to be revalidated. Once the total size of the files exceeds
+ * `max_size` the least recently used entries are removed. Objects larger than
+ * `max_size` are never stored.
+ *
+ * The cache index is loaded from the directory when the cache is created,
+ * using the modification time of the files to initialize the LRU order.
+ * Multiple processes may share the directory, but each one enforces the size
+ * limit independently.
+ */
+class ObjectDiskCache {
+ public:
+  /// Create a cache in @p directory, the directory is created if needed.
+  ObjectDiskCache(std::string directory, std::int64_t max_size);
+
+  /// Return the key for an object generation.
+  static std::string MakeKey(std::string const& bucket_name,
+                             std::string const& object_name,
+                             std::int64_t generation);
+
+  /// A function to write the contents of a cache entry, returns false on error.
+  using Writer = std::function<bool(std::ostream&)>;
+
+  /// The result of `LookupOrFill()`, `file` is null if the fill failed.
+  struct Result {
+    std::shared_ptr<MappedFile> file;
+    bool hit;
+  };
+
+  /// Return the contents for @p key, `file` is null on a miss.
+  Result Lookup(std::string const& key);
+
+  /**
+   * Return the contents for @p key, calling @p writer to fill the entry on a
+   * miss.
+   *
+   * Concurrent misses for the same key are coalesced: only one thread calls
+   * its @p writer, the others wait for it and are served from the cache. If
+   * the fill fails one of the waiting threads tries again.
+   */
+  Result LookupOrFill(std::string const& key, Writer const& writer);
+
+  /// The total size of the cached files.
+  std::int64_t size() const;
+
+  /// The number of cached files.
+  std::size_t entry_count() const;
+
+  /// The maximum size of the cache, larger objects are never stored.
+  std::int64_t max_size() const { return max_size_; }
+
+ private:
+  struct Entry {
+    std::int64_t size;
+    std::list<std::string>::iterator lru;
+    // Changes each time the file is replaced.
+    std::uint64_t id;
+  };
+  using Map = std::map<std::string, Entry>;
+
+  void LoadIndex();
+  std::string PathFor(std::string const& key) const;
+  std::shared_ptr<MappedFile> MapEntry(std::string const& key,
+                                       std::uint64_t id);
+  std::shared_ptr<MappedFile> Fill(std::string const& key,
+                                   Writer const& writer);
+  void InsertImpl(std::string const& key, std::int64_t size);
+  void EraseImpl(Map::iterator loc);
+
+  std::string directory_;
+  std::int64_t max_size_;
+  mutable std::mutex mu_;
+  std::condition_variable cv_;
+  Map entries_;
+  // The keys in most-recently-used order.
+  std::list<std::string> lru_;
+  std::int64_t size_;
+  // The keys being downloaded by some thread.
+  std::set<std::string> pending_;
+  std::uint64_t next_id_;
+  google::cloud::internal::DefaultPRNG generator_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_DISK_CACHE_H_
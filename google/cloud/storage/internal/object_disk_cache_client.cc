@@ -0,0 +1,246 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_disk_cache_client.h"
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+/**
+ * Read an object from a memory mapped file in the cache.
+ */
+class MappedFileReadStreambuf : public ObjectReadStreambuf {
+ public:
+  MappedFileReadStreambuf(std::shared_ptr<MappedFile> file, bool cache_hit)
+      : file_(std::move(file)), cache_hit_(cache_hit), is_open_(true) {
+    // The get area is never modified, `std::basic_streambuf` only writes to it
+    // through `pbackfail()`, which always fails in this class.
+    char* data = const_cast<char*>(file_->data());
+    setg(data, data, data + file_->size());
+  }
+
+  HttpResponse Close() override {
+    is_open_ = false;
+    return HttpResponse{200, {}, {}};
+  }
+  bool IsOpen() const override { return is_open_; }
+  bool cache_hit() const override { return cache_hit_; }
+
+ private:
+  std::shared_ptr<MappedFile> file_;
+  bool cache_hit_;
+  bool is_open_;
+};
+
+bool IsCacheable(ReadObjectRangeRequest const& request) {
+  auto const& gzip = request.get_option<EnableGzipDecompression>();
+  return request.begin() == 0 and request.end() == 0 and
+         not(gzip.has_value() and gzip.value()) and
+         not request.get_option<IfGenerationMatch>().has_value() and
+         not request.get_option<IfGenerationNotMatch>().has_value() and
+         not request.get_option<IfMetaGenerationMatch>().has_value() and
+         not request.get_option<IfMetaGenerationNotMatch>().has_value();
+}
+
+/// Copy the contents of @p buf to @p os, returns false on errors.
+bool CopyStream(ObjectReadStreambuf& buf, std::ostream& os) {
+  // TODO(#937) - use client options to configure buffer size.
+  std::vector<char> buffer(128 * 1024);
+  while (os) {
+    auto count = buf.sgetn(buffer.data(), buffer.size());
+    if (count <= 0) {
+      break;
+    }
+    os.write(buffer.data(), count);
+  }
+  // The download closes itself once all the data is received.
+  if (buf.IsOpen()) {
+    return buf.Close().status_code < 300 and os.good();
+  }
+  return os.good();
+}
+}  // namespace
+
+ObjectDiskCacheClient::ObjectDiskCacheClient(std::shared_ptr<RawClient> client,
+                                             std::string directory,
+                                             std::int64_t max_size)
+    : client_(std::move(client)),
+      cache_(new ObjectDiskCache(std::move(directory), max_size)) {}
+
+ClientOptions const& ObjectDiskCacheClient::client_options() const {
+  return client_->client_options();
+}
+
+std::pair<Status, ListBucketsResponse> ObjectDiskCacheClient::ListBuckets(
+    ListBucketsRequest const& request) {
+  return client_->ListBuckets(request);
+}
+
+std::pair<Status, BucketMetadata> ObjectDiskCacheClient::GetBucketMetadata(
+    GetBucketMetadataRequest const& request) {
+  return client_->GetBucketMetadata(request);
+}
+
+std::pair<Status, EmptyResponse> ObjectDiskCacheClient::DeleteBucket(
+    DeleteBucketRequest const& request) {
+  return client_->DeleteBucket(request);
+}
+
+std::pair<Status, ObjectMetadata> ObjectDiskCacheClient::InsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  return client_->InsertObjectMedia(request);
+}
+
+std::pair<Status, ObjectMetadata> ObjectDiskCacheClient::GetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  return client_->GetObjectMetadata(request);
+}
+
+std::pair<Status, std::unique_ptr<ObjectReadStreambuf>>
+ObjectDiskCacheClient::ReadObject(ReadObjectRangeRequest const& request) {
+  if (not IsCacheable(request)) {
+    return client_->ReadObject(request);
+  }
+  ReadObjectRangeRequest download = request;
+  // The data is always validated before it is stored in the cache.
+  download.set_multiple_options(DisableCrc32cChecksum(false));
+  GetObjectMetadataRequest metadata_request(request.bucket_name(),
+                                            request.object_name());
+  metadata_request.set_multiple_options(
+      Generation(request.get_option<Generation>()),
+      UserProject(request.get_option<UserProject>()));
+  if (request.get_option<Generation>().has_value()) {
+    // Cache hits do not need the metadata.
+    auto hit = cache_->Lookup(ObjectDiskCache::MakeKey(
+        request.bucket_name(), request.object_name(),
+        request.get_option<Generation>().value()));
+    if (hit.file) {
+      std::unique_ptr<ObjectReadStreambuf> buf(
+          new MappedFileReadStreambuf(std::move(hit.file), true));
+      return std::make_pair(Status(), std::move(buf));
+    }
+  }
+  auto metadata = client_->GetObjectMetadata(metadata_request);
+  if (not metadata.first.ok()) {
+    // Let the download report the error.
+    return client_->ReadObject(request);
+  }
+  if (static_cast<std::int64_t>(metadata.second.size()) > cache_->max_size()) {
+    // The object would never be stored, stream it directly to the application.
+    return client_->ReadObject(request);
+  }
+  download.set_multiple_options(Generation(metadata.second.generation()));
+
+  auto key = ObjectDiskCache::MakeKey(
+      request.bucket_name(), request.object_name(),
+      download.get_option<Generation>().value());
+  auto result = cache_->LookupOrFill(key, [this, &download](std::ostream& os) {
+    auto response = client_->ReadObject(download);
+    if (not response.first.ok() or not response.second) {
+      return false;
+    }
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      return CopyStream(*response.second, os);
+    } catch (std::exception const&) {
+      // The download is repeated without the cache, which reports the error.
+      return false;
+    }
+#else
+    return CopyStream(*response.second, os);
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  });
+  if (not result.file) {
+    return client_->ReadObject(request);
+  }
+  std::unique_ptr<ObjectReadStreambuf> buf(
+      new MappedFileReadStreambuf(std::move(result.file), result.hit));
+  return std::make_pair(Status(), std::move(buf));
+}
+
+std::pair<Status, std::unique_ptr<ObjectWriteStreambuf>>
+ObjectDiskCacheClient::WriteObject(
+    InsertObjectStreamingRequest const& request) {
+  return client_->WriteObject(request);
+}
+
+std::pair<Status, ListObjectsResponse> ObjectDiskCacheClient::ListObjects(
+    ListObjectsRequest const& request) {
+  return client_->ListObjects(request);
+}
+
+std::pair<Status, EmptyResponse> ObjectDiskCacheClient::DeleteObject(
+    DeleteObjectRequest const& request) {
+  return client_->DeleteObject(request);
+}
+
+std::pair<Status, ObjectMetadata> ObjectDiskCacheClient::CopyObject(
+    CopyObjectRequest const& request) {
+  return client_->CopyObject(request);
+}
+
+std::pair<Status, RewriteObjectResponse> ObjectDiskCacheClient::RewriteObject(
+    RewriteObjectRequest const& request) {
+  return client_->RewriteObject(request);
+}
+
+std::pair<Status, ListBucketAclResponse> ObjectDiskCacheClient::ListBucketAcl(
+    ListBucketAclRequest const& request) {
+  return client_->ListBucketAcl(request);
+}
+
+std::pair<Status, ListObjectAclResponse> ObjectDiskCacheClient::ListObjectAcl(
+    ListObjectAclRequest const& request) {
+  return client_->ListObjectAcl(request);
+}
+
+std::pair<Status, ObjectAccessControl> ObjectDiskCacheClient::CreateObjectAcl(
+    CreateObjectAclRequest const& request) {
+  return client_->CreateObjectAcl(request);
+}
+
+std::pair<Status, EmptyResponse> ObjectDiskCacheClient::DeleteObjectAcl(
+    ObjectAclRequest const& request) {
+  return client_->DeleteObjectAcl(request);
+}
+
+std::pair<Status, ObjectAccessControl> ObjectDiskCacheClient::GetObjectAcl(
+    ObjectAclRequest const& request) {
+  return client_->GetObjectAcl(request);
+}
+
+std::pair<Status, ObjectAccessControl> ObjectDiskCacheClient::UpdateObjectAcl(
+    UpdateObjectAclRequest const& request) {
+  return client_->UpdateObjectAcl(request);
+}
+
+std::pair<Status, ObjectAccessControl> ObjectDiskCacheClient::PatchObjectAcl(
+    PatchObjectAclRequest const& request) {
+  return client_->PatchObjectAcl(request);
+}
+
+std::pair<Status, BatchResponse> ObjectDiskCacheClient::ExecuteBatch(
+    BatchRequest const& request) {
+  return client_->ExecuteBatch(request);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
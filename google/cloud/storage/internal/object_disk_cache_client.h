@@ -0,0 +1,111 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_DISK_CACHE_CLIENT_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_DISK_CACHE_CLIENT_H_
+
+#include "google/cloud/storage/internal/object_disk_cache.h"
+#include "google/cloud/storage/internal/raw_client.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A decorator for `storage::Client` that caches object contents on disk.
+ *
+ * `ReadObject()` requests for a full object are served from an
+ * `ObjectDiskCache`, keyed by the bucket, object and generation. If the request
+ * does not specify a `Generation` the decorator first fetches the object
+ * metadata to find the current generation. On a cache miss the metadata is
+ * also used to stream objects larger than the cache directly, without storing
+ * them on disk. Reads with preconditions, ranges or `EnableGzipDecompression`
+ * bypass the cache, as do any requests where the cache cannot be used (e.g.
+ * because the metadata request failed).
+ *
+ * Cached objects are read directly from the memory mapped file, and the
+ * returned streams report `cache_hit()`.
+ */
+class ObjectDiskCacheClient : public RawClient {
+ public:
+  ObjectDiskCacheClient(std::shared_ptr<RawClient> client,
+                        std::string directory, std::int64_t max_size);
+  ~ObjectDiskCacheClient() override = default;
+
+  ClientOptions const& client_options() const override;
+
+  std::pair<Status, ListBucketsResponse> ListBuckets(
+      ListBucketsRequest const& request) override;
+
+  std::pair<Status, BucketMetadata> GetBucketMetadata(
+      GetBucketMetadataRequest const& request) override;
+  std::pair<Status, EmptyResponse> DeleteBucket(
+      DeleteBucketRequest const&) override;
+
+  std::pair<Status, ObjectMetadata> InsertObjectMedia(
+      InsertObjectMediaRequest const& request) override;
+
+  std::pair<Status, ObjectMetadata> GetObjectMetadata(
+      GetObjectMetadataRequest const& request) override;
+
+  std::pair<Status, std::unique_ptr<ObjectReadStreambuf>> ReadObject(
+      ReadObjectRangeRequest const&) override;
+
+  std::pair<Status, std::unique_ptr<ObjectWriteStreambuf>> WriteObject(
+      InsertObjectStreamingRequest const&) override;
+
+  std::pair<Status, ListObjectsResponse> ListObjects(
+      ListObjectsRequest const&) override;
+
+  std::pair<Status, EmptyResponse> DeleteObject(
+      DeleteObjectRequest const&) override;
+
+  std::pair<Status, ObjectMetadata> CopyObject(
+      CopyObjectRequest const&) override;
+  std::pair<Status, RewriteObjectResponse> RewriteObject(
+      RewriteObjectRequest const&) override;
+
+  std::pair<Status, ListBucketAclResponse> ListBucketAcl(
+      ListBucketAclRequest const& request) override;
+
+  std::pair<Status, ListObjectAclResponse> ListObjectAcl(
+      ListObjectAclRequest const& request) override;
+  std::pair<Status, ObjectAccessControl> CreateObjectAcl(
+      CreateObjectAclRequest const&) override;
+  std::pair<Status, EmptyResponse> DeleteObjectAcl(
+      ObjectAclRequest const&) override;
+  std::pair<Status, ObjectAccessControl> GetObjectAcl(
+      ObjectAclRequest const&) override;
+  std::pair<Status, ObjectAccessControl> UpdateObjectAcl(
+      UpdateObjectAclRequest const&) override;
+  std::pair<Status, ObjectAccessControl> PatchObjectAcl(
+      PatchObjectAclRequest const&) override;
+  std::pair<Status, BatchResponse> ExecuteBatch(BatchRequest const&) override;
+
+  std::shared_ptr<RawClient> client() const { return client_; }
+  ObjectDiskCache const& cache() const { return *cache_; }
+
+ private:
+  std::shared_ptr<RawClient> client_;
+  std::unique_ptr<ObjectDiskCache> cache_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_DISK_CACHE_CLIENT_H_
@@ -0,0 +1,226 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_disk_cache_client.h"
+#include "google/cloud/storage/object_stream.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/storage/testing/string_read_streambuf.h"
+#include <gmock/gmock.h>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <unistd.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using namespace storage::testing::canonical_errors;
+using storage::testing::StringReadStreambuf;
+
+std::pair<Status, std::unique_ptr<ObjectReadStreambuf>> MakeDownload(
+    std::string contents) {
+  return std::make_pair(Status(), std::unique_ptr<ObjectReadStreambuf>(
+                                      new StringReadStreambuf(contents)));
+}
+
+std::pair<Status, ObjectMetadata> MakeMetadata(std::int64_t generation,
+                                               std::uint64_t size) {
+  auto json = R"""({"generation": ")""" + std::to_string(generation) +
+              R"""(", "size": ")""" + std::to_string(size) + R"""("})""";
+  return std::make_pair(Status(), ObjectMetadata::ParseFromString(json));
+}
+
+std::string ReadAll(
+    std::pair<Status, std::unique_ptr<ObjectReadStreambuf>> result,
+    bool& cache_hit) {
+  ObjectReadStream stream(std::move(result.second));
+  std::string contents(std::istreambuf_iterator<char>{stream}, {});
+  cache_hit = stream.cache_hit();
+  return contents;
+}
+
+class ObjectDiskCacheClientTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char const* tmpdir = std::getenv("TMPDIR");
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    directory_ = std::string(tmpdir == nullptr ? "/tmp" : tmpdir) +
+                 "/object-disk-cache-client-test-" +
+                 google::cloud::internal::Sample(generator, 16,
+                                                 "abcdefghijklmnopqrstuvwxyz");
+    mock_ = std::make_shared<testing::MockClient>();
+  }
+
+  void TearDown() override {
+    DIR* dir = opendir(directory_.c_str());
+    if (dir == nullptr) {
+      return;
+    }
+    for (auto* entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+      std::remove((directory_ + '/' + entry->d_name).c_str());
+    }
+    closedir(dir);
+    rmdir(directory_.c_str());
+  }
+
+  std::string directory_;
+  std::shared_ptr<testing::MockClient> mock_;
+};
+
+/// @test Verify that reads for a generation are served from the cache.
+TEST_F(ObjectDiskCacheClientTest, ReadWithGeneration) {
+  // The metadata is only needed on a miss, to check the object size.
+  EXPECT_CALL(*mock_, GetObjectMetadata(_))
+      .WillOnce(Invoke([](GetObjectMetadataRequest const& r) {
+        EXPECT_EQ(7, r.get_option<Generation>().value());
+        return MakeMetadata(7, 12);
+      }));
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce(Invoke([](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(7, r.get_option<Generation>().value());
+        return MakeDownload("the contents");
+      }));
+
+  ObjectDiskCacheClient client(mock_, directory_, 1024);
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_multiple_options(Generation(7));
+  bool cache_hit = true;
+  EXPECT_EQ("the contents", ReadAll(client.ReadObject(request), cache_hit));
+  EXPECT_FALSE(cache_hit);
+  EXPECT_EQ("the contents", ReadAll(client.ReadObject(request), cache_hit));
+  EXPECT_TRUE(cache_hit);
+}
+
+/// @test Verify that the current generation is used when none is requested.
+TEST_F(ObjectDiskCacheClientTest, ReadLatestGeneration) {
+  EXPECT_CALL(*mock_, GetObjectMetadata(_))
+      .WillOnce(Return(MakeMetadata(7, 9)))
+      .WillOnce(Return(MakeMetadata(7, 9)))
+      .WillOnce(Return(MakeMetadata(8, 9)));
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce(Invoke([](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(7, r.get_option<Generation>().value());
+        return MakeDownload("version 7");
+      }))
+      .WillOnce(Invoke([](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(8, r.get_option<Generation>().value());
+        return MakeDownload("version 8");
+      }));
+
+  ObjectDiskCacheClient client(mock_, directory_, 1024);
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  bool cache_hit;
+  EXPECT_EQ("version 7", ReadAll(client.ReadObject(request), cache_hit));
+  EXPECT_EQ("version 7", ReadAll(client.ReadObject(request), cache_hit));
+  EXPECT_TRUE(cache_hit);
+  EXPECT_EQ("version 8", ReadAll(client.ReadObject(request), cache_hit));
+  EXPECT_FALSE(cache_hit);
+}
+
+/// @test Verify that objects larger than the cache are streamed directly.
+TEST_F(ObjectDiskCacheClientTest, BypassLargeObjects) {
+  EXPECT_CALL(*mock_, GetObjectMetadata(_))
+      .Times(2)
+      .WillRepeatedly(Return(MakeMetadata(7, 2048)));
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([](ReadObjectRangeRequest const& r) {
+        // The application request is used unmodified.
+        EXPECT_FALSE(r.get_option<Generation>().has_value());
+        EXPECT_FALSE(r.get_option<DisableCrc32cChecksum>().has_value());
+        return MakeDownload(std::string(2048, 'x'));
+      }));
+
+  ObjectDiskCacheClient client(mock_, directory_, 1024);
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  bool cache_hit;
+  EXPECT_EQ(2048U, ReadAll(client.ReadObject(request), cache_hit).size());
+  EXPECT_FALSE(cache_hit);
+  EXPECT_EQ(2048U, ReadAll(client.ReadObject(request), cache_hit).size());
+  EXPECT_FALSE(cache_hit);
+  EXPECT_EQ(0U, client.cache().entry_count());
+}
+
+/// @test Verify that requests with preconditions bypass the cache.
+TEST_F(ObjectDiskCacheClientTest, BypassWithPreconditions) {
+  EXPECT_CALL(*mock_, GetObjectMetadata(_)).Times(0);
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(7, r.get_option<IfGenerationMatch>().value());
+        return MakeDownload("the contents");
+      }));
+
+  ObjectDiskCacheClient client(mock_, directory_, 1024);
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_multiple_options(Generation(7), IfGenerationMatch(7));
+  bool cache_hit;
+  EXPECT_EQ("the contents", ReadAll(client.ReadObject(request), cache_hit));
+  EXPECT_EQ("the contents", ReadAll(client.ReadObject(request), cache_hit));
+  EXPECT_FALSE(cache_hit);
+  EXPECT_EQ(0U, client.cache().entry_count());
+}
+
+/// @test Verify that errors are reported by a regular download.
+TEST_F(ObjectDiskCacheClientTest, MetadataError) {
+  EXPECT_CALL(*mock_, GetObjectMetadata(_))
+      .WillOnce(Return(std::make_pair(PermanentError(), ObjectMetadata{})));
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce(Invoke([](ReadObjectRangeRequest const& r) {
+        EXPECT_FALSE(r.get_option<Generation>().has_value());
+        return std::make_pair(PermanentError(),
+                              std::unique_ptr<ObjectReadStreambuf>());
+      }));
+
+  ObjectDiskCacheClient client(mock_, directory_, 1024);
+  auto result =
+      client.ReadObject(ReadObjectRangeRequest("test-bucket", "test-object"));
+  EXPECT_EQ(PermanentError().status_code(), result.first.status_code());
+}
+
+/// @test Verify that failed downloads are not cached.
+TEST_F(ObjectDiskCacheClientTest, DownloadError) {
+  EXPECT_CALL(*mock_, GetObjectMetadata(_))
+      .WillOnce(Return(MakeMetadata(7, 9)));
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce(Invoke([](ReadObjectRangeRequest const&) {
+        return std::make_pair(TransientError(),
+                              std::unique_ptr<ObjectReadStreambuf>());
+      }))
+      .WillOnce(Invoke([](ReadObjectRangeRequest const&) {
+        return std::make_pair(TransientError(),
+                              std::unique_ptr<ObjectReadStreambuf>());
+      }));
+
+  ObjectDiskCacheClient client(mock_, directory_, 1024);
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_multiple_options(Generation(7));
+  auto result = client.ReadObject(request);
+  EXPECT_EQ(TransientError().status_code(), result.first.status_code());
+  EXPECT_EQ(0U, client.cache().entry_count());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,251 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_disk_cache.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <dirent.h>
+#include <unistd.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+class ObjectDiskCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char const* tmpdir = std::getenv("TMPDIR");
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    directory_ = std::string(tmpdir == nullptr ? "/tmp" : tmpdir) +
+                 "/object-disk-cache-test-" +
+                 google::cloud::internal::Sample(generator, 16,
+                                                 "abcdefghijklmnopqrstuvwxyz");
+  }
+
+  void TearDown() override {
+    DIR* dir = opendir(directory_.c_str());
+    if (dir == nullptr) {
+      return;
+    }
+    for (auto* entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+      std::remove((directory_ + '/' + entry->d_name).c_str());
+    }
+    closedir(dir);
+    rmdir(directory_.c_str());
+  }
+
+  std::string directory_;
+};
+
+ObjectDiskCache::Writer WriteContents(std::string contents, int& calls) {
+  return [contents, &calls](std::ostream& os) {
+    ++calls;
+    os << contents;
+    return true;
+  };
+}
+
+std::string AsString(ObjectDiskCache::Result const& result) {
+  return std::string(result.file->data(), result.file->size());
+}
+
+/// @test Verify that the key depends on all the object attributes.
+TEST_F(ObjectDiskCacheTest, MakeKey) {
+  auto key = ObjectDiskCache::MakeKey("bucket", "object", 1);
+  EXPECT_EQ(64U, key.size());
+  EXPECT_EQ(std::string::npos, key.find_first_not_of("0123456789abcdef"));
+  EXPECT_EQ(key, ObjectDiskCache::MakeKey("bucket", "object", 1));
+  EXPECT_NE(key, ObjectDiskCache::MakeKey("bucket", "object", 2));
+  EXPECT_NE(key, ObjectDiskCache::MakeKey("bucket", "object2", 1));
+  EXPECT_NE(key, ObjectDiskCache::MakeKey("bucket2", "object", 1));
+}
+
+/// @test Verify that the second lookup is served from the cache.
+TEST_F(ObjectDiskCacheTest, MissThenHit) {
+  ObjectDiskCache cache(directory_, 1024);
+  int calls = 0;
+  auto key = ObjectDiskCache::MakeKey("bucket", "object", 1);
+  auto miss = cache.LookupOrFill(key, WriteContents("the contents", calls));
+  ASSERT_TRUE(miss.file);
+  EXPECT_FALSE(miss.hit);
+  EXPECT_EQ("the contents", AsString(miss));
+
+  auto hit = cache.LookupOrFill(key, WriteContents("not used", calls));
+  ASSERT_TRUE(hit.file);
+  EXPECT_TRUE(hit.hit);
+  EXPECT_EQ("the contents", AsString(hit));
+  EXPECT_EQ(1, calls);
+  EXPECT_EQ(1U, cache.entry_count());
+  EXPECT_EQ(12, cache.size());
+}
+
+/// @test Verify that Lookup() never fills the cache.
+TEST_F(ObjectDiskCacheTest, Lookup) {
+  ObjectDiskCache cache(directory_, 1024);
+  int calls = 0;
+  auto key = ObjectDiskCache::MakeKey("bucket", "object", 1);
+  auto miss = cache.Lookup(key);
+  EXPECT_FALSE(miss.file);
+  EXPECT_FALSE(miss.hit);
+  EXPECT_EQ(0U, cache.entry_count());
+
+  cache.LookupOrFill(key, WriteContents("the contents", calls));
+  auto hit = cache.Lookup(key);
+  ASSERT_TRUE(hit.file);
+  EXPECT_TRUE(hit.hit);
+  EXPECT_EQ("the contents", AsString(hit));
+}
+
+/// @test Verify that entries removed by other processes are filled again.
+TEST_F(ObjectDiskCacheTest, RemovedFile) {
+  ObjectDiskCache cache(directory_, 1024);
+  int calls = 0;
+  auto key = ObjectDiskCache::MakeKey("bucket", "object", 1);
+  cache.LookupOrFill(key, WriteContents("the contents", calls));
+  std::remove((directory_ + '/' + key + ".data").c_str());
+
+  EXPECT_FALSE(cache.Lookup(key).file);
+  EXPECT_EQ(0U, cache.entry_count());
+  auto result = cache.LookupOrFill(key, WriteContents("the contents", calls));
+  ASSERT_TRUE(result.file);
+  EXPECT_FALSE(result.hit);
+  EXPECT_EQ(2, calls);
+  EXPECT_EQ(1U, cache.entry_count());
+}
+
+/// @test Verify that empty objects are cached.
+TEST_F(ObjectDiskCacheTest, EmptyObject) {
+  ObjectDiskCache cache(directory_, 1024);
+  int calls = 0;
+  auto key = ObjectDiskCache::MakeKey("bucket", "object", 1);
+  cache.LookupOrFill(key, WriteContents("", calls));
+  auto hit = cache.LookupOrFill(key, WriteContents("", calls));
+  ASSERT_TRUE(hit.file);
+  EXPECT_TRUE(hit.hit);
+  EXPECT_EQ(0U, hit.file->size());
+  EXPECT_EQ(1, calls);
+}
+
+/// @test Verify that the least recently used entries are evicted.
+TEST_F(ObjectDiskCacheTest, EvictLeastRecentlyUsed) {
+  ObjectDiskCache cache(directory_, 10);
+  int calls = 0;
+  auto a = ObjectDiskCache::MakeKey("bucket", "a", 1);
+  auto b = ObjectDiskCache::MakeKey("bucket", "b", 1);
+  auto c = ObjectDiskCache::MakeKey("bucket", "c", 1);
+  cache.LookupOrFill(a, WriteContents("aaaa", calls));
+  auto mapped = cache.LookupOrFill(b, WriteContents("bbbb", calls));
+  EXPECT_TRUE(cache.LookupOrFill(a, WriteContents("aaaa", calls)).hit);
+  cache.LookupOrFill(c, WriteContents("cccc", calls));
+  EXPECT_EQ(3, calls);
+  EXPECT_EQ(2U, cache.entry_count());
+  EXPECT_EQ(8, cache.size());
+
+  // The evicted file can still be read through the existing mapping.
+  EXPECT_EQ("bbbb", AsString(mapped));
+
+  EXPECT_TRUE(cache.LookupOrFill(a, WriteContents("aaaa", calls)).hit);
+  EXPECT_TRUE(cache.LookupOrFill(c, WriteContents("cccc", calls)).hit);
+  EXPECT_FALSE(cache.LookupOrFill(b, WriteContents("bbbb", calls)).hit);
+  EXPECT_EQ(4, calls);
+}
+
+/// @test Verify that objects larger than the cache are served, not stored.
+TEST_F(ObjectDiskCacheTest, TooLarge) {
+  ObjectDiskCache cache(directory_, 4);
+  int calls = 0;
+  auto key = ObjectDiskCache::MakeKey("bucket", "object", 1);
+  auto result = cache.LookupOrFill(key, WriteContents("0123456789", calls));
+  ASSERT_TRUE(result.file);
+  EXPECT_EQ("0123456789", AsString(result));
+  EXPECT_EQ(0U, cache.entry_count());
+  EXPECT_EQ(0, cache.size());
+}
+
+/// @test Verify that failed fills are not cached.
+TEST_F(ObjectDiskCacheTest, WriterFailure) {
+  ObjectDiskCache cache(directory_, 1024);
+  auto key = ObjectDiskCache::MakeKey("bucket", "object", 1);
+  auto result = cache.LookupOrFill(key, [](std::ostream& os) {
+    os << "partial";
+    return false;
+  });
+  EXPECT_FALSE(result.file);
+  EXPECT_EQ(0U, cache.entry_count());
+
+  int calls = 0;
+  result = cache.LookupOrFill(key, WriteContents("complete", calls));
+  ASSERT_TRUE(result.file);
+  EXPECT_EQ("complete", AsString(result));
+  EXPECT_EQ(1, calls);
+}
+
+/// @test Verify that the index is loaded from an existing directory.
+TEST_F(ObjectDiskCacheTest, LoadIndex) {
+  int calls = 0;
+  auto key = ObjectDiskCache::MakeKey("bucket", "object", 1);
+  {
+    ObjectDiskCache cache(directory_, 1024);
+    cache.LookupOrFill(key, WriteContents("the contents", calls));
+  }
+  ObjectDiskCache cache(directory_, 1024);
+  EXPECT_EQ(1U, cache.entry_count());
+  EXPECT_EQ(12, cache.size());
+  auto result = cache.LookupOrFill(key, WriteContents("not used", calls));
+  EXPECT_TRUE(result.hit);
+  EXPECT_EQ("the contents", AsString(result));
+  EXPECT_EQ(1, calls);
+}
+
+/// @test Verify that concurrent misses are coalesced into a single fill.
+TEST_F(ObjectDiskCacheTest, CoalesceMisses) {
+  ObjectDiskCache cache(directory_, 1024);
+  auto key = ObjectDiskCache::MakeKey("bucket", "object", 1);
+  std::atomic<int> calls(0);
+  auto writer = [&calls](std::ostream& os) {
+    ++calls;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    os << "the contents";
+    return true;
+  };
+
+  int const thread_count = 8;
+  std::vector<std::string> results(thread_count);
+  std::vector<std::thread> threads;
+  for (int i = 0; i != thread_count; ++i) {
+    threads.emplace_back([&cache, &key, &writer, &results, i] {
+      auto result = cache.LookupOrFill(key, writer);
+      results[i] = AsString(result);
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(1, calls.load());
+  for (auto const& r : results) {
+    EXPECT_EQ("the contents", r);
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
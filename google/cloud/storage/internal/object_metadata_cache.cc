@@ -0,0 +1,120 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_metadata_cache.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+// GCS bucket and object names cannot contain newlines, so they are safe to use
+// as separators. All the keys for an object share the same prefix.
+std::string KeyPrefix(std::string const& bucket_name,
+                      std::string const& object_name) {
+  return bucket_name + '\n' + object_name + '\n';
+}
+}  // namespace
+
+ObjectMetadataCache::ObjectMetadataCache(std::size_t max_entries,
+                                         std::chrono::milliseconds ttl)
+    : max_entries_(max_entries), ttl_(ttl), epoch_(0) {}
+
+std::string ObjectMetadataCache::MakeKey(std::string const& bucket_name,
+                                         std::string const& object_name,
+                                         std::int64_t generation,
+                                         std::string const& projection) {
+  return KeyPrefix(bucket_name, object_name) + std::to_string(generation) +
+         '\n' + projection;
+}
+
+ObjectMetadataCache::LookupResult ObjectMetadataCache::Lookup(
+    std::string const& key) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto loc = entries_.find(key);
+  if (loc == entries_.end()) {
+    return LookupResult{false, false, ObjectMetadata{}, epoch_};
+  }
+  lru_.splice(lru_.begin(), lru_, loc->second.lru);
+  bool fresh = std::chrono::steady_clock::now() < loc->second.expiration;
+  return LookupResult{true, fresh, loc->second.metadata, epoch_};
+}
+
+void ObjectMetadataCache::Insert(std::string const& key,
+                                 ObjectMetadata metadata,
+                                 std::uint64_t epoch) {
+  auto expiration = std::chrono::steady_clock::now() + ttl_;
+  std::lock_guard<std::mutex> lk(mu_);
+  if (epoch != epoch_ or max_entries_ == 0) {
+    return;
+  }
+  auto loc = entries_.find(key);
+  if (loc != entries_.end()) {
+    loc->second.metadata = std::move(metadata);
+    loc->second.expiration = expiration;
+    lru_.splice(lru_.begin(), lru_, loc->second.lru);
+    return;
+  }
+  lru_.push_front(key);
+  entries_.emplace(key, Entry{std::move(metadata), expiration, lru_.begin()});
+  while (entries_.size() > max_entries_) {
+    EraseImpl(entries_.find(lru_.back()));
+  }
+}
+
+void ObjectMetadataCache::Erase(std::string const& key) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto loc = entries_.find(key);
+  if (loc != entries_.end()) {
+    EraseImpl(loc);
+  }
+}
+
+void ObjectMetadataCache::Invalidate(std::string const& bucket_name,
+                                     std::string const& object_name) {
+  auto prefix = KeyPrefix(bucket_name, object_name);
+  std::lock_guard<std::mutex> lk(mu_);
+  ++epoch_;
+  auto loc = entries_.lower_bound(prefix);
+  while (loc != entries_.end() and
+         loc->first.compare(0, prefix.size(), prefix) == 0) {
+    auto next = std::next(loc);
+    EraseImpl(loc);
+    loc = next;
+  }
+}
+
+void ObjectMetadataCache::InvalidateAll() {
+  std::lock_guard<std::mutex> lk(mu_);
+  ++epoch_;
+  entries_.clear();
+  lru_.clear();
+}
+
+std::size_t ObjectMetadataCache::size() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return entries_.size();
+}
+
+void ObjectMetadataCache::EraseImpl(Map::iterator loc) {
+  lru_.erase(loc->second.lru);
+  entries_.erase(loc);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,108 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_METADATA_CACHE_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_METADATA_CACHE_H_
+
+#include "google/cloud/storage/object_metadata.h"
+#include <chrono>
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A bounded, thread-safe, cache of `ObjectMetadata` values.
+ *
+ * Entries are evicted in least-recently-used order once the cache is full.
+ * An entry is *fresh* for `ttl` after it was inserted, stale entries are kept
+ * so the caller can revalidate them with a conditional request.
+ *
+ * Each call to `Invalidate()` advances an epoch counter. Callers capture the
+ * epoch with `Lookup()` before making a request, and `Insert()` discards the
+ * value if any invalidation happened while the request was in progress. The
+ * counter is global, which may discard a few valid values, but it never
+ * caches a value older than a write made through the same client.
+ */
+class ObjectMetadataCache {
+ public:
+  ObjectMetadataCache(std::size_t max_entries, std::chrono::milliseconds ttl);
+
+  /**
+   * Return the key for an object.
+   *
+   * @param generation the requested generation, or 0 for the latest.
+   * @param projection the requested projection, it changes the contents of
+   *     the metadata.
+   */
+  static std::string MakeKey(std::string const& bucket_name,
+                             std::string const& object_name,
+                             std::int64_t generation,
+                             std::string const& projection);
+
+  /// The result of `Lookup()`, `metadata` is only set if `found` is true.
+  struct LookupResult {
+    bool found;
+    bool fresh;
+    ObjectMetadata metadata;
+    std::uint64_t epoch;
+  };
+
+  LookupResult Lookup(std::string const& key);
+
+  /// Insert or refresh an entry, unless it was invalidated after @p epoch.
+  void Insert(std::string const& key, ObjectMetadata metadata,
+              std::uint64_t epoch);
+
+  void Erase(std::string const& key);
+
+  /// Remove all the entries (any generation) for an object.
+  void Invalidate(std::string const& bucket_name,
+                  std::string const& object_name);
+
+  /// Remove all the entries.
+  void InvalidateAll();
+
+  std::size_t size() const;
+
+ private:
+  struct Entry {
+    ObjectMetadata metadata;
+    std::chrono::steady_clock::time_point expiration;
+    std::list<std::string>::iterator lru;
+  };
+  using Map = std::map<std::string, Entry>;
+
+  void EraseImpl(Map::iterator loc);
+
+  std::size_t max_entries_;
+  std::chrono::milliseconds ttl_;
+  mutable std::mutex mu_;
+  Map entries_;
+  // The keys in most-recently-used order.
+  std::list<std::string> lru_;
+  std::uint64_t epoch_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_METADATA_CACHE_H_
@@ -0,0 +1,287 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_metadata_cache_client.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+/// The HTTP status code for a successful revalidation.
+long const NOT_MODIFIED = 304;
+
+bool HasPreconditions(GetObjectMetadataRequest const& request) {
+  return request.get_option<IfGenerationMatch>().has_value() or
+         request.get_option<IfGenerationNotMatch>().has_value() or
+         request.get_option<IfMetaGenerationMatch>().has_value() or
+         request.get_option<IfMetaGenerationNotMatch>().has_value() or
+         request.get_option<IfNoneMatchEtag>().has_value();
+}
+
+/**
+ * Wrap the streambuf returned by `WriteObject()` to invalidate the cache.
+ *
+ * The object only changes when the upload completes, that is, when the
+ * wrapped streambuf is closed or destroyed.
+ */
+class InvalidatingWriteStreambuf : public ObjectWriteStreambuf {
+ public:
+  InvalidatingWriteStreambuf(std::unique_ptr<ObjectWriteStreambuf> buf,
+                             std::shared_ptr<ObjectMetadataCache> cache,
+                             std::string bucket_name, std::string object_name)
+      : buf_(std::move(buf)),
+        cache_(std::move(cache)),
+        bucket_name_(std::move(bucket_name)),
+        object_name_(std::move(object_name)),
+        closed_(false) {}
+
+  ~InvalidatingWriteStreambuf() override {
+    buf_.reset();
+    if (not closed_) {
+      cache_->Invalidate(bucket_name_, object_name_);
+    }
+  }
+
+  bool IsOpen() const override { return buf_->IsOpen(); }
+  std::string received_hash() const override { return buf_->received_hash(); }
+  std::string computed_hash() const override { return buf_->computed_hash(); }
+
+ protected:
+  int sync() override { return buf_->pubsync(); }
+
+  std::streamsize xsputn(char const* s, std::streamsize count) override {
+    return buf_->sputn(s, count);
+  }
+
+  int_type overflow(int_type ch) override {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+      return traits_type::not_eof(ch);
+    }
+    return buf_->sputc(traits_type::to_char_type(ch));
+  }
+
+  HttpResponse DoClose() override {
+    auto response = buf_->Close();
+    closed_ = true;
+    cache_->Invalidate(bucket_name_, object_name_);
+    return response;
+  }
+
+ private:
+  std::unique_ptr<ObjectWriteStreambuf> buf_;
+  std::shared_ptr<ObjectMetadataCache> cache_;
+  std::string bucket_name_;
+  std::string object_name_;
+  bool closed_;
+};
+}  // namespace
+
+ObjectMetadataCacheClient::ObjectMetadataCacheClient(
+    std::shared_ptr<RawClient> client, std::size_t max_entries,
+    std::chrono::milliseconds ttl)
+    : client_(std::move(client)),
+      cache_(std::make_shared<ObjectMetadataCache>(max_entries, ttl)) {}
+
+ClientOptions const& ObjectMetadataCacheClient::client_options() const {
+  return client_->client_options();
+}
+
+std::pair<Status, ListBucketsResponse> ObjectMetadataCacheClient::ListBuckets(
+    ListBucketsRequest const& request) {
+  return client_->ListBuckets(request);
+}
+
+std::pair<Status, BucketMetadata> ObjectMetadataCacheClient::GetBucketMetadata(
+    GetBucketMetadataRequest const& request) {
+  return client_->GetBucketMetadata(request);
+}
+
+std::pair<Status, EmptyResponse> ObjectMetadataCacheClient::DeleteBucket(
+    DeleteBucketRequest const& request) {
+  return client_->DeleteBucket(request);
+}
+
+std::pair<Status, ObjectMetadata> ObjectMetadataCacheClient::InsertObjectMedia(
+    InsertObjectMediaRequest const& request) {
+  auto result = client_->InsertObjectMedia(request);
+  cache_->Invalidate(request.bucket_name(), request.object_name());
+  return result;
+}
+
+std::pair<Status, ObjectMetadata> ObjectMetadataCacheClient::GetObjectMetadata(
+    GetObjectMetadataRequest const& request) {
+  // Partial responses cannot be used for other requests.
+  if (HasPreconditions(request) or request.get_option<Fields>().has_value()) {
+    return client_->GetObjectMetadata(request);
+  }
+  auto generation = request.get_option<Generation>();
+  auto projection = request.get_option<Projection>();
+  auto key = ObjectMetadataCache::MakeKey(
+      request.bucket_name(), request.object_name(),
+      generation.has_value() ? generation.value() : 0,
+      projection.has_value() ? projection.value() : std::string{});
+
+  auto lookup = cache_->Lookup(key);
+  if (lookup.found and lookup.fresh) {
+    return std::make_pair(Status(), std::move(lookup.metadata));
+  }
+  if (lookup.found) {
+    GetObjectMetadataRequest revalidate = request;
+    if (not lookup.metadata.etag().empty()) {
+      revalidate.set_multiple_options(IfNoneMatchEtag(lookup.metadata.etag()));
+    } else {
+      // Without the generation precondition a new object with the same
+      // metageneration would be reported as "not modified".
+      revalidate.set_multiple_options(
+          IfGenerationMatch(lookup.metadata.generation()),
+          IfMetaGenerationNotMatch(lookup.metadata.metageneration()));
+    }
+    auto result = client_->GetObjectMetadata(revalidate);
+    if (result.first.status_code() == NOT_MODIFIED) {
+      cache_->Insert(key, lookup.metadata, lookup.epoch);
+      return std::make_pair(Status(), std::move(lookup.metadata));
+    }
+    if (result.first.ok()) {
+      cache_->Insert(key, result.second, lookup.epoch);
+      return result;
+    }
+    cache_->Erase(key);
+    // A failed generation precondition means the object was replaced, fetch
+    // the new version. Any other errors are returned to the caller.
+    if (result.first.status_code() != 412) {
+      return result;
+    }
+    lookup = cache_->Lookup(key);
+  }
+  auto result = client_->GetObjectMetadata(request);
+  if (result.first.ok()) {
+    cache_->Insert(key, result.second, lookup.epoch);
+  }
+  return result;
+}
+
+std::pair<Status, std::unique_ptr<ObjectReadStreambuf>>
+ObjectMetadataCacheClient::ReadObject(ReadObjectRangeRequest const& request) {
+  return client_->ReadObject(request);
+}
+
+std::pair<Status, std::unique_ptr<ObjectWriteStreambuf>>
+ObjectMetadataCacheClient::WriteObject(
+    InsertObjectStreamingRequest const& request) {
+  auto result = client_->WriteObject(request);
+  if (not result.second) {
+    return result;
+  }
+  std::unique_ptr<ObjectWriteStreambuf> buf(new InvalidatingWriteStreambuf(
+      std::move(result.second), cache_, request.bucket_name(),
+      request.object_name()));
+  return std::make_pair(std::move(result.first), std::move(buf));
+}
+
+std::pair<Status, ListObjectsResponse> ObjectMetadataCacheClient::ListObjects(
+    ListObjectsRequest const& request) {
+  return client_->ListObjects(request);
+}
+
+std::pair<Status, EmptyResponse> ObjectMetadataCacheClient::DeleteObject(
+    DeleteObjectRequest const& request) {
+  auto result = client_->DeleteObject(request);
+  cache_->Invalidate(request.bucket_name(), request.object_name());
+  return result;
+}
+
+std::pair<Status, ObjectMetadata> ObjectMetadataCacheClient::CopyObject(
+    CopyObjectRequest const& request) {
+  auto result = client_->CopyObject(request);
+  cache_->Invalidate(request.destination_bucket(),
+                     request.destination_object());
+  return result;
+}
+
+std::pair<Status, RewriteObjectResponse>
+ObjectMetadataCacheClient::RewriteObject(RewriteObjectRequest const& request) {
+  auto result = client_->RewriteObject(request);
+  cache_->Invalidate(request.destination_bucket(),
+                     request.destination_object());
+  return result;
+}
+
+std::pair<Status, ListBucketAclResponse>
+ObjectMetadataCacheClient::ListBucketAcl(ListBucketAclRequest const& request) {
+  return client_->ListBucketAcl(request);
+}
+
+std::pair<Status, ListObjectAclResponse>
+ObjectMetadataCacheClient::ListObjectAcl(ListObjectAclRequest const& request) {
+  return client_->ListObjectAcl(request);
+}
+
+std::pair<Status, ObjectAccessControl>
+ObjectMetadataCacheClient::CreateObjectAcl(
+    CreateObjectAclRequest const& request) {
+  auto result = client_->CreateObjectAcl(request);
+  cache_->Invalidate(request.bucket_name(), request.object_name());
+  return result;
+}
+
+std::pair<Status, EmptyResponse> ObjectMetadataCacheClient::DeleteObjectAcl(
+    ObjectAclRequest const& request) {
+  auto result = client_->DeleteObjectAcl(request);
+  cache_->Invalidate(request.bucket_name(), request.object_name());
+  return result;
+}
+
+std::pair<Status, ObjectAccessControl> ObjectMetadataCacheClient::GetObjectAcl(
+    ObjectAclRequest const& request) {
+  return client_->GetObjectAcl(request);
+}
+
+std::pair<Status, ObjectAccessControl>
+ObjectMetadataCacheClient::UpdateObjectAcl(
+    UpdateObjectAclRequest const& request) {
+  auto result = client_->UpdateObjectAcl(request);
+  cache_->Invalidate(request.bucket_name(), request.object_name());
+  return result;
+}
+
+std::pair<Status, ObjectAccessControl>
+ObjectMetadataCacheClient::PatchObjectAcl(
+    PatchObjectAclRequest const& request) {
+  auto result = client_->PatchObjectAcl(request);
+  cache_->Invalidate(request.bucket_name(), request.object_name());
+  return result;
+}
+
+std::pair<Status, BatchResponse> ObjectMetadataCacheClient::ExecuteBatch(
+    BatchRequest const& request) {
+  auto result = client_->ExecuteBatch(request);
+  // The operations in a batch are already formatted as HTTP requests, it is
+  // simpler to discard all the entries than to find the affected objects.
+  bool modifies = std::any_of(
+      request.operations().begin(), request.operations().end(),
+      [](BatchOperation const& op) { return op.method != "GET"; });
+  if (modifies) {
+    cache_->InvalidateAll();
+  }
+  return result;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
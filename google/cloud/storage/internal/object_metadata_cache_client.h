@@ -0,0 +1,118 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_METADATA_CACHE_CLIENT_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_METADATA_CACHE_CLIENT_H_
+
+#include "google/cloud/storage/internal/object_metadata_cache.h"
+#include "google/cloud/storage/internal/raw_client.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A decorator for `storage::Client` that caches the results of
+ * `GetObjectMetadata()`.
+ *
+ * Fresh entries are returned without contacting the service. Stale entries are
+ * revalidated with a conditional request, using `IfNoneMatchEtag` (or
+ * `IfGenerationMatch` and `IfMetaGenerationNotMatch` if the metadata has no
+ * etag). If the object has not changed the service returns `304 Not Modified`
+ * with an empty payload, and the cached value is used.
+ *
+ * Requests with preconditions or `Fields` always bypass the cache. Operations
+ * made through this decorator that modify an object, such as
+ * `InsertObjectMedia()`, `WriteObject()`, `DeleteObject()`, or any changes to
+ * the object ACL, invalidate the cached entries for that object. `CopyObject()`
+ * and `RewriteObject()` invalidate the entries for the destination object.
+ *
+ * The decorator must be installed below the `RetryClient`, the retry policies
+ * treat the `304` status as a permanent error.
+ */
+class ObjectMetadataCacheClient : public RawClient {
+ public:
+  ObjectMetadataCacheClient(std::shared_ptr<RawClient> client,
+                            std::size_t max_entries,
+                            std::chrono::milliseconds ttl);
+  ~ObjectMetadataCacheClient() override = default;
+
+  ClientOptions const& client_options() const override;
+
+  std::pair<Status, ListBucketsResponse> ListBuckets(
+      ListBucketsRequest const& request) override;
+
+  std::pair<Status, BucketMetadata> GetBucketMetadata(
+      GetBucketMetadataRequest const& request) override;
+  std::pair<Status, EmptyResponse> DeleteBucket(
+      DeleteBucketRequest const&) override;
+
+  std::pair<Status, ObjectMetadata> InsertObjectMedia(
+      InsertObjectMediaRequest const& request) override;
+
+  std::pair<Status, ObjectMetadata> GetObjectMetadata(
+      GetObjectMetadataRequest const& request) override;
+
+  std::pair<Status, std::unique_ptr<ObjectReadStreambuf>> ReadObject(
+      ReadObjectRangeRequest const&) override;
+
+  std::pair<Status, std::unique_ptr<ObjectWriteStreambuf>> WriteObject(
+      InsertObjectStreamingRequest const&) override;
+
+  std::pair<Status, ListObjectsResponse> ListObjects(
+      ListObjectsRequest const&) override;
+
+  std::pair<Status, EmptyResponse> DeleteObject(
+      DeleteObjectRequest const&) override;
+
+  std::pair<Status, ObjectMetadata> CopyObject(
+      CopyObjectRequest const&) override;
+  std::pair<Status, RewriteObjectResponse> RewriteObject(
+      RewriteObjectRequest const&) override;
+
+  std::pair<Status, ListBucketAclResponse> ListBucketAcl(
+      ListBucketAclRequest const& request) override;
+
+  std::pair<Status, ListObjectAclResponse> ListObjectAcl(
+      ListObjectAclRequest const& request) override;
+  std::pair<Status, ObjectAccessControl> CreateObjectAcl(
+      CreateObjectAclRequest const&) override;
+  std::pair<Status, EmptyResponse> DeleteObjectAcl(
+      ObjectAclRequest const&) override;
+  std::pair<Status, ObjectAccessControl> GetObjectAcl(
+      ObjectAclRequest const&) override;
+  std::pair<Status, ObjectAccessControl> UpdateObjectAcl(
+      UpdateObjectAclRequest const&) override;
+  std::pair<Status, ObjectAccessControl> PatchObjectAcl(
+      PatchObjectAclRequest const&) override;
+  std::pair<Status, BatchResponse> ExecuteBatch(BatchRequest const&) override;
+
+  std::shared_ptr<RawClient> client() const { return client_; }
+  ObjectMetadataCache const& cache() const { return *cache_; }
+
+ private:
+  std::shared_ptr<RawClient> client_;
+  // The cache is shared with the streams returned by `WriteObject()`, which
+  // invalidate the object when they are closed.
+  std::shared_ptr<ObjectMetadataCache> cache_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_METADATA_CACHE_CLIENT_H_
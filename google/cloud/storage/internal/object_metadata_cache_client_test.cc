@@ -0,0 +1,278 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/object_metadata_cache_client.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using namespace storage::testing::canonical_errors;
+
+ObjectMetadata MakeMetadata(std::string const& etag, std::int64_t generation,
+                            std::int64_t metageneration) {
+  return ObjectMetadata::ParseFromString(R"""({
+      "bucket": "test-bucket",
+      "name": "test-object",
+      "etag": ")""" + etag + R"""(",
+      "generation": ")""" + std::to_string(generation) + R"""(",
+      "metageneration": ")""" + std::to_string(metageneration) + R"""("
+  })""");
+}
+
+std::chrono::milliseconds const LONG_TTL = std::chrono::minutes(10);
+std::chrono::milliseconds const ZERO_TTL = std::chrono::milliseconds(0);
+
+/// @test Verify that fresh entries do not contact the service.
+TEST(ObjectMetadataCacheClientTest, FreshHit) {
+  auto mock = std::make_shared<testing::MockClient>();
+  auto expected = MakeMetadata("XYZ", 7, 1);
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(std::make_pair(Status(), expected)));
+
+  ObjectMetadataCacheClient client(mock, 10, LONG_TTL);
+  for (int i = 0; i != 3; ++i) {
+    auto actual =
+        client.GetObjectMetadata(GetObjectMetadataRequest("test-bucket",
+                                                          "test-object"));
+    EXPECT_TRUE(actual.first.ok());
+    EXPECT_EQ(expected, actual.second);
+  }
+  EXPECT_EQ(1U, client.cache().size());
+}
+
+/// @test Verify that stale entries are revalidated using the etag.
+TEST(ObjectMetadataCacheClientTest, RevalidateNotModified) {
+  auto mock = std::make_shared<testing::MockClient>();
+  auto expected = MakeMetadata("XYZ", 7, 1);
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([&expected](GetObjectMetadataRequest const& r) {
+        EXPECT_FALSE(r.get_option<IfNoneMatchEtag>().has_value());
+        return std::make_pair(Status(), expected);
+      }))
+      .WillOnce(Invoke([](GetObjectMetadataRequest const& r) {
+        EXPECT_EQ("XYZ", r.get_option<IfNoneMatchEtag>().value());
+        EXPECT_EQ(3, r.get_option<Generation>().value());
+        return std::make_pair(Status(304, ""), ObjectMetadata{});
+      }));
+
+  ObjectMetadataCacheClient client(mock, 10, ZERO_TTL);
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  request.set_multiple_options(Generation(3));
+  EXPECT_EQ(expected, client.GetObjectMetadata(request).second);
+  auto actual = client.GetObjectMetadata(request);
+  EXPECT_TRUE(actual.first.ok());
+  EXPECT_EQ(expected, actual.second);
+}
+
+/// @test Verify that modified objects replace the cached value.
+TEST(ObjectMetadataCacheClientTest, RevalidateModified) {
+  auto mock = std::make_shared<testing::MockClient>();
+  auto original = MakeMetadata("XYZ", 7, 1);
+  auto updated = MakeMetadata("ABC", 7, 2);
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(std::make_pair(Status(), original)))
+      .WillOnce(Return(std::make_pair(Status(), updated)))
+      .WillOnce(Invoke([](GetObjectMetadataRequest const& r) {
+        EXPECT_EQ("ABC", r.get_option<IfNoneMatchEtag>().value());
+        return std::make_pair(Status(304, ""), ObjectMetadata{});
+      }));
+
+  ObjectMetadataCacheClient client(mock, 10, ZERO_TTL);
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  EXPECT_EQ(original, client.GetObjectMetadata(request).second);
+  EXPECT_EQ(updated, client.GetObjectMetadata(request).second);
+  EXPECT_EQ(updated, client.GetObjectMetadata(request).second);
+}
+
+/// @test Verify the revalidation when the metadata does not have an etag.
+TEST(ObjectMetadataCacheClientTest, RevalidateWithoutEtag) {
+  auto mock = std::make_shared<testing::MockClient>();
+  auto original = MakeMetadata("", 7, 1);
+  auto replaced = MakeMetadata("", 8, 1);
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(std::make_pair(Status(), original)))
+      .WillOnce(Invoke([](GetObjectMetadataRequest const& r) {
+        EXPECT_EQ(7, r.get_option<IfGenerationMatch>().value());
+        EXPECT_EQ(1, r.get_option<IfMetaGenerationNotMatch>().value());
+        return std::make_pair(Status(412, "precondition failed"),
+                              ObjectMetadata{});
+      }))
+      .WillOnce(Invoke([&replaced](GetObjectMetadataRequest const& r) {
+        EXPECT_FALSE(r.get_option<IfGenerationMatch>().has_value());
+        return std::make_pair(Status(), replaced);
+      }));
+
+  ObjectMetadataCacheClient client(mock, 10, ZERO_TTL);
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  EXPECT_EQ(original, client.GetObjectMetadata(request).second);
+  auto actual = client.GetObjectMetadata(request);
+  EXPECT_TRUE(actual.first.ok());
+  EXPECT_EQ(replaced, actual.second);
+}
+
+/// @test Verify that errors are not cached.
+TEST(ObjectMetadataCacheClientTest, ErrorsNotCached) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(std::make_pair(TransientError(), ObjectMetadata{})))
+      .WillOnce(Return(std::make_pair(Status(), MakeMetadata("XYZ", 7, 1))));
+
+  ObjectMetadataCacheClient client(mock, 10, LONG_TTL);
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  EXPECT_FALSE(client.GetObjectMetadata(request).first.ok());
+  EXPECT_TRUE(client.GetObjectMetadata(request).first.ok());
+  EXPECT_TRUE(client.GetObjectMetadata(request).first.ok());
+}
+
+/// @test Verify that requests with preconditions bypass the cache.
+TEST(ObjectMetadataCacheClientTest, PreconditionsBypass) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .Times(2)
+      .WillRepeatedly(
+          Return(std::make_pair(Status(), MakeMetadata("XYZ", 7, 1))));
+
+  ObjectMetadataCacheClient client(mock, 10, LONG_TTL);
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  request.set_multiple_options(IfMetaGenerationMatch(1));
+  client.GetObjectMetadata(request);
+  client.GetObjectMetadata(request);
+  EXPECT_EQ(0U, client.cache().size());
+}
+
+/// @test Verify that partial responses are not cached.
+TEST(ObjectMetadataCacheClientTest, FieldsBypass) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .Times(2)
+      .WillRepeatedly(
+          Return(std::make_pair(Status(), MakeMetadata("XYZ", 7, 1))));
+
+  ObjectMetadataCacheClient client(mock, 10, LONG_TTL);
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  request.set_multiple_options(Fields("name,size"));
+  client.GetObjectMetadata(request);
+  client.GetObjectMetadata(request);
+  EXPECT_EQ(0U, client.cache().size());
+}
+
+/// @test Verify that changes to the object invalidate the cache.
+TEST(ObjectMetadataCacheClientTest, WritesInvalidate) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .Times(3)
+      .WillRepeatedly(
+          Return(std::make_pair(Status(), MakeMetadata("XYZ", 7, 1))));
+  EXPECT_CALL(*mock, DeleteObject(_))
+      .WillOnce(Return(std::make_pair(Status(), EmptyResponse{})));
+  EXPECT_CALL(*mock, PatchObjectAcl(_))
+      .WillOnce(Return(std::make_pair(Status(), ObjectAccessControl{})));
+
+  ObjectMetadataCacheClient client(mock, 10, LONG_TTL);
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  client.GetObjectMetadata(request);
+  client.PatchObjectAcl(
+      PatchObjectAclRequest("test-bucket", "test-object", "user-test",
+                            ObjectAccessControlPatchBuilder()));
+  EXPECT_EQ(0U, client.cache().size());
+  client.GetObjectMetadata(request);
+  client.DeleteObject(DeleteObjectRequest("test-bucket", "test-object"));
+  EXPECT_EQ(0U, client.cache().size());
+  client.GetObjectMetadata(request);
+}
+
+class MockStreambuf : public ObjectWriteStreambuf {
+ public:
+  MOCK_CONST_METHOD0(IsOpen, bool());
+  MOCK_METHOD0(DoClose, HttpResponse());
+};
+
+/// @test Verify that uploads invalidate the cache when they complete.
+TEST(ObjectMetadataCacheClientTest, WriteObjectInvalidates) {
+  auto mock = std::make_shared<testing::MockClient>();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Return(std::make_pair(Status(), MakeMetadata("XYZ", 7, 1))));
+  EXPECT_CALL(*mock, WriteObject(_))
+      .WillOnce(Invoke([](InsertObjectStreamingRequest const&) {
+        auto* mock_result = new MockStreambuf;
+        EXPECT_CALL(*mock_result, DoClose())
+            .WillOnce(Return(HttpResponse{200, "{}", {}}));
+        std::unique_ptr<ObjectWriteStreambuf> result(mock_result);
+        return std::make_pair(Status(), std::move(result));
+      }));
+
+  ObjectMetadataCacheClient client(mock, 10, LONG_TTL);
+  client.GetObjectMetadata(
+      GetObjectMetadataRequest("test-bucket", "test-object"));
+  auto buf =
+      client
+          .WriteObject(InsertObjectStreamingRequest("test-bucket",
+                                                    "test-object"))
+          .second;
+  EXPECT_EQ(1U, client.cache().size());
+  EXPECT_EQ(200, buf->Close().status_code);
+  EXPECT_EQ(0U, client.cache().size());
+}
+
+/// @test Verify that the least recently used entries are evicted.
+TEST(ObjectMetadataCacheTest, Eviction) {
+  ObjectMetadataCache cache(2, LONG_TTL);
+  auto epoch = cache.Lookup("a").epoch;
+  cache.Insert("a", MakeMetadata("A", 1, 1), epoch);
+  cache.Insert("b", MakeMetadata("B", 1, 1), epoch);
+  EXPECT_TRUE(cache.Lookup("a").found);
+  cache.Insert("c", MakeMetadata("C", 1, 1), epoch);
+  EXPECT_EQ(2U, cache.size());
+  EXPECT_TRUE(cache.Lookup("a").found);
+  EXPECT_FALSE(cache.Lookup("b").found);
+  EXPECT_TRUE(cache.Lookup("c").found);
+}
+
+/// @test Verify that values fetched before an invalidation are discarded.
+TEST(ObjectMetadataCacheTest, InsertAfterInvalidate) {
+  ObjectMetadataCache cache(10, LONG_TTL);
+  auto key = ObjectMetadataCache::MakeKey("test-bucket", "test-object", 0, "");
+  auto lookup = cache.Lookup(key);
+  cache.Invalidate("test-bucket", "test-object");
+  cache.Insert(key, MakeMetadata("XYZ", 7, 1), lookup.epoch);
+  EXPECT_FALSE(cache.Lookup(key).found);
+
+  // Invalidation removes all the generations, but only for that object.
+  auto epoch = cache.Lookup(key).epoch;
+  cache.Insert(key, MakeMetadata("XYZ", 7, 1), epoch);
+  cache.Insert(ObjectMetadataCache::MakeKey("test-bucket", "test-object", 7,
+                                            "full"),
+               MakeMetadata("XYZ", 7, 1), epoch);
+  cache.Insert(ObjectMetadataCache::MakeKey("test-bucket", "test-object-2", 0,
+                                            ""),
+               MakeMetadata("XYZ", 7, 1), epoch);
+  EXPECT_EQ(3U, cache.size());
+  cache.Invalidate("test-bucket", "test-object");
+  EXPECT_EQ(1U, cache.size());
+}
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -16,7 +16,10 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_STREAMBUF_H_
 
 #include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/status.h"
 #include <iostream>
+#include <map>
+#include <string>
 
 namespace google {
 namespace cloud {
@@ -38,6 +41,28 @@ class ObjectReadStreambuf : public std::basic_streambuf<char> {
 
   virtual HttpResponse Close() = 0;
   virtual bool IsOpen() const = 0;
+
+  /// The hashes reported by the service, empty until the download completes.
+  virtual std::string received_hash() const { return std::string{}; }
+
+  /// The hashes computed from the data, empty until the download completes.
+  virtual std::string computed_hash() const { return std::string{}; }
+
+  /// Return true if the data is read from a local cache.
+  virtual bool cache_hit() const { return false; }
+
+  /// The error reported by the service or the network, if the download failed.
+  virtual Status status() const { return Status(); }
+
+  /**
+   * The response headers.
+   *
+   * The headers are received before any data, they are available after the
+   * first read.
+   */
+  virtual std::multimap<std::string, std::string> headers() const {
+    return {};
+  }
 };
 
 /**
@@ -56,6 +81,12 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
   HttpResponse Close();
   virtual bool IsOpen() const = 0;
 
+  /// The hashes reported by the service, empty until the upload is closed.
+  virtual std::string received_hash() const { return std::string{}; }
+
+  /// The hashes computed from the data, empty until the upload is closed.
+  virtual std::string computed_hash() const { return std::string{}; }
+
  protected:
   virtual HttpResponse DoClose() = 0;
 };
@@ -199,6 +199,23 @@ struct OpenSslUtils {
     return b64str;
   }
 
+  /**
+   * Create a new OpenSSL digest context.
+   */
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)  // Older than version 1.1.0
+  inline static std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_destroy)>
+  GetDigestCtx() {
+    return std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_destroy)>(
+        EVP_MD_CTX_create(), &EVP_MD_CTX_destroy);
+  };
+#else
+  inline static std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>
+  GetDigestCtx() {
+    return std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>(
+        EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+  };
+#endif
+
  private:
   static std::unique_ptr<BIO, decltype(&BIO_free_all)>
   MakeBioChainForBase64Transcoding() {
@@ -222,20 +239,6 @@ struct OpenSslUtils {
     BIO_set_flags(static_cast<BIO*>(bio_chain.get()), BIO_FLAGS_BASE64_NO_NL);
     return bio_chain;
   }
-
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)  // Older than version 1.1.0
-  inline static std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_destroy)>
-  GetDigestCtx() {
-    return std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_destroy)>(
-        EVP_MD_CTX_create(), &EVP_MD_CTX_destroy);
-  };
-#else
-  inline static std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>
-  GetDigestCtx() {
-    return std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>(
-        EVP_MD_CTX_new(), &EVP_MD_CTX_free);
-  };
-#endif
 };
 
 }  // namespace internal
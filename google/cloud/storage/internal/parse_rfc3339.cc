@@ -15,6 +15,7 @@
 #include "google/cloud/storage/internal/parse_rfc3339.h"
 #include "google/cloud/internal/throw_delegate.h"
 #include <cctype>
+#include <cstdint>
 #include <cstdio>
 #include <iomanip>
 #include <iostream>
@@ -168,6 +169,112 @@ std::chrono::seconds ParseOffset(char const*& buffer,
   ++buffer;
   return std::chrono::seconds(0);
 }
+
+/// Convert a civil date (in the proleptic Gregorian calendar) to days since
+/// 1970-01-01, see http://howardhinnant.github.io/date_algorithms.html
+std::int64_t DaysFromCivil(int year, unsigned month, unsigned day) {
+  year -= month <= 2 ? 1 : 0;
+  int const era = (year >= 0 ? year : year - 399) / 400;
+  auto const yoe = static_cast<unsigned>(year - era * 400);
+  unsigned const doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 +
+                       day - 1;
+  unsigned const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097LL + static_cast<std::int64_t>(doe) - 719468LL;
+}
+
+/**
+ * Parse the timestamp formats generated by Google Cloud Storage.
+ *
+ * The service always uses `YYYY-MM-DDTHH:MM:SS[.fraction]Z`, so all the fields
+ * are at fixed positions. This function parses that layout directly, without
+ * sscanf(3) or mktime(3), and returns false for anything else (including any
+ * invalid date or time), in which case the caller uses the general purpose
+ * parser, which also reports the errors.
+ */
+bool ParseRfc3339Fast(std::string const& timestamp,
+                      std::chrono::system_clock::time_point& result) {
+  constexpr std::size_t BASE_WIDTH = 19;
+  if (timestamp.size() <= BASE_WIDTH) {
+    return false;
+  }
+  char const* p = timestamp.data();
+  if (p[4] != '-' or p[7] != '-' or p[10] != 'T' or p[13] != ':' or
+      p[16] != ':') {
+    return false;
+  }
+  // Accumulate the validation of all the digits, instead of checking each one.
+  unsigned invalid = 0;
+  auto digit = [&invalid](char c) {
+    unsigned d = static_cast<unsigned char>(c) - static_cast<unsigned>('0');
+    invalid |= static_cast<unsigned>(d > 9);
+    return d;
+  };
+  auto two_digits = [&digit](char const* q) {
+    return digit(q[0]) * 10 + digit(q[1]);
+  };
+  unsigned const year =
+      digit(p[0]) * 1000 + digit(p[1]) * 100 + two_digits(p + 2);
+  unsigned const month = two_digits(p + 5);
+  unsigned const day = two_digits(p + 8);
+  unsigned const hours = two_digits(p + 11);
+  unsigned const minutes = two_digits(p + 14);
+  unsigned const seconds = two_digits(p + 17);
+  if (invalid != 0) {
+    return false;
+  }
+
+  constexpr unsigned DAYS_IN_MONTH[] = {31, 28, 31, 30, 31, 30,
+                                        31, 31, 30, 31, 30, 31};
+  unsigned const month_days =
+      month == 2 and IsLeapYear(static_cast<int>(year))
+          ? 29
+          : DAYS_IN_MONTH[(month - 1) % 12];
+  // Leap seconds are accepted, as in ParseDateTime().
+  if (month < 1 or month > 12 or day < 1 or day > month_days or hours > 23 or
+      minutes > 59 or seconds > 60) {
+    return false;
+  }
+
+  std::size_t pos = BASE_WIDTH;
+  std::int64_t nanos = 0;
+  if (p[pos] == '.') {
+    ++pos;
+    std::size_t const start = pos;
+    // Ignore any digits past nanoseconds, as ParseFractionalSeconds() does.
+    for (; pos != timestamp.size(); ++pos) {
+      unsigned d = static_cast<unsigned char>(p[pos]) -
+                   static_cast<unsigned>('0');
+      if (d > 9) {
+        break;
+      }
+      if (pos - start < 9) {
+        nanos = nanos * 10 + d;
+      }
+    }
+    if (pos == start) {
+      return false;
+    }
+    constexpr std::int64_t SCALE[] = {1000000000, 100000000, 10000000,
+                                      1000000,    100000,    10000,
+                                      1000,       100,       10,
+                                      1};
+    nanos *= SCALE[pos - start < 9 ? pos - start : 9];
+  }
+  if (pos + 1 != timestamp.size() or p[pos] != 'Z') {
+    return false;
+  }
+
+  std::int64_t const seconds_since_epoch =
+      DaysFromCivil(static_cast<int>(year), month, day) * 86400LL +
+      hours * 3600LL + minutes * 60LL + seconds;
+  using std::chrono::duration_cast;
+  result = std::chrono::system_clock::time_point(
+      duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::seconds(seconds_since_epoch)) +
+      duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::nanoseconds(nanos)));
+  return true;
+}
 }  // anonymous namespace
 
 namespace google {
@@ -177,6 +284,15 @@ inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 std::chrono::system_clock::time_point ParseRfc3339(
     std::string const& timestamp) {
+  std::chrono::system_clock::time_point result;
+  if (ParseRfc3339Fast(timestamp, result)) {
+    return result;
+  }
+  return ParseRfc3339Generic(timestamp);
+}
+
+std::chrono::system_clock::time_point ParseRfc3339Generic(
+    std::string const& timestamp) {
   // TODO(#530) - dynamically change the timezone offset.
   // Because this computation is a bit expensive, assume the timezone offset
   // does not change during the lifetime of the program.  This function takes
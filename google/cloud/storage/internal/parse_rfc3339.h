@@ -36,11 +36,24 @@ namespace internal {
  * precision in fractional seconds, though it would be surprising to see
  * femtosecond timestamp for Internet events.
  *
+ * The timestamps in the format used by the service
+ * (`YYYY-MM-DDTHH:MM:SS[.fraction]Z`) are parsed by a specialized fast path,
+ * any other valid RFC-3339 timestamp is parsed by `ParseRfc3339Generic()`.
+ *
  * @see https://tools.ietf.org/html/rfc3339
  */
 std::chrono::system_clock::time_point ParseRfc3339(
     std::string const& timestamp);
 
+/**
+ * Parse @p timestamp as RFC-3339 format, without using the fast path.
+ *
+ * Applications should use `ParseRfc3339()`, this function is only exposed to
+ * test and benchmark the fast path against it.
+ */
+std::chrono::system_clock::time_point ParseRfc3339Generic(
+    std::string const& timestamp);
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -15,6 +15,7 @@
 #include "google/cloud/storage/internal/parse_rfc3339.h"
 #include <gtest/gtest.h>
 #include <ctime>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -130,6 +131,41 @@ TEST(ParseRfc3339Test, ParseFull) {
   EXPECT_EQ(500, actual_milliseconds.count());
 }
 
+TEST(ParseRfc3339Test, ParseLeapSecond) {
+  auto timestamp = ParseRfc3339("2016-12-31T23:59:60Z");
+  // Use `date -u +%s --date='2017-01-01T00:00:00'` to get the magic value:
+  EXPECT_EQ(1483228800L,
+            duration_cast<seconds>(timestamp.time_since_epoch()).count());
+}
+
+TEST(ParseRfc3339Test, ParseBeforeEpoch) {
+  auto timestamp = ParseRfc3339("1969-12-31T23:59:59.250Z");
+  EXPECT_EQ(-750L,
+            duration_cast<milliseconds>(timestamp.time_since_epoch()).count());
+}
+
+/// @test Verify the fast path agrees with the general purpose parser.
+TEST(ParseRfc3339Test, FastPathMatchesGeneric) {
+  std::vector<std::string> timestamps{
+      "1970-01-01T00:00:00Z",
+      "1999-12-31T23:59:59Z",
+      "2000-02-29T12:00:00Z",
+      "2016-02-29T00:00:00.1Z",
+      "2018-03-01T01:02:03.12Z",
+      "2018-05-18T14:42:03.123Z",
+      "2018-05-18T14:42:03.1234Z",
+      "2018-05-18T14:42:03.123456Z",
+      "2018-05-18T14:42:03.123456789Z",
+      "2018-05-18T14:42:03.1234567890123Z",
+      "2018-12-31T23:59:59.999Z",
+      "2100-03-01T00:00:00Z",
+      "2199-12-31T23:59:59Z",
+  };
+  for (auto const& t : timestamps) {
+    EXPECT_EQ(ParseRfc3339Generic(t), ParseRfc3339(t)) << "timestamp=" << t;
+  }
+}
+
 TEST(ParseRfc3339Test, DetectInvalidSeparator) {
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
   EXPECT_THROW(ParseRfc3339("2018-05-18x14:42:03Z"), std::invalid_argument);
@@ -145,6 +181,24 @@ TEST(ParseRfc3339Test, DetectInvalidSeparator) {
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 }
 
+TEST(ParseRfc3339Test, DetectMissingFractional) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(ParseRfc3339("2018-05-18T14:42:03.Z"), std::invalid_argument);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(ParseRfc3339("2018-05-18T14:42:03.Z"),
+                            "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+TEST(ParseRfc3339Test, DetectInvalidDigit) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(ParseRfc3339("2018-05-1xT14:42:03Z"), std::invalid_argument);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(ParseRfc3339("2018-05-1xT14:42:03Z"),
+                            "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
 TEST(ParseRfc3339Test, DetectLongYear) {
 #if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
   EXPECT_THROW(ParseRfc3339("52018-05-18T14:42:03Z"), std::invalid_argument);
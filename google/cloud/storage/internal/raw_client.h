@@ -18,6 +18,7 @@
 #include "google/cloud/storage/bucket_metadata.h"
 #include "google/cloud/storage/client_options.h"
 #include "google/cloud/storage/credentials.h"
+#include "google/cloud/storage/internal/batch_request.h"
 #include "google/cloud/storage/internal/bucket_acl_requests.h"
 #include "google/cloud/storage/internal/bucket_requests.h"
 #include "google/cloud/storage/internal/delete_object_request.h"
@@ -29,6 +30,7 @@
 #include "google/cloud/storage/internal/object_acl_requests.h"
 #include "google/cloud/storage/internal/object_streambuf.h"
 #include "google/cloud/storage/internal/read_object_range_request.h"
+#include "google/cloud/storage/internal/rewrite_object_requests.h"
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/storage/status.h"
 
@@ -78,6 +80,17 @@ class RawClient {
   virtual std::pair<Status, EmptyResponse> DeleteObject(
       DeleteObjectRequest const&) = 0;
 
+  virtual std::pair<Status, ObjectMetadata> CopyObject(
+      CopyObjectRequest const&) = 0;
+  /**
+   * Execute one step of an object rewrite.
+   *
+   * The caller repeats the request, with the token in the response, until the
+   * response reports that the rewrite is done.
+   */
+  virtual std::pair<Status, RewriteObjectResponse> RewriteObject(
+      RewriteObjectRequest const&) = 0;
+
   virtual std::pair<Status, ListBucketAclResponse> ListBucketAcl(
       ListBucketAclRequest const&) = 0;
 
@@ -93,6 +106,15 @@ class RawClient {
       UpdateObjectAclRequest const&) = 0;
   virtual std::pair<Status, ObjectAccessControl> PatchObjectAcl(
       PatchObjectAclRequest const&) = 0;
+
+  /**
+   * Execute several operations in a single request.
+   *
+   * The returned status is the status of the batch request itself, the result
+   * of each operation is in the corresponding element of the response.
+   */
+  virtual std::pair<Status, BatchResponse> ExecuteBatch(
+      BatchRequest const&) = 0;
 };
 
 }  // namespace internal
@@ -16,6 +16,8 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_READ_OBJECT_RANGE_REQUEST_H_
 
 #include "google/cloud/storage/internal/generic_object_request.h"
+#include "google/cloud/storage/compression_options.h"
+#include "google/cloud/storage/hashing_options.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/well_known_parameters.h"
 
@@ -28,10 +30,11 @@ namespace internal {
  * Request a range of object data.
  */
 class ReadObjectRangeRequest
-    : public GenericObjectRequest<ReadObjectRangeRequest, Generation,
-                                  IfGenerationMatch, IfGenerationNotMatch,
-                                  IfMetaGenerationMatch,
-                                  IfMetaGenerationNotMatch, UserProject> {
+    : public GenericObjectRequest<
+          ReadObjectRangeRequest, DisableCrc32cChecksum,
+          EnableGzipDecompression, EnableMD5Hash, Generation,
+          IfGenerationMatch, IfGenerationNotMatch, IfMetaGenerationMatch,
+          IfMetaGenerationNotMatch, UserProject> {
  public:
   ReadObjectRangeRequest() : GenericObjectRequest(), begin_(0), end_(0) {}
 
@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/internal/retry_client.h"
 #include "google/cloud/storage/internal/raw_client_wrapper_utils.h"
+#include "google/cloud/storage/internal/retry_object_read_streambuf.h"
 #include <sstream>
 #include <thread>
 
@@ -52,8 +53,9 @@ using raw_client_wrapper_utils::CheckSignature;
  * @param client the storage::Client object to make the call through.
  * @param retry_policy the policy controlling what failures are retryable, and
  *     for how long we can retry
- * @param backoff_policy the policy controlling how long to wait before
- *     retrying.
+ * @param backoff_prototype the policy controlling how long to wait before
+ *     retrying. It is only cloned if the first attempt fails, most operations
+ *     succeed on the first attempt and do not need any backoff state.
  * @param function the pointer to the member function to call.
  * @param request an initialized request parameter for the call.
  * @param error_message include this message in any exception or error log.
@@ -64,11 +66,12 @@ template <typename MemberFunction>
 static typename std::enable_if<
     CheckSignature<MemberFunction>::value,
     typename CheckSignature<MemberFunction>::ReturnType>::type
-MakeCall(RetryPolicy& retry_policy, BackoffPolicy& backoff_policy,
+MakeCall(RetryPolicy& retry_policy, BackoffPolicy const& backoff_prototype,
          RawClient& client, MemberFunction function,
          typename CheckSignature<MemberFunction>::RequestType const& request,
          char const* error_message) {
   google::cloud::storage::Status last_status;
+  std::unique_ptr<BackoffPolicy> backoff_policy;
   while (not retry_policy.IsExhausted()) {
     auto result = (client.*function)(request);
     if (result.first.ok()) {
@@ -85,7 +88,10 @@ MakeCall(RetryPolicy& retry_policy, BackoffPolicy& backoff_policy,
       }
       google::cloud::internal::RaiseRuntimeError(os.str());
     }
-    auto delay = backoff_policy.OnCompletion();
+    if (not backoff_policy) {
+      backoff_policy = backoff_prototype.clone();
+    }
+    auto delay = backoff_policy->OnCompletion();
     std::this_thread::sleep_for(delay);
   }
   std::ostringstream os;
@@ -114,48 +120,57 @@ ClientOptions const& RetryClient::client_options() const {
 std::pair<Status, ListBucketsResponse> RetryClient::ListBuckets(
     ListBucketsRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::ListBuckets, request, __func__);
 }
 
 std::pair<Status, BucketMetadata> RetryClient::GetBucketMetadata(
     GetBucketMetadataRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::GetBucketMetadata, request, __func__);
 }
 
 std::pair<Status, EmptyResponse> RetryClient::DeleteBucket(
     DeleteBucketRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::DeleteBucket, request, __func__);
 }
 
 std::pair<Status, ObjectMetadata> RetryClient::InsertObjectMedia(
     InsertObjectMediaRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::InsertObjectMedia, request, __func__);
 }
 
 std::pair<Status, ObjectMetadata> RetryClient::GetObjectMetadata(
     GetObjectMetadataRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::GetObjectMetadata, request, __func__);
 }
 
 std::pair<Status, std::unique_ptr<ObjectReadStreambuf>> RetryClient::ReadObject(
     ReadObjectRangeRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  // Decompressed downloads cannot be resumed, the offsets in the data do not
+  // match the offsets in the object.
+  auto const& gzip = request.get_option<EnableGzipDecompression>();
+  if (not(gzip.has_value() and gzip.value())) {
+    auto result = MakeCall(*retry_policy, *backoff_policy_, *client_,
+                           &RawClient::ReadObject,
+                           RetryObjectReadStreambuf::ChildRequest(request, 0),
+                           __func__);
+    std::unique_ptr<ObjectReadStreambuf> buf(new RetryObjectReadStreambuf(
+        client_, request, std::move(result.second), *retry_policy_,
+        *backoff_policy_));
+    return std::make_pair(std::move(result.first), std::move(buf));
+  }
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::ReadObject, request, __func__);
 }
 
@@ -163,83 +178,96 @@ std::pair<Status, std::unique_ptr<ObjectWriteStreambuf>>
 RetryClient::WriteObject(
     internal::InsertObjectStreamingRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::WriteObject, request, __func__);
 }
 
 std::pair<Status, ListObjectsResponse> RetryClient::ListObjects(
     ListObjectsRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::ListObjects, request, __func__);
 }
 
 std::pair<Status, EmptyResponse> RetryClient::DeleteObject(
     DeleteObjectRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::DeleteObject, request, __func__);
 }
 
+std::pair<Status, ObjectMetadata> RetryClient::CopyObject(
+    CopyObjectRequest const& request) {
+  auto retry_policy = retry_policy_->clone();
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
+                  &RawClient::CopyObject, request, __func__);
+}
+
+std::pair<Status, RewriteObjectResponse> RetryClient::RewriteObject(
+    RewriteObjectRequest const& request) {
+  auto retry_policy = retry_policy_->clone();
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
+                  &RawClient::RewriteObject, request, __func__);
+}
+
 std::pair<Status, ListBucketAclResponse> RetryClient::ListBucketAcl(
     ListBucketAclRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::ListBucketAcl, request, __func__);
 }
 
 std::pair<Status, ListObjectAclResponse> RetryClient::ListObjectAcl(
     ListObjectAclRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::ListObjectAcl, request, __func__);
 }
 
 std::pair<Status, ObjectAccessControl> RetryClient::CreateObjectAcl(
     CreateObjectAclRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::CreateObjectAcl, request, __func__);
 }
 
 std::pair<Status, EmptyResponse> RetryClient::DeleteObjectAcl(
     ObjectAclRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::DeleteObjectAcl, request, __func__);
 }
 
 std::pair<Status, ObjectAccessControl> RetryClient::GetObjectAcl(
     ObjectAclRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::GetObjectAcl, request, __func__);
 }
 
 std::pair<Status, ObjectAccessControl> RetryClient::UpdateObjectAcl(
     UpdateObjectAclRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::UpdateObjectAcl, request, __func__);
 }
 
 std::pair<Status, ObjectAccessControl> RetryClient::PatchObjectAcl(
     PatchObjectAclRequest const& request) {
   auto retry_policy = retry_policy_->clone();
-  auto backoff_policy = backoff_policy_->clone();
-  return MakeCall(*retry_policy, *backoff_policy, *client_,
+  return MakeCall(*retry_policy, *backoff_policy_, *client_,
                   &RawClient::PatchObjectAcl, request, __func__);
 }
 
+std::pair<Status, BatchResponse> RetryClient::ExecuteBatch(
+    BatchRequest const& request) {
+  // Retrying the batch would repeat the operations that already completed,
+  // and some of them (e.g. deleting an object) are not idempotent. The
+  // operations succeed or fail independently, the application can retry
+  // them in a new batch.
+  return client_->ExecuteBatch(request);
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
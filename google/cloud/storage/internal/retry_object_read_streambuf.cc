@@ -0,0 +1,191 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/retry_object_read_streambuf.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include "google/cloud/log.h"
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+RetryObjectReadStreambuf::RetryObjectReadStreambuf(
+    std::shared_ptr<RawClient> client, ReadObjectRangeRequest request,
+    std::unique_ptr<ObjectReadStreambuf> child,
+    RetryPolicy const& retry_policy, BackoffPolicy const& backoff_policy)
+    : client_(std::move(client)),
+      request_(std::move(request)),
+      child_(std::move(child)),
+      retry_prototype_(retry_policy.clone()),
+      backoff_prototype_(backoff_policy.clone()),
+      resume_offset_(0),
+      hash_validator_(CreateHashValidator(request_)),
+      hash_validator_result_{{}, {}, false},
+      // TODO(#937) - use client options to configure buffer size.
+      buffer_(128 * 1024),
+      offset_(0),
+      resume_count_(0),
+      first_response_(true),
+      finished_(false),
+      resumable_(true),
+      transcoded_(false) {
+  // Start with an empty read area, to force an underflow() on the first
+  // extraction.
+  setg(buffer_.data(), buffer_.data(), buffer_.data());
+}
+
+ReadObjectRangeRequest RetryObjectReadStreambuf::ChildRequest(
+    ReadObjectRangeRequest const& request, std::int64_t offset) {
+  ReadObjectRangeRequest child = request;
+  child.set_begin(request.begin() + offset);
+  child.set_multiple_options(DisableCrc32cChecksum(true), EnableMD5Hash(false));
+  return child;
+}
+
+HttpResponse RetryObjectReadStreambuf::Close() { return child_->Close(); }
+
+bool RetryObjectReadStreambuf::IsOpen() const { return child_->IsOpen(); }
+
+RetryObjectReadStreambuf::int_type RetryObjectReadStreambuf::underflow() {
+  while (true) {
+    int_type next;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      next = child_->sgetc();
+    } catch (std::exception const& ex) {
+      if (not Resume(ex.what())) {
+        throw;
+      }
+      continue;
+    }
+#else
+    next = child_->sgetc();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    if (first_response_) {
+      ProcessFirstResponse();
+    }
+    if (traits_type::eq_int_type(next, traits_type::eof())) {
+      Finish();
+      setg(buffer_.data(), buffer_.data(), buffer_.data());
+      return traits_type::eof();
+    }
+    // `sgetc()` succeeded, so the child has at least one character in its get
+    // area. Copying only what is available never calls `underflow()` on the
+    // child, so no data is lost if the child fails.
+    auto available = static_cast<std::size_t>(child_->in_avail());
+    auto count = child_->sgetn(buffer_.data(),
+                               (std::min)(available, buffer_.size()));
+    hash_validator_->Update(buffer_.data(), static_cast<std::size_t>(count));
+    offset_ += count;
+    setg(buffer_.data(), buffer_.data(), buffer_.data() + count);
+    return traits_type::to_int_type(buffer_.front());
+  }
+}
+
+void RetryObjectReadStreambuf::ProcessFirstResponse() {
+  first_response_ = false;
+  if (child_->cache_hit()) {
+    // The data is validated before it is stored in the cache, and the cache
+    // has no headers to compare against.
+    hash_validator_.reset(new NullHashValidator);
+    resumable_ = false;
+    return;
+  }
+  auto headers = child_->headers();
+  auto transformations =
+      headers.equal_range("x-guploader-response-body-transformations");
+  for (auto i = transformations.first; i != transformations.second; ++i) {
+    // The service decompressed the data, the offsets do not match the stored
+    // object, and the hashes cannot be validated.
+    if (i->second.find("gunzipped") != std::string::npos) {
+      transcoded_ = true;
+      resumable_ = false;
+    }
+  }
+  if (request_.get_option<Generation>().has_value()) {
+    return;
+  }
+  auto generation = headers.find("x-goog-generation");
+  if (generation != headers.end()) {
+    request_.set_multiple_options(
+        Generation(std::strtoll(generation->second.c_str(), nullptr, 10)));
+  }
+}
+
+bool RetryObjectReadStreambuf::Resume(char const* error) {
+  Status last_status = child_->status();
+  // Only errors reported by the service or the network are retried, other
+  // errors (e.g. invalid data) would just happen again.
+  if (last_status.ok() or not resumable_ or
+      StatusTraits::IsPermanentFailure(last_status)) {
+    return false;
+  }
+  // Without the generation the object could change, only restarting from the
+  // beginning is safe.
+  if (offset_ != 0 and not request_.get_option<Generation>().has_value()) {
+    return false;
+  }
+  if (not retry_policy_ or offset_ != resume_offset_) {
+    retry_policy_ = retry_prototype_->clone();
+    backoff_policy_ = backoff_prototype_->clone();
+    resume_offset_ = offset_;
+  }
+  GCP_LOG(INFO) << __func__ << "() download of " << request_.object_name()
+                << " interrupted at offset " << offset_ << ": " << error;
+  while (true) {
+    if (not retry_policy_->OnFailure(last_status)) {
+      std::ostringstream os;
+      if (retry_policy_->IsExhausted()) {
+        os << "Retry policy exhausted in ReadObject: " << last_status;
+      } else {
+        os << "Permanent error in ReadObject: " << last_status;
+      }
+      google::cloud::internal::RaiseRuntimeError(os.str());
+    }
+    std::this_thread::sleep_for(backoff_policy_->OnCompletion());
+    auto result = client_->ReadObject(ChildRequest(request_, offset_));
+    if (result.first.ok()) {
+      child_ = std::move(result.second);
+      ++resume_count_;
+      return true;
+    }
+    last_status = std::move(result.first);
+  }
+}
+
+void RetryObjectReadStreambuf::Finish() {
+  if (finished_) {
+    return;
+  }
+  finished_ = true;
+  for (auto const& kv : child_->headers()) {
+    hash_validator_->ProcessHeader(kv.first, kv.second);
+  }
+  hash_validator_result_ = hash_validator_->Finish();
+  if (hash_validator_result_.is_mismatch and not transcoded_) {
+    google::cloud::internal::RaiseRuntimeError(
+        FormatHashMismatch(__func__, hash_validator_result_));
+  }
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
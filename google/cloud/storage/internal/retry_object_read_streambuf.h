@@ -0,0 +1,136 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RETRY_OBJECT_READ_STREAMBUF_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RETRY_OBJECT_READ_STREAMBUF_H_
+
+#include "google/cloud/storage/internal/hash_validator.h"
+#include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/retry_policy.h"
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Resume interrupted downloads from the last byte received.
+ *
+ * This class reads the data through a child `ObjectReadStreambuf`, and keeps
+ * track of the number of bytes returned to the application. If the child
+ * fails with a transient error (as defined by @p retry_policy) the download is
+ * restarted with a new `ReadObject()` request, starting at that offset. The
+ * object generation, as reported by the first response, is included in the
+ * new request, so the object cannot change in the middle of the download.
+ *
+ * The policies are cloned each time the download is interrupted, as long as
+ * some data was received since the previous interruption. Long downloads can
+ * outlive any time-based policy, but a download that makes no progress
+ * eventually exhausts the policy.
+ *
+ * The hashes are computed by this class, because only this class sees all the
+ * data. The children are expected to be created with hash validation
+ * disabled. When the download completes the hashes are compared against the
+ * `x-goog-hash` headers of the last child, and a mismatch raises an exception.
+ *
+ * The errors are detected through the exceptions raised by the child, this
+ * class is only useful if exceptions are enabled.
+ */
+class RetryObjectReadStreambuf : public ObjectReadStreambuf {
+ public:
+  RetryObjectReadStreambuf(std::shared_ptr<RawClient> client,
+                           ReadObjectRangeRequest request,
+                           std::unique_ptr<ObjectReadStreambuf> child,
+                           RetryPolicy const& retry_policy,
+                           BackoffPolicy const& backoff_policy);
+
+  /**
+   * Create the request for a child download starting at @p offset.
+   *
+   * The hashes are computed by this class, so they are disabled in the child.
+   */
+  static ReadObjectRangeRequest ChildRequest(
+      ReadObjectRangeRequest const& request, std::int64_t offset);
+
+  ~RetryObjectReadStreambuf() override = default;
+
+  HttpResponse Close() override;
+  bool IsOpen() const override;
+  std::string received_hash() const override {
+    return hash_validator_result_.received;
+  }
+  std::string computed_hash() const override {
+    return hash_validator_result_.computed;
+  }
+  bool cache_hit() const override { return child_->cache_hit(); }
+  Status status() const override { return child_->status(); }
+  std::multimap<std::string, std::string> headers() const override {
+    return child_->headers();
+  }
+
+  /// The number of bytes returned to the application.
+  std::int64_t offset() const { return offset_; }
+
+  /// The number of times the download was resumed.
+  int resume_count() const { return resume_count_; }
+
+ protected:
+  int_type underflow() override;
+
+ private:
+  /// Examine the headers of the first response.
+  void ProcessFirstResponse();
+
+  /**
+   * Restart the download after @p error.
+   *
+   * @return false if the download cannot be resumed, the caller should report
+   *     the original error in this case.
+   * @throw std::runtime_error if the retry policy is exhausted.
+   */
+  bool Resume(char const* error);
+
+  /// Validate the hashes once the download completes.
+  void Finish();
+
+  std::shared_ptr<RawClient> client_;
+  ReadObjectRangeRequest request_;
+  std::unique_ptr<ObjectReadStreambuf> child_;
+  std::unique_ptr<RetryPolicy> retry_prototype_;
+  std::unique_ptr<BackoffPolicy> backoff_prototype_;
+  std::unique_ptr<RetryPolicy> retry_policy_;
+  std::unique_ptr<BackoffPolicy> backoff_policy_;
+  // The value of `offset_` when the download was last resumed.
+  std::int64_t resume_offset_;
+  std::unique_ptr<HashValidator> hash_validator_;
+  HashValidator::Result hash_validator_result_;
+  std::vector<char> buffer_;
+  std::int64_t offset_;
+  int resume_count_;
+  bool first_response_;
+  bool finished_;
+  // Set to false if the download cannot be resumed, for example, when the
+  // service decompresses the data before sending it.
+  bool resumable_;
+  bool transcoded_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RETRY_OBJECT_READ_STREAMBUF_H_
@@ -0,0 +1,220 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/retry_object_read_streambuf.h"
+#include "google/cloud/storage/internal/crc32c.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+using namespace storage::testing::canonical_errors;
+
+using Headers = std::multimap<std::string, std::string>;
+
+/// A streambuf returning some chunks and then failing with @p error.
+class FakeReadStreambuf : public ObjectReadStreambuf {
+ public:
+  FakeReadStreambuf(std::vector<std::string> chunks, Status error,
+                    Headers headers)
+      : chunks_(std::move(chunks)),
+        error_(std::move(error)),
+        headers_(std::move(headers)),
+        next_(0) {}
+
+  HttpResponse Close() override { return HttpResponse{200, {}, {}}; }
+  bool IsOpen() const override { return next_ <= chunks_.size(); }
+  Status status() const override { return status_; }
+  Headers headers() const override { return headers_; }
+
+ protected:
+  int_type underflow() override {
+    if (next_ < chunks_.size()) {
+      current_ = chunks_[next_++];
+      char* data = &current_[0];
+      setg(data, data, data + current_.size());
+      return traits_type::to_int_type(*data);
+    }
+    if (not error_.ok()) {
+      status_ = error_;
+      google::cloud::internal::RaiseRuntimeError("fake download error");
+    }
+    next_ = chunks_.size() + 1;
+    return traits_type::eof();
+  }
+
+ private:
+  std::vector<std::string> chunks_;
+  Status error_;
+  Headers headers_;
+  std::size_t next_;
+  std::string current_;
+  Status status_;
+};
+
+std::unique_ptr<ObjectReadStreambuf> MakeChild(std::vector<std::string> chunks,
+                                               Status error, Headers headers) {
+  return std::unique_ptr<ObjectReadStreambuf>(new FakeReadStreambuf(
+      std::move(chunks), std::move(error), std::move(headers)));
+}
+
+std::string HashHeader(std::string const& contents) {
+  return "crc32c=" + Crc32cToBase64(Crc32cExtend(0, contents));
+}
+
+class RetryObjectReadStreambufTest : public ::testing::Test {
+ protected:
+  void SetUp() override { mock_ = std::make_shared<testing::MockClient>(); }
+
+  std::unique_ptr<RetryObjectReadStreambuf> MakeBuf(
+      ReadObjectRangeRequest const& request,
+      std::unique_ptr<ObjectReadStreambuf> child) {
+    return std::unique_ptr<RetryObjectReadStreambuf>(
+        new RetryObjectReadStreambuf(
+            mock_, request, std::move(child), LimitedErrorCountRetryPolicy(2),
+            ExponentialBackoffPolicy(std::chrono::microseconds(1),
+                                     std::chrono::microseconds(1), 2.0)));
+  }
+
+  static std::string ReadAll(std::streambuf& buf) {
+    return std::string(std::istreambuf_iterator<char>(&buf), {});
+  }
+
+  std::shared_ptr<testing::MockClient> mock_;
+};
+
+/// @test Verify that downloads resume from the last byte received.
+TEST_F(RetryObjectReadStreambufTest, ResumeAfterTransientError) {
+  std::string const contents = "0123456789abcdefghij";
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  auto buf = MakeBuf(request, MakeChild({"01234", "56789"}, TransientError(),
+                                        {{"x-goog-generation", "7"}}));
+
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce(Invoke([&](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(10, r.begin());
+        EXPECT_EQ(0, r.end());
+        EXPECT_EQ(7, r.get_option<Generation>().value());
+        EXPECT_TRUE(r.get_option<DisableCrc32cChecksum>().value());
+        return std::make_pair(
+            Status(), MakeChild({"abcdefghij"}, Status(),
+                                {{"x-goog-hash", HashHeader(contents)}}));
+      }));
+
+  EXPECT_EQ(contents, ReadAll(*buf));
+  EXPECT_EQ(20, buf->offset());
+  EXPECT_EQ(1, buf->resume_count());
+  EXPECT_EQ(HashHeader(contents), buf->received_hash());
+  EXPECT_EQ(HashHeader(contents), buf->computed_hash());
+}
+
+/// @test Verify that the hashes are validated across resumed downloads.
+TEST_F(RetryObjectReadStreambufTest, HashMismatchAfterResume) {
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  auto buf = MakeBuf(request, MakeChild({"01234"}, TransientError(),
+                                        {{"x-goog-generation", "7"}}));
+
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce(Invoke([&](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(5, r.begin());
+        return std::make_pair(
+            Status(), MakeChild({"XXXXX"}, Status(),
+                                {{"x-goog-hash", HashHeader("0123456789")}}));
+      }));
+
+  EXPECT_THROW(try { ReadAll(*buf); } catch (std::runtime_error const& ex) {
+    EXPECT_THAT(ex.what(), HasSubstr("Mismatched hashes"));
+    throw;
+  },
+               std::runtime_error);
+}
+
+/// @test Verify that permanent errors are not retried.
+TEST_F(RetryObjectReadStreambufTest, PermanentError) {
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  auto buf = MakeBuf(request, MakeChild({"01234"}, PermanentError(),
+                                        {{"x-goog-generation", "7"}}));
+
+  EXPECT_CALL(*mock_, ReadObject(_)).Times(0);
+  EXPECT_THROW(try { ReadAll(*buf); } catch (std::runtime_error const& ex) {
+    EXPECT_THAT(ex.what(), HasSubstr("fake download error"));
+    throw;
+  },
+               std::runtime_error);
+}
+
+/// @test Verify that downloads making no progress exhaust the retry policy.
+TEST_F(RetryObjectReadStreambufTest, TooManyFailures) {
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  auto buf = MakeBuf(request, MakeChild({"01234"}, TransientError(),
+                                        {{"x-goog-generation", "7"}}));
+
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(5, r.begin());
+        return std::make_pair(Status(), MakeChild({}, TransientError(), {}));
+      }));
+
+  EXPECT_THROW(try { ReadAll(*buf); } catch (std::runtime_error const& ex) {
+    EXPECT_THAT(ex.what(), HasSubstr("Retry policy exhausted"));
+    throw;
+  },
+               std::runtime_error);
+}
+
+/// @test Verify that downloads are not resumed without a generation.
+TEST_F(RetryObjectReadStreambufTest, NoGeneration) {
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  auto buf = MakeBuf(request, MakeChild({"01234"}, TransientError(), {}));
+
+  EXPECT_CALL(*mock_, ReadObject(_)).Times(0);
+  EXPECT_THROW(ReadAll(*buf), std::runtime_error);
+}
+
+/// @test Verify that range downloads resume within the range.
+TEST_F(RetryObjectReadStreambufTest, ResumeRange) {
+  ReadObjectRangeRequest request("test-bucket", "test-object", 100, 120);
+  request.set_multiple_options(Generation(3));
+  auto buf = MakeBuf(request, MakeChild({"01234"}, TransientError(), {}));
+
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillOnce(Invoke([&](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(105, r.begin());
+        EXPECT_EQ(120, r.end());
+        EXPECT_EQ(3, r.get_option<Generation>().value());
+        return std::make_pair(Status(),
+                              MakeChild({"56789abcdefghij"}, Status(), {}));
+      }));
+
+  EXPECT_EQ("0123456789abcdefghij", ReadAll(*buf));
+  EXPECT_EQ(1, buf->resume_count());
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,71 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/rewrite_object_requests.h"
+#include "google/cloud/storage/internal/metadata_parser.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include <iostream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+std::ostream& operator<<(std::ostream& os, CopyObjectRequest const& r) {
+  os << "CopyObjectRequest={source_bucket=" << r.source_bucket()
+     << ", source_object=" << r.source_object()
+     << ", destination_bucket=" << r.destination_bucket()
+     << ", destination_object=" << r.destination_object();
+  r.DumpOptions(os, ", ");
+  return os << "}";
+}
+
+std::ostream& operator<<(std::ostream& os, RewriteObjectRequest const& r) {
+  os << "RewriteObjectRequest={source_bucket=" << r.source_bucket()
+     << ", source_object=" << r.source_object()
+     << ", destination_bucket=" << r.destination_bucket()
+     << ", destination_object=" << r.destination_object()
+     << ", rewrite_token=" << r.rewrite_token();
+  r.DumpOptions(os, ", ");
+  return os << "}";
+}
+
+RewriteObjectResponse RewriteObjectResponse::FromHttpResponse(
+    HttpResponse&& response) {
+  auto json = nl::json::parse(response.payload);
+  RewriteObjectResponse result;
+  result.total_bytes_rewritten =
+      ParseUnsignedLongField(json, "totalBytesRewritten");
+  result.object_size = ParseUnsignedLongField(json, "objectSize");
+  result.done = ParseBoolField(json, "done");
+  result.rewrite_token = json.value("rewriteToken", "");
+  if (json.count("resource") != 0) {
+    result.resource = ObjectMetadata::ParseFromJson(json["resource"]);
+  }
+  return result;
+}
+
+std::ostream& operator<<(std::ostream& os, RewriteObjectResponse const& r) {
+  return os << "RewriteObjectResponse={total_bytes_rewritten="
+            << r.total_bytes_rewritten << ", object_size=" << r.object_size
+            << ", done=" << std::boolalpha << r.done
+            << ", rewrite_token=" << r.rewrite_token
+            << ", resource=" << r.resource << "}";
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,144 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_REWRITE_OBJECT_REQUESTS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_REWRITE_OBJECT_REQUESTS_H_
+
+#include "google/cloud/storage/internal/generic_request.h"
+#include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/object_metadata.h"
+#include "google/cloud/storage/well_known_parameters.h"
+#include <iosfwd>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/// Common attributes for requests that copy one object into another.
+template <typename Derived, typename... Parameters>
+class GenericCopyRequest : public GenericRequest<Derived, Parameters...> {
+ public:
+  GenericCopyRequest() = default;
+
+  explicit GenericCopyRequest(std::string source_bucket,
+                              std::string source_object,
+                              std::string destination_bucket,
+                              std::string destination_object)
+      : source_bucket_(std::move(source_bucket)),
+        source_object_(std::move(source_object)),
+        destination_bucket_(std::move(destination_bucket)),
+        destination_object_(std::move(destination_object)) {}
+
+  std::string const& source_bucket() const { return source_bucket_; }
+  Derived& set_source_bucket(std::string v) {
+    source_bucket_ = std::move(v);
+    return *static_cast<Derived*>(this);
+  }
+
+  std::string const& source_object() const { return source_object_; }
+  Derived& set_source_object(std::string v) {
+    source_object_ = std::move(v);
+    return *static_cast<Derived*>(this);
+  }
+
+  std::string const& destination_bucket() const { return destination_bucket_; }
+  Derived& set_destination_bucket(std::string v) {
+    destination_bucket_ = std::move(v);
+    return *static_cast<Derived*>(this);
+  }
+
+  std::string const& destination_object() const { return destination_object_; }
+  Derived& set_destination_object(std::string v) {
+    destination_object_ = std::move(v);
+    return *static_cast<Derived*>(this);
+  }
+
+ private:
+  std::string source_bucket_;
+  std::string source_object_;
+  std::string destination_bucket_;
+  std::string destination_object_;
+};
+
+/**
+ * Copy an object with a single request.
+ *
+ * The service rejects this request if the copy cannot complete quickly, e.g.
+ * for large objects copied across locations or storage classes, use
+ * `RewriteObjectRequest` for those.
+ */
+class CopyObjectRequest
+    : public GenericCopyRequest<
+          CopyObjectRequest, DestinationKmsKeyName, DestinationPredefinedAcl,
+          IfGenerationMatch, IfGenerationNotMatch, IfMetaGenerationMatch,
+          IfMetaGenerationNotMatch, IfSourceGenerationMatch,
+          IfSourceGenerationNotMatch, IfSourceMetaGenerationMatch,
+          IfSourceMetaGenerationNotMatch, Projection, SourceGeneration,
+          UserProject> {
+ public:
+  using GenericCopyRequest::GenericCopyRequest;
+};
+
+std::ostream& operator<<(std::ostream& os, CopyObjectRequest const& r);
+
+/**
+ * Make one step of a (possibly) multi-request object rewrite.
+ *
+ * The first request has an empty `rewrite_token()`, the following requests
+ * use the token returned by the previous response.
+ */
+class RewriteObjectRequest
+    : public GenericCopyRequest<
+          RewriteObjectRequest, DestinationKmsKeyName, DestinationPredefinedAcl,
+          IfGenerationMatch, IfGenerationNotMatch, IfMetaGenerationMatch,
+          IfMetaGenerationNotMatch, IfSourceGenerationMatch,
+          IfSourceGenerationNotMatch, IfSourceMetaGenerationMatch,
+          IfSourceMetaGenerationNotMatch, MaxBytesRewrittenPerCall, Projection,
+          SourceGeneration, UserProject> {
+ public:
+  using GenericCopyRequest::GenericCopyRequest;
+
+  std::string const& rewrite_token() const { return rewrite_token_; }
+  RewriteObjectRequest& set_rewrite_token(std::string v) {
+    rewrite_token_ = std::move(v);
+    return *this;
+  }
+
+ private:
+  std::string rewrite_token_;
+};
+
+std::ostream& operator<<(std::ostream& os, RewriteObjectRequest const& r);
+
+/// The response to a `RewriteObjectRequest`.
+struct RewriteObjectResponse {
+  static RewriteObjectResponse FromHttpResponse(HttpResponse&& response);
+
+  std::uint64_t total_bytes_rewritten;
+  std::uint64_t object_size;
+  bool done;
+  std::string rewrite_token;
+  /// The metadata of the destination object, only valid if `done` is true.
+  ObjectMetadata resource;
+};
+
+std::ostream& operator<<(std::ostream& os, RewriteObjectResponse const& r);
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_REWRITE_OBJECT_REQUESTS_H_
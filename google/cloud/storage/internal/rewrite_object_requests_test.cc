@@ -0,0 +1,108 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/rewrite_object_requests.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::testing::HasSubstr;
+
+TEST(RewriteObjectRequestsTest, CopyOStream) {
+  CopyObjectRequest request("src-bucket", "src-object", "dst-bucket",
+                            "dst-object");
+  request.set_multiple_options(IfSourceGenerationMatch(7),
+                               DestinationPredefinedAcl("private"));
+  std::ostringstream os;
+  os << request;
+  EXPECT_THAT(os.str(), HasSubstr("source_bucket=src-bucket"));
+  EXPECT_THAT(os.str(), HasSubstr("source_object=src-object"));
+  EXPECT_THAT(os.str(), HasSubstr("destination_bucket=dst-bucket"));
+  EXPECT_THAT(os.str(), HasSubstr("destination_object=dst-object"));
+  EXPECT_THAT(os.str(), HasSubstr("ifSourceGenerationMatch=7"));
+  EXPECT_THAT(os.str(), HasSubstr("destinationPredefinedAcl=private"));
+}
+
+TEST(RewriteObjectRequestsTest, RewriteOStream) {
+  RewriteObjectRequest request("src-bucket", "src-object", "dst-bucket",
+                               "dst-object");
+  request.set_rewrite_token("abcd-token");
+  request.set_multiple_options(MaxBytesRewrittenPerCall(1048576),
+                               SourceGeneration(3));
+  std::ostringstream os;
+  os << request;
+  EXPECT_THAT(os.str(), HasSubstr("source_bucket=src-bucket"));
+  EXPECT_THAT(os.str(), HasSubstr("destination_object=dst-object"));
+  EXPECT_THAT(os.str(), HasSubstr("rewrite_token=abcd-token"));
+  EXPECT_THAT(os.str(), HasSubstr("maxBytesRewrittenPerCall=1048576"));
+  EXPECT_THAT(os.str(), HasSubstr("sourceGeneration=3"));
+}
+
+TEST(RewriteObjectRequestsTest, ParseInProgress) {
+  std::string text = R"""({
+      "kind": "storage#rewriteResponse",
+      "totalBytesRewritten": "1048576",
+      "objectSize": "10485760",
+      "done": false,
+      "rewriteToken": "abcd-token"
+  })""";
+  auto actual =
+      RewriteObjectResponse::FromHttpResponse(HttpResponse{200, text, {}});
+  EXPECT_EQ(1048576U, actual.total_bytes_rewritten);
+  EXPECT_EQ(10485760U, actual.object_size);
+  EXPECT_FALSE(actual.done);
+  EXPECT_EQ("abcd-token", actual.rewrite_token);
+
+  std::ostringstream os;
+  os << actual;
+  EXPECT_THAT(os.str(), HasSubstr("total_bytes_rewritten=1048576"));
+  EXPECT_THAT(os.str(), HasSubstr("done=false"));
+  EXPECT_THAT(os.str(), HasSubstr("rewrite_token=abcd-token"));
+}
+
+TEST(RewriteObjectRequestsTest, ParseDone) {
+  std::string text = R"""({
+      "kind": "storage#rewriteResponse",
+      "totalBytesRewritten": 1024,
+      "objectSize": 1024,
+      "done": true,
+      "resource": {
+        "bucket": "dst-bucket",
+        "name": "dst-object",
+        "generation": "42",
+        "size": "1024"
+      }
+  })""";
+  auto actual =
+      RewriteObjectResponse::FromHttpResponse(HttpResponse{200, text, {}});
+  EXPECT_EQ(1024U, actual.total_bytes_rewritten);
+  EXPECT_EQ(1024U, actual.object_size);
+  EXPECT_TRUE(actual.done);
+  EXPECT_EQ("", actual.rewrite_token);
+  EXPECT_EQ("dst-bucket", actual.resource.bucket());
+  EXPECT_EQ("dst-object", actual.resource.name());
+  EXPECT_EQ(42, actual.resource.generation());
+  EXPECT_EQ(1024U, actual.resource.size());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,230 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/seekable_object_read_streambuf.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <algorithm>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+SeekableObjectReadStreambuf::SeekableObjectReadStreambuf(
+    std::shared_ptr<RawClient> client, ReadObjectRangeRequest request,
+    std::int64_t object_size, RandomAccessOptions const& options)
+    : client_(std::move(client)),
+      request_(std::move(request)),
+      object_size_(object_size),
+      options_(options),
+      buffer_(options.buffer_size()),
+      window_begin_(0),
+      download_offset_(0),
+      download_end_(0),
+      random_access_(false),
+      sequential_reads_(0),
+      request_count_(0),
+      closed_(false) {
+  // Each download covers an arbitrary range, the hashes cannot be validated.
+  request_.set_multiple_options(DisableCrc32cChecksum(true),
+                                EnableMD5Hash(false));
+  // Start with an empty read area, to force an underflow() on the first
+  // extraction.
+  setg(buffer_.data(), buffer_.data(), buffer_.data());
+}
+
+std::unique_ptr<ObjectReadStreambuf> SeekableObjectReadStreambuf::Create(
+    std::shared_ptr<RawClient> client, ReadObjectRangeRequest request,
+    RandomAccessOptions const& options) {
+  GetObjectMetadataRequest metadata_request(request.bucket_name(),
+                                            request.object_name());
+  metadata_request.set_multiple_options(
+      Generation(request.get_option<Generation>()),
+      IfGenerationMatch(request.get_option<IfGenerationMatch>()),
+      IfGenerationNotMatch(request.get_option<IfGenerationNotMatch>()),
+      IfMetaGenerationMatch(request.get_option<IfMetaGenerationMatch>()),
+      IfMetaGenerationNotMatch(request.get_option<IfMetaGenerationNotMatch>()),
+      UserProject(request.get_option<UserProject>()));
+  auto metadata = client->GetObjectMetadata(metadata_request);
+  if (not metadata.first.ok()) {
+    std::ostringstream os;
+    os << "Error in ReadObjectRandomAccess(): " << metadata.first;
+    google::cloud::internal::RaiseRuntimeError(os.str());
+  }
+  request.set_multiple_options(Generation(metadata.second.generation()));
+  return std::unique_ptr<ObjectReadStreambuf>(new SeekableObjectReadStreambuf(
+      std::move(client), std::move(request),
+      static_cast<std::int64_t>(metadata.second.size()), options));
+}
+
+HttpResponse SeekableObjectReadStreambuf::Close() {
+  CloseDownload();
+  closed_ = true;
+  return HttpResponse{200, {}, {}};
+}
+
+Status SeekableObjectReadStreambuf::status() const {
+  if (not download_) {
+    return Status();
+  }
+  return download_->status();
+}
+
+std::multimap<std::string, std::string> SeekableObjectReadStreambuf::headers()
+    const {
+  if (not download_) {
+    return {};
+  }
+  return download_->headers();
+}
+
+SeekableObjectReadStreambuf::int_type SeekableObjectReadStreambuf::underflow() {
+  auto pos = position();
+  if (closed_ or pos >= object_size_) {
+    window_begin_ = pos;
+    setg(buffer_.data(), buffer_.data(), buffer_.data());
+    return traits_type::eof();
+  }
+  bool reuse_download = download_ and pos >= download_offset_ and
+                        pos < download_end_ and
+                        pos - download_offset_ <= options_.max_skip();
+  if (reuse_download) {
+    Skip(pos - download_offset_);
+    if (download_offset_ != pos) {
+      // The download ended before the expected size of the object.
+      window_begin_ = pos;
+      setg(buffer_.data(), buffer_.data(), buffer_.data());
+      return traits_type::eof();
+    }
+  } else {
+    StartDownload(pos);
+  }
+  auto size = (std::min)(static_cast<std::int64_t>(buffer_.size()),
+                         download_end_ - download_offset_);
+  std::int64_t count = 0;
+  while (count < size) {
+    auto n = download_->sgetn(buffer_.data() + count, size - count);
+    if (n <= 0) {
+      break;
+    }
+    count += n;
+  }
+  download_offset_ += count;
+  window_begin_ = pos;
+  setg(buffer_.data(), buffer_.data(), buffer_.data() + count);
+  if (count == 0) {
+    return traits_type::eof();
+  }
+  return traits_type::to_int_type(buffer_.front());
+}
+
+SeekableObjectReadStreambuf::pos_type SeekableObjectReadStreambuf::seekoff(
+    off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) {
+  std::int64_t target;
+  switch (dir) {
+    case std::ios_base::beg:
+      target = off;
+      break;
+    case std::ios_base::cur:
+      target = position() + off;
+      break;
+    case std::ios_base::end:
+      target = object_size_ + off;
+      break;
+    default:
+      return pos_type(off_type(-1));
+  }
+  return seekpos(pos_type(target), which);
+}
+
+SeekableObjectReadStreambuf::pos_type SeekableObjectReadStreambuf::seekpos(
+    pos_type pos, std::ios_base::openmode which) {
+  std::int64_t target = off_type(pos);
+  if ((which & std::ios_base::in) == 0 or target < 0 or
+      target > object_size_) {
+    return pos_type(off_type(-1));
+  }
+  auto window_end = window_begin_ + (egptr() - eback());
+  if (target >= window_begin_ and target <= window_end) {
+    setg(eback(), eback() + (target - window_begin_), egptr());
+    return pos;
+  }
+  // The next underflow() decides how to read the data at the new position.
+  window_begin_ = target;
+  setg(buffer_.data(), buffer_.data(), buffer_.data());
+  return pos;
+}
+
+void SeekableObjectReadStreambuf::StartDownload(std::int64_t offset) {
+  if (offset == download_offset_) {
+    // The application kept reading where the last download stopped, after
+    // enough of these a single download for the rest of the object is more
+    // efficient.
+    if (random_access_ and
+        ++sequential_reads_ >= options_.sequential_threshold()) {
+      random_access_ = false;
+    }
+  } else if (offset < download_offset_ or
+             offset - download_offset_ > options_.max_skip()) {
+    random_access_ = true;
+    sequential_reads_ = 0;
+  }
+  CloseDownload();
+
+  ReadObjectRangeRequest request = request_;
+  request.set_begin(offset);
+  if (random_access_) {
+    download_end_ = (std::min)(
+        object_size_, offset + static_cast<std::int64_t>(buffer_.size()));
+    request.set_end(download_end_);
+  } else {
+    download_end_ = object_size_;
+    request.set_end(0);
+  }
+  ++request_count_;
+  auto result = client_->ReadObject(request);
+  if (not result.first.ok()) {
+    std::ostringstream os;
+    os << "Error in ReadObjectRandomAccess(): " << result.first;
+    google::cloud::internal::RaiseRuntimeError(os.str());
+  }
+  download_ = std::move(result.second);
+  download_offset_ = offset;
+}
+
+void SeekableObjectReadStreambuf::CloseDownload() {
+  if (download_ and download_->IsOpen()) {
+    download_->Close();
+  }
+}
+
+void SeekableObjectReadStreambuf::Skip(std::int64_t count) {
+  while (count > 0) {
+    auto n = download_->sgetn(
+        buffer_.data(),
+        (std::min)(count, static_cast<std::int64_t>(buffer_.size())));
+    if (n <= 0) {
+      return;
+    }
+    download_offset_ += n;
+    count -= n;
+  }
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
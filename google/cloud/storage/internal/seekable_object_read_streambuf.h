@@ -0,0 +1,124 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_SEEKABLE_OBJECT_READ_STREAMBUF_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_SEEKABLE_OBJECT_READ_STREAMBUF_H_
+
+#include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/random_access_options.h"
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A seekable `ObjectReadStreambuf`.
+ *
+ * The data is read into a window of `RandomAccessOptions::buffer_size()`
+ * bytes, seeks within the window are served without any requests. Short
+ * forward seeks read and discard the data from the current download, longer
+ * seeks close the download and start a new one at the new position.
+ *
+ * The class starts in sequential mode: each download requests the rest of the
+ * object. A backward seek, or a forward seek longer than
+ * `RandomAccessOptions::max_skip()`, switches to random access mode, where
+ * each download is bounded by the window size, so seeking away does not waste
+ * a large transfer. If the application reads several windows in order the
+ * class switches back to sequential mode.
+ *
+ * All the downloads use the same generation, so the object cannot change
+ * while it is read. The hashes are not validated, the ranges read by the
+ * application rarely cover the whole object.
+ */
+class SeekableObjectReadStreambuf : public ObjectReadStreambuf {
+ public:
+  SeekableObjectReadStreambuf(std::shared_ptr<RawClient> client,
+                              ReadObjectRangeRequest request,
+                              std::int64_t object_size,
+                              RandomAccessOptions const& options);
+
+  /**
+   * Fetch the object metadata and create a new instance.
+   *
+   * The metadata provides the object size, needed to seek relative to the end
+   * of the object, and the generation used in all the downloads.
+   *
+   * @throw std::runtime_error if the metadata request fails.
+   */
+  static std::unique_ptr<ObjectReadStreambuf> Create(
+      std::shared_ptr<RawClient> client, ReadObjectRangeRequest request,
+      RandomAccessOptions const& options);
+
+  ~SeekableObjectReadStreambuf() override = default;
+
+  HttpResponse Close() override;
+  bool IsOpen() const override { return not closed_; }
+  Status status() const override;
+  std::multimap<std::string, std::string> headers() const override;
+
+  std::int64_t object_size() const { return object_size_; }
+
+  /// Return true if the downloads are bounded by the window size.
+  bool random_access() const { return random_access_; }
+
+  /// The number of downloads started.
+  int request_count() const { return request_count_; }
+
+ protected:
+  int_type underflow() override;
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                   std::ios_base::openmode which) override;
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+ private:
+  /// The offset in the object of the next character.
+  std::int64_t position() const { return window_begin_ + (gptr() - eback()); }
+
+  /// Start a new download at @p offset, updating the access mode.
+  void StartDownload(std::int64_t offset);
+
+  /// Close the current download, if any.
+  void CloseDownload();
+
+  /// Read and discard @p count bytes from the current download.
+  void Skip(std::int64_t count);
+
+  std::shared_ptr<RawClient> client_;
+  ReadObjectRangeRequest request_;
+  std::int64_t object_size_;
+  RandomAccessOptions options_;
+  std::vector<char> buffer_;
+  // The offset in the object of `eback()`.
+  std::int64_t window_begin_;
+  std::unique_ptr<ObjectReadStreambuf> download_;
+  // The offset of the next byte in the current download, when there is no
+  // download this is where the last one stopped.
+  std::int64_t download_offset_;
+  // The end of the range requested by the current download.
+  std::int64_t download_end_;
+  bool random_access_;
+  int sequential_reads_;
+  int request_count_;
+  bool closed_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_SEEKABLE_OBJECT_READ_STREAMBUF_H_
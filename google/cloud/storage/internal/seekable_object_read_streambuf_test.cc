@@ -0,0 +1,211 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/seekable_object_read_streambuf.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/storage/testing/string_read_streambuf.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Invoke;
+
+using storage::testing::OBJECT_CONTENTS;
+using storage::testing::StringReadStreambuf;
+
+class SeekableObjectReadStreambufTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mock_ = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*mock_, ReadObject(_))
+        .WillRepeatedly(Invoke([this](ReadObjectRangeRequest const& r) {
+          EXPECT_EQ(7, r.get_option<Generation>().value());
+          requests_.emplace_back(r.begin(), r.end());
+          auto begin = static_cast<std::size_t>(r.begin());
+          auto end = r.end() == 0 ? OBJECT_CONTENTS.size()
+                                  : static_cast<std::size_t>(r.end());
+          return std::make_pair(
+              Status(),
+              std::unique_ptr<ObjectReadStreambuf>(new StringReadStreambuf(
+                  OBJECT_CONTENTS.substr(begin, end - begin))));
+        }));
+  }
+
+  std::unique_ptr<SeekableObjectReadStreambuf> MakeBuf(
+      RandomAccessOptions const& options) {
+    ReadObjectRangeRequest request("test-bucket", "test-object");
+    request.set_multiple_options(Generation(7));
+    return std::unique_ptr<SeekableObjectReadStreambuf>(
+        new SeekableObjectReadStreambuf(
+            mock_, std::move(request),
+            static_cast<std::int64_t>(OBJECT_CONTENTS.size()), options));
+  }
+
+  static std::string Read(std::istream& stream, std::size_t count) {
+    std::string result(count, '\0');
+    stream.read(&result[0], count);
+    result.resize(static_cast<std::size_t>(stream.gcount()));
+    return result;
+  }
+
+  std::shared_ptr<testing::MockClient> mock_;
+  std::vector<std::pair<std::int64_t, std::int64_t>> requests_;
+};
+
+using Range = std::pair<std::int64_t, std::int64_t>;
+
+/// @test Verify that sequential reads use a single download.
+TEST_F(SeekableObjectReadStreambufTest, Sequential) {
+  auto buf = MakeBuf(RandomAccessOptions().set_buffer_size(8));
+  std::istream stream(buf.get());
+  EXPECT_EQ(OBJECT_CONTENTS, Read(stream, 100));
+  EXPECT_THAT(requests_, ElementsAre(Range(0, 0)));
+  EXPECT_FALSE(buf->random_access());
+}
+
+/// @test Verify that seeks within the window do not make new requests.
+TEST_F(SeekableObjectReadStreambufTest, SeekWithinWindow) {
+  auto buf = MakeBuf(RandomAccessOptions().set_buffer_size(8));
+  std::istream stream(buf.get());
+  EXPECT_EQ("0123", Read(stream, 4));
+  EXPECT_EQ(4, stream.tellg());
+  stream.seekg(1);
+  EXPECT_EQ("123", Read(stream, 3));
+  stream.seekg(2, std::ios_base::cur);
+  EXPECT_EQ(6, stream.tellg());
+  EXPECT_EQ("67", Read(stream, 2));
+  EXPECT_EQ(1, buf->request_count());
+}
+
+/// @test Verify that short forward seeks reuse the download.
+TEST_F(SeekableObjectReadStreambufTest, ShortForwardSeek) {
+  auto buf =
+      MakeBuf(RandomAccessOptions().set_buffer_size(4).set_max_skip(8));
+  std::istream stream(buf.get());
+  EXPECT_EQ("0123", Read(stream, 4));
+  stream.seekg(10);
+  EXPECT_EQ("abcd", Read(stream, 4));
+  EXPECT_THAT(requests_, ElementsAre(Range(0, 0)));
+  EXPECT_FALSE(buf->random_access());
+}
+
+/// @test Verify that seeks relative to the end use bounded requests.
+TEST_F(SeekableObjectReadStreambufTest, SeekFromEnd) {
+  auto buf = MakeBuf(RandomAccessOptions().set_buffer_size(4).set_max_skip(0));
+  std::istream stream(buf.get());
+  stream.seekg(-6, std::ios_base::end);
+  EXPECT_EQ(30, stream.tellg());
+  EXPECT_EQ("uvwx", Read(stream, 4));
+  EXPECT_TRUE(buf->random_access());
+  EXPECT_THAT(requests_, ElementsAre(Range(30, 34)));
+}
+
+/// @test Verify the switch between random and sequential access.
+TEST_F(SeekableObjectReadStreambufTest, AdaptiveMode) {
+  auto buf = MakeBuf(RandomAccessOptions()
+                         .set_buffer_size(4)
+                         .set_max_skip(2)
+                         .set_sequential_threshold(2));
+  std::istream stream(buf.get());
+  EXPECT_EQ("0123", Read(stream, 4));
+  // A long forward seek switches to random access.
+  stream.seekg(20);
+  EXPECT_EQ("klmn", Read(stream, 4));
+  EXPECT_TRUE(buf->random_access());
+  // A backward seek, outside the window.
+  stream.seekg(8);
+  EXPECT_EQ("89ab", Read(stream, 4));
+  // Two contiguous reads switch back to sequential access.
+  EXPECT_EQ("cdefghij", Read(stream, 8));
+  EXPECT_FALSE(buf->random_access());
+  EXPECT_EQ("klmnopqrstuvwxyz", Read(stream, 100));
+  EXPECT_THAT(requests_, ElementsAre(Range(0, 0), Range(20, 24), Range(8, 12),
+                                     Range(12, 16), Range(16, 0)));
+}
+
+/// @test Verify that invalid seeks fail.
+TEST_F(SeekableObjectReadStreambufTest, InvalidSeek) {
+  auto buf = MakeBuf(RandomAccessOptions());
+  EXPECT_EQ(-1, buf->pubseekoff(-1, std::ios_base::beg));
+  EXPECT_EQ(-1, buf->pubseekoff(1, std::ios_base::end));
+  EXPECT_EQ(-1, buf->pubseekpos(0, std::ios_base::out));
+  EXPECT_EQ(36, buf->pubseekoff(0, std::ios_base::end));
+  EXPECT_EQ(0, buf->request_count());
+}
+
+/// @test Verify that Create() uses the generation from the metadata.
+TEST_F(SeekableObjectReadStreambufTest, Create) {
+  EXPECT_CALL(*mock_, GetObjectMetadata(_))
+      .WillOnce(Invoke([](GetObjectMetadataRequest const& r) {
+        EXPECT_EQ("test-object", r.object_name());
+        EXPECT_EQ("my-project", r.get_option<UserProject>().value());
+        return std::make_pair(
+            Status(),
+            ObjectMetadata::ParseFromJson(nl::json{
+                {"name", "test-object"},
+                {"size", std::to_string(OBJECT_CONTENTS.size())},
+                {"generation", "7"}}));
+      }));
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_multiple_options(UserProject("my-project"));
+  auto buf = SeekableObjectReadStreambuf::Create(mock_, std::move(request),
+                                                 RandomAccessOptions());
+  std::istream stream(buf.get());
+  stream.seekg(-3, std::ios_base::end);
+  EXPECT_EQ("xyz", Read(stream, 10));
+}
+
+/// @test Verify that metadata errors are reported.
+TEST_F(SeekableObjectReadStreambufTest, CreateFailure) {
+  EXPECT_CALL(*mock_, GetObjectMetadata(_))
+      .WillOnce(Invoke([](GetObjectMetadataRequest const&) {
+        return std::make_pair(testing::canonical_errors::PermanentError(),
+                              ObjectMetadata{});
+      }));
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(SeekableObjectReadStreambuf::Create(mock_, std::move(request),
+                                                   RandomAccessOptions()),
+               std::runtime_error);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(
+      SeekableObjectReadStreambuf::Create(mock_, std::move(request),
+                                          RandomAccessOptions()),
+      "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+TEST(RandomAccessOptionsTest, InvalidBufferSize) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(RandomAccessOptions().set_buffer_size(0),
+               std::invalid_argument);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(RandomAccessOptions().set_buffer_size(0),
+                            "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
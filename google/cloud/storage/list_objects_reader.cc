@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/list_objects_reader.h"
+#include "google/cloud/internal/throw_delegate.h"
 
 namespace google {
 namespace cloud {
@@ -64,6 +65,22 @@ ListObjectsIterator& ListObjectsIterator::operator++() {
   return *this;
 }
 
+ListObjectsReader& ListObjectsReader::EnablePrefetch(std::size_t max_pages) {
+  if (max_pages == 0) {
+    google::cloud::internal::RaiseInvalidArgument(
+        "ListObjectsReader::EnablePrefetch() - max_pages must be > 0");
+  }
+  if (prefetcher_ or on_last_page_) {
+    return *this;
+  }
+  // Continue from the next page, which is the first page if the iteration has
+  // not started.
+  request_.set_page_token(next_page_token_);
+  prefetcher_.reset(
+      new internal::ListObjectsPrefetcher(client_, request_, max_pages));
+  return *this;
+}
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 ListObjectsReader::iterator ListObjectsReader::begin() {
   return iterator(this, GetNext());
@@ -74,8 +91,7 @@ google::cloud::internal::optional<ObjectMetadata> ListObjectsReader::GetNext() {
     if (on_last_page_) {
       return google::cloud::internal::optional<ObjectMetadata>();
     }
-    request_.set_page_token(std::move(next_page_token_));
-    auto response = client_->ListObjects(request_);
+    auto response = FetchNextPage();
     // TODO(#759) - once the refactoring dust settles, the client either raises
     // if there was an error, or we get here with a success status, so there
     // is no need to check response.first.ok().
@@ -93,6 +109,15 @@ google::cloud::internal::optional<ObjectMetadata> ListObjectsReader::GetNext() {
       std::move(*current_++));
 }
 
+std::pair<Status, internal::ListObjectsResponse>
+ListObjectsReader::FetchNextPage() {
+  if (prefetcher_) {
+    return prefetcher_->Next();
+  }
+  request_.set_page_token(std::move(next_page_token_));
+  return client_->ListObjects(request_);
+}
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECTS_READER_H_
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_LIST_OBJECTS_READER_H_
 
+#include "google/cloud/storage/internal/list_objects_prefetcher.h"
 #include "google/cloud/storage/internal/list_objects_request.h"
 #include "google/cloud/storage/internal/raw_client.h"
 #include <iterator>
@@ -88,6 +89,26 @@ class ListObjectsReader {
   /// The iterator type for this stream.
   using iterator = ListObjectsIterator;
 
+  /**
+   * Fetch the next pages in a background thread while the caller iterates.
+   *
+   * By default the reader only requests the next page when the iterator
+   * reaches the end of the current page, so the application stalls for a full
+   * round-trip every page. With prefetching enabled the next page is requested
+   * as soon as the previous one arrives, and up to @p max_pages pages are
+   * buffered. Use this when the application processes each object for a
+   * while, and the memory for the additional pages is acceptable.
+   *
+   * The iterators are not affected, but the `RawClient` is called from a
+   * different thread, and the destructor of this object blocks until any
+   * pending request completes.
+   *
+   * @param max_pages the maximum number of pages received but not yet
+   *     consumed by the iteration, must be greater than zero.
+   * @throw std::invalid_argument if @p max_pages is zero.
+   */
+  ListObjectsReader& EnablePrefetch(std::size_t max_pages = 1);
+
   /**
    * Return an iterator over the list of objects.
    *
@@ -117,12 +138,16 @@ class ListObjectsReader {
   google::cloud::internal::optional<ObjectMetadata> GetNext();
 
  private:
+  /// Fetch the next page, directly or from the prefetcher.
+  std::pair<Status, internal::ListObjectsResponse> FetchNextPage();
+
   std::shared_ptr<internal::RawClient> client_;
   internal::ListObjectsRequest request_;
   std::vector<ObjectMetadata> current_objects_;
   std::vector<ObjectMetadata>::iterator current_;
   std::string next_page_token_;
   bool on_last_page_;
+  std::unique_ptr<internal::ListObjectsPrefetcher> prefetcher_;
 };
 
 }  // namespace STORAGE_CLIENT_NS
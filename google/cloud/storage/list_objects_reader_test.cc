@@ -13,10 +13,12 @@
 // limitations under the License.
 
 #include "google/cloud/storage/list_objects_reader.h"
+#include "google/cloud/internal/throw_delegate.h"
 #include "google/cloud/storage/internal/nljson.h"
 #include "google/cloud/storage/testing/canonical_errors.h"
 #include "google/cloud/storage/testing/mock_client.h"
 #include <gmock/gmock.h>
+#include <future>
 
 namespace google {
 namespace cloud {
@@ -81,6 +83,124 @@ TEST(ListObjectsReaderTest, Basic) {
   EXPECT_THAT(actual, ContainerEq(expected));
 }
 
+/// Create the mocks for a list with @p page_count pages of 2 objects each.
+std::vector<ObjectMetadata> SetupPagedMock(MockClient& mock, int page_count) {
+  std::vector<ObjectMetadata> expected;
+  for (int i = 0; i != 2 * page_count; ++i) {
+    std::string id = "object-" + std::to_string(i);
+    nl::json metadata{
+        {"bucket", "foo-bar"},
+        {"id", id},
+        {"name", id},
+        {"kind", "storage#object"},
+    };
+    expected.emplace_back(ObjectMetadata::ParseFromJson(metadata));
+  }
+  auto& ex = EXPECT_CALL(mock, ListObjects(_));
+  for (int i = 0; i != page_count; ++i) {
+    ListObjectsResponse response;
+    if (i != page_count - 1) {
+      response.next_page_token = "page-" + std::to_string(i + 1);
+    }
+    response.items.push_back(expected[2 * i]);
+    response.items.push_back(expected[2 * i + 1]);
+    std::string token = i == 0 ? "" : "page-" + std::to_string(i);
+    ex.WillOnce(Invoke([response, token](ListObjectsRequest const& r) {
+      EXPECT_EQ(token, r.page_token());
+      return std::make_pair(Status(), response);
+    }));
+  }
+  return expected;
+}
+
+/// @test Verify that prefetching returns the same objects.
+TEST(ListObjectsReaderTest, Prefetch) {
+  auto mock = std::make_shared<MockClient>();
+  auto expected = SetupPagedMock(*mock, 4);
+
+  ListObjectsReader reader(mock, "foo-bar-baz", Prefix("dir/"));
+  reader.EnablePrefetch(2);
+  std::vector<ObjectMetadata> actual;
+  for (auto&& object : reader) {
+    actual.push_back(object);
+  }
+  EXPECT_THAT(actual, ContainerEq(expected));
+}
+
+/// @test Verify that prefetching can be enabled after the iteration starts.
+TEST(ListObjectsReaderTest, PrefetchAfterBegin) {
+  auto mock = std::make_shared<MockClient>();
+  auto expected = SetupPagedMock(*mock, 3);
+
+  ListObjectsReader reader(mock, "foo-bar-baz");
+  std::vector<ObjectMetadata> actual;
+  auto it = reader.begin();
+  actual.push_back(*it);
+  reader.EnablePrefetch();
+  for (++it; it != reader.end(); ++it) {
+    actual.push_back(*it);
+  }
+  EXPECT_THAT(actual, ContainerEq(expected));
+}
+
+/// @test Verify that the next page is requested before the iterator needs it.
+TEST(ListObjectsReaderTest, PrefetchIsAhead) {
+  ListObjectsResponse first;
+  first.next_page_token = "page-1";
+  first.items.resize(1);
+  std::promise<void> second_requested;
+
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillOnce(Return(std::make_pair(Status(), first)))
+      .WillOnce(Invoke([&second_requested](ListObjectsRequest const&) {
+        second_requested.set_value();
+        return std::make_pair(Status(), ListObjectsResponse());
+      }));
+
+  ListObjectsReader reader(mock, "foo-bar-baz");
+  reader.EnablePrefetch(1);
+  auto it = reader.begin();
+  ASSERT_NE(reader.end(), it);
+  // The iterator is still in the first page, the second page must be
+  // requested anyway.
+  auto status = second_requested.get_future().wait_for(std::chrono::seconds(5));
+  EXPECT_EQ(std::future_status::ready, status);
+  EXPECT_EQ(reader.end(), ++it);
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that errors in the background thread reach the caller.
+TEST(ListObjectsReaderTest, PrefetchError) {
+  ListObjectsResponse first;
+  first.next_page_token = "page-1";
+  first.items.resize(2);
+
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillOnce(Return(std::make_pair(Status(), first)))
+      .WillOnce(Invoke([](ListObjectsRequest const&) {
+        google::cloud::internal::RaiseRuntimeError("uh-oh");
+        return std::make_pair(Status(), ListObjectsResponse());
+      }));
+
+  ListObjectsReader reader(mock, "foo-bar-baz");
+  reader.EnablePrefetch(3);
+  auto it = reader.begin();
+  ASSERT_NE(reader.end(), it);
+  ++it;
+  ASSERT_NE(reader.end(), it);
+  EXPECT_THROW(++it, std::runtime_error);
+}
+
+/// @test Verify that EnablePrefetch() validates its argument.
+TEST(ListObjectsReaderTest, PrefetchInvalid) {
+  auto mock = std::make_shared<MockClient>();
+  ListObjectsReader reader(mock, "foo-bar-baz");
+  EXPECT_THROW(reader.EnablePrefetch(0), std::invalid_argument);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
 TEST(ListObjectsReaderTest, Empty) {
   auto mock = std::make_shared<MockClient>();
   EXPECT_CALL(*mock, ListObjects(_))
@@ -91,6 +211,31 @@ TEST(ListObjectsReaderTest, Empty) {
   EXPECT_EQ(0U, count);
 }
 
+/// @test Verify that the inventory fields are used for every page.
+TEST(ListObjectsReaderTest, InventoryFields) {
+  auto mock = std::make_shared<MockClient>();
+  ListObjectsResponse first;
+  first.next_page_token = "page-1";
+  first.items.emplace_back(ObjectMetadata::ParseFromJson(
+      nl::json{{"name", "foo"}, {"size", "1024"}, {"generation", "7"}}));
+  EXPECT_CALL(*mock, ListObjects(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([&first](ListObjectsRequest const& r) {
+        auto const& fields = r.get_option<Fields>();
+        EXPECT_TRUE(fields.has_value());
+        EXPECT_EQ("nextPageToken,prefixes,items(name,size,generation)",
+                  fields.value());
+        if (r.page_token().empty()) {
+          return std::make_pair(Status(), first);
+        }
+        return std::make_pair(Status(), ListObjectsResponse());
+      }));
+
+  ListObjectsReader reader(mock, "foo-bar-baz", ListObjectsInventoryFields());
+  auto count = std::distance(reader.begin(), reader.end());
+  EXPECT_EQ(1U, count);
+}
+
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -156,6 +156,25 @@ TEST(ObjectMetadataTest, Parse) {
                                       .count());
 }
 
+/// @test Verify that partial responses (see `Fields`) are parsed.
+TEST(ObjectMetadataTest, ParsePartial) {
+  auto actual = ObjectMetadata::ParseFromString(R"""({
+      "name": "baz",
+      "size": "102400",
+      "generation": "12345"
+})""");
+
+  EXPECT_EQ("baz", actual.name());
+  EXPECT_EQ(102400U, actual.size());
+  EXPECT_EQ(12345, actual.generation());
+  EXPECT_TRUE(actual.acl().empty());
+  EXPECT_EQ("", actual.bucket());
+  EXPECT_EQ(0U, actual.metadata_count());
+  EXPECT_EQ(0, actual.metageneration());
+  EXPECT_EQ(std::chrono::system_clock::time_point{}, actual.time_created());
+  EXPECT_EQ(std::chrono::system_clock::time_point{}, actual.updated());
+}
+
 /// @test Verify that the IOStream operator works as expected.
 TEST(ObjectMetadataTest, IOStream) {
   auto meta = CreateObjectMetadataForTest();
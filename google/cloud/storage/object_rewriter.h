@@ -0,0 +1,98 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_REWRITER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_REWRITER_H_
+
+#include "google/cloud/storage/internal/raw_client.h"
+#include <functional>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * The progress of an object rewrite.
+ */
+struct RewriteProgress {
+  std::uint64_t total_bytes_rewritten;
+  std::uint64_t object_size;
+  bool done;
+};
+
+/**
+ * Complete a (potentially) long-running object rewrite.
+ *
+ * Rewriting large objects across locations or storage classes may take many
+ * requests, each request returns a token used to continue the rewrite in the
+ * next one. Applications can call `Iterate()` to make one request at a time,
+ * and save the `token()` to resume the rewrite from a different process, or
+ * call `Result()` to block until the rewrite completes.
+ */
+class ObjectRewriter {
+ public:
+  ObjectRewriter(std::shared_ptr<internal::RawClient> client,
+                 internal::RewriteObjectRequest request);
+
+  /**
+   * Make one request to the service.
+   *
+   * @return the progress after the request, calling `Iterate()` after the
+   *     rewrite is done has no effect.
+   * @throw std::runtime_error if the request fails.
+   */
+  RewriteProgress Iterate();
+
+  /**
+   * Make requests until the rewrite completes.
+   *
+   * @return the metadata of the destination object.
+   * @throw std::runtime_error if any request fails.
+   */
+  ObjectMetadata Result() {
+    return ResultWithProgressCallback([](RewriteProgress const&) {});
+  }
+
+  /**
+   * Make requests until the rewrite completes, reporting the progress.
+   *
+   * @param callback invoked after each request.
+   * @return the metadata of the destination object.
+   * @throw std::runtime_error if any request fails.
+   */
+  ObjectMetadata ResultWithProgressCallback(
+      std::function<void(RewriteProgress const&)> callback);
+
+  /// The token to resume the rewrite, empty before the first request.
+  std::string const& token() const { return request_.rewrite_token(); }
+
+  RewriteProgress const& current_progress() const { return progress_; }
+
+  /// The metadata of the destination object, only valid once it is done.
+  ObjectMetadata const& result() const { return result_; }
+
+ private:
+  std::shared_ptr<internal::RawClient> client_;
+  internal::RewriteObjectRequest request_;
+  RewriteProgress progress_;
+  ObjectMetadata result_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_REWRITER_H_
@@ -60,6 +60,32 @@ class ObjectReadStream : public std::basic_istream<char> {
   bool IsOpen() const { return buf_.get() != nullptr and buf_->IsOpen(); }
   internal::HttpResponse Close();
 
+  /**
+   * The hashes reported by the service, e.g. `crc32c=AAAAAA==`.
+   *
+   * The value is only available once the download has completed. If the hashes
+   * do not match the computed values, the stream `badbit` is set (or an
+   * exception raised, if enabled with `exceptions()`) at that point.
+   *
+   * @see `DisableCrc32cChecksum` and `EnableMD5Hash` to configure what hashes
+   *     are computed.
+   */
+  std::string received_hash() const {
+    return buf_ ? buf_->received_hash() : std::string{};
+  }
+
+  /// The hashes computed from the downloaded data.
+  std::string computed_hash() const {
+    return buf_ ? buf_->computed_hash() : std::string{};
+  }
+
+  /**
+   * Return true if the data is served from the local object cache.
+   *
+   * @see `ClientOptions::set_object_disk_cache_directory()`.
+   */
+  bool cache_hit() const { return buf_ and buf_->cache_hit(); }
+
  private:
   std::unique_ptr<internal::ObjectReadStreambuf> buf_;
 };
@@ -112,6 +138,24 @@ class ObjectWriteStream : public std::basic_ostream<char> {
   /// Close the stream and return the (unparsed) result, useful for testing.
   internal::HttpResponse CloseRaw();
 
+  /**
+   * The hashes reported by the service, e.g. `crc32c=AAAAAA==`.
+   *
+   * The value is only available after the stream is closed. `Close()` raises
+   * an exception if the hashes do not match the computed values.
+   *
+   * @see `DisableCrc32cChecksum` and `EnableMD5Hash` to configure what hashes
+   *     are computed.
+   */
+  std::string received_hash() const {
+    return buf_ ? buf_->received_hash() : std::string{};
+  }
+
+  /// The hashes computed from the uploaded data.
+  std::string computed_hash() const {
+    return buf_ ? buf_->computed_hash() : std::string{};
+  }
+
  private:
   std::unique_ptr<internal::ObjectWriteStreambuf> buf_;
 };
@@ -190,6 +190,148 @@ TEST_F(ObjectTest, DeleteObjectPermanentFailure) {
       "DeleteObject");
 }
 
+TEST_F(ObjectTest, CopyObject) {
+  std::string text = R"""({
+      "bucket": "dst-bucket",
+      "name": "dst-object",
+      "generation": "3"
+})""";
+  auto expected = ObjectMetadata::ParseFromString(text);
+
+  EXPECT_CALL(*mock, CopyObject(_))
+      .WillOnce(Return(std::make_pair(TransientError(), ObjectMetadata{})))
+      .WillOnce(Invoke([&expected](internal::CopyObjectRequest const& r) {
+        EXPECT_EQ("src-bucket", r.source_bucket());
+        EXPECT_EQ("src-object", r.source_object());
+        EXPECT_EQ("dst-bucket", r.destination_bucket());
+        EXPECT_EQ("dst-object", r.destination_object());
+        EXPECT_EQ(7, r.get_option<IfSourceGenerationMatch>().value());
+        return std::make_pair(Status(), expected);
+      }));
+  Client client{std::shared_ptr<internal::RawClient>(mock),
+                LimitedErrorCountRetryPolicy(2),
+                ExponentialBackoffPolicy(ms(100), ms(500), 2)};
+
+  auto actual = client.CopyObject("src-bucket", "src-object", "dst-bucket",
+                                  "dst-object", IfSourceGenerationMatch(7));
+  EXPECT_EQ(expected, actual);
+}
+
+TEST_F(ObjectTest, CopyObjectTooManyFailures) {
+  testing::TooManyFailuresTest<ObjectMetadata>(
+      mock, EXPECT_CALL(*mock, CopyObject(_)),
+      [](Client& client) {
+        client.CopyObject("src-bucket", "src-object", "dst-bucket",
+                          "dst-object");
+      },
+      "CopyObject");
+}
+
+TEST_F(ObjectTest, CopyObjectPermanentFailure) {
+  testing::PermanentFailureTest<ObjectMetadata>(
+      *client, EXPECT_CALL(*mock, CopyObject(_)),
+      [](Client& client) {
+        client.CopyObject("src-bucket", "src-object", "dst-bucket",
+                          "dst-object");
+      },
+      "CopyObject");
+}
+
+TEST_F(ObjectTest, RewriteObject) {
+  std::string text = R"""({
+      "bucket": "dst-bucket",
+      "name": "dst-object",
+      "generation": "3"
+})""";
+  auto expected = ObjectMetadata::ParseFromString(text);
+
+  EXPECT_CALL(*mock, RewriteObject(_))
+      .WillOnce(Invoke([](internal::RewriteObjectRequest const& r) {
+        EXPECT_EQ("", r.rewrite_token());
+        EXPECT_EQ(1048576,
+                  r.get_option<MaxBytesRewrittenPerCall>().value());
+        return std::make_pair(
+            Status(), internal::RewriteObjectResponse{1048576, 3145728, false,
+                                                      "token-1", {}});
+      }))
+      .WillOnce(Return(std::make_pair(TransientError(),
+                                      internal::RewriteObjectResponse{})))
+      .WillOnce(Invoke([](internal::RewriteObjectRequest const& r) {
+        EXPECT_EQ("token-1", r.rewrite_token());
+        return std::make_pair(
+            Status(), internal::RewriteObjectResponse{2097152, 3145728, false,
+                                                      "token-2", {}});
+      }))
+      .WillOnce(Invoke([&expected](internal::RewriteObjectRequest const& r) {
+        EXPECT_EQ("src-bucket", r.source_bucket());
+        EXPECT_EQ("src-object", r.source_object());
+        EXPECT_EQ("dst-bucket", r.destination_bucket());
+        EXPECT_EQ("dst-object", r.destination_object());
+        EXPECT_EQ("token-2", r.rewrite_token());
+        return std::make_pair(
+            Status(), internal::RewriteObjectResponse{3145728, 3145728, true,
+                                                      "", expected});
+      }));
+  Client client{std::shared_ptr<internal::RawClient>(mock),
+                LimitedErrorCountRetryPolicy(2),
+                ExponentialBackoffPolicy(ms(1), ms(5), 2)};
+
+  auto rewriter =
+      client.RewriteObject("src-bucket", "src-object", "dst-bucket",
+                           "dst-object", MaxBytesRewrittenPerCall(1048576));
+  auto progress = rewriter.Iterate();
+  EXPECT_EQ(1048576U, progress.total_bytes_rewritten);
+  EXPECT_EQ(3145728U, progress.object_size);
+  EXPECT_FALSE(progress.done);
+  EXPECT_EQ("token-1", rewriter.token());
+
+  std::vector<std::uint64_t> reported;
+  auto actual =
+      rewriter.ResultWithProgressCallback([&reported](RewriteProgress const& p) {
+        reported.push_back(p.total_bytes_rewritten);
+      });
+  EXPECT_EQ(expected, actual);
+  EXPECT_TRUE(rewriter.current_progress().done);
+  EXPECT_EQ(2U, reported.size());
+  EXPECT_EQ(3145728U, reported.back());
+}
+
+TEST_F(ObjectTest, ResumeRewriteObject) {
+  EXPECT_CALL(*mock, RewriteObject(_))
+      .WillOnce(Invoke([](internal::RewriteObjectRequest const& r) {
+        EXPECT_EQ("saved-token", r.rewrite_token());
+        return std::make_pair(
+            Status(),
+            internal::RewriteObjectResponse{8, 8, true, "", ObjectMetadata{}});
+      }));
+
+  auto rewriter = client->ResumeRewriteObject(
+      "src-bucket", "src-object", "dst-bucket", "dst-object", "saved-token");
+  EXPECT_TRUE(rewriter.Iterate().done);
+  // Once the rewrite is done no more requests are made.
+  EXPECT_TRUE(rewriter.Iterate().done);
+}
+
+TEST_F(ObjectTest, RewriteObjectTooManyFailures) {
+  testing::TooManyFailuresTest<internal::RewriteObjectResponse>(
+      mock, EXPECT_CALL(*mock, RewriteObject(_)),
+      [](Client& client) {
+        client.RewriteObjectBlocking("src-bucket", "src-object", "dst-bucket",
+                                     "dst-object");
+      },
+      "RewriteObject");
+}
+
+TEST_F(ObjectTest, RewriteObjectPermanentFailure) {
+  testing::PermanentFailureTest<internal::RewriteObjectResponse>(
+      *client, EXPECT_CALL(*mock, RewriteObject(_)),
+      [](Client& client) {
+        client.RewriteObjectBlocking("src-bucket", "src-object", "dst-bucket",
+                                     "dst-object");
+      },
+      "RewriteObject");
+}
+
 }  // namespace
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -0,0 +1,391 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_list_objects_reader.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace {
+// Define the defaults using a pre-processor macro, this allows the application
+// developers to change the defaults for their application by compiling with
+// different values.
+#ifndef STORAGE_CLIENT_DEFAULT_PARALLEL_LIST_CONCURRENCY
+#define STORAGE_CLIENT_DEFAULT_PARALLEL_LIST_CONCURRENCY 8
+#endif  // STORAGE_CLIENT_DEFAULT_PARALLEL_LIST_CONCURRENCY
+
+#ifndef STORAGE_CLIENT_DEFAULT_PARALLEL_LIST_MAX_BUFFERED_OBJECTS
+#define STORAGE_CLIENT_DEFAULT_PARALLEL_LIST_MAX_BUFFERED_OBJECTS 10000
+#endif  // STORAGE_CLIENT_DEFAULT_PARALLEL_LIST_MAX_BUFFERED_OBJECTS
+}  // anonymous namespace
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+ParallelListObjectsOptions::ParallelListObjectsOptions()
+    : max_concurrency_(STORAGE_CLIENT_DEFAULT_PARALLEL_LIST_CONCURRENCY),
+      max_buffered_objects_(
+          STORAGE_CLIENT_DEFAULT_PARALLEL_LIST_MAX_BUFFERED_OBJECTS),
+      ordered_(false),
+      delimiter_("/") {}
+
+ParallelListObjectsOptions& ParallelListObjectsOptions::set_max_concurrency(
+    std::size_t v) {
+  if (v == 0) {
+    google::cloud::internal::RaiseInvalidArgument(
+        "ParallelListObjectsOptions::set_max_concurrency() - must be > 0");
+  }
+  max_concurrency_ = v;
+  return *this;
+}
+
+ParallelListObjectsOptions&
+ParallelListObjectsOptions::set_max_buffered_objects(std::size_t v) {
+  if (v == 0) {
+    google::cloud::internal::RaiseInvalidArgument(
+        "ParallelListObjectsOptions::set_max_buffered_objects() - must be > 0");
+  }
+  max_buffered_objects_ = v;
+  return *this;
+}
+
+ParallelListObjectsIterator::ParallelListObjectsIterator(
+    ParallelListObjectsReader* owner,
+    google::cloud::internal::optional<ObjectMetadata> value)
+    : owner_(owner), value_(std::move(value)) {
+  if (not value_) {
+    // This iterator was initialized by begin() on an empty list, turn it into
+    // an end() iterator.
+    owner_ = nullptr;
+  }
+}
+
+ParallelListObjectsIterator& ParallelListObjectsIterator::operator++() {
+  value_ = owner_->GetNext();
+  if (not value_) {
+    owner_ = nullptr;
+  }
+  return *this;
+}
+
+/**
+ * Implement the listing, this is the state shared with the worker threads.
+ *
+ * Each prefix is represented by a `Node`. The worker threads take the pending
+ * nodes in lexicographical order, list all the pages for that prefix, and
+ * add any new sub-prefixes to the pending nodes.
+ *
+ * In unordered mode the objects are simply appended to a queue, and the
+ * workers stop requesting pages while the queue is full. In ordered mode each
+ * node keeps the objects and sub-prefixes in the order returned by the
+ * service, and the consumer traverses the resulting tree depth-first. Ordered
+ * mode cannot use the same limit: the consumer may be waiting for a node that
+ * no worker can list while the buffers are full of later nodes.
+ */
+class ParallelListObjectsReader::Impl {
+ public:
+  Impl(std::shared_ptr<internal::RawClient> client,
+       internal::ListObjectsRequest request,
+       ParallelListObjectsOptions const& options);
+  ~Impl();
+
+  google::cloud::internal::optional<ObjectMetadata> GetNext();
+
+ private:
+  struct Node;
+  /// An entry in a node, either an object or a child node.
+  struct Entry {
+    ObjectMetadata object;
+    std::shared_ptr<Node> child;
+  };
+  struct Node {
+    explicit Node(std::string p) : prefix(std::move(p)), complete(false) {}
+    std::string prefix;
+    std::deque<Entry> entries;
+    bool complete;
+  };
+
+  void Shutdown();
+  void Worker();
+  /// Block until the queue has room for more objects, false on shutdown.
+  bool WaitForCapacity();
+  void ListPrefix(std::shared_ptr<Node> node);
+  bool AddPage(Node& node, internal::ListObjectsResponse page);
+  void RaiseIfFailed();
+
+  std::shared_ptr<internal::RawClient> client_;
+  internal::ListObjectsRequest request_;
+  std::string delimiter_;
+  bool ordered_;
+  std::size_t max_buffered_objects_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::map<std::string, std::shared_ptr<Node>> pending_;
+  std::size_t active_;
+  bool shutdown_;
+  std::string error_;
+  std::exception_ptr exception_;
+  std::deque<ObjectMetadata> unordered_;
+  std::vector<std::shared_ptr<Node>> stack_;
+  std::vector<std::thread> workers_;
+};
+
+ParallelListObjectsReader::Impl::Impl(
+    std::shared_ptr<internal::RawClient> client,
+    internal::ListObjectsRequest request,
+    ParallelListObjectsOptions const& options)
+    : client_(std::move(client)),
+      request_(std::move(request)),
+      delimiter_(options.delimiter()),
+      ordered_(options.ordered()),
+      max_buffered_objects_(options.max_buffered_objects()),
+      active_(0),
+      shutdown_(false) {
+  auto const& prefix = request_.get_option<Prefix>();
+  auto root = std::make_shared<Node>(prefix.has_value() ? prefix.value() : "");
+  pending_.emplace(root->prefix, root);
+  if (ordered_) {
+    stack_.push_back(std::move(root));
+  }
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  try {
+    for (std::size_t i = 0; i != options.max_concurrency(); ++i) {
+      workers_.emplace_back(&Impl::Worker, this);
+    }
+  } catch (...) {
+    // The destructor does not run if the constructor fails, the threads
+    // already started must be stopped here.
+    Shutdown();
+    throw;
+  }
+#else
+  for (std::size_t i = 0; i != options.max_concurrency(); ++i) {
+    workers_.emplace_back(&Impl::Worker, this);
+  }
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+ParallelListObjectsReader::Impl::~Impl() { Shutdown(); }
+
+void ParallelListObjectsReader::Impl::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (auto& t : workers_) {
+    t.join();
+  }
+  workers_.clear();
+}
+
+google::cloud::internal::optional<ObjectMetadata>
+ParallelListObjectsReader::Impl::GetNext() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (true) {
+    RaiseIfFailed();
+    if (not ordered_) {
+      if (not unordered_.empty()) {
+        auto object = std::move(unordered_.front());
+        unordered_.pop_front();
+        if (unordered_.size() + 1 == max_buffered_objects_) {
+          // The queue was full, wake up the workers.
+          cv_.notify_all();
+        }
+        return google::cloud::internal::optional<ObjectMetadata>(
+            std::move(object));
+      }
+      if (pending_.empty() and active_ == 0) {
+        return google::cloud::internal::optional<ObjectMetadata>();
+      }
+      cv_.wait(lk);
+      continue;
+    }
+    if (stack_.empty()) {
+      return google::cloud::internal::optional<ObjectMetadata>();
+    }
+    auto& node = *stack_.back();
+    if (not node.entries.empty()) {
+      auto entry = std::move(node.entries.front());
+      node.entries.pop_front();
+      if (entry.child) {
+        stack_.push_back(std::move(entry.child));
+        continue;
+      }
+      return google::cloud::internal::optional<ObjectMetadata>(
+          std::move(entry.object));
+    }
+    if (node.complete) {
+      stack_.pop_back();
+      continue;
+    }
+    cv_.wait(lk);
+  }
+}
+
+void ParallelListObjectsReader::Impl::Worker() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (true) {
+    cv_.wait(lk, [this] {
+      return shutdown_ or not pending_.empty() or active_ == 0;
+    });
+    if (shutdown_ or pending_.empty()) {
+      // Either the reader is being destroyed, or there is no more work and no
+      // other worker can create more.
+      return;
+    }
+    auto node = std::move(pending_.begin()->second);
+    pending_.erase(pending_.begin());
+    ++active_;
+    lk.unlock();
+    ListPrefix(std::move(node));
+    lk.lock();
+    --active_;
+    cv_.notify_all();
+  }
+}
+
+bool ParallelListObjectsReader::Impl::WaitForCapacity() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] {
+    return shutdown_ or ordered_ or unordered_.size() < max_buffered_objects_;
+  });
+  return not shutdown_;
+}
+
+void ParallelListObjectsReader::Impl::ListPrefix(std::shared_ptr<Node> node) {
+  auto request = request_;
+  request.set_multiple_options(Prefix(std::string(node->prefix)),
+                               Delimiter(std::string(delimiter_)));
+  std::string page_token;
+  do {
+    if (not WaitForCapacity()) {
+      return;
+    }
+    request.set_page_token(std::move(page_token));
+    std::pair<Status, internal::ListObjectsResponse> page;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      page = client_->ListObjects(request);
+    } catch (...) {
+      std::lock_guard<std::mutex> lk(mu_);
+      exception_ = std::current_exception();
+      shutdown_ = true;
+      cv_.notify_all();
+      return;
+    }
+#else
+    page = client_->ListObjects(request);
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    std::lock_guard<std::mutex> lk(mu_);
+    if (not page.first.ok()) {
+      std::ostringstream os;
+      os << "ParallelListObjectsReader - error listing prefix <"
+         << node->prefix << ">: " << page.first;
+      error_ = os.str();
+      shutdown_ = true;
+      cv_.notify_all();
+      return;
+    }
+    page_token = page.second.next_page_token;
+    if (not AddPage(*node, std::move(page.second))) {
+      return;
+    }
+    cv_.notify_all();
+  } while (not page_token.empty());
+}
+
+bool ParallelListObjectsReader::Impl::AddPage(
+    Node& node, internal::ListObjectsResponse page) {
+  if (shutdown_) {
+    return false;
+  }
+  std::vector<std::shared_ptr<Node>> children;
+  for (auto& p : page.prefixes) {
+    // The service should only return longer prefixes, but guard against
+    // loops anyway.
+    if (p.size() <= node.prefix.size()) {
+      continue;
+    }
+    auto child = std::make_shared<Node>(std::move(p));
+    pending_.emplace(child->prefix, child);
+    children.push_back(std::move(child));
+  }
+  if (page.next_page_token.empty()) {
+    node.complete = true;
+  }
+  if (not ordered_) {
+    std::move(page.items.begin(), page.items.end(),
+              std::back_inserter(unordered_));
+    return true;
+  }
+  // Merge the objects and the prefixes, both are sorted.
+  auto object = page.items.begin();
+  auto child = children.begin();
+  while (object != page.items.end() or child != children.end()) {
+    if (child == children.end() or
+        (object != page.items.end() and object->name() <= (*child)->prefix)) {
+      node.entries.push_back(Entry{std::move(*object), nullptr});
+      ++object;
+    } else {
+      node.entries.push_back(Entry{ObjectMetadata(), std::move(*child)});
+      ++child;
+    }
+  }
+  return true;
+}
+
+void ParallelListObjectsReader::Impl::RaiseIfFailed() {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  if (exception_) {
+    std::rethrow_exception(exception_);
+  }
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  if (not error_.empty()) {
+    google::cloud::internal::RaiseRuntimeError(error_);
+  }
+}
+
+ParallelListObjectsReader::ParallelListObjectsReader(
+    std::shared_ptr<internal::RawClient> client,
+    internal::ListObjectsRequest request,
+    ParallelListObjectsOptions const& options)
+    : impl_(new Impl(std::move(client), std::move(request), options)) {}
+
+ParallelListObjectsReader::ParallelListObjectsReader(
+    ParallelListObjectsReader&&) noexcept = default;
+ParallelListObjectsReader& ParallelListObjectsReader::operator=(
+    ParallelListObjectsReader&&) noexcept = default;
+ParallelListObjectsReader::~ParallelListObjectsReader() = default;
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+ParallelListObjectsReader::iterator ParallelListObjectsReader::begin() {
+  return iterator(this, GetNext());
+}
+
+google::cloud::internal::optional<ObjectMetadata>
+ParallelListObjectsReader::GetNext() {
+  return impl_->GetNext();
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,195 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_LIST_OBJECTS_READER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_LIST_OBJECTS_READER_H_
+
+#include "google/cloud/storage/internal/list_objects_request.h"
+#include "google/cloud/storage/internal/raw_client.h"
+#include <iterator>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * Configure a `ParallelListObjectsReader`.
+ */
+class ParallelListObjectsOptions {
+ public:
+  ParallelListObjectsOptions();
+
+  /// The maximum number of `ListObjects` requests in flight.
+  std::size_t max_concurrency() const { return max_concurrency_; }
+  ParallelListObjectsOptions& set_max_concurrency(std::size_t v);
+
+  /**
+   * Return the objects in the same order as `Client::ListObjects()`.
+   *
+   * When disabled (the default) the objects are returned as soon as they are
+   * received. When enabled, objects in later prefixes are buffered until all
+   * the previous objects are returned, which can use a lot of memory if the
+   * first prefixes are large.
+   */
+  bool ordered() const { return ordered_; }
+  ParallelListObjectsOptions& set_ordered(bool v) {
+    ordered_ = v;
+    return *this;
+  }
+
+  /**
+   * The maximum number of objects received but not yet returned.
+   *
+   * In unordered mode the workers stop requesting more pages once this many
+   * objects are waiting for the application. Each page can exceed the limit,
+   * so the actual number of buffered objects may be larger, but it does not
+   * grow without bounds if the application is slower than the listing.
+   */
+  std::size_t max_buffered_objects() const { return max_buffered_objects_; }
+  ParallelListObjectsOptions& set_max_buffered_objects(std::size_t v);
+
+  /// The delimiter used to discover the prefixes, typically "/".
+  std::string const& delimiter() const { return delimiter_; }
+  ParallelListObjectsOptions& set_delimiter(std::string v) {
+    delimiter_ = std::move(v);
+    return *this;
+  }
+
+ private:
+  std::size_t max_concurrency_;
+  std::size_t max_buffered_objects_;
+  bool ordered_;
+  std::string delimiter_;
+};
+
+class ParallelListObjectsReader;
+
+/**
+ * A class meeting C++'s InputIterator requirements for parallel listings.
+ */
+class ParallelListObjectsIterator
+    : public std::iterator<std::input_iterator_tag, ObjectMetadata> {
+ public:
+  ParallelListObjectsIterator() : owner_(nullptr) {}
+
+  ParallelListObjectsIterator& operator++();
+  ParallelListObjectsIterator const operator++(int) {
+    ParallelListObjectsIterator tmp(*this);
+    operator++();
+    return tmp;
+  }
+
+  ObjectMetadata const* operator->() const { return value_.operator->(); }
+  ObjectMetadata* operator->() { return value_.operator->(); }
+
+  ObjectMetadata const& operator*() const& { return *value_; }
+  ObjectMetadata& operator*() & { return *value_; }
+  ObjectMetadata const&& operator*() const&& { return *std::move(value_); }
+  ObjectMetadata&& operator*() && { return *std::move(value_); }
+
+  bool operator==(ParallelListObjectsIterator const& rhs) const {
+    // All end iterators are equal.
+    if (owner_ == nullptr) {
+      return rhs.owner_ == nullptr;
+    }
+    // All non-end iterators in the same reader are equal.
+    return owner_ == rhs.owner_;
+  }
+
+  bool operator!=(ParallelListObjectsIterator const& rhs) const {
+    return !(*this == rhs);
+  }
+
+ private:
+  friend class ParallelListObjectsReader;
+  explicit ParallelListObjectsIterator(
+      ParallelListObjectsReader* owner,
+      google::cloud::internal::optional<ObjectMetadata> value);
+
+ private:
+  ParallelListObjectsReader* owner_;
+  google::cloud::internal::optional<ObjectMetadata> value_;
+};
+
+/**
+ * List the objects in a bucket using multiple `ListObjects` requests.
+ *
+ * A single `ListObjects` pagination chain is serial, each page needs the token
+ * from the previous page. This class lists each "directory" independently:
+ * it lists a prefix using a delimiter, which returns the objects directly in
+ * that prefix and the sub-prefixes, and then lists each sub-prefix the same
+ * way, using up to `max_concurrency()` background threads.
+ *
+ * The result contains the same objects as `Client::ListObjects()` with the
+ * same `Prefix`. This works best for buckets where the object names are
+ * organized in many "directories", it is no faster than `ListObjects()` for
+ * buckets without the delimiter in the object names.
+ *
+ * The destructor stops the background threads, it blocks until any pending
+ * requests complete.
+ */
+class ParallelListObjectsReader {
+ public:
+  template <typename... Parameters>
+  ParallelListObjectsReader(std::shared_ptr<internal::RawClient> client,
+                            std::string bucket_name,
+                            ParallelListObjectsOptions const& options,
+                            Parameters&&... parameters)
+      : ParallelListObjectsReader(
+            std::move(client),
+            internal::ListObjectsRequest(std::move(bucket_name))
+                .set_multiple_options(std::forward<Parameters>(parameters)...),
+            options) {}
+
+  ParallelListObjectsReader(ParallelListObjectsReader&&) noexcept;
+  ParallelListObjectsReader& operator=(ParallelListObjectsReader&&) noexcept;
+  ~ParallelListObjectsReader();
+
+  /// The iterator type for this stream.
+  using iterator = ParallelListObjectsIterator;
+
+  /**
+   * Return an iterator over the list of objects.
+   *
+   * The returned iterator is a single-pass input iterator. Creating, and
+   * particularly incrementing, multiple iterators on the same reader is
+   * unsupported and can produce incorrect results.
+   *
+   * @throws std::runtime_error if any of the requests failed after retries.
+   */
+  iterator begin();
+
+  /// Return an iterator pointing to the end of the stream.
+  iterator end() { return ParallelListObjectsIterator(); }
+
+ private:
+  friend class ParallelListObjectsIterator;
+  class Impl;
+
+  ParallelListObjectsReader(std::shared_ptr<internal::RawClient> client,
+                            internal::ListObjectsRequest request,
+                            ParallelListObjectsOptions const& options);
+
+  google::cloud::internal::optional<ObjectMetadata> GetNext();
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_LIST_OBJECTS_READER_H_
@@ -0,0 +1,210 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_list_objects_reader.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+namespace nl = internal::nl;
+using internal::ListObjectsRequest;
+using internal::ListObjectsResponse;
+using ::testing::_;
+using ::testing::ElementsAreArray;
+using ::testing::Invoke;
+using testing::MockClient;
+using ::testing::UnorderedElementsAreArray;
+
+std::vector<std::string> const OBJECT_NAMES = {
+    "a",         "b/1",     "b/2",   "b/c/1", "b/c/2", "b/c/3", "b/d/1",
+    "b/d/e/f/1", "b0",      "c/",    "c/1",   "d/x/1", "d/y/1", "d/z/1",
+    "e/1",       "e/2",     "e/3",   "e/4",   "e/5",   "f",
+};
+
+/**
+ * Emulate `ListObjects` with a prefix and delimiter, using small pages.
+ */
+std::pair<Status, ListObjectsResponse> FakeListObjects(
+    ListObjectsRequest const& request) {
+  std::string prefix = request.get_option<Prefix>().has_value()
+                           ? request.get_option<Prefix>().value()
+                           : "";
+  std::string delimiter = request.get_option<Delimiter>().has_value()
+                              ? request.get_option<Delimiter>().value()
+                              : "";
+  // Compute all the entries (objects and prefixes) in order.
+  std::vector<std::pair<std::string, bool>> entries;
+  for (auto const& name : OBJECT_NAMES) {
+    if (name.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+    auto pos = delimiter.empty() ? std::string::npos
+                                 : name.find(delimiter, prefix.size());
+    if (pos == std::string::npos) {
+      entries.emplace_back(name, false);
+      continue;
+    }
+    auto p = name.substr(0, pos + delimiter.size());
+    if (entries.empty() or entries.back().first != p) {
+      entries.emplace_back(p, true);
+    }
+  }
+  std::size_t const page_size = 3;
+  std::size_t begin = request.page_token().empty()
+                          ? 0
+                          : std::stoul(request.page_token());
+  std::size_t end = (std::min)(begin + page_size, entries.size());
+  ListObjectsResponse response;
+  for (auto i = begin; i != end; ++i) {
+    if (entries[i].second) {
+      response.prefixes.push_back(entries[i].first);
+    } else {
+      response.items.emplace_back(ObjectMetadata::ParseFromJson(
+          nl::json{{"bucket", "test-bucket"}, {"name", entries[i].first}}));
+    }
+  }
+  if (end != entries.size()) {
+    response.next_page_token = std::to_string(end);
+  }
+  return std::make_pair(Status(), response);
+}
+
+std::vector<std::string> ListAll(ParallelListObjectsReader& reader) {
+  std::vector<std::string> names;
+  for (auto const& object : reader) {
+    names.push_back(object.name());
+  }
+  return names;
+}
+
+/// @test Verify the unordered listing returns all the objects.
+TEST(ParallelListObjectsReaderTest, Unordered) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_)).WillRepeatedly(Invoke(FakeListObjects));
+
+  ParallelListObjectsReader reader(
+      mock, "test-bucket", ParallelListObjectsOptions().set_max_concurrency(4));
+  EXPECT_THAT(ListAll(reader), UnorderedElementsAreArray(OBJECT_NAMES));
+}
+
+/// @test Verify the ordered listing returns the same order as ListObjects().
+TEST(ParallelListObjectsReaderTest, Ordered) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_)).WillRepeatedly(Invoke(FakeListObjects));
+
+  for (std::size_t concurrency : {1, 3, 16}) {
+    ParallelListObjectsReader reader(mock, "test-bucket",
+                                     ParallelListObjectsOptions()
+                                         .set_max_concurrency(concurrency)
+                                         .set_ordered(true));
+    EXPECT_THAT(ListAll(reader), ElementsAreArray(OBJECT_NAMES))
+        << "concurrency=" << concurrency;
+  }
+}
+
+/// @test Verify that the Prefix parameter is the root of the listing.
+TEST(ParallelListObjectsReaderTest, Prefix) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_)).WillRepeatedly(Invoke(FakeListObjects));
+
+  ParallelListObjectsReader reader(
+      mock, "test-bucket", ParallelListObjectsOptions().set_ordered(true),
+      Prefix("b/"));
+  EXPECT_THAT(ListAll(reader),
+              ElementsAreArray({"b/1", "b/2", "b/c/1", "b/c/2", "b/c/3",
+                                "b/d/1", "b/d/e/f/1"}));
+}
+
+/// @test Verify that abandoning the iteration stops the workers.
+TEST(ParallelListObjectsReaderTest, Abandon) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_)).WillRepeatedly(Invoke(FakeListObjects));
+
+  ParallelListObjectsReader reader(mock, "test-bucket",
+                                   ParallelListObjectsOptions());
+  auto it = reader.begin();
+  EXPECT_NE(reader.end(), it);
+  // The destructor must not block forever.
+}
+
+/// @test Verify that the workers stop listing when the queue is full.
+TEST(ParallelListObjectsReaderTest, BoundedQueue) {
+  auto mock = std::make_shared<MockClient>();
+  std::atomic<int> calls(0);
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillRepeatedly(Invoke([&calls](ListObjectsRequest const& r) {
+        ++calls;
+        return FakeListObjects(r);
+      }));
+
+  auto options = ParallelListObjectsOptions()
+                     .set_max_concurrency(4)
+                     .set_max_buffered_objects(2);
+  {
+    ParallelListObjectsReader reader(mock, "test-bucket", options);
+    auto it = reader.begin();
+    EXPECT_NE(reader.end(), it);
+    // Give the workers time to list everything if they are not blocked. The
+    // listing needs 16 pages, with at most 4 pages of 3 objects in flight after
+    // the queue fills up the workers cannot get all the remaining objects.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_GT(16, calls.load());
+  }
+
+  ParallelListObjectsReader reader(mock, "test-bucket", options);
+  EXPECT_THAT(ListAll(reader), UnorderedElementsAreArray(OBJECT_NAMES));
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that errors are reported to the caller.
+TEST(ParallelListObjectsReaderTest, Error) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillRepeatedly(Invoke([](ListObjectsRequest const& r) {
+        if (r.get_option<Prefix>().value() == "d/") {
+          google::cloud::internal::RaiseRuntimeError("uh-oh");
+        }
+        return FakeListObjects(r);
+      }));
+
+  ParallelListObjectsReader reader(mock, "test-bucket",
+                                   ParallelListObjectsOptions());
+  EXPECT_THROW(ListAll(reader), std::runtime_error);
+}
+
+/// @test Verify that invalid options are rejected.
+TEST(ParallelListObjectsReaderTest, InvalidOptions) {
+  EXPECT_THROW(ParallelListObjectsOptions().set_max_concurrency(0),
+               std::invalid_argument);
+  EXPECT_THROW(ParallelListObjectsOptions().set_max_buffered_objects(0),
+               std::invalid_argument);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
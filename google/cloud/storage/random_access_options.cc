@@ -0,0 +1,57 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/random_access_options.h"
+#include "google/cloud/internal/throw_delegate.h"
+
+namespace {
+// Define the defaults using a pre-processor macro, this allows the application
+// developers to change the defaults for their application by compiling with
+// different values.
+#ifndef STORAGE_CLIENT_DEFAULT_RANDOM_ACCESS_BUFFER_SIZE
+#define STORAGE_CLIENT_DEFAULT_RANDOM_ACCESS_BUFFER_SIZE (1024 * 1024)
+#endif  // STORAGE_CLIENT_DEFAULT_RANDOM_ACCESS_BUFFER_SIZE
+
+#ifndef STORAGE_CLIENT_DEFAULT_RANDOM_ACCESS_MAX_SKIP
+#define STORAGE_CLIENT_DEFAULT_RANDOM_ACCESS_MAX_SKIP (1024 * 1024)
+#endif  // STORAGE_CLIENT_DEFAULT_RANDOM_ACCESS_MAX_SKIP
+
+#ifndef STORAGE_CLIENT_DEFAULT_RANDOM_ACCESS_SEQUENTIAL_THRESHOLD
+#define STORAGE_CLIENT_DEFAULT_RANDOM_ACCESS_SEQUENTIAL_THRESHOLD 2
+#endif  // STORAGE_CLIENT_DEFAULT_RANDOM_ACCESS_SEQUENTIAL_THRESHOLD
+}  // anonymous namespace
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+RandomAccessOptions::RandomAccessOptions()
+    : buffer_size_(STORAGE_CLIENT_DEFAULT_RANDOM_ACCESS_BUFFER_SIZE),
+      max_skip_(STORAGE_CLIENT_DEFAULT_RANDOM_ACCESS_MAX_SKIP),
+      sequential_threshold_(
+          STORAGE_CLIENT_DEFAULT_RANDOM_ACCESS_SEQUENTIAL_THRESHOLD) {}
+
+RandomAccessOptions& RandomAccessOptions::set_buffer_size(std::size_t v) {
+  if (v == 0) {
+    google::cloud::internal::RaiseInvalidArgument(
+        "RandomAccessOptions::set_buffer_size() - must be > 0");
+  }
+  buffer_size_ = v;
+  return *this;
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
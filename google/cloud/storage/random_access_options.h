@@ -0,0 +1,78 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_RANDOM_ACCESS_OPTIONS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_RANDOM_ACCESS_OPTIONS_H_
+
+#include "google/cloud/storage/version.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * Configure `Client::ReadObjectRandomAccess()`.
+ */
+class RandomAccessOptions {
+ public:
+  RandomAccessOptions();
+
+  /**
+   * The size of the buffered window.
+   *
+   * Seeks within the window do not make any requests. When the stream detects
+   * random access this is also the size of each ranged request.
+   */
+  std::size_t buffer_size() const { return buffer_size_; }
+  RandomAccessOptions& set_buffer_size(std::size_t v);
+
+  /**
+   * Forward seeks up to this many bytes read and discard the data.
+   *
+   * Reading a few bytes from the open download is usually cheaper than the
+   * latency of a new request.
+   */
+  std::int64_t max_skip() const { return max_skip_; }
+  RandomAccessOptions& set_max_skip(std::int64_t v) {
+    max_skip_ = v;
+    return *this;
+  }
+
+  /**
+   * Switch back to sequential reads after this many contiguous requests.
+   *
+   * In random access mode each request is bounded by `buffer_size()`. If the
+   * application reads this many consecutive windows the stream makes a single
+   * request for the rest of the object instead.
+   */
+  int sequential_threshold() const { return sequential_threshold_; }
+  RandomAccessOptions& set_sequential_threshold(int v) {
+    sequential_threshold_ = v;
+    return *this;
+  }
+
+ private:
+  std::size_t buffer_size_;
+  std::int64_t max_skip_;
+  int sequential_threshold_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_RANDOM_ACCESS_OPTIONS_H_
@@ -0,0 +1,249 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/read_ranges.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace {
+auto constexpr kDefaultMaxConcurrency = 8;
+auto constexpr kDefaultMaxGap = 64 * 1024;
+auto constexpr kDefaultMaxCoalescedSize = 32 * 1024 * 1024;
+}  // anonymous namespace
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+ReadRangesOptions::ReadRangesOptions()
+    : max_concurrency_(kDefaultMaxConcurrency),
+      max_gap_(kDefaultMaxGap),
+      max_coalesced_size_(kDefaultMaxCoalescedSize) {}
+
+ReadRangesOptions& ReadRangesOptions::set_max_concurrency(std::size_t v) {
+  if (v == 0) {
+    google::cloud::internal::RaiseInvalidArgument(
+        "ReadRangesOptions::set_max_concurrency() - must be > 0");
+  }
+  max_concurrency_ = v;
+  return *this;
+}
+
+namespace internal {
+namespace {
+/// Read up to @p size bytes from @p buf, returns the number of bytes read.
+std::int64_t ReadFully(ObjectReadStreambuf& buf, char* data,
+                       std::int64_t size) {
+  std::int64_t offset = 0;
+  while (offset < size) {
+    auto count = buf.sgetn(data + offset, size - offset);
+    if (count <= 0) {
+      break;
+    }
+    offset += count;
+  }
+  return offset;
+}
+
+/// The service returns this status for ranges that start past the end of the
+/// object.
+long const RANGE_NOT_SATISFIABLE = 416;
+
+/// Copy the data for each range in @p group from @p buf.
+void CopyGroup(ObjectReadStreambuf& buf, CoalescedRange const& group,
+               std::vector<ReadRange>& ranges) {
+  if (group.members.size() == 1) {
+    // Read directly into the application buffer.
+    auto& range = ranges[group.members.front()];
+    range.bytes_read = ReadFully(buf, range.buffer, range.length);
+    return;
+  }
+  std::string data(static_cast<std::size_t>(group.end - group.begin), '\0');
+  auto size = ReadFully(buf, &data[0], group.end - group.begin);
+  for (auto index : group.members) {
+    auto& range = ranges[index];
+    auto start = range.offset - group.begin;
+    auto count = (std::min)(range.length, size - start);
+    if (count <= 0) {
+      continue;
+    }
+    std::memcpy(range.buffer, data.data() + start,
+                static_cast<std::size_t>(count));
+    range.bytes_read = count;
+  }
+}
+
+/**
+ * Read the ranges in @p group with a single request.
+ *
+ * Groups starting at or past the end of the object are not an error, their
+ * ranges are left with `bytes_read == 0`.
+ *
+ * @return the generation reported by the service, or 0 if unknown.
+ */
+std::int64_t ReadGroup(RawClient& client,
+                       ReadObjectRangeRequest const& prototype,
+                       CoalescedRange const& group,
+                       std::vector<ReadRange>& ranges) {
+  ReadObjectRangeRequest request = prototype;
+  request.set_begin(group.begin).set_end(group.end);
+  auto result = client.ReadObject(request);
+  if (result.first.status_code() == RANGE_NOT_SATISFIABLE) {
+    return 0;
+  }
+  if (not result.first.ok()) {
+    std::ostringstream os;
+    os << "Error in ReadRanges(): " << result.first;
+    google::cloud::internal::RaiseRuntimeError(os.str());
+  }
+  auto& buf = *result.second;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  try {
+    CopyGroup(buf, group, ranges);
+  } catch (...) {
+    // Downloads report errors when the data is read, not when they start.
+    if (buf.status().status_code() != RANGE_NOT_SATISFIABLE) {
+      throw;
+    }
+    return 0;
+  }
+#else
+  CopyGroup(buf, group, ranges);
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  std::int64_t generation = 0;
+  auto headers = buf.headers();
+  auto loc = headers.find("x-goog-generation");
+  if (loc != headers.end()) {
+    generation = std::strtoll(loc->second.c_str(), nullptr, 10);
+  }
+  if (buf.IsOpen()) {
+    buf.Close();
+  }
+  return generation;
+}
+}  // namespace
+
+std::vector<CoalescedRange> CoalesceRanges(std::vector<ReadRange> const& ranges,
+                                           std::int64_t max_gap,
+                                           std::int64_t max_coalesced_size) {
+  std::vector<std::size_t> order;
+  for (std::size_t i = 0; i != ranges.size(); ++i) {
+    if (ranges[i].length > 0) {
+      order.push_back(i);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&ranges](std::size_t lhs, std::size_t rhs) {
+                     return ranges[lhs].offset < ranges[rhs].offset;
+                   });
+  std::vector<CoalescedRange> result;
+  for (auto index : order) {
+    auto const& range = ranges[index];
+    auto end = range.offset + range.length;
+    if (not result.empty()) {
+      auto& last = result.back();
+      auto merged_end = (std::max)(last.end, end);
+      if (range.offset <= last.end + max_gap and
+          merged_end - last.begin <= max_coalesced_size) {
+        last.end = merged_end;
+        last.members.push_back(index);
+        continue;
+      }
+    }
+    result.push_back(CoalescedRange{range.offset, end, {index}});
+  }
+  return result;
+}
+
+void ReadRanges(RawClient& client, ReadObjectRangeRequest request,
+                std::vector<ReadRange>& ranges,
+                ReadRangesOptions const& options) {
+  for (auto& range : ranges) {
+    range.bytes_read = 0;
+  }
+  auto groups = CoalesceRanges(ranges, options.max_gap(),
+                               options.max_coalesced_size());
+  if (groups.empty()) {
+    return;
+  }
+  std::size_t first = 0;
+  if (not request.get_option<Generation>().has_value()) {
+    // Read one group to discover the generation, the remaining groups are read
+    // from the same version of the object.
+    auto generation = ReadGroup(client, request, groups.front(), ranges);
+    if (generation != 0) {
+      request.set_multiple_options(Generation(std::move(generation)));
+    }
+    first = 1;
+  }
+
+  std::atomic<std::size_t> next(first);
+  std::mutex mu;
+  std::exception_ptr exception;
+  auto worker = [&]() {
+    while (true) {
+      auto i = next++;
+      if (i >= groups.size()) {
+        return;
+      }
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+      try {
+        ReadGroup(client, request, groups[i], ranges);
+      } catch (...) {
+        std::lock_guard<std::mutex> lk(mu);
+        if (not exception) {
+          exception = std::current_exception();
+        }
+        // Stop the other workers, the remaining ranges are not read.
+        next = groups.size();
+        return;
+      }
+#else
+      ReadGroup(client, request, groups[i], ranges);
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    }
+  };
+
+  // The threads only live for the duration of this call. Never start more
+  // threads than there are requests left, and the calling thread is also a
+  // worker.
+  auto remaining = groups.size() - first;
+  auto concurrency = (std::min)(options.max_concurrency(), remaining);
+  std::vector<std::thread> workers;
+  for (std::size_t i = 1; i < concurrency; ++i) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto& t : workers) {
+    t.join();
+  }
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+}  // namespace internal
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
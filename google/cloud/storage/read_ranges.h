@@ -0,0 +1,130 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_READ_RANGES_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_READ_RANGES_H_
+
+#include "google/cloud/storage/internal/raw_client.h"
+#include <cstdint>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * A range of bytes to read with `Client::ReadRanges()`.
+ */
+struct ReadRange {
+  ReadRange(std::int64_t o, std::int64_t l, char* b)
+      : offset(o), length(l), buffer(b), bytes_read(0) {}
+
+  /// The offset of the first byte in the object.
+  std::int64_t offset;
+
+  /// The number of bytes to read.
+  std::int64_t length;
+
+  /// Receives the data, the caller must provide at least `length` bytes.
+  char* buffer;
+
+  /**
+   * The number of bytes stored in `buffer`.
+   *
+   * This is less than `length` if the range extends past the end of the
+   * object, and 0 if the range starts at or past the end of the object.
+   */
+  std::int64_t bytes_read;
+};
+
+/**
+ * Configure `Client::ReadRanges()`.
+ */
+class ReadRangesOptions {
+ public:
+  ReadRangesOptions();
+
+  /**
+   * The maximum number of `ReadObject` requests in flight.
+   *
+   * Each call to `Client::ReadRanges()` creates its own threads, and joins
+   * them before returning. It uses at most `max_concurrency() - 1` threads,
+   * in addition to the calling thread, and never more threads than requests.
+   */
+  std::size_t max_concurrency() const { return max_concurrency_; }
+  ReadRangesOptions& set_max_concurrency(std::size_t v);
+
+  /**
+   * Ranges separated by at most this many bytes are read with one request.
+   *
+   * Reading the bytes between the ranges is usually cheaper than the latency
+   * of an additional request.
+   */
+  std::int64_t max_gap() const { return max_gap_; }
+  ReadRangesOptions& set_max_gap(std::int64_t v) {
+    max_gap_ = v;
+    return *this;
+  }
+
+  /// Ranges are not merged into requests larger than this many bytes.
+  std::int64_t max_coalesced_size() const { return max_coalesced_size_; }
+  ReadRangesOptions& set_max_coalesced_size(std::int64_t v) {
+    max_coalesced_size_ = v;
+    return *this;
+  }
+
+ private:
+  std::size_t max_concurrency_;
+  std::int64_t max_gap_;
+  std::int64_t max_coalesced_size_;
+};
+
+namespace internal {
+/// A group of ranges read with a single request.
+struct CoalescedRange {
+  std::int64_t begin;
+  std::int64_t end;
+  /// The indices of the ranges in this group, sorted by offset.
+  std::vector<std::size_t> members;
+};
+
+/**
+ * Group @p ranges into requests.
+ *
+ * Ranges with zero length are ignored, ranges can overlap.
+ */
+std::vector<CoalescedRange> CoalesceRanges(std::vector<ReadRange> const& ranges,
+                                           std::int64_t max_gap,
+                                           std::int64_t max_coalesced_size);
+
+/**
+ * Read @p ranges from the object in @p request.
+ *
+ * If @p request does not include a `Generation` the first request is made
+ * alone, and the other requests use the generation it reports, so all the
+ * data comes from the same version of the object.
+ *
+ * @throw std::runtime_error if any of the requests fails.
+ */
+void ReadRanges(RawClient& client, ReadObjectRangeRequest request,
+                std::vector<ReadRange>& ranges,
+                ReadRangesOptions const& options);
+}  // namespace internal
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_READ_RANGES_H_
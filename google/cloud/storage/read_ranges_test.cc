@@ -0,0 +1,239 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/read_ranges.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/storage/testing/string_read_streambuf.h"
+#include <gmock/gmock.h>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+using internal::CoalesceRanges;
+using internal::ReadObjectRangeRequest;
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Invoke;
+using testing::MockClient;
+using testing::OBJECT_CONTENTS;
+using testing::StringReadStreambuf;
+
+/// Emulate a download for a range that starts past the end of the object.
+class RangeNotSatisfiableStreambuf : public internal::ObjectReadStreambuf {
+ public:
+  internal::HttpResponse Close() override {
+    return internal::HttpResponse{416, {}, {}};
+  }
+  bool IsOpen() const override { return true; }
+  Status status() const override { return Status(416, "out of range"); }
+
+ protected:
+  int_type underflow() override {
+    // Like `CurlReadStreambuf`, the error is reported when reading the data.
+    google::cloud::internal::RaiseRuntimeError("416: out of range");
+  }
+};
+
+/// Emulate `ReadObject` for range requests on `OBJECT_CONTENTS`.
+std::pair<Status, std::unique_ptr<internal::ObjectReadStreambuf>> FakeRead(
+    ReadObjectRangeRequest const& request) {
+  auto begin = static_cast<std::size_t>(request.begin());
+  if (begin >= OBJECT_CONTENTS.size()) {
+    return std::make_pair(Status(),
+                          std::unique_ptr<internal::ObjectReadStreambuf>(
+                              new RangeNotSatisfiableStreambuf));
+  }
+  auto end = (std::min)(static_cast<std::size_t>(request.end()),
+                        OBJECT_CONTENTS.size());
+  return std::make_pair(Status(),
+                        std::unique_ptr<internal::ObjectReadStreambuf>(
+                            new StringReadStreambuf(
+                                OBJECT_CONTENTS.substr(begin, end - begin),
+                                {{"x-goog-generation", "7"}})));
+}
+
+TEST(ReadRangesTest, CoalesceRanges) {
+  std::vector<ReadRange> ranges{
+      {20, 4, nullptr}, {0, 2, nullptr}, {4, 2, nullptr},
+      {8, 0, nullptr},  {5, 3, nullptr}, {100, 10, nullptr},
+  };
+  auto groups = CoalesceRanges(ranges, 2, 1000);
+  ASSERT_EQ(3U, groups.size());
+  EXPECT_EQ(0, groups[0].begin);
+  EXPECT_EQ(8, groups[0].end);
+  EXPECT_THAT(groups[0].members, ElementsAre(1, 2, 4));
+  EXPECT_EQ(20, groups[1].begin);
+  EXPECT_EQ(24, groups[1].end);
+  EXPECT_THAT(groups[1].members, ElementsAre(0));
+  EXPECT_EQ(100, groups[2].begin);
+  EXPECT_EQ(110, groups[2].end);
+  EXPECT_THAT(groups[2].members, ElementsAre(5));
+}
+
+TEST(ReadRangesTest, CoalesceRangesMaxSize) {
+  std::vector<ReadRange> ranges{
+      {0, 4, nullptr}, {4, 4, nullptr}, {8, 4, nullptr}, {12, 4, nullptr}};
+  auto groups = CoalesceRanges(ranges, 100, 8);
+  ASSERT_EQ(2U, groups.size());
+  EXPECT_THAT(groups[0].members, ElementsAre(0, 1));
+  EXPECT_THAT(groups[1].members, ElementsAre(2, 3));
+}
+
+TEST(ReadRangesTest, ReadRanges) {
+  auto mock = std::make_shared<MockClient>();
+  std::mutex mu;
+  std::vector<std::pair<std::int64_t, std::int64_t>> requests;
+  std::vector<std::int64_t> generations;
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillRepeatedly(Invoke([&](ReadObjectRangeRequest const& r) {
+        std::lock_guard<std::mutex> lk(mu);
+        requests.emplace_back(r.begin(), r.end());
+        auto const& g = r.get_option<Generation>();
+        generations.push_back(g.has_value() ? g.value() : 0);
+        return FakeRead(r);
+      }));
+
+  std::vector<char> buffer(64);
+  std::vector<ReadRange> ranges{
+      {30, 10, &buffer[0]},
+      {0, 3, &buffer[10]},
+      {4, 2, &buffer[20]},
+      {16, 2, &buffer[30]},
+  };
+  internal::ReadRanges(*mock, ReadObjectRangeRequest("test-bucket", "test-obj"),
+                       ranges, ReadRangesOptions().set_max_gap(2));
+
+  EXPECT_EQ("012", std::string(ranges[1].buffer, ranges[1].bytes_read));
+  EXPECT_EQ("45", std::string(ranges[2].buffer, ranges[2].bytes_read));
+  EXPECT_EQ("gh", std::string(ranges[3].buffer, ranges[3].bytes_read));
+  // This range extends past the end of the object.
+  EXPECT_EQ("uvwxyz", std::string(ranges[0].buffer, ranges[0].bytes_read));
+
+  ASSERT_EQ(3U, requests.size());
+  // The first request discovers the generation, the others use it.
+  EXPECT_EQ(std::make_pair(std::int64_t(0), std::int64_t(6)), requests[0]);
+  EXPECT_THAT(generations, ElementsAre(0, 7, 7));
+}
+
+TEST(ReadRangesTest, ReadRangesWithGeneration) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ReadObject(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([](ReadObjectRangeRequest const& r) {
+        EXPECT_EQ(3, r.get_option<Generation>().value());
+        return FakeRead(r);
+      }));
+
+  std::vector<char> buffer(16);
+  std::vector<ReadRange> ranges{{0, 4, &buffer[0]}, {20, 4, &buffer[8]}};
+  auto request = ReadObjectRangeRequest("test-bucket", "test-obj");
+  request.set_multiple_options(Generation(3));
+  internal::ReadRanges(*mock, request, ranges,
+                       ReadRangesOptions().set_max_gap(0));
+  EXPECT_EQ("0123", std::string(ranges[0].buffer, ranges[0].bytes_read));
+  EXPECT_EQ("klmn", std::string(ranges[1].buffer, ranges[1].bytes_read));
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+/// @test Verify that ranges past the end of the object are empty, not errors.
+TEST(ReadRangesTest, RangeNotSatisfiable) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ReadObject(_))
+      .Times(3)
+      .WillRepeatedly(Invoke(FakeRead));
+
+  std::vector<char> buffer(32);
+  std::vector<ReadRange> ranges{
+      {0, 4, &buffer[0]},
+      {36, 4, &buffer[8]},
+      {100, 4, &buffer[16]},
+  };
+  internal::ReadRanges(*mock, ReadObjectRangeRequest("test-bucket", "test-obj"),
+                       ranges, ReadRangesOptions().set_max_gap(0));
+  EXPECT_EQ("0123", std::string(ranges[0].buffer, ranges[0].bytes_read));
+  EXPECT_EQ(0, ranges[1].bytes_read);
+  EXPECT_EQ(0, ranges[2].bytes_read);
+}
+
+/// @test Verify that ranges past the end are empty when reported on start.
+TEST(ReadRangesTest, RangeNotSatisfiableOnStart) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ReadObject(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([](ReadObjectRangeRequest const& r) {
+        if (r.begin() >= static_cast<std::int64_t>(OBJECT_CONTENTS.size())) {
+          return std::make_pair(
+              Status(416, "out of range"),
+              std::unique_ptr<internal::ObjectReadStreambuf>());
+        }
+        return FakeRead(r);
+      }));
+
+  std::vector<char> buffer(16);
+  std::vector<ReadRange> ranges{{40, 4, &buffer[0]}, {4, 4, &buffer[8]}};
+  internal::ReadRanges(*mock, ReadObjectRangeRequest("test-bucket", "test-obj"),
+                       ranges, ReadRangesOptions().set_max_gap(0));
+  EXPECT_EQ(0, ranges[0].bytes_read);
+  EXPECT_EQ("4567", std::string(ranges[1].buffer, ranges[1].bytes_read));
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+TEST(ReadRangesTest, Failure) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillRepeatedly(Invoke([](ReadObjectRangeRequest const& r) {
+        if (r.begin() == 0) {
+          return FakeRead(r);
+        }
+        return std::make_pair(
+            testing::canonical_errors::PermanentError(),
+            std::unique_ptr<internal::ObjectReadStreambuf>());
+      }));
+
+  std::vector<char> buffer(16);
+  std::vector<ReadRange> ranges{{0, 4, &buffer[0]}, {20, 4, &buffer[8]}};
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(internal::ReadRanges(
+                   *mock, ReadObjectRangeRequest("test-bucket", "test-obj"),
+                   ranges, ReadRangesOptions().set_max_gap(0)),
+               std::runtime_error);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(
+      internal::ReadRanges(*mock,
+                           ReadObjectRangeRequest("test-bucket", "test-obj"),
+                           ranges, ReadRangesOptions().set_max_gap(0)),
+      "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+TEST(ReadRangesTest, InvalidConcurrency) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(ReadRangesOptions().set_max_concurrency(0),
+               std::invalid_argument);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(ReadRangesOptions().set_max_concurrency(0),
+                            "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
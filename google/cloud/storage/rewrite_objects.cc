@@ -0,0 +1,111 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/rewrite_objects.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace {
+auto constexpr kDefaultMaxConcurrency = 16;
+}  // anonymous namespace
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+RewriteObjectsOptions::RewriteObjectsOptions()
+    : max_concurrency_(kDefaultMaxConcurrency) {}
+
+RewriteObjectsOptions& RewriteObjectsOptions::set_max_concurrency(
+    std::size_t v) {
+  if (v == 0) {
+    google::cloud::internal::RaiseInvalidArgument(
+        "RewriteObjectsOptions::set_max_concurrency() - must be > 0");
+  }
+  max_concurrency_ = v;
+  return *this;
+}
+
+namespace internal {
+std::vector<RewriteObjectsResult> RewriteObjects(
+    std::shared_ptr<RawClient> client, RewriteObjectRequest const& prototype,
+    std::vector<RewriteObjectsEntry> const& entries,
+    RewriteObjectsOptions const& options) {
+  std::vector<RewriteObjectsResult> results(entries.size());
+  if (entries.empty()) {
+    return results;
+  }
+
+  std::mutex mu;
+  auto const& callback = options.progress_callback();
+  auto rewrite = [&](std::size_t i) {
+    auto const& entry = entries[i];
+    RewriteObjectRequest request = prototype;
+    request.set_source_bucket(entry.source_bucket)
+        .set_source_object(entry.source_object)
+        .set_destination_bucket(entry.destination_bucket)
+        .set_destination_object(entry.destination_object);
+    ObjectRewriter rewriter(client, std::move(request));
+    results[i].metadata =
+        rewriter.ResultWithProgressCallback([&](RewriteProgress const& p) {
+          if (callback) {
+            std::lock_guard<std::mutex> lk(mu);
+            callback(i, p);
+          }
+        });
+  };
+
+  std::atomic<std::size_t> next(0);
+  auto worker = [&]() {
+    while (true) {
+      auto i = next++;
+      if (i >= entries.size()) {
+        return;
+      }
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+      try {
+        rewrite(i);
+      } catch (std::exception const& ex) {
+        results[i].error = ex.what();
+      } catch (...) {
+        results[i].error = "unknown exception";
+      }
+#else
+      rewrite(i);
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    }
+  };
+
+  auto concurrency = (std::min)(options.max_concurrency(), entries.size());
+  std::vector<std::thread> workers;
+  // The calling thread is also a worker.
+  for (std::size_t i = 1; i < concurrency; ++i) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto& t : workers) {
+    t.join();
+  }
+  return results;
+}
+}  // namespace internal
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
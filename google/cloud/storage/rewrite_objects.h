@@ -0,0 +1,107 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_REWRITE_OBJECTS_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_REWRITE_OBJECTS_H_
+
+#include "google/cloud/storage/object_rewriter.h"
+#include <functional>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * An object to rewrite with `Client::RewriteObjects()`.
+ */
+struct RewriteObjectsEntry {
+  RewriteObjectsEntry(std::string sb, std::string so, std::string db,
+                      std::string dob)
+      : source_bucket(std::move(sb)),
+        source_object(std::move(so)),
+        destination_bucket(std::move(db)),
+        destination_object(std::move(dob)) {}
+
+  std::string source_bucket;
+  std::string source_object;
+  std::string destination_bucket;
+  std::string destination_object;
+};
+
+/**
+ * The result of rewriting one object with `Client::RewriteObjects()`.
+ */
+struct RewriteObjectsResult {
+  /// The metadata of the destination object, only valid if `ok()`.
+  ObjectMetadata metadata;
+
+  /// A description of the error, empty if the rewrite succeeded.
+  std::string error;
+
+  bool ok() const { return error.empty(); }
+};
+
+/**
+ * Configure `Client::RewriteObjects()`.
+ */
+class RewriteObjectsOptions {
+ public:
+  using ProgressCallback =
+      std::function<void(std::size_t index, RewriteProgress const&)>;
+
+  RewriteObjectsOptions();
+
+  /// The maximum number of rewrites in progress at the same time.
+  std::size_t max_concurrency() const { return max_concurrency_; }
+  RewriteObjectsOptions& set_max_concurrency(std::size_t v);
+
+  /**
+   * Called after each rewrite request, with the index of the entry.
+   *
+   * The callback is called from several threads, but never concurrently.
+   */
+  ProgressCallback const& progress_callback() const {
+    return progress_callback_;
+  }
+  RewriteObjectsOptions& set_progress_callback(ProgressCallback v) {
+    progress_callback_ = std::move(v);
+    return *this;
+  }
+
+ private:
+  std::size_t max_concurrency_;
+  ProgressCallback progress_callback_;
+};
+
+namespace internal {
+/**
+ * Rewrite each object in @p entries, running several rewrites concurrently.
+ *
+ * Each rewrite uses a copy of @p prototype, with the source and destination
+ * from its entry. A failed rewrite does not stop the others, its error is
+ * reported in the corresponding element of the result.
+ */
+std::vector<RewriteObjectsResult> RewriteObjects(
+    std::shared_ptr<RawClient> client, RewriteObjectRequest const& prototype,
+    std::vector<RewriteObjectsEntry> const& entries,
+    RewriteObjectsOptions const& options);
+}  // namespace internal
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_REWRITE_OBJECTS_H_
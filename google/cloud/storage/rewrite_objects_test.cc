@@ -0,0 +1,138 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/rewrite_objects.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include <gmock/gmock.h>
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+using internal::RewriteObjectRequest;
+using internal::RewriteObjectResponse;
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+using testing::MockClient;
+
+/// Emulate a rewrite that takes two requests, unless the source is "fail".
+std::pair<Status, RewriteObjectResponse> FakeRewrite(
+    RewriteObjectRequest const& r) {
+  if (r.source_object() == "fail") {
+    return std::make_pair(testing::canonical_errors::PermanentError(),
+                          RewriteObjectResponse{});
+  }
+  if (r.rewrite_token().empty()) {
+    return std::make_pair(
+        Status(), RewriteObjectResponse{5, 10, false, "token", {}});
+  }
+  ObjectMetadata metadata = ObjectMetadata::ParseFromString(
+      R"""({"bucket": ")""" + r.destination_bucket() + R"""(", "name": ")""" +
+      r.destination_object() + R"""("})""");
+  return std::make_pair(Status(),
+                        RewriteObjectResponse{10, 10, true, "", metadata});
+}
+
+TEST(RewriteObjectsTest, Basic) {
+  auto mock = std::make_shared<MockClient>();
+  std::mutex mu;
+  std::multiset<std::string> user_projects;
+  EXPECT_CALL(*mock, RewriteObject(_))
+      .Times(6)
+      .WillRepeatedly(Invoke([&](RewriteObjectRequest const& r) {
+        std::lock_guard<std::mutex> lk(mu);
+        user_projects.insert(r.get_option<UserProject>().value());
+        return FakeRewrite(r);
+      }));
+
+  std::vector<RewriteObjectsEntry> entries{
+      {"src", "o1", "dst", "d1"},
+      {"src", "o2", "dst", "d2"},
+      {"src", "o3", "dst", "d3"},
+  };
+  std::map<std::size_t, std::vector<std::uint64_t>> progress;
+  RewriteObjectRequest prototype;
+  prototype.set_multiple_options(UserProject("my-project"));
+  auto results = internal::RewriteObjects(
+      mock, prototype, entries,
+      RewriteObjectsOptions().set_max_concurrency(2).set_progress_callback(
+          [&progress](std::size_t index, RewriteProgress const& p) {
+            progress[index].push_back(p.total_bytes_rewritten);
+          }));
+
+  ASSERT_EQ(3U, results.size());
+  for (std::size_t i = 0; i != results.size(); ++i) {
+    EXPECT_TRUE(results[i].ok());
+    EXPECT_EQ("dst", results[i].metadata.bucket());
+    EXPECT_EQ(entries[i].destination_object, results[i].metadata.name());
+    EXPECT_EQ((std::vector<std::uint64_t>{5, 10}), progress[i]);
+  }
+  EXPECT_EQ(6U, user_projects.count("my-project"));
+}
+
+TEST(RewriteObjectsTest, PartialFailure) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, RewriteObject(_)).WillRepeatedly(Invoke(FakeRewrite));
+
+  std::vector<RewriteObjectsEntry> entries{
+      {"src", "o1", "dst", "d1"},
+      {"src", "fail", "dst", "d2"},
+      {"src", "o3", "dst", "d3"},
+  };
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  auto results = internal::RewriteObjects(mock, RewriteObjectRequest(),
+                                          entries, RewriteObjectsOptions());
+  ASSERT_EQ(3U, results.size());
+  EXPECT_TRUE(results[0].ok());
+  EXPECT_FALSE(results[1].ok());
+  EXPECT_THAT(results[1].error, HasSubstr("ObjectRewriter"));
+  EXPECT_TRUE(results[2].ok());
+  EXPECT_EQ("d3", results[2].metadata.name());
+#else
+  EXPECT_DEATH_IF_SUPPORTED(
+      internal::RewriteObjects(mock, RewriteObjectRequest(), entries,
+                               RewriteObjectsOptions()),
+      "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+TEST(RewriteObjectsTest, Empty) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, RewriteObject(_)).Times(0);
+  auto results = internal::RewriteObjects(mock, RewriteObjectRequest(), {},
+                                          RewriteObjectsOptions());
+  EXPECT_TRUE(results.empty());
+}
+
+TEST(RewriteObjectsTest, InvalidConcurrency) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  EXPECT_THROW(RewriteObjectsOptions().set_max_concurrency(0),
+               std::invalid_argument);
+#else
+  EXPECT_DEATH_IF_SUPPORTED(RewriteObjectsOptions().set_max_concurrency(0),
+                            "exceptions are disabled");
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -1,22 +1,31 @@
 # DO NOT EDIT -- GENERATED BY CMake -- Change the CMakeLists.txt file if needed
 storage_client_HDRS = [
+    "batch.h",
     "bucket_access_control.h",
     "bucket_metadata.h",
     "client.h",
     "client_options.h",
+    "compression_options.h",
     "credentials.h",
+    "hashing_options.h",
     "internal/access_control_common.h",
     "internal/authorized_user_credentials.h",
+    "internal/batch_request.h",
     "internal/binary_data_as_debug_string.h",
     "internal/bucket_acl_requests.h",
     "internal/bucket_requests.h",
     "internal/raw_client_wrapper_utils.h",
     "internal/common_metadata.h",
+    "internal/complex_option.h",
+    "internal/crc32c.h",
     "internal/credential_constants.h",
     "internal/curl_handle.h",
     "internal/curl_download_request.h",
+    "internal/curl_download_pipeline.h",
     "internal/curl_request.h",
     "internal/curl_request_builder.h",
+    "internal/curl_share.h",
+    "internal/curl_upload_pipeline.h",
     "internal/curl_upload_request.h",
     "internal/curl_wrappers.h",
     "internal/curl_client.h",
@@ -28,29 +37,47 @@ storage_client_HDRS = [
     "internal/generic_request.h",
     "internal/get_object_metadata_request.h",
     "internal/google_application_default_credentials_file.h",
+    "internal/gzip_codec.h",
+    "internal/hash_validator.h",
     "internal/http_response.h",
     "internal/insert_object_media_request.h",
+    "internal/json_items_parser.h",
+    "internal/latency_tracker.h",
     "internal/list_object_acl_request.h",
+    "internal/list_objects_prefetcher.h",
     "internal/list_objects_request.h",
     "internal/logging_client.h",
     "internal/metadata_parser.h",
+    "internal/metrics_client.h",
     "internal/nljson.h",
     "internal/openssl_util.h",
     "internal/object_acl_requests.h",
+    "internal/object_disk_cache.h",
+    "internal/object_disk_cache_client.h",
+    "internal/object_metadata_cache.h",
+    "internal/object_metadata_cache_client.h",
     "internal/object_streambuf.h",
     "internal/parse_rfc3339.h",
     "internal/patch_builder.h",
     "internal/raw_client.h",
     "internal/read_object_range_request.h",
     "internal/retry_client.h",
+    "internal/retry_object_read_streambuf.h",
+    "internal/rewrite_object_requests.h",
+    "internal/seekable_object_read_streambuf.h",
     "internal/service_account_credentials.h",
     "lifecycle_rule.h",
     "list_buckets_reader.h",
     "list_objects_reader.h",
     "object_access_control.h",
     "object_metadata.h",
+    "object_rewriter.h",
     "object_stream.h",
+    "parallel_list_objects_reader.h",
+    "random_access_options.h",
+    "read_ranges.h",
     "retry_policy.h",
+    "rewrite_objects.h",
     "status.h",
     "storage_class.h",
     "version.h",
@@ -59,19 +86,25 @@ storage_client_HDRS = [
 ]
 
 storage_client_SRCS = [
+    "batch.cc",
     "bucket_access_control.cc",
     "bucket_metadata.cc",
     "client.cc",
     "client_options.cc",
     "credentials.cc",
     "internal/access_control_common.cc",
+    "internal/batch_request.cc",
     "internal/binary_data_as_debug_string.cc",
     "internal/bucket_acl_requests.cc",
     "internal/bucket_requests.cc",
+    "internal/crc32c.cc",
     "internal/curl_handle.cc",
+    "internal/curl_download_pipeline.cc",
     "internal/curl_download_request.cc",
     "internal/curl_request.cc",
     "internal/curl_request_builder.cc",
+    "internal/curl_share.cc",
+    "internal/curl_upload_pipeline.cc",
     "internal/curl_upload_request.cc",
     "internal/curl_wrappers.cc",
     "internal/curl_client.cc",
@@ -81,21 +114,39 @@ storage_client_SRCS = [
     "internal/format_rfc3339.cc",
     "internal/get_object_metadata_request.cc",
     "internal/google_application_default_credentials_file.cc",
+    "internal/gzip_codec.cc",
+    "internal/hash_validator.cc",
     "internal/insert_object_media_request.cc",
+    "internal/json_items_parser.cc",
+    "internal/latency_tracker.cc",
     "internal/list_object_acl_request.cc",
+    "internal/list_objects_prefetcher.cc",
     "internal/list_objects_request.cc",
     "internal/logging_client.cc",
     "internal/metadata_parser.cc",
+    "internal/metrics_client.cc",
     "internal/object_acl_requests.cc",
+    "internal/object_disk_cache.cc",
+    "internal/object_disk_cache_client.cc",
+    "internal/object_metadata_cache.cc",
+    "internal/object_metadata_cache_client.cc",
     "internal/object_streambuf.cc",
     "internal/parse_rfc3339.cc",
     "internal/read_object_range_request.cc",
     "internal/retry_client.cc",
+    "internal/retry_object_read_streambuf.cc",
+    "internal/rewrite_object_requests.cc",
+    "internal/seekable_object_read_streambuf.cc",
     "lifecycle_rule.cc",
     "list_buckets_reader.cc",
     "list_objects_reader.cc",
     "object_access_control.cc",
     "object_metadata.cc",
+    "object_rewriter.cc",
     "object_stream.cc",
+    "parallel_list_objects_reader.cc",
+    "random_access_options.cc",
+    "read_ranges.cc",
+    "rewrite_objects.cc",
     "version.cc",
 ]
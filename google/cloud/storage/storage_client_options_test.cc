@@ -99,6 +99,39 @@ TEST_F(ClientOptionsTest, ProjectIdFromEnvironment) {
   EXPECT_EQ("test-project-id", options.project_id());
 }
 
+TEST_F(ClientOptionsTest, ObjectMetadataCache) {
+  ClientOptions options(CreateInsecureCredentials());
+  EXPECT_EQ(0U, options.object_metadata_cache_size());
+  options.set_object_metadata_cache_size(100).set_object_metadata_cache_ttl(
+      std::chrono::seconds(3));
+  EXPECT_EQ(100U, options.object_metadata_cache_size());
+  EXPECT_EQ(std::chrono::seconds(3), options.object_metadata_cache_ttl());
+}
+
+TEST_F(ClientOptionsTest, ObjectDiskCache) {
+  ClientOptions options(CreateInsecureCredentials());
+  EXPECT_EQ("", options.object_disk_cache_directory());
+  EXPECT_LT(0, options.object_disk_cache_max_size());
+  options.set_object_disk_cache_directory("/var/cache/gcs")
+      .set_object_disk_cache_max_size(1024);
+  EXPECT_EQ("/var/cache/gcs", options.object_disk_cache_directory());
+  EXPECT_EQ(1024, options.object_disk_cache_max_size());
+}
+
+TEST_F(ClientOptionsTest, UploadPipelineDepth) {
+  ClientOptions options(CreateInsecureCredentials());
+  EXPECT_LT(0U, options.upload_pipeline_depth());
+  options.set_upload_pipeline_depth(8);
+  EXPECT_EQ(8U, options.upload_pipeline_depth());
+}
+
+TEST_F(ClientOptionsTest, DownloadReadAhead) {
+  ClientOptions options(CreateInsecureCredentials());
+  EXPECT_EQ(0U, options.download_read_ahead());
+  options.set_download_read_ahead(4);
+  EXPECT_EQ(4U, options.download_read_ahead());
+}
+
 TEST_F(ClientOptionsTest, ProjectIdFromEnvironmentNotSet) {
   google::cloud::internal::UnsetEnv("GOOGLE_CLOUD_PROJECT");
   ClientOptions options(CreateInsecureCredentials());
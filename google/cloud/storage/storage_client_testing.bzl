@@ -1,11 +1,14 @@
 # DO NOT EDIT -- GENERATED BY CMake -- Change the CMakeLists.txt file if needed
 storage_client_testing_HDRS = [
     "testing/canonical_errors.h",
+    "testing/fake_http_server.h",
     "testing/mock_client.h",
     "testing/mock_http_request.h",
     "testing/retry_tests.h",
+    "testing/string_read_streambuf.h",
 ]
 
 storage_client_testing_SRCS = [
+    "testing/fake_http_server.cc",
     "testing/mock_http_request.cc",
 ]
@@ -3,6 +3,7 @@ storage_client_unit_tests = [
     "bucket_access_control_test.cc",
     "bucket_metadata_test.cc",
     "bucket_test.cc",
+    "client_batch_test.cc",
     "client_bucket_acl_test.cc",
     "client_object_acl_test.cc",
     "client_test.cc",
@@ -10,24 +11,40 @@ storage_client_unit_tests = [
     "credentials_test.cc",
     "internal/access_control_common_test.cc",
     "internal/authorized_user_credentials_test.cc",
+    "internal/batch_request_test.cc",
     "internal/binary_data_as_debug_string_test.cc",
     "internal/bucket_acl_requests_test.cc",
     "internal/bucket_requests_test.cc",
     "internal/delete_object_request_test.cc",
+    "internal/crc32c_test.cc",
+    "internal/curl_download_pipeline_test.cc",
+    "internal/curl_download_request_test.cc",
+    "internal/curl_upload_pipeline_test.cc",
     "internal/format_rfc3339_test.cc",
     "internal/get_object_metadata_request_test.cc",
     "internal/google_application_default_credentials_file_test.cc",
+    "internal/gzip_codec_test.cc",
+    "internal/hash_validator_test.cc",
     "internal/insert_object_media_request_test.cc",
+    "internal/json_items_parser_test.cc",
+    "internal/latency_tracker_test.cc",
     "internal/list_object_acl_request_test.cc",
     "internal/list_objects_request_test.cc",
     "internal/logging_client_test.cc",
     "internal/metadata_parser_test.cc",
+    "internal/metrics_client_test.cc",
     "internal/nljson_test.cc",
     "internal/object_acl_requests_test.cc",
+    "internal/object_disk_cache_client_test.cc",
+    "internal/object_disk_cache_test.cc",
+    "internal/object_metadata_cache_client_test.cc",
     "internal/parse_rfc3339_test.cc",
     "internal/patch_builder_test.cc",
     "internal/retry_client_test.cc",
+    "internal/retry_object_read_streambuf_test.cc",
     "internal/read_object_range_request_test.cc",
+    "internal/rewrite_object_requests_test.cc",
+    "internal/seekable_object_read_streambuf_test.cc",
     "internal/service_account_credentials_test.cc",
     "lifecycle_rule_test.cc",
     "list_buckets_reader_test.cc",
@@ -35,7 +52,10 @@ storage_client_unit_tests = [
     "object_access_control_test.cc",
     "object_metadata_test.cc",
     "object_test.cc",
+    "parallel_list_objects_reader_test.cc",
+    "read_ranges_test.cc",
     "retry_policy_test.cc",
+    "rewrite_objects_test.cc",
     "storage_class_test.cc",
     "storage_client_options_test.cc",
     "link_test.cc",
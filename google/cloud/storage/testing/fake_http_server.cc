@@ -0,0 +1,386 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/testing/fake_http_server.h"
+#include "google/cloud/internal/throw_delegate.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+namespace testing {
+namespace {
+#ifdef MSG_NOSIGNAL
+int const kSendFlags = MSG_NOSIGNAL;
+#else
+int const kSendFlags = 0;
+#endif  // MSG_NOSIGNAL
+
+/// The interval to check if the server was shutdown while waiting for clients.
+constexpr int kAcceptPollMillis = 50;
+
+[[noreturn]] void RaiseSystemError(char const* where) {
+  std::string msg = where;
+  msg += ": ";
+  msg += std::strerror(errno);
+  google::cloud::internal::RaiseRuntimeError(msg);
+}
+
+/// Create a socket listening on an ephemeral loopback port.
+int ListenOnLoopback(int& port) {
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    RaiseSystemError("socket()");
+  }
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0;
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) !=
+      0) {
+    ::close(fd);
+    RaiseSystemError("bind()");
+  }
+  if (::listen(fd, SOMAXCONN) != 0) {
+    ::close(fd);
+    RaiseSystemError("listen()");
+  }
+  socklen_t length = sizeof(address);
+  if (::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+    ::close(fd);
+    RaiseSystemError("getsockname()");
+  }
+  port = ntohs(address.sin_port);
+  return fd;
+}
+
+std::string LoopbackUrl(int port) {
+  return "http://127.0.0.1:" + std::to_string(port);
+}
+
+std::string UrlDecode(std::string const& value) {
+  std::string result;
+  result.reserve(value.size());
+  for (std::size_t i = 0; i < value.size(); ++i) {
+    if (value[i] == '%' and i + 2 < value.size()) {
+      result += static_cast<char>(
+          std::strtol(value.substr(i + 1, 2).c_str(), nullptr, 16));
+      i += 2;
+    } else if (value[i] == '+') {
+      result += ' ';
+    } else {
+      result += value[i];
+    }
+  }
+  return result;
+}
+}  // namespace
+
+std::string FakeHttpConnection::ReadRequestHeaders() {
+  if (not ReadUntil("\r\n\r\n")) {
+    std::string partial;
+    partial.swap(buffer_);
+    return partial;
+  }
+  auto end = buffer_.find("\r\n\r\n") + 4;
+  std::string headers = buffer_.substr(0, end);
+  buffer_.erase(0, end);
+  std::string lower = headers;
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](char c) { return static_cast<char>(std::tolower(c)); });
+  if (lower.find("expect: 100-continue") != std::string::npos) {
+    Write("HTTP/1.1 100 Continue\r\n\r\n");
+  }
+  return headers;
+}
+
+std::string FakeHttpConnection::ReadChunkedBody() {
+  std::string body;
+  std::int64_t size;
+  ReadChunks(&body, size);
+  return body;
+}
+
+bool FakeHttpConnection::ReadRequest(FakeHttpRequest& request) {
+  std::string line;
+  if (not ReadLine(line)) {
+    return false;
+  }
+  std::istringstream request_line(line);
+  std::string target;
+  request_line >> request.method >> target;
+  auto qpos = target.find('?');
+  request.path = UrlDecode(target.substr(0, qpos));
+  request.query.clear();
+  if (qpos != std::string::npos) {
+    std::istringstream query(target.substr(qpos + 1));
+    std::string parameter;
+    while (std::getline(query, parameter, '&')) {
+      auto eq = parameter.find('=');
+      std::string value;
+      if (eq != std::string::npos) {
+        value = UrlDecode(parameter.substr(eq + 1));
+      }
+      request.query[parameter.substr(0, eq)] = std::move(value);
+    }
+  }
+
+  request.headers.clear();
+  while (true) {
+    if (not ReadLine(line)) {
+      return false;
+    }
+    if (line.empty()) {
+      break;
+    }
+    auto colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    std::string name = line.substr(0, colon);
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](char c) { return static_cast<char>(std::tolower(c)); });
+    auto value_start = line.find_first_not_of(' ', colon + 1);
+    request.headers[name] = value_start == std::string::npos
+                                ? std::string{}
+                                : line.substr(value_start);
+  }
+
+  auto expect = request.headers.find("expect");
+  if (expect != request.headers.end() and expect->second == "100-continue") {
+    if (not Write("HTTP/1.1 100 Continue\r\n\r\n")) {
+      return false;
+    }
+  }
+
+  request.body_size = 0;
+  auto te = request.headers.find("transfer-encoding");
+  if (te != request.headers.end() and te->second == "chunked") {
+    return ReadChunks(nullptr, request.body_size);
+  }
+  auto cl = request.headers.find("content-length");
+  if (cl != request.headers.end()) {
+    request.body_size = std::strtoll(cl->second.c_str(), nullptr, 10);
+  }
+  return Discard(request.body_size);
+}
+
+bool FakeHttpConnection::Write(char const* data, std::size_t size) {
+  while (size != 0) {
+    auto n = ::send(fd_, data, size, kSendFlags);
+    if (n < 0 and errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    data += n;
+    size -= static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+void FakeHttpConnection::WaitForShutdown() {
+  std::unique_lock<std::mutex> lk(server_.mu_);
+  server_.cv_.wait(lk, [this] { return server_.shutdown_; });
+}
+
+bool FakeHttpConnection::Fill() {
+  char tmp[64 * 1024];
+  while (true) {
+    auto n = ::recv(fd_, tmp, sizeof(tmp), 0);
+    if (n < 0 and errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    buffer_.append(tmp, static_cast<std::size_t>(n));
+    return true;
+  }
+}
+
+bool FakeHttpConnection::ReadUntil(std::string const& terminator) {
+  while (buffer_.find(terminator) == std::string::npos) {
+    if (not Fill()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FakeHttpConnection::ReadAtLeast(std::size_t size) {
+  while (buffer_.size() < size) {
+    if (not Fill()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FakeHttpConnection::ReadLine(std::string& line) {
+  if (not ReadUntil("\r\n")) {
+    return false;
+  }
+  auto eol = buffer_.find("\r\n");
+  line = buffer_.substr(0, eol);
+  buffer_.erase(0, eol + 2);
+  return true;
+}
+
+bool FakeHttpConnection::Discard(std::int64_t size) {
+  while (size > 0) {
+    if (buffer_.empty() and not Fill()) {
+      return false;
+    }
+    auto n = (std::min)(static_cast<std::size_t>(size), buffer_.size());
+    buffer_.erase(0, n);
+    size -= static_cast<std::int64_t>(n);
+  }
+  return true;
+}
+
+bool FakeHttpConnection::ReadChunks(std::string* body, std::int64_t& size) {
+  size = 0;
+  std::string line;
+  while (ReadLine(line)) {
+    auto chunk_size = std::strtoll(line.c_str(), nullptr, 16);
+    if (chunk_size == 0) {
+      // Skip any trailers, up to the empty line.
+      do {
+        if (not ReadLine(line)) {
+          return false;
+        }
+      } while (not line.empty());
+      return true;
+    }
+    // Each chunk is followed by a CRLF.
+    if (body == nullptr) {
+      if (not Discard(chunk_size + 2)) {
+        return false;
+      }
+    } else {
+      auto length = static_cast<std::size_t>(chunk_size);
+      if (not ReadAtLeast(length + 2)) {
+        return false;
+      }
+      body->append(buffer_, 0, length);
+      buffer_.erase(0, length + 2);
+    }
+    size += chunk_size;
+  }
+  return false;
+}
+
+FakeHttpServer::FakeHttpServer(Handler handler)
+    : handler_(std::move(handler)),
+      port_(0),
+      listen_fd_(ListenOnLoopback(port_)),
+      shutdown_(false),
+      active_connections_(0) {
+  // Start the thread only after all the other members are initialized.
+  thread_ = std::thread(&FakeHttpServer::Run, this);
+}
+
+FakeHttpServer::~FakeHttpServer() {
+  Shutdown();
+  thread_.join();
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return active_connections_ == 0; });
+  }
+  ::close(listen_fd_);
+}
+
+std::string FakeHttpServer::url() const { return LoopbackUrl(port_); }
+
+void FakeHttpServer::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+    // Unblock any handler waiting for data from the client.
+    for (int fd : connection_fds_) {
+      ::shutdown(fd, SHUT_RDWR);
+    }
+  }
+  cv_.notify_all();
+}
+
+void FakeHttpServer::Run() {
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      if (shutdown_) {
+        return;
+      }
+    }
+    pollfd pfd{listen_fd_, POLLIN, 0};
+    if (::poll(&pfd, 1, kAcceptPollMillis) <= 0) {
+      continue;
+    }
+    int fd = ::accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) {
+      continue;
+    }
+    std::lock_guard<std::mutex> lk(mu_);
+    if (shutdown_) {
+      ::close(fd);
+      return;
+    }
+    // The clients may open many short-lived connections, the threads are
+    // detached so they release their resources as soon as they finish.
+    // `active_connections_` tracks them for the destructor.
+    std::thread([this, fd] { HandleConnection(fd); }).detach();
+    connection_fds_.insert(fd);
+    ++active_connections_;
+  }
+}
+
+void FakeHttpServer::HandleConnection(int fd) {
+  {
+    FakeHttpConnection connection(*this, fd);
+    handler_(connection);
+  }
+  std::lock_guard<std::mutex> lk(mu_);
+  connection_fds_.erase(fd);
+  ::close(fd);
+  --active_connections_;
+  // Notify while holding the lock, the server may be destroyed as soon as the
+  // last connection finishes.
+  cv_.notify_all();
+}
+
+std::string UnusedLoopbackUrl() {
+  // Bind to an ephemeral port and release it, nothing listens there after the
+  // socket is closed.
+  int port;
+  int fd = ListenOnLoopback(port);
+  ::close(fd);
+  return LoopbackUrl(port);
+}
+
+}  // namespace testing
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,157 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TESTING_FAKE_HTTP_SERVER_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TESTING_FAKE_HTTP_SERVER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+namespace testing {
+class FakeHttpServer;
+
+/// The parts of a request returned by `FakeHttpConnection::ReadRequest()`.
+struct FakeHttpRequest {
+  std::string method;
+  /// The path, without the query string, and URL-decoded.
+  std::string path;
+  /// The query parameters, URL-decoded.
+  std::map<std::string, std::string> query;
+  /// The request headers, the names are converted to lowercase.
+  std::map<std::string, std::string> headers;
+  /// The size of the request body, the body itself is discarded.
+  std::int64_t body_size = 0;
+};
+
+/**
+ * A connection accepted by `FakeHttpServer`.
+ *
+ * The handlers use this class to read the request and write raw bytes as the
+ * response, so the tests control exactly what the libcurl classes receive,
+ * including truncated responses and connections that never respond.
+ */
+class FakeHttpConnection {
+ public:
+  /**
+   * Read the request line and headers.
+   *
+   * If the request contains `Expect: 100-continue` the interim response is
+   * sent before returning, so the client starts sending the body.
+   */
+  std::string ReadRequestHeaders();
+
+  /**
+   * Read a body sent with chunked transfer encoding.
+   *
+   * @return the data received, stops early if the client closes the
+   *     connection.
+   */
+  std::string ReadChunkedBody();
+
+  /**
+   * Read a complete request, discarding its body.
+   *
+   * Both chunked and `Content-Length` bodies are supported.
+   *
+   * @return false if the connection is closed before the request is complete.
+   */
+  bool ReadRequest(FakeHttpRequest& request);
+
+  /// Send @p data to the client, return false on errors.
+  bool Write(std::string const& data) {
+    return Write(data.data(), data.size());
+  }
+  bool Write(char const* data, std::size_t size);
+
+  /// Block until the server is shutdown.
+  void WaitForShutdown();
+
+ private:
+  friend class FakeHttpServer;
+  FakeHttpConnection(FakeHttpServer& server, int fd)
+      : server_(server), fd_(fd) {}
+
+  bool Fill();
+  bool ReadUntil(std::string const& terminator);
+  bool ReadAtLeast(std::size_t size);
+  bool ReadLine(std::string& line);
+  bool Discard(std::int64_t size);
+  /// Read a chunked body, appending the data to @p body if not null.
+  bool ReadChunks(std::string* body, std::int64_t& size);
+
+  FakeHttpServer& server_;
+  int fd_;
+  std::string buffer_;
+};
+
+/**
+ * A minimal HTTP server on the loopback interface.
+ *
+ * The server accepts connections in a background thread and calls the handler
+ * for each one, in a separate thread. The connection is closed when the
+ * handler returns. `Shutdown()` and the destructor unblock any handler waiting
+ * for the client or in `FakeHttpConnection::WaitForShutdown()`, and the
+ * destructor waits until all the handlers return.
+ */
+class FakeHttpServer {
+ public:
+  using Handler = std::function<void(FakeHttpConnection&)>;
+
+  explicit FakeHttpServer(Handler handler);
+  ~FakeHttpServer();
+
+  FakeHttpServer(FakeHttpServer const&) = delete;
+  FakeHttpServer& operator=(FakeHttpServer const&) = delete;
+
+  /// The URL to reach this server, e.g. `http://127.0.0.1:12345`.
+  std::string url() const;
+
+  /// Stop accepting connections and unblock the handlers, does not wait.
+  void Shutdown();
+
+ private:
+  friend class FakeHttpConnection;
+  void Run();
+  void HandleConnection(int fd);
+
+  Handler handler_;
+  int port_;
+  int listen_fd_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool shutdown_;
+  std::set<int> connection_fds_;
+  int active_connections_;
+  std::thread thread_;
+};
+
+/// Return a loopback URL where no server is listening.
+std::string UnusedLoopbackUrl();
+
+}  // namespace testing
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TESTING_FAKE_HTTP_SERVER_H_
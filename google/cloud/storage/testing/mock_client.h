@@ -56,6 +56,11 @@ class MockClient : public google::cloud::storage::internal::RawClient {
                                 internal::ListObjectsRequest const&));
   MOCK_METHOD1(DeleteObject, ResponseWrapper<internal::EmptyResponse>(
                                  internal::DeleteObjectRequest const&));
+  MOCK_METHOD1(CopyObject, ResponseWrapper<ObjectMetadata>(
+                               internal::CopyObjectRequest const&));
+  MOCK_METHOD1(RewriteObject,
+               ResponseWrapper<internal::RewriteObjectResponse>(
+                   internal::RewriteObjectRequest const&));
 
   MOCK_METHOD1(ListBucketAcl, ResponseWrapper<internal::ListBucketAclResponse>(
                                   internal::ListBucketAclRequest const&));
@@ -72,6 +77,8 @@ class MockClient : public google::cloud::storage::internal::RawClient {
                                     internal::UpdateObjectAclRequest const&));
   MOCK_METHOD1(PatchObjectAcl, ResponseWrapper<ObjectAccessControl>(
                                    internal::PatchObjectAclRequest const&));
+  MOCK_METHOD1(ExecuteBatch, ResponseWrapper<internal::BatchResponse>(
+                                 internal::BatchRequest const&));
 };
 }  // namespace testing
 }  // namespace storage
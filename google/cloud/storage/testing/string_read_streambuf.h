@@ -0,0 +1,62 @@
+// Copyright 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TESTING_STRING_READ_STREAMBUF_H_
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TESTING_STRING_READ_STREAMBUF_H_
+
+#include "google/cloud/storage/internal/object_streambuf.h"
+#include <map>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+namespace testing {
+/// The contents of the object used in the tests that read ranges of data.
+std::string const OBJECT_CONTENTS = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+/**
+ * A streambuf returning a fixed string, like a completed download.
+ *
+ * Use it to return the data from mocked `RawClient::ReadObject()` calls.
+ */
+class StringReadStreambuf : public internal::ObjectReadStreambuf {
+ public:
+  explicit StringReadStreambuf(
+      std::string contents,
+      std::multimap<std::string, std::string> headers = {})
+      : contents_(std::move(contents)), headers_(std::move(headers)) {
+    char* data = &contents_[0];
+    setg(data, data, data + contents_.size());
+  }
+
+  internal::HttpResponse Close() override {
+    return internal::HttpResponse{200, {}, {}};
+  }
+  bool IsOpen() const override { return false; }
+  std::multimap<std::string, std::string> headers() const override {
+    return headers_;
+  }
+
+ private:
+  std::string contents_;
+  std::multimap<std::string, std::string> headers_;
+};
+
+}  // namespace testing
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_TESTING_STRING_READ_STREAMBUF_H_
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/log.h"
+#include "google/cloud/storage/internal/curl_download_pipeline.h"
 #include "google/cloud/storage/internal/curl_request_builder.h"
 #include <gmock/gmock.h>
 #include <cstdlib>
@@ -71,6 +72,64 @@ TEST(CurlDownloadRequestTest, SimpleStream) {
   EXPECT_EQ(kDownloadedLines, count);
 }
 
+TEST(CurlDownloadRequestTest, ReadAhead) {
+  constexpr int kDownloadedLines = 100;
+  storage::internal::CurlRequestBuilder request(
+      HttpBinEndpoint() + "/stream/" + std::to_string(kDownloadedLines));
+
+  CurlDownloadPipeline download(request.BuildDownloadRequest(std::string{}),
+                                4);
+
+  HttpResponse response;
+  std::string buffer;
+  int count = 0;
+  do {
+    EXPECT_TRUE(download.IsOpen());
+    response = download.GetMore(buffer);
+    count += std::count(buffer.begin(), buffer.end(), '\n');
+  } while (response.status_code == 100);
+
+  EXPECT_EQ(200, response.status_code) << ", payload=" << response.payload;
+  EXPECT_FALSE(download.IsOpen());
+  EXPECT_EQ(kDownloadedLines, count);
+}
+
+TEST(CurlDownloadRequestTest, FirstByteTimeout) {
+  // httpbin delays the response for the given number of seconds.
+  storage::internal::CurlRequestBuilder request(HttpBinEndpoint() +
+                                                "/delay/10");
+  request.SetStallDetection(std::chrono::milliseconds(500),
+                            std::chrono::milliseconds(0), 0);
+  auto download = request.BuildDownloadRequest(std::string{});
+
+  auto start = std::chrono::steady_clock::now();
+  std::string buffer;
+  auto response = download.GetMore(buffer);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_EQ(503, response.status_code) << ", payload=" << response.payload;
+  EXPECT_THAT(response.payload, HasSubstr("stalled"));
+  EXPECT_TRUE(download.stalled());
+  EXPECT_LT(elapsed, std::chrono::seconds(5));
+}
+
+TEST(CurlDownloadRequestTest, StallTimeout) {
+  // httpbin sends the bytes over the given duration, that is well below the
+  // minimum rate.
+  storage::internal::CurlRequestBuilder request(
+      HttpBinEndpoint() + "/drip?duration=10&numbytes=10&delay=0");
+  request.SetStallDetection(std::chrono::milliseconds(0),
+                            std::chrono::milliseconds(1000), 1024);
+  auto download = request.BuildDownloadRequest(std::string{});
+
+  HttpResponse response;
+  std::string buffer;
+  do {
+    response = download.GetMore(buffer);
+  } while (response.status_code == 100);
+  EXPECT_EQ(503, response.status_code) << ", payload=" << response.payload;
+  EXPECT_TRUE(download.stalled());
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
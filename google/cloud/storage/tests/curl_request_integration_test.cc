@@ -17,6 +17,7 @@
 #include "google/cloud/storage/internal/nljson.h"
 #include <gmock/gmock.h>
 #include <cstdlib>
+#include <thread>
 #include <vector>
 
 namespace storage = google::cloud::storage;
@@ -48,6 +49,36 @@ TEST(CurlRequestTest, SimpleGET) {
   EXPECT_EQ("bar1==bar2=", args["bar"].get<std::string>());
 }
 
+TEST(CurlRequestTest, SharedHandles) {
+  auto share = std::make_shared<storage::internal::CurlShare>();
+  auto make_request = [&share](int i) {
+    storage::internal::CurlRequestBuilder request(HttpBinEndpoint() + "/get");
+    request.SetCurlShare(share);
+    request.AddQueryParameter("i", std::to_string(i));
+    return request.BuildRequest(std::string{});
+  };
+  std::vector<storage::internal::CurlRequest> requests;
+  for (int i = 0; i != 8; ++i) {
+    requests.emplace_back(make_request(i));
+  }
+  // The requests can use the share concurrently, and outlive the original
+  // pointer.
+  share.reset();
+  std::vector<std::thread> threads;
+  std::vector<long> codes(requests.size());
+  for (std::size_t i = 0; i != requests.size(); ++i) {
+    threads.emplace_back([&requests, &codes, i] {
+      codes[i] = requests[i].MakeRequest().status_code;
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto code : codes) {
+    EXPECT_EQ(200, code);
+  }
+}
+
 TEST(CurlRequestTest, FailedGET) {
   // This test fails if somebody manages to run a https server on port 0 (you
   // can't, but just documenting the assumptions in this test).
@@ -36,8 +36,10 @@ std::string HttpBinEndpoint() {
 TEST(CurlStreambufIntegrationTest, WriteManyBytes) {
   internal::CurlRequestBuilder builder(HttpBinEndpoint() + "/post");
   builder.AddHeader("Content-Type: application/octet-stream");
-  std::unique_ptr<internal::CurlStreambuf> buf(
-      new internal::CurlStreambuf(builder.BuildUpload(), 128 * 1024));
+  std::unique_ptr<internal::CurlStreambuf> buf(new internal::CurlStreambuf(
+      builder.BuildUpload(), 128 * 1024, 2,
+      std::unique_ptr<internal::HashValidator>(new internal::NullHashValidator),
+      std::unique_ptr<internal::GzipCompressor>()));
   ObjectWriteStream writer(std::move(buf));
 
   auto generator = google::cloud::internal::MakeDefaultPRNG();
@@ -196,6 +196,208 @@ TEST_F(ObjectIntegrationTest, StreamingWriteAutoClose) {
   client.DeleteObject(bucket_name, object_name);
 }
 
+TEST_F(ObjectIntegrationTest, StreamingHashes) {
+  Client client;
+  auto bucket_name = ObjectTestEnvironment::bucket_name();
+  auto object_name = MakeRandomObjectName();
+
+  std::string expected = "The quick brown fox jumps over the lazy dog";
+
+  auto os = client.WriteObject(bucket_name, object_name, IfGenerationMatch(0),
+                               EnableMD5Hash(true));
+  os << expected;
+  ObjectMetadata meta = os.Close();
+  EXPECT_EQ("crc32c=ImIEBA==,md5=nhB9nTcrtoJr2B01QqQZ1g==",
+            os.computed_hash());
+  EXPECT_EQ(os.computed_hash(), os.received_hash()) << " meta=" << meta;
+
+  auto stream =
+      client.ReadObject(bucket_name, object_name, EnableMD5Hash(true));
+  std::string actual(std::istreambuf_iterator<char>{stream}, {});
+  EXPECT_EQ(expected, actual);
+  EXPECT_FALSE(stream.bad());
+  EXPECT_EQ(os.computed_hash(), stream.computed_hash());
+  EXPECT_EQ(stream.computed_hash(), stream.received_hash());
+
+  client.DeleteObject(bucket_name, object_name);
+}
+
+TEST_F(ObjectIntegrationTest, StreamingGzip) {
+  Client client;
+  auto bucket_name = ObjectTestEnvironment::bucket_name();
+  auto object_name = MakeRandomObjectName();
+
+  std::string expected;
+  for (int line = 0; line != 1000; ++line) {
+    expected += std::to_string(line) + ": a very compressible line\n";
+  }
+
+  auto os = client.WriteObject(bucket_name, object_name, IfGenerationMatch(0),
+                               EnableGzipCompression(true));
+  os << expected;
+  ObjectMetadata meta = os.Close();
+  EXPECT_EQ("gzip", meta.content_encoding());
+  EXPECT_GT(expected.size() / 4, meta.size());
+
+  // Download the compressed data and decompress it locally.
+  auto compressed = client.ReadObject(bucket_name, object_name,
+                                      EnableGzipDecompression(true));
+  std::string actual(std::istreambuf_iterator<char>{compressed}, {});
+  EXPECT_EQ(expected, actual);
+  EXPECT_EQ(os.computed_hash(), compressed.computed_hash());
+
+  // The service decompresses the data for clients that do not accept gzip.
+  auto transcoded = client.ReadObject(bucket_name, object_name);
+  actual.assign(std::istreambuf_iterator<char>{transcoded}, {});
+  EXPECT_EQ(expected, actual);
+
+  client.DeleteObject(bucket_name, object_name);
+}
+
+TEST_F(ObjectIntegrationTest, ReadRanges) {
+  Client client;
+  auto bucket_name = ObjectTestEnvironment::bucket_name();
+  auto object_name = MakeRandomObjectName();
+
+  std::string expected;
+  for (int line = 0; line != 1000; ++line) {
+    expected += std::to_string(line) + ": some data for range reads\n";
+  }
+  (void)client.InsertObject(bucket_name, object_name, expected,
+                            IfGenerationMatch(0));
+
+  std::vector<char> buffer(1024);
+  std::vector<ReadRange> ranges{
+      {static_cast<std::int64_t>(expected.size() - 100), 200, &buffer[0]},
+      {0, 100, &buffer[200]},
+      {150, 100, &buffer[300]},
+      {10000, 100, &buffer[400]},
+  };
+  client.ReadRanges(bucket_name, object_name, ranges,
+                    ReadRangesOptions().set_max_gap(100));
+  for (auto const& r : ranges) {
+    auto length = (std::min)(r.length, static_cast<std::int64_t>(
+                                           expected.size() - r.offset));
+    EXPECT_EQ(expected.substr(r.offset, length),
+              std::string(r.buffer, r.bytes_read));
+  }
+
+  client.DeleteObject(bucket_name, object_name);
+}
+
+TEST_F(ObjectIntegrationTest, PartialResponses) {
+  Client client;
+  auto bucket_name = ObjectTestEnvironment::bucket_name();
+  auto object_name = MakeRandomObjectName();
+
+  auto insert_meta = client.InsertObject(bucket_name, object_name,
+                                         LoremIpsum(), IfGenerationMatch(0));
+
+  auto meta = client.GetObjectMetadata(bucket_name, object_name,
+                                       Fields("name,size,generation"));
+  EXPECT_EQ(object_name, meta.name());
+  EXPECT_EQ(insert_meta.size(), meta.size());
+  EXPECT_EQ(insert_meta.generation(), meta.generation());
+  EXPECT_EQ("", meta.bucket());
+  EXPECT_TRUE(meta.acl().empty());
+
+  int count = 0;
+  for (auto const& o :
+       client.ListObjects(bucket_name, ListObjectsInventoryFields())) {
+    EXPECT_EQ("", o.bucket());
+    EXPECT_TRUE(o.acl().empty());
+    if (o.name() == object_name) {
+      EXPECT_EQ(insert_meta.size(), o.size());
+      EXPECT_EQ(insert_meta.generation(), o.generation());
+      ++count;
+    }
+  }
+  EXPECT_EQ(1, count);
+
+  client.DeleteObject(bucket_name, object_name);
+}
+
+TEST_F(ObjectIntegrationTest, CopyObject) {
+  Client client;
+  auto bucket_name = ObjectTestEnvironment::bucket_name();
+  auto source_name = MakeRandomObjectName();
+  auto destination_name = MakeRandomObjectName();
+
+  std::string expected = LoremIpsum();
+  auto source_meta = client.InsertObject(bucket_name, source_name, expected,
+                                         IfGenerationMatch(0));
+
+  ObjectMetadata meta = client.CopyObject(
+      bucket_name, source_name, bucket_name, destination_name,
+      IfGenerationMatch(0), IfSourceGenerationMatch(source_meta.generation()));
+  EXPECT_EQ(bucket_name, meta.bucket());
+  EXPECT_EQ(destination_name, meta.name());
+  EXPECT_EQ(expected.size(), meta.size());
+
+  auto stream = client.ReadObject(bucket_name, destination_name);
+  std::string actual(std::istreambuf_iterator<char>{stream}, {});
+  EXPECT_EQ(expected, actual);
+
+  client.DeleteObject(bucket_name, destination_name);
+  client.DeleteObject(bucket_name, source_name);
+}
+
+TEST_F(ObjectIntegrationTest, RewriteObject) {
+  Client client;
+  auto bucket_name = ObjectTestEnvironment::bucket_name();
+  auto source_name = MakeRandomObjectName();
+
+  // Create an object large enough to (potentially) need multiple requests.
+  std::string expected;
+  while (expected.size() < 3 * 1024 * 1024) {
+    expected += LoremIpsum();
+  }
+  (void)client.InsertObject(bucket_name, source_name, expected,
+                            IfGenerationMatch(0));
+
+  std::vector<RewriteObjectsEntry> entries;
+  for (int i = 0; i != 3; ++i) {
+    entries.emplace_back(bucket_name, source_name, bucket_name,
+                         MakeRandomObjectName());
+  }
+  // Rewrite one object by hand, and the others with `RewriteObjects()`.
+  auto rewriter = client.RewriteObject(
+      bucket_name, source_name, bucket_name, entries[0].destination_object,
+      MaxBytesRewrittenPerCall(1024 * 1024));
+  RewriteProgress progress{0, 0, false};
+  while (not progress.done) {
+    progress = rewriter.Iterate();
+    EXPECT_EQ(expected.size(), progress.object_size);
+    EXPECT_GE(progress.object_size, progress.total_bytes_rewritten);
+  }
+  EXPECT_EQ(entries[0].destination_object, rewriter.result().name());
+  EXPECT_EQ(expected.size(), rewriter.result().size());
+
+  entries.erase(entries.begin());
+  std::vector<std::size_t> reported(entries.size());
+  auto results = client.RewriteObjects(
+      entries,
+      RewriteObjectsOptions().set_max_concurrency(2).set_progress_callback(
+          [&reported](std::size_t index, RewriteProgress const&) {
+            ++reported[index];
+          }),
+      MaxBytesRewrittenPerCall(1024 * 1024));
+  ASSERT_EQ(entries.size(), results.size());
+  for (std::size_t i = 0; i != results.size(); ++i) {
+    EXPECT_TRUE(results[i].ok()) << results[i].error;
+    EXPECT_EQ(entries[i].destination_object, results[i].metadata.name());
+    EXPECT_LE(1U, reported[i]);
+
+    auto stream = client.ReadObject(bucket_name, entries[i].destination_object);
+    std::string actual(std::istreambuf_iterator<char>{stream}, {});
+    EXPECT_EQ(expected, actual);
+    client.DeleteObject(bucket_name, entries[i].destination_object);
+  }
+
+  client.DeleteObject(bucket_name, rewriter.result().name());
+  client.DeleteObject(bucket_name, source_name);
+}
+
 TEST_F(ObjectIntegrationTest, AccessControlCRUD) {
   Client client;
   auto bucket_name = ObjectTestEnvironment::bucket_name();
@@ -255,6 +457,34 @@ TEST_F(ObjectIntegrationTest, AccessControlCRUD) {
 
   client.DeleteObject(bucket_name, object_name);
 }
+
+TEST_F(ObjectIntegrationTest, BatchDelete) {
+  Client client;
+  auto bucket_name = ObjectTestEnvironment::bucket_name();
+
+  std::vector<std::string> names;
+  for (int i = 0; i != 3; ++i) {
+    names.emplace_back(MakeRandomObjectName());
+    (void)client.InsertObject(bucket_name, names.back(), LoremIpsum(),
+                              IfGenerationMatch(0));
+  }
+
+  Batch batch;
+  std::vector<std::future<Status>> results;
+  for (auto const& name : names) {
+    results.emplace_back(batch.DeleteObject(bucket_name, name));
+  }
+  client.ExecuteBatch(std::move(batch));
+  for (auto& r : results) {
+    auto status = r.get();
+    EXPECT_TRUE(status.ok()) << status;
+  }
+
+  auto objects = client.ListObjects(bucket_name);
+  for (auto const& o : objects) {
+    EXPECT_EQ(names.end(), std::find(names.begin(), names.end(), o.name()));
+  }
+}
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
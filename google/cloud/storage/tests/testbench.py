@@ -15,8 +15,13 @@
 """A test bench for the Google Cloud Storage C++ Client Library."""
 
 import argparse
+import base64
+import hashlib
 import json
+import struct
 import time
+import uuid
+import zlib
 import flask
 import httpbin
 import os
@@ -87,10 +92,102 @@ def canonical_entity_name(entity):
     return entity.lower()
 
 
+def parse_fields(value):
+    """
+    Parse the value of a 'fields' query parameter.
+
+    :param value:str the parameter value, e.g. 'nextPageToken,items(name,size)'
+    :return:dict map each selected field to its selected sub-fields, an empty
+        dict selects the complete field.
+    """
+
+    def parse(pos):
+        result = {}
+        name = ''
+        while pos < len(value):
+            c = value[pos]
+            if c == ',':
+                if name.strip():
+                    result[name.strip()] = {}
+                name = ''
+            elif c == '(':
+                result[name.strip()], pos = parse(pos + 1)
+                name = ''
+            elif c == ')':
+                break
+            else:
+                name += c
+            pos += 1
+        if name.strip():
+            result[name.strip()] = {}
+        return result, pos
+
+    return parse(0)[0]
+
+
+def filter_fields(resource, selection):
+    """Return the fields in selection from resource (a dict or a list)."""
+    if not selection:
+        return resource
+    if isinstance(resource, list):
+        return [filter_fields(r, selection) for r in resource]
+    return {
+        key: filter_fields(resource[key], sub)
+        for key, sub in selection.items() if key in resource
+    }
+
+
+def apply_fields(request, resource):
+    """Implement partial responses, as requested by the 'fields' parameter."""
+    fields = request.args.get('fields')
+    if fields is None:
+        return resource
+    return filter_fields(resource, parse_fields(fields))
+
+
+def make_crc32c_table():
+    """Create the lookup table for the CRC32C (Castagnoli) checksum."""
+    table = []
+    for i in range(256):
+        crc = i
+        for _ in range(8):
+            crc = (crc >> 1) ^ (0x82F63B78 if crc & 1 else 0)
+        table.append(crc)
+    return table
+
+
+CRC32C_TABLE = make_crc32c_table()
+
+
+def compute_crc32c(media):
+    """
+    Compute the CRC32C checksum of an object, formatted as GCS does.
+
+    :param media:bytes the object contents.
+    :return:str the big-endian checksum, encoded in base64.
+    """
+    crc = 0xFFFFFFFF
+    for b in bytearray(media):
+        crc = CRC32C_TABLE[(crc ^ b) & 0xFF] ^ (crc >> 8)
+    value = struct.pack('>I', crc ^ 0xFFFFFFFF)
+    return base64.b64encode(value).decode('utf-8')
+
+
+def compute_md5(media):
+    """
+    Compute the MD5 hash of an object, formatted as GCS does.
+
+    :param media:bytes the object contents.
+    :return:str the MD5 hash, encoded in base64.
+    """
+    return base64.b64encode(hashlib.md5(media).digest()).decode('utf-8')
+
+
 class GcsObjectVersion(object):
     """Represent a single revision of a GCS Object."""
 
-    def __init__(self, gcs_url, bucket_name, name, generation, request):
+    def __init__(self, gcs_url, bucket_name, name, generation, request,
+                 media=None):
         """
         Initialize a new object revision.
 
@@ -99,6 +196,8 @@ class GcsObjectVersion(object):
         :param name:str the name of the object.
         :param generation:int the generation number for this object.
         :param request:flask.Request the contents of the HTTP request.
+        :param media:bytes the object contents, if None they are read from
+            the request.
         """
         self.bucket_name = bucket_name
         self.name = name
@@ -106,7 +205,9 @@ class GcsObjectVersion(object):
         self.object_id = bucket_name + '/o/' + name + '/' + str(generation)
         now = time.gmtime(time.time())
         timestamp = time.strftime('%Y-%m-%dT%H:%M:%SZ', now)
-        if request.environ.get('HTTP_TRANSFER_ENCODING', '') == 'chunked':
+        if media is not None:
+            self.media = media
+        elif request.environ.get('HTTP_TRANSFER_ENCODING', '') == 'chunked':
             self.media = request.environ.get('wsgi.input').read()
         else:
             self.media = request.data
@@ -124,8 +225,13 @@ class GcsObjectVersion(object):
             'location': 'US',
             'storageClass': 'STANDARD',
             'size': len(self.media),
+            'crc32c': compute_crc32c(self.media),
+            'md5Hash': compute_md5(self.media),
             'etag': 'XYZ='
         }
+        content_encoding = request.args.get('contentEncoding', None)
+        if content_encoding is not None:
+            self.metadata['contentEncoding'] = content_encoding
         self.insert_acl(
             canonical_entity_name('project-owners-123456789'), 'OWNER')
         self.insert_acl(
@@ -250,16 +356,18 @@ class GcsObject(object):
         self.generation = 0
         self.revisions = {}
 
-    def get_revision(self, request):
+    def get_revision(self, request, generation_field='generation'):
         """
         Get the information about a particular object revision or raise.
 
         :param request:flask.Request
+        :param generation_field:str the name of the query parameter with the
+            generation, copy requests use 'sourceGeneration'.
         :return:GcsObjectRevision the object revision.
         :raises:ErrorResponse if the request contains an invalid generation
             number.
         """
-        generation = request.args.get('generation')
+        generation = request.args.get(generation_field)
         if generation is None:
             return self.get_latest()
         version = self.revisions.get(int(generation))
@@ -289,22 +397,29 @@ class GcsObject(object):
     def get_latest(self):
         return self.revisions.get(self.generation, None)
 
-    def check_preconditions(self, request):
-        """Verify that the preconditions in request are met."""
+    def check_preconditions(self, request, prefix='if'):
+        """
+        Verify that the preconditions in request are met.
 
-        generation_match = request.args.get('ifGenerationMatch')
+        :param request:flask.Request
+        :param prefix:str the prefix for the query parameters, copy requests
+            use 'ifSource' for the preconditions on the source object.
+        """
+
+        generation_match = request.args.get(prefix + 'GenerationMatch')
         if generation_match is not None \
                 and int(generation_match) != self.generation:
             raise ErrorResponse('Precondition Failed', status_code=412)
 
         # This object does not exist (yet), testing in this case is special.
-        generation_not_match = request.args.get('ifGenerationNotMatch')
+        generation_not_match = request.args.get(prefix + 'GenerationNotMatch')
         if generation_not_match is not None \
                 and int(generation_not_match) == self.generation:
             raise ErrorResponse('Precondition Failed', status_code=412)
 
-        metageneration_match = request.args.get('ifMetagenerationMatch')
-        metageneration_not_match = request.args.get('ifMetagenerationNotMatch')
+        metageneration_match = request.args.get(prefix + 'MetagenerationMatch')
+        metageneration_not_match = request.args.get(
+            prefix + 'MetagenerationNotMatch')
         if self.generation == 0:
             if metageneration_match is not None \
                     or metageneration_not_match is not None:
@@ -333,6 +448,24 @@ class GcsObject(object):
         self.revisions[self.generation] = GcsObjectVersion(
             gcs_url, self.bucket_name, self.name, self.generation, request)
 
+    def copy_from(self, gcs_url, request, source):
+        """
+        Insert a new revision with the contents of another object revision.
+
+        :param gcs_url:str the root URL for the fake GCS service.
+        :param request:flask.Request the contents of the HTTP request.
+        :param source:GcsObjectVersion the revision to copy.
+        :return:GcsObjectVersion the new revision.
+        """
+        self.generation += 1
+        revision = GcsObjectVersion(gcs_url, self.bucket_name, self.name,
+                                    self.generation, request, source.media)
+        for field in ['contentEncoding', 'contentType']:
+            if field in source.metadata:
+                revision.metadata[field] = source.metadata[field]
+        self.revisions[self.generation] = revision
+        return revision
+
 
 class GcsBucket(object):
     """Represent a GCS Bucket."""
@@ -463,6 +596,9 @@ GCS_OBJECTS = dict()
 # Define the collection of Buckets indexed by <bucket_name>
 GCS_BUCKETS = dict()
 
+# Define the rewrites in progress indexed by their rewriteToken.
+GCS_REWRITES = dict()
+
 # Define the WSGI application to handle bucket requests.
 GCS_HANDLER_PATH = '/storage/v1'
 gcs = flask.Flask(__name__)
@@ -605,7 +741,7 @@ def objects_list(bucket_name):
         if o.get_latest() is None:
             continue
         result['items'].append(o.get_latest().metadata)
-    return json.dumps(result)
+    return json.dumps(apply_fields(flask.request, result))
 
 
 @gcs.route('/b/<bucket_name>/o/<object_name>')
@@ -621,13 +757,58 @@ def objects_get(bucket_name, object_name):
     if media is not None:
         if media != 'media':
             raise ErrorResponse('Invalid alt=%s parameter' % media)
-        response = flask.make_response(revision.media)
-        length = len(revision.media)
-        response.headers['Content-Range'] = 'bytes 0-%d/%d' % (length - 1,
-                                                               length)
+        media = revision.media
+        transcoded = False
+        if revision.metadata.get('contentEncoding', '') == 'gzip':
+            # Like GCS, decompress gzip-encoded objects for clients that do
+            # not accept gzip.
+            accept = flask.request.headers.get('Accept-Encoding', '')
+            if 'gzip' not in accept:
+                media = zlib.decompress(media, 16 + zlib.MAX_WBITS)
+                transcoded = True
+        length = len(media)
+        begin, end = 0, length - 1
+        status_code = 200
+        range_header = flask.request.headers.get('Range', None)
+        if range_header is not None and not transcoded:
+            begin, end = parse_range_header(range_header, length)
+            media = media[begin:end + 1]
+            status_code = 206
+        response = flask.make_response(media, status_code)
+        response.headers['Content-Range'] = 'bytes %d-%d/%d' % (begin, end,
+                                                                length)
+        response.headers['x-goog-generation'] = str(
+            revision.metadata.get('generation'))
+        if transcoded:
+            response.headers[
+                'x-guploader-response-body-transformations'] = 'gunzipped'
+        elif revision.metadata.get('contentEncoding', '') == 'gzip':
+            response.headers['Content-Encoding'] = 'gzip'
+        response.headers['x-goog-hash'] = 'crc32c=%s,md5=%s' % (
+            revision.metadata.get('crc32c'), revision.metadata.get('md5Hash'))
         return response
 
-    return json.dumps(revision.metadata)
+    return json.dumps(apply_fields(flask.request, revision.metadata))
+
+
+def parse_range_header(value, length):
+    """Parse a 'Range: bytes=<begin>-[<end>]' header.
+
+    Returns the first and last byte of the range, clipped to the object size.
+    """
+    unit = 'bytes='
+    if not value.startswith(unit):
+        raise ErrorResponse('Invalid Range header %s' % value)
+    first, _, last = value[len(unit):].partition('-')
+    try:
+        begin = int(first)
+        end = int(last) if last else length - 1
+    except ValueError:
+        raise ErrorResponse('Invalid Range header %s' % value)
+    if begin >= length or end < begin:
+        raise ErrorResponse('Range not satisfiable %s' % value,
+                            status_code=416)
+    return begin, min(end, length - 1)
 
 
 @gcs.route('/b/<bucket_name>/o/<object_name>', methods=['DELETE'])
@@ -644,6 +825,93 @@ def objects_delete(bucket_name, object_name):
     return json.dumps({})
 
 
+def get_copy_source(bucket_name, object_name, request):
+    """Find the source revision for a copy or rewrite request."""
+    object_path = bucket_name + '/o/' + object_name
+    gcs_object = GCS_OBJECTS.get(object_path)
+    if gcs_object is None or gcs_object.get_latest() is None:
+        raise ErrorResponse(
+            'Source object %s not found' % object_path, status_code=404)
+    gcs_object.check_preconditions(request, prefix='ifSource')
+    return gcs_object.get_revision(request, generation_field='sourceGeneration')
+
+
+def copy_to_destination(bucket_name, object_name, request, source):
+    """Create a new revision of the destination object with the source data."""
+    base_url = flask.url_for('gcs_index', _external=True)
+    object_path = bucket_name + '/o/' + object_name
+    gcs_object = GCS_OBJECTS.get(object_path,
+                                 GcsObject(bucket_name, object_name))
+    gcs_object.check_preconditions(request)
+    GCS_OBJECTS[object_path] = gcs_object
+    return gcs_object.copy_from(base_url, request, source)
+
+
+@gcs.route(
+    '/b/<source_bucket>/o/<source_object>/copyTo/b/<destination_bucket>/o/'
+    '<destination_object>',
+    methods=['POST'])
+def objects_copy(source_bucket, source_object, destination_bucket,
+                 destination_object):
+    """Implement the 'Objects: copy' API, copy an object."""
+    source = get_copy_source(source_bucket, source_object, flask.request)
+    revision = copy_to_destination(destination_bucket, destination_object,
+                                   flask.request, source)
+    return json.dumps(revision.metadata)
+
+
+@gcs.route(
+    '/b/<source_bucket>/o/<source_object>/rewriteTo/b/<destination_bucket>/o/'
+    '<destination_object>',
+    methods=['POST'])
+def objects_rewrite(source_bucket, source_object, destination_bucket,
+                    destination_object):
+    """Implement the 'Objects: rewrite' API, copy an object in steps.
+
+    Each request copies at most maxBytesRewrittenPerCall bytes (all the data if
+    the parameter is not set), and returns a token to continue the rewrite.
+    Unlike the service, any positive value is accepted, which lets the tests
+    exercise multi-step rewrites without creating large objects.
+    """
+    token = flask.request.args.get('rewriteToken')
+    if token is None:
+        source = get_copy_source(source_bucket, source_object, flask.request)
+        token = str(uuid.uuid4())
+        GCS_REWRITES[token] = {
+            'source': source,
+            'destination': destination_bucket + '/o/' + destination_object,
+            'bytes_rewritten': 0
+        }
+    state = GCS_REWRITES.get(token)
+    if state is None:
+        raise ErrorResponse('Invalid rewriteToken %s' % token)
+    if state.get('destination') != \
+            destination_bucket + '/o/' + destination_object:
+        raise ErrorResponse('Mismatched destination for rewriteToken')
+    source = state.get('source')
+    object_size = len(source.media)
+    max_bytes = int(flask.request.args.get('maxBytesRewrittenPerCall', 0))
+    if max_bytes <= 0:
+        max_bytes = object_size
+    state['bytes_rewritten'] = min(object_size,
+                                   state['bytes_rewritten'] + max_bytes)
+    done = state['bytes_rewritten'] == object_size
+    response = {
+        'kind': 'storage#rewriteResponse',
+        'totalBytesRewritten': str(state['bytes_rewritten']),
+        'objectSize': str(object_size),
+        'done': done
+    }
+    if done:
+        GCS_REWRITES.pop(token)
+        revision = copy_to_destination(destination_bucket, destination_object,
+                                       flask.request, source)
+        response['resource'] = revision.metadata
+    else:
+        response['rewriteToken'] = token
+    return json.dumps(response)
+
+
 @gcs.route('/b/<bucket_name>/o/<object_name>/acl')
 def objects_acl_list(bucket_name, object_name):
     """Implement the 'ObjectAccessControls: list' API.
@@ -771,10 +1039,87 @@ def objects_insert(bucket_name):
     return json.dumps(current_version.metadata)
 
 
+# Define the WSGI application to handle batch requests.
+BATCH_HANDLER_PATH = '/batch/storage/v1'
+batch = flask.Flask(__name__)
+batch.debug = True
+
+
+@batch.errorhandler(ErrorResponse)
+def batch_error(error):
+    return error.as_response()
+
+
+def parse_http_headers(lines):
+    """Parse a list of 'Name: value' lines into a dictionary."""
+    headers = {}
+    for line in lines:
+        name, _, value = line.partition(':')
+        headers[name.strip()] = value.strip()
+    return headers
+
+
+@batch.route('/', methods=['POST'])
+def objects_batch():
+    """Implement the GCS batch requests.
+
+    Each part of the multipart/mixed payload is an embedded HTTP request,
+    which is dispatched to the GCS application. The results are returned as
+    the parts of a multipart/mixed response, in the same order.
+    """
+    boundary = flask.request.mimetype_params.get('boundary', None)
+    if flask.request.mimetype != 'multipart/mixed' or boundary is None:
+        raise ErrorResponse('Batch requests must be multipart/mixed')
+    payload = flask.request.get_data(as_text=True).replace('\r\n', '\n')
+    parts = payload.split('--' + boundary)
+    if len(parts) < 2 or not parts[-1].startswith('--'):
+        raise ErrorResponse('Missing closing delimiter in batch request')
+    operations = parts[1:-1]
+    if len(operations) > 100:
+        raise ErrorResponse('Too many operations in batch request')
+
+    client = gcs.test_client()
+    response_boundary = 'batch_testbench_%d' % int(time.time() * 1000)
+    result = ''
+    for index, part in enumerate(operations):
+        # Each part has its own headers, then the embedded HTTP request. The
+        # newline before each delimiter belongs to the delimiter.
+        part_head, _, message = part.lstrip('\n').partition('\n\n')
+        part_headers = parse_http_headers(part_head.split('\n'))
+        content_id = part_headers.get('Content-ID', '<%d>' % (index + 1))
+        head, _, body = message.partition('\n\n')
+        if body.endswith('\n'):
+            body = body[:-1]
+        lines = head.split('\n')
+        method, target, _ = lines[0].split(' ', 2)
+        if not target.startswith(GCS_HANDLER_PATH + '/'):
+            raise ErrorResponse('Invalid target in batch request: %s' % target)
+        headers = parse_http_headers(lines[1:])
+        headers.pop('Content-Length', None)
+        response = client.open(
+            target[len(GCS_HANDLER_PATH):],
+            method=method,
+            headers=headers,
+            data=body)
+        result += '--' + response_boundary + '\r\n'
+        result += 'Content-Type: application/http\r\n'
+        result += 'Content-ID: <response-%s>\r\n\r\n' % content_id.strip(
+            '<>')
+        result += 'HTTP/1.1 %s\r\n' % response.status
+        result += 'Content-Type: %s\r\n\r\n' % response.content_type
+        result += response.get_data(as_text=True) + '\r\n'
+    result += '--' + response_boundary + '--\r\n'
+    batch_response = flask.make_response(result)
+    batch_response.headers['Content-Type'] = (
+        'multipart/mixed; boundary=' + response_boundary)
+    return batch_response
+
+
 application = wsgi.DispatcherMiddleware(root, {
     '/httpbin': httpbin.app,
     GCS_HANDLER_PATH: gcs,
     UPLOAD_HANDLER_PATH: upload,
+    BATCH_HANDLER_PATH: batch,
 })
 
 
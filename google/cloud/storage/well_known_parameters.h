@@ -58,6 +58,35 @@ struct Projection : public WellKnownParameter<Projection, std::string> {
   static char const* well_known_parameter_name() { return "projection"; }
 };
 
+/**
+ * Request a partial response with only the given fields.
+ *
+ * The value uses the syntax described in
+ * https://cloud.google.com/storage/docs/json_api/v1/how-tos/performance, e.g.
+ * `Fields("name,size")`. The fields not included in the response have their
+ * default values in the returned metadata.
+ *
+ * For list operations the fields refer to the whole response, they must
+ * include `nextPageToken` to fetch more than one page, and `prefixes` if the
+ * listing uses a `Delimiter`.
+ */
+struct Fields : public WellKnownParameter<Fields, std::string> {
+  using WellKnownParameter<Fields, std::string>::WellKnownParameter;
+  static char const* well_known_parameter_name() { return "fields"; }
+};
+
+/**
+ * Only list the name, size and generation of each object.
+ *
+ * Use this with `Client::ListObjects()` or `Client::ParallelListObjects()` to
+ * scan large buckets: the responses are several times smaller, and the client
+ * does not parse ACLs, custom metadata, or timestamps. The other fields in the
+ * returned `ObjectMetadata` have their default values.
+ */
+inline Fields ListObjectsInventoryFields() {
+  return Fields("nextPageToken,prefixes,items(name,size,generation)");
+}
+
 struct UserProject : public WellKnownParameter<UserProject, std::string> {
   using WellKnownParameter<UserProject, std::string>::WellKnownParameter;
   static char const* well_known_parameter_name() { return "userProject"; }
@@ -106,6 +135,11 @@ struct Prefix : public WellKnownParameter<Prefix, std::string> {
   static char const* well_known_parameter_name() { return "prefix"; }
 };
 
+struct Delimiter : public WellKnownParameter<Delimiter, std::string> {
+  using WellKnownParameter<Delimiter, std::string>::WellKnownParameter;
+  static char const* well_known_parameter_name() { return "delimiter"; }
+};
+
 struct PredefinedDefaultObjectAcl
     : public WellKnownParameter<PredefinedDefaultObjectAcl, std::string> {
   using WellKnownParameter<PredefinedDefaultObjectAcl,
@@ -141,6 +175,80 @@ struct PredefinedAcl : public WellKnownParameter<PredefinedAcl, std::string> {
   static char const* well_known_parameter_name() { return "predefinedAcl"; }
 };
 
+struct SourceGeneration
+    : public WellKnownParameter<SourceGeneration, std::int64_t> {
+  using WellKnownParameter<SourceGeneration, std::int64_t>::WellKnownParameter;
+  static char const* well_known_parameter_name() { return "sourceGeneration"; }
+};
+
+struct IfSourceGenerationMatch
+    : public WellKnownParameter<IfSourceGenerationMatch, std::int64_t> {
+  using WellKnownParameter<IfSourceGenerationMatch,
+                           std::int64_t>::WellKnownParameter;
+  static char const* well_known_parameter_name() {
+    return "ifSourceGenerationMatch";
+  }
+};
+
+struct IfSourceGenerationNotMatch
+    : public WellKnownParameter<IfSourceGenerationNotMatch, std::int64_t> {
+  using WellKnownParameter<IfSourceGenerationNotMatch,
+                           std::int64_t>::WellKnownParameter;
+  static char const* well_known_parameter_name() {
+    return "ifSourceGenerationNotMatch";
+  }
+};
+
+struct IfSourceMetaGenerationMatch
+    : public WellKnownParameter<IfSourceMetaGenerationMatch, std::int64_t> {
+  using WellKnownParameter<IfSourceMetaGenerationMatch,
+                           std::int64_t>::WellKnownParameter;
+  static char const* well_known_parameter_name() {
+    return "ifSourceMetagenerationMatch";
+  }
+};
+
+struct IfSourceMetaGenerationNotMatch
+    : public WellKnownParameter<IfSourceMetaGenerationNotMatch, std::int64_t> {
+  using WellKnownParameter<IfSourceMetaGenerationNotMatch,
+                           std::int64_t>::WellKnownParameter;
+  static char const* well_known_parameter_name() {
+    return "ifSourceMetagenerationNotMatch";
+  }
+};
+
+struct DestinationKmsKeyName
+    : public WellKnownParameter<DestinationKmsKeyName, std::string> {
+  using WellKnownParameter<DestinationKmsKeyName,
+                           std::string>::WellKnownParameter;
+  static char const* well_known_parameter_name() {
+    return "destinationKmsKeyName";
+  }
+};
+
+struct DestinationPredefinedAcl
+    : public WellKnownParameter<DestinationPredefinedAcl, std::string> {
+  using WellKnownParameter<DestinationPredefinedAcl,
+                           std::string>::WellKnownParameter;
+  static char const* well_known_parameter_name() {
+    return "destinationPredefinedAcl";
+  }
+};
+
+/**
+ * Limit the number of bytes copied by each `Objects: rewrite` request.
+ *
+ * The service may copy fewer bytes, the value must be a multiple of 1MiB.
+ */
+struct MaxBytesRewrittenPerCall
+    : public WellKnownParameter<MaxBytesRewrittenPerCall, std::int64_t> {
+  using WellKnownParameter<MaxBytesRewrittenPerCall,
+                           std::int64_t>::WellKnownParameter;
+  static char const* well_known_parameter_name() {
+    return "maxBytesRewrittenPerCall";
+  }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud